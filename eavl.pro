@@ -26,22 +26,43 @@ SOURCES += \
  src/common/eavlAtomicProperties.cpp \
  src/common/eavlCUDA.cpp \
  src/common/eavlCellComponents.cpp \
+ src/common/eavlCellLocator.cpp \
  src/common/eavlCellSetExplicit.cpp \
  src/common/eavlDataSet.cpp \
  src/common/eavlExecutor.cpp \
+ src/common/eavlMemoryTracker.cpp \
  src/common/eavlNewIsoTables.cpp \
  src/common/eavlOperation.cpp \
+ src/common/eavlStatistics.cpp \
  src/common/eavlTimer.cpp \
  src/exporters/eavlVTKExporter.cpp \
+ src/exporters/eavlBinaryExporter.cpp \
  src/exporters/eavlPNMExporter.cpp \
+ src/filters/eavl2DGraphLayoutForceMutator.cpp \
  src/filters/eavl3X3AverageMutator.cu \
+ src/filters/eavlAppendFilter.cpp \
+ src/filters/eavlClipFilter.cu \
+ src/filters/eavlConnectedComponentsMutator.cpp \
+ src/filters/eavlDecimateFilter.cpp \
  src/filters/eavlElevateMutator.cpp \
- src/filters/eavlExternalFaceMutator.cpp \
+ src/filters/eavlExpressionMutator.cu \
+ src/filters/eavlExternalFaceMutator.cu \
+ src/filters/eavlGradientMutator.cu \
  src/filters/eavlIsosurfaceFilter.cu \
+ src/filters/eavlMetaCellIndex.cu \
+ src/filters/eavlNodeStencilMutator.cu \
+ src/filters/eavlRecenterMutator.cu \
+ src/filters/eavlResampleFilter.cpp \
+ src/filters/eavlSliceFilter.cu \
+ src/filters/eavlStatisticsMutator.cpp \
+ src/filters/eavlStreamlineFilter.cpp \
  src/filters/eavlSurfaceNormalMutator.cu \
  src/filters/eavlTesselate2DFilter.cpp \
- src/filters/eavlThresholdMutator.cpp \
+ src/filters/eavlThresholdFilter.cu \
+ src/filters/eavlThresholdMutator.cu \
+ src/filters/eavlUnaryMathMutator.cu \
  src/importers/eavlBOVImporter.cpp \
+ src/importers/eavlBinaryImporter.cpp \
  src/importers/eavlImporterFactory.cpp \
  src/importers/eavlMADNESSImporter.cpp \
  src/importers/eavlPDBImporter.cpp \
@@ -58,17 +79,34 @@ SOURCES += \
     src/importers/eavlCurveImporter.cpp \
     src/filters/eavlTransformMutator.cu \
     src/filters/eavlTransformMutator.cu \
-    src/filters/eavlThresholdMutator.cpp \
+    src/filters/eavlThresholdFilter.cu \
+    src/filters/eavlThresholdMutator.cu \
     src/filters/eavlTesselate2DFilter.cpp \
     src/filters/eavlSurfaceNormalMutator.cu \
+    src/filters/eavlStreamlineFilter.cpp \
+    src/filters/eavlStatisticsMutator.cpp \
+    src/filters/eavlSliceFilter.cu \
     src/filters/eavlScalarBinFilter.cu \
+    src/filters/eavlResampleFilter.cpp \
+    src/filters/eavlRecenterMutator.cu \
+    src/filters/eavlNodeStencilMutator.cu \
+    src/filters/eavlMetaCellIndex.cu \
     src/filters/eavlIsosurfaceFilter.cu \
-    src/filters/eavlExternalFaceMutator.cpp \
+    src/filters/eavlGradientMutator.cu \
+    src/filters/eavlExternalFaceMutator.cu \
+    src/filters/eavlExpressionMutator.cu \
     src/filters/eavlElevateMutator.cpp \
+    src/filters/eavlDecimateFilter.cpp \
+    src/filters/eavlConnectedComponentsMutator.cpp \
     src/filters/eavlCellToNodeRecenterMutator.cu \
+    src/filters/eavlClipFilter.cu \
     src/filters/eavlBinaryMathMutator.cu \
+    src/filters/eavlAppendFilter.cpp \
     src/filters/eavl3X3AverageMutator.cu \
+    src/filters/eavl2DGraphLayoutForceMutator.cpp \
     src/common/eavlUtility.cpp \
+    src/common/eavlMemoryTracker.cpp \
+    src/common/eavlCellLocator.cpp \
     src/importers/eavlPNGImporter.cpp
 
 HEADERS += $$files(src/common/*.h) $$files(src/exporters/*.h) $$files(src/filters/*.h) $$files(src/importers/*.h) $$files(src/math/*.h) $$files(src/operations/*.h) $$files(src/rendering/*.h) \
@@ -80,13 +118,28 @@ HEADERS += $$files(src/common/*.h) $$files(src/exporters/*.h) $$files(src/filter
     src/importers/eavlCurveImporter.h \
     src/filters/eavlTransformMutator.h \
     src/filters/eavlThresholdMutator.h \
+    src/filters/eavlThresholdFilter.h \
     src/filters/eavlTesselate2DFilter.h \
     src/filters/eavlSurfaceNormalMutator.h \
+    src/filters/eavlStreamlineFilter.h \
+    src/filters/eavlStatisticsMutator.h \
+    src/filters/eavlSliceFilter.h \
     src/filters/eavlScalarBinFilter.h \
+    src/filters/eavlResampleFilter.h \
+    src/filters/eavlRecenterMutator.h \
+    src/filters/eavlNodeStencilMutator.h \
+    src/filters/eavlMetaCellIndex.h \
     src/filters/eavlIsosurfaceFilter.h \
+    src/filters/eavlGradientMutator.h \
     src/filters/eavlExternalFaceMutator.h \
+    src/filters/eavlExpressionMutator.h \
     src/filters/eavlElevateMutator.h \
+    src/filters/eavlDecimateFilter.h \
+    src/filters/eavlConnectedComponentsMutator.h \
     src/filters/eavlCellToNodeRecenterMutator.h \
+    src/filters/eavlClipFilter.h \
     src/filters/eavlBinaryMathMutator.h \
+    src/filters/eavlAppendFilter.h \
     src/filters/eavl3X3AverageMutator.h \
+    src/filters/eavl2DGraphLayoutForceMutator.h \
     src/importers/eavlPNGImporter.h
@@ -6,6 +6,7 @@
 #include "eavl.h"
 #include "eavlException.h"
 #include "eavlCUDA.h"
+#include "eavlMemoryTracker.h"
 
 #ifdef HAVE_CUDA
 #include <cuda.h>
@@ -37,18 +38,45 @@ class eavlArray
   protected:
     string        name;
     int           ncomponents;
+    eavlMemoryTracker::Category memoryCategory;
+    long long     trackedBytes;
+
+    /// Report the bytes our storage now holds to eavlMemoryTracker.
+    /// Call this with the expected size before growing (so an
+    /// exhausted budget throws before allocating) and with the actual
+    /// size afterwards.
+    void TrackMemory(long long bytes)
+    {
+        eavlMemoryTracker::Change(memoryCategory, trackedBytes, bytes);
+        trackedBytes = bytes;
+    }
   public:
     eavlArray(const string &n,     ///< name
               int nc = 1)          ///< number of components
-        : name(n)
+        : name(n),
+          memoryCategory(eavlMemoryTracker::GetArrayCategory()),
+          trackedBytes(0)
     {
         SetNumberOfComponents(nc);
     }
-    virtual ~eavlArray() { }
+    virtual ~eavlArray()
+    {
+        eavlMemoryTracker::Free(memoryCategory, trackedBytes);
+    }
     const string &GetName()
     {
         return name;
     }
+    eavlMemoryTracker::Category GetMemoryCategory()
+    {
+        return memoryCategory;
+    }
+    void SetMemoryCategory(eavlMemoryTracker::Category c)
+    {
+        eavlMemoryTracker::Free(memoryCategory, trackedBytes);
+        memoryCategory = c;
+        eavlMemoryTracker::Allocate(memoryCategory, trackedBytes);
+    }
     virtual eavlArray *Create(const string &n, int nc = 1, int nt = 0) = 0;
     virtual const char *GetBasicType() = 0;
     virtual void   SetNumberOfTuples(int) = 0;
@@ -270,6 +298,14 @@ class eavlConcreteArray : public eavlArray
     void NeedToUseOnHost() const {};
     void NeedToUseOnDevice() const {};
 #endif
+    void ResizeHost(size_t n)
+    {
+        long long bytes = n * sizeof(T);
+        if (bytes > trackedBytes)
+            TrackMemory(bytes);
+        host_values_self.resize(n);
+        TrackMemory(host_values_self.capacity() * sizeof(T));
+    }
   public:
     eavlConcreteArray(const string &n, int nc = 1, int nt = 0) : eavlArray(n,nc)
     {
@@ -284,7 +320,7 @@ class eavlConcreteArray : public eavlArray
         device_values = NULL;
 #endif
         if (nt > 0)
-            host_values_self.resize(ncomponents * nt);
+            ResizeHost(ncomponents * nt);
     }
     eavlConcreteArray(T *extarray,
                       const string &n, int nc = 1, int nt = 0) : eavlArray(n,nc)
@@ -324,7 +360,7 @@ class eavlConcreteArray : public eavlArray
         if (host_provided)
             THROW(eavlException, "Cannot resize externally-provided array");
         NeedToUseOnHost();
-        host_values_self.resize(ncomponents * n);
+        ResizeHost(ncomponents * n);
     }
     virtual int GetNumberOfTuples() const
     {
@@ -383,6 +419,7 @@ class eavlConcreteArray : public eavlArray
         // assert ncomponents==1?
         NeedToUseOnHost();
         host_values_self.push_back(v);
+        TrackMemory(host_values_self.capacity() * sizeof(T));
     }
     virtual double GetComponentAsDouble(int i, int c)
     {
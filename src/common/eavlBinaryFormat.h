@@ -0,0 +1,72 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_BINARY_FORMAT_H
+#define EAVL_BINARY_FORMAT_H
+
+// ****************************************************************************
+// File:  eavlBinaryFormat.h
+//
+// Purpose:
+///   Constants shared by eavlBinaryExporter and eavlBinaryImporter.
+///
+///   A file is a flat sequence of records in native byte order:
+///   \verbatim
+///     header       : "EAVLBIN\0", int version, int endian-check
+///     npoints      : int
+///     logical      : int type [, int logicaldim, int regdim, int dims[regdim]]
+///     coord systems: int n, then per system:
+///                    int type, [double xform[16],] int ndims, then per axis:
+///                    int cartesian-axis, int axis-type,
+///                    (string field, int comp) | (int logdim, double o, d)
+///     cell sets    : int n, then per set:
+///                    int type, string name, int dimensionality, then
+///                    structured: int regdim, int dims[regdim]
+///                    explicit  : long ncells, long nconn, then aligned
+///                                int shapetype[], connectivity[],
+///                                mapCellToIndex[]
+///                    subset    : int parent, long n, aligned int ids[]
+///     fields       : int n, then per field:
+///                    string name, string type, int order, int assoc,
+///                    int assocvalue, int ncomp, long ntuples,
+///                    aligned raw values
+///   \endverbatim
+///   Strings are an int length followed by the characters.  Every bulk
+///   array starts on an EAVL_BINARY_ALIGNMENT byte boundary (relative to
+///   the start of the file) so a reader can map the file and use the
+///   values in place.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+
+#define EAVL_BINARY_MAGIC       "EAVLBIN"
+#define EAVL_BINARY_VERSION     1
+#define EAVL_BINARY_ENDIANCHECK 0x01020304
+#define EAVL_BINARY_ALIGNMENT   64
+
+enum eavlBinaryLogicalType
+{
+    EAVL_BINARY_LOGICAL_NONE,
+    EAVL_BINARY_LOGICAL_REGULAR
+};
+
+enum eavlBinaryCoordinatesType
+{
+    EAVL_BINARY_COORDS_CARTESIAN,
+    EAVL_BINARY_COORDS_CARTESIAN_WITH_TRANSFORM
+};
+
+enum eavlBinaryAxisType
+{
+    EAVL_BINARY_AXIS_FIELD,
+    EAVL_BINARY_AXIS_REGULAR
+};
+
+enum eavlBinaryCellSetType
+{
+    EAVL_BINARY_CELLSET_STRUCTURED,
+    EAVL_BINARY_CELLSET_EXPLICIT,
+    EAVL_BINARY_CELLSET_SUBSET
+};
+
+#endif
@@ -0,0 +1,368 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlCellLocator.h"
+#include "eavlShapeFunctions.h"
+#include "eavlException.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+// approximate number of cells we aim for in each bin, at each level
+static const int topCellsPerBin  = 32;
+static const int leafCellsPerBin = 4;
+static const int maxBinsPerAxis  = 1024;
+
+// ****************************************************************************
+// Function:  ChooseResolution
+//
+// Purpose:
+///   Pick a bin count along each axis of a box so that there are roughly
+///   "target" bins in total and the bins are close to cubical.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+static void
+ChooseResolution(int dim, const double ext[3], double target, int res[3])
+{
+    res[0] = res[1] = res[2] = 1;
+    double vol = 1;
+    int nd = 0;
+    for (int d=0; d<dim; d++)
+    {
+        if (ext[d] > 0)
+        {
+            vol *= ext[d];
+            nd++;
+        }
+    }
+    if (target <= 1 || nd == 0)
+        return;
+
+    double h = pow(vol / target, 1. / double(nd));
+    for (int d=0; d<dim; d++)
+    {
+        if (ext[d] <= 0)
+            continue;
+        int n = int(ceil(ext[d] / h));
+        res[d] = (n < 1) ? 1 : ((n > maxBinsPerAxis) ? maxBinsPerAxis : n);
+    }
+}
+
+eavlCellLocator::eavlCellLocator(eavlDataSet *ds, eavlCellSet *cs)
+    : cells(cs)
+{
+    dim = cells->GetDimensionality();
+    if (dim < 2 || dim > 3)
+        THROW(eavlException,"eavlCellLocator only supports 2D and 3D cell sets");
+
+    //
+    // cache the point coordinates and find the bounds
+    //
+    int npts = ds->GetNumPoints();
+    coords.resize(3*npts);
+    for (int d=0; d<3; d++)
+    {
+        bmin[d] = +DBL_MAX;
+        bmax[d] = -DBL_MAX;
+    }
+    for (int i=0; i<npts; i++)
+    {
+        for (int d=0; d<3; d++)
+        {
+            double v = ds->GetPoint(i, d);
+            coords[3*i+d] = v;
+            if (v < bmin[d])
+                bmin[d] = v;
+            if (v > bmax[d])
+                bmax[d] = v;
+        }
+    }
+    if (npts == 0)
+    {
+        for (int d=0; d<3; d++)
+            bmin[d] = bmax[d] = 0;
+    }
+
+    //
+    // size the top level of the grid
+    //
+    int ncells = cells->GetNumCells();
+    double ext[3];
+    for (int d=0; d<3; d++)
+        ext[d] = bmax[d] - bmin[d];
+    ChooseResolution(dim, ext, double(ncells) / double(topCellsPerBin),
+                     topDims);
+    for (int d=0; d<3; d++)
+        topDelta[d] = (ext[d] > 0) ? ext[d] / double(topDims[d]) : 1.;
+    int ntop = topDims[0]*topDims[1]*topDims[2];
+
+    //
+    // count the cells overlapping each top-level bin
+    //
+    vector<int> topCount(ntop, 0);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int c=0; c<ncells; c++)
+    {
+        eavlCell cell = cells->GetCellNodes(c);
+        if (eavlShapeTopologicalDimension(cell.type) != dim)
+            continue;
+        double lo[3], hi[3];
+        int rlo[3], rhi[3];
+        GetCellBounds(cell, lo, hi);
+        GetBinRange(lo, hi, bmin, topDelta, topDims, rlo, rhi);
+        for (int k=rlo[2]; k<=rhi[2]; k++)
+            for (int j=rlo[1]; j<=rhi[1]; j++)
+                for (int i=rlo[0]; i<=rhi[0]; i++)
+                {
+#ifdef HAVE_OPENMP
+#pragma omp atomic
+#endif
+                    topCount[(k*topDims[1] + j)*topDims[0] + i]++;
+                }
+    }
+
+    //
+    // refine each top-level bin according to how many cells it holds
+    //
+    topLeafStart.resize(ntop+1);
+    topLeafDims.resize(3*ntop);
+    topLeafStart[0] = 0;
+    for (int b=0; b<ntop; b++)
+    {
+        ChooseResolution(dim, topDelta,
+                         double(topCount[b]) / double(leafCellsPerBin),
+                         &(topLeafDims[3*b]));
+        topLeafStart[b+1] = topLeafStart[b] +
+            topLeafDims[3*b+0] * topLeafDims[3*b+1] * topLeafDims[3*b+2];
+    }
+    int nleaf = topLeafStart[ntop];
+
+    //
+    // count, scan, and fill the leaf bins; cells land in a leaf in
+    // whatever order the threads reach them, so sort each leaf after
+    // filling to keep the result independent of the thread count
+    //
+    leafCellStart.clear();
+    leafCellStart.resize(nleaf+1, 0);
+    vector<int> cursor;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        if (pass == 1)
+        {
+            for (int l=0; l<nleaf; l++)
+                leafCellStart[l+1] += leafCellStart[l];
+            leafCells.resize(leafCellStart[nleaf]);
+            cursor.assign(leafCellStart.begin(), leafCellStart.end()-1);
+        }
+
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int c=0; c<ncells; c++)
+        {
+            eavlCell cell = cells->GetCellNodes(c);
+            if (eavlShapeTopologicalDimension(cell.type) != dim)
+                continue;
+            double lo[3], hi[3];
+            int rlo[3], rhi[3];
+            GetCellBounds(cell, lo, hi);
+            GetBinRange(lo, hi, bmin, topDelta, topDims, rlo, rhi);
+            for (int k=rlo[2]; k<=rhi[2]; k++)
+            for (int j=rlo[1]; j<=rhi[1]; j++)
+            for (int i=rlo[0]; i<=rhi[0]; i++)
+            {
+                int b = (k*topDims[1] + j)*topDims[0] + i;
+                const int *ldims = &(topLeafDims[3*b]);
+                double lorigin[3], ldelta[3];
+                int llo[3], lhi[3];
+                GetTopBinExtents(b, lorigin, ldelta);
+                GetBinRange(lo, hi, lorigin, ldelta, ldims, llo, lhi);
+                for (int kk=llo[2]; kk<=lhi[2]; kk++)
+                for (int jj=llo[1]; jj<=lhi[1]; jj++)
+                for (int ii=llo[0]; ii<=lhi[0]; ii++)
+                {
+                    int l = topLeafStart[b] +
+                        (kk*ldims[1] + jj)*ldims[0] + ii;
+                    if (pass == 0)
+                    {
+#ifdef HAVE_OPENMP
+#pragma omp atomic
+#endif
+                        leafCellStart[l+1]++;
+                    }
+                    else
+                    {
+                        int pos;
+#ifdef HAVE_OPENMP
+#pragma omp atomic capture
+#endif
+                        pos = cursor[l]++;
+                        leafCells[pos] = c;
+                    }
+                }
+            }
+        }
+    }
+
+#ifdef HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic,64)
+#endif
+    for (int l=0; l<nleaf; l++)
+        std::sort(leafCells.begin() + leafCellStart[l],
+                  leafCells.begin() + leafCellStart[l+1]);
+}
+
+void
+eavlCellLocator::GetCellBounds(const eavlCell &cell,
+                               double lo[3], double hi[3]) const
+{
+    for (int d=0; d<3; d++)
+    {
+        lo[d] = +DBL_MAX;
+        hi[d] = -DBL_MAX;
+    }
+    for (int n=0; n<cell.numIndices; n++)
+    {
+        const float *p = &(coords[3*cell.indices[n]]);
+        for (int d=0; d<3; d++)
+        {
+            if (p[d] < lo[d])
+                lo[d] = p[d];
+            if (p[d] > hi[d])
+                hi[d] = p[d];
+        }
+    }
+}
+
+void
+eavlCellLocator::GetBinRange(const double lo[3], const double hi[3],
+                             const double origin[3], const double delta[3],
+                             const int dims[3], int rlo[3], int rhi[3]) const
+{
+    for (int d=0; d<3; d++)
+    {
+        int a = int(floor((lo[d] - origin[d]) / delta[d]));
+        int b = int(floor((hi[d] - origin[d]) / delta[d]));
+        rlo[d] = (a < 0) ? 0 : ((a >= dims[d]) ? dims[d]-1 : a);
+        rhi[d] = (b < 0) ? 0 : ((b >= dims[d]) ? dims[d]-1 : b);
+    }
+}
+
+void
+eavlCellLocator::GetTopBinExtents(int b,
+                                  double origin[3], double delta[3]) const
+{
+    int ijk[3];
+    ijk[0] = b % topDims[0];
+    ijk[1] = (b / topDims[0]) % topDims[1];
+    ijk[2] = b / (topDims[0]*topDims[1]);
+    for (int d=0; d<3; d++)
+    {
+        origin[d] = bmin[d] + ijk[d]*topDelta[d];
+        delta[d]  = topDelta[d] / double(topLeafDims[3*b+d]);
+    }
+}
+
+// ****************************************************************************
+// Method:  eavlCellLocator::TestCell
+//
+// Purpose:
+///   Check if the given point lies in the given cell.  On success, fills
+///   in the cell and the parametric coordinates of the point.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+bool
+eavlCellLocator::TestCell(int index, const double p[3], double rst[3],
+                          eavlCell &cell) const
+{
+    cell = cells->GetCellNodes(index);
+    if (eavlShapeTopologicalDimension(cell.type) != dim ||
+        cell.numIndices > 12)
+        return false;
+
+    double lo[3], hi[3];
+    GetCellBounds(cell, lo, hi);
+    for (int d=0; d<dim; d++)
+    {
+        double eps = 1.e-5 * (hi[d] - lo[d]);
+        if (p[d] < lo[d] - eps || p[d] > hi[d] + eps)
+            return false;
+    }
+
+    double pts[36];
+    for (int n=0; n<cell.numIndices; n++)
+        for (int d=0; d<3; d++)
+            pts[3*n+d] = coords[3*cell.indices[n]+d];
+
+    if (!eavlWorldToParametric(cell.type, cell.numIndices, pts, p, dim, rst))
+        return false;
+    return eavlParametricIsInside(cell.type, rst[0], rst[1], rst[2], 1.e-5);
+}
+
+// ****************************************************************************
+// Method:  eavlCellLocator::FindCell
+//
+// Purpose:
+///   Return the index of the cell containing point p, or -1 if no cell
+///   contains it.  If a hint is given (e.g. the cell found for a nearby
+///   point on a previous call), that cell is tested first.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+int
+eavlCellLocator::FindCell(const double p[3], double rst[3], eavlCell &cell,
+                          int hint) const
+{
+    if (hint >= 0 && TestCell(hint, p, rst, cell))
+        return hint;
+
+    int top[3];
+    for (int d=0; d<3; d++)
+    {
+        if (d < dim && (p[d] < bmin[d] || p[d] > bmax[d]))
+            return -1;
+        int i = int(floor((p[d] - bmin[d]) / topDelta[d]));
+        top[d] = (i < 0) ? 0 : ((i >= topDims[d]) ? topDims[d]-1 : i);
+    }
+    int b = (top[2]*topDims[1] + top[1])*topDims[0] + top[0];
+
+    double origin[3], delta[3];
+    GetTopBinExtents(b, origin, delta);
+    const int *ldims = &(topLeafDims[3*b]);
+    int leaf[3];
+    for (int d=0; d<3; d++)
+    {
+        int i = int(floor((p[d] - origin[d]) / delta[d]));
+        leaf[d] = (i < 0) ? 0 : ((i >= ldims[d]) ? ldims[d]-1 : i);
+    }
+    int l = topLeafStart[b] + (leaf[2]*ldims[1] + leaf[1])*ldims[0] + leaf[0];
+
+    for (int i=leafCellStart[l]; i<leafCellStart[l+1]; i++)
+    {
+        int c = leafCells[i];
+        if (c != hint && TestCell(c, p, rst, cell))
+            return c;
+    }
+    return -1;
+}
+
+long long
+eavlCellLocator::GetMemoryUsage()
+{
+    long long mem = sizeof(eavlCellLocator);
+    mem += coords.size() * sizeof(float);
+    mem += topLeafStart.size() * sizeof(int);
+    mem += topLeafDims.size() * sizeof(int);
+    mem += leafCellStart.size() * sizeof(int);
+    mem += leafCells.size() * sizeof(int);
+    return mem;
+}
@@ -0,0 +1,69 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_CELL_LOCATOR_H
+#define EAVL_CELL_LOCATOR_H
+
+#include "STL.h"
+#include "eavlDataSet.h"
+#include "eavlCellSet.h"
+#include "eavlCell.h"
+
+// ****************************************************************************
+// Class:  eavlCellLocator
+//
+// Purpose:
+///   Finds the cell containing a given point, and the parametric
+///   coordinates of that point within the cell.
+///   Cells are binned by bounding box into a two-level uniform grid:
+///   the top level is sized from the total cell count, and each top-level
+///   bin is refined independently based on the number of cells it
+///   overlaps, so that strongly graded or clustered meshes do not end up
+///   with a few bins holding most of the cells.
+///   FindCell does not modify the locator, so queries may be issued
+///   concurrently from multiple threads.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlCellLocator
+{
+  protected:
+    eavlCellSet   *cells;
+    int            dim;
+    vector<float>  coords;
+    double         bmin[3];
+    double         bmax[3];
+    int            topDims[3];
+    double         topDelta[3];
+    vector<int>    topLeafStart;
+    vector<int>    topLeafDims;
+    vector<int>    leafCellStart;
+    vector<int>    leafCells;
+
+  public:
+    eavlCellLocator(eavlDataSet *ds, eavlCellSet *cs);
+    int  FindCell(const double p[3], double rst[3], eavlCell &cell,
+                  int hint = -1) const;
+    bool TestCell(int index, const double p[3], double rst[3],
+                  eavlCell &cell) const;
+    int  GetSpatialDimension() const { return dim; }
+    void GetBounds(double lo[3], double hi[3]) const
+    {
+        for (int d=0; d<3; d++)
+        {
+            lo[d] = bmin[d];
+            hi[d] = bmax[d];
+        }
+    }
+    long long GetMemoryUsage();
+
+  protected:
+    void GetCellBounds(const eavlCell &cell, double lo[3], double hi[3]) const;
+    void GetBinRange(const double lo[3], const double hi[3],
+                     const double origin[3], const double delta[3],
+                     const int dims[3], int rlo[3], int rhi[3]) const;
+    void GetTopBinExtents(int topIndex,
+                          double origin[3], double delta[3]) const;
+};
+
+#endif
@@ -27,7 +27,7 @@ class eavlCellSetAllQuadTree : public eavlCellSet
     }
     virtual int GetNumCells()
     {
-        return log->root.GetNumCells(true);
+        return log->GetNumLeaves();
     }
     virtual eavlCell GetCellNodes(int index)
     {
@@ -39,8 +39,6 @@ class eavlCellSetAllQuadTree : public eavlCellSet
         cell.indices[1] = index*4 + 1;
         cell.indices[2] = index*4 + 2;
         cell.indices[3] = index*4 + 3;
-        //eavlLogicalStructureQuadTree::QuadTreeCell *qcell = log->celllist[index];
-        //cerr << "  width="<<(qcell->xmax-qcell->xmin)<<" level="<<qcell->lvl<<endl;
         return cell;
     }
     virtual void PrintSummary(ostream &out)
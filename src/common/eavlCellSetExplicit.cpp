@@ -1,8 +1,6 @@
 // Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
 #include "eavlCellSetExplicit.h"
 
-using std::multimap;
-
 class eavlEdge
 {
  public:
@@ -341,12 +339,14 @@ void eavlCellSetExplicit::BuildFaceConnectivity()
 
 void eavlCellSetExplicit::BuildNodeCellConnectivity()
 {
+    if (nodeCellConnectivityValid)
+        return;
+
     nodeCellConnectivity.shapetype.clear();
     nodeCellConnectivity.connectivity.clear();
 
-    multimap<int,int> cells_of_nodes;
-
-    int maxNodeID = 0;
+    // count the cells using each node
+    vector<int> count;
     int numCells = GetNumCells();
     for (int cell = 0, cindex = 0; cell < numCells; ++cell)
     {
@@ -354,31 +354,40 @@ void eavlCellSetExplicit::BuildNodeCellConnectivity()
         for (int pt=0; pt<npts; ++pt)
         {
             int index = cellNodeConnectivity.connectivity[cindex++];
-            if (index > maxNodeID)
-                maxNodeID = index;
-            cells_of_nodes.insert(pair<int,int>(index,cell));
+            if (index >= (int)count.size())
+                count.resize(index+1, 0);
+            ++count[index];
         }
     }
 
-    int last_node = -1;
-    int cur_node_ctr = 0;
-    int cur_node_connstart = 0;
-    for (multimap<int,int>::iterator iter = cells_of_nodes.begin();
-         iter != cells_of_nodes.end(); iter++)
+    // lay out each node's list (its count, then its cells) in order
+    int numNodes = count.size();
+    vector<int> next(numNodes);
+    int nconn = 0;
+    for (int node = 0; node < numNodes; ++node)
+    {
+        next[node] = nconn + 1;
+        nconn += count[node] + 1;
+    }
+    nodeCellConnectivity.shapetype.resize(numNodes);
+    nodeCellConnectivity.connectivity.resize(nconn);
+    for (int node = 0; node < numNodes; ++node)
+    {
+        nodeCellConnectivity.shapetype[node] = EAVL_POINT;
+        nodeCellConnectivity.connectivity[next[node]-1] = count[node];
+    }
+
+    // and fill in the cells, which keeps them in increasing order
+    for (int cell = 0, cindex = 0; cell < numCells; ++cell)
     {
-        int node = iter->first;
-        while (last_node < node)
+        int npts = cellNodeConnectivity.connectivity[cindex++];
+        for (int pt=0; pt<npts; ++pt)
         {
-            ++last_node;
-            nodeCellConnectivity.shapetype.push_back(EAVL_POINT);
-            cur_node_ctr = 0;
-            cur_node_connstart = nodeCellConnectivity.connectivity.size();
-            nodeCellConnectivity.connectivity.push_back(0);
+            int index = cellNodeConnectivity.connectivity[cindex++];
+            nodeCellConnectivity.connectivity[next[index]++] = cell;
         }
-        int cell = iter->second;
-        nodeCellConnectivity.connectivity.push_back(cell);
-        ++nodeCellConnectivity.connectivity[cur_node_connstart];
     }
 
     nodeCellConnectivity.CreateReverseIndex();
+    nodeCellConnectivityValid = true;
 }
@@ -22,6 +22,14 @@
 //   Jeremy Meredith, Fri Oct 19 16:54:36 EDT 2012
 //   Added reverse connectivity (i.e. get cells attached to a node).
 //
+//   agent, Sun Oct 18 2026
+//   GetMemoryUsage now counts the reverse, edge, and face connectivity.
+//
+//   agent, Sun Oct 18 2026
+//   The reverse connectivity is now built once and kept until the cells
+//   are replaced, rather than rebuilt every time it is requested.
+//   Handing out the cell connectivity for writing also invalidates it.
+//
 // ****************************************************************************
 
 class eavlCellSetExplicit : public eavlCellSet
@@ -32,6 +40,7 @@ class eavlCellSetExplicit : public eavlCellSet
     eavlExplicitConnectivity cellNodeConnectivity;
 
     eavlExplicitConnectivity nodeCellConnectivity;
+    bool nodeCellConnectivityValid;
 
     eavlExplicitConnectivity cellEdgeConnectivity;
     eavlExplicitConnectivity edgeNodeConnectivity;
@@ -48,6 +57,7 @@ class eavlCellSetExplicit : public eavlCellSet
   public:
     eavlCellSetExplicit(const string &n, int d)
         : eavlCellSet(n,d),
+          nodeCellConnectivityValid(false),
           numEdges(-1),
           numFaces(-1)
     {
@@ -71,6 +81,7 @@ class eavlCellSetExplicit : public eavlCellSet
     {
         cellNodeConnectivity.Replace(conn);
         cellNodeConnectivity.CreateReverseIndex();
+        nodeCellConnectivityValid = false;
         numEdges = -1;
         numFaces = -1;
     }
@@ -81,6 +92,8 @@ class eavlCellSetExplicit : public eavlCellSet
         switch (topology)
         {
           case EAVL_NODES_OF_CELLS:
+            // the derived connectivities are cached until the cells are
+            // replaced with SetCellNodeConnectivity
             return cellNodeConnectivity;
 
           case EAVL_CELLS_OF_NODES:
@@ -151,13 +164,13 @@ class eavlCellSetExplicit : public eavlCellSet
     virtual long long GetMemoryUsage()
     {
         long long mem = 0;
-        mem += sizeof(vector<eavlCellShape>);
-        mem += cellNodeConnectivity.shapetype.size() * sizeof(eavlCellShape);
-        mem += sizeof(vector<int>);
-        mem += cellNodeConnectivity.connectivity.size() * sizeof(int);
-        mem += sizeof(vector<int>);
-        mem += cellNodeConnectivity.mapCellToIndex.size() * sizeof(int);
-        ///\todo: update this (e.g. with edge, face connectivity)
+        mem += cellNodeConnectivity.GetMemoryUsage();
+        mem += nodeCellConnectivity.GetMemoryUsage();
+        mem += cellEdgeConnectivity.GetMemoryUsage();
+        mem += edgeNodeConnectivity.GetMemoryUsage();
+        mem += cellFaceConnectivity.GetMemoryUsage();
+        mem += faceNodeConnectivity.GetMemoryUsage();
+        mem += 2 * sizeof(int);
         return mem + eavlCellSet::GetMemoryUsage();
     }
 };
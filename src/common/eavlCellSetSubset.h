@@ -3,12 +3,29 @@
 #define EAVL_CELL_SET_SUBSET_H
 
 #include "eavlCellSet.h"
+#include "eavlCellSetAllStructured.h"
+#include "eavlException.h"
+#include <algorithm>
+
 // ****************************************************************************
 // Class:  eavlCellSetSubset
 //
 // Purpose:
 ///   This set of cells is an explicit subset of other another cell set
 ///
+///   The selected parent cell indices are stored in whichever of three
+///   representations is smallest: a list of contiguous index ranges,
+///   a bitmap over the parent cells (with a running count every
+///   EAVL_SUBSET_BITMAP_BLOCK words for random access), or a plain list.
+///   Build a subset by calling AddCell for each selected parent cell
+///   and then Finalize; cells added in increasing order are accumulated
+///   as ranges or bits without ever materializing the full list.  Cells
+///   added out of order force the list representation so the given
+///   order is kept.
+///
+///   Use an Iterator to walk the selected cells in amortized constant
+///   time per cell; GetParentIndex gives random access in log time.
+///
 ///\todo: the existence of this in our current data model raises one issue:
 ///       do we need to make an explicit downselection of our cell variables
 ///       when we do the subselection?  if we indirected the cell variable
@@ -22,21 +39,206 @@
 // Programmer:  Jeremy Meredith, Dave Pugmire, Sean Ahern
 // Creation:    February 15, 2011
 //
+// Modifications:
+//   agent, Sun Oct 18 2026
+//   Store the selection adaptively as ranges, a bitmap, or a list, and
+//   added iteration.  Structured parents are accessed directly rather
+//   than through a virtual call.  The public "subset" vector is gone:
+//   fill a subset with AddCell, AddCellRange or SetCells, and read it
+//   with GetParentIndex, GetParentIndices or an Iterator.
+//
 // ****************************************************************************
 
+#define EAVL_SUBSET_BITMAP_BLOCK 8
+
+// operations iterating a subset in parallel give each thread chunks
+// of this many cells, each with its own Iterator
+#define EAVL_SUBSET_ITERATOR_BLOCK 1024
 
 class eavlCellSetSubset : public eavlCellSet
 {
+  public:
+    enum StorageType
+    {
+        RANGES,
+        BITMAP,
+        LIST
+    };
+
+    class Iterator;
+
   protected:
     eavlCellSet *parent; ///<\todo: should this really be a pointer, or index, or what?
-  public:
-    vector<int> subset;
+    eavlCellSetAllStructured *parentStructured;
+
+    StorageType  storage;
+    int          ncells;
+    int          lastAdded;
+
+    // RANGES: range i covers parent cells rangeStart[i] .. and holds
+    // subset cells rangeOffset[i] up to rangeOffset[i+1]
+    vector<int>  rangeStart;
+    vector<int>  rangeOffset;
+
+    // BITMAP: one bit per parent cell; blockOffset[b] is the number of
+    // selected cells before word b*EAVL_SUBSET_BITMAP_BLOCK
+    vector<unsigned int> bits;
+    vector<int>  blockOffset;
+
+    // LIST
+    vector<int>  list;
+
   public:
     eavlCellSetSubset(eavlCellSet *p)
         : eavlCellSet(string("subset_of_")+p->GetName(), p->GetDimensionality()),
           parent(p)
     {
+        parentStructured = dynamic_cast<eavlCellSetAllStructured*>(p);
+        Clear();
+    }
+    eavlCellSetSubset(const string &n, eavlCellSet *p)
+        : eavlCellSet(n, p->GetDimensionality()), parent(p)
+    {
+        parentStructured = dynamic_cast<eavlCellSetAllStructured*>(p);
+        Clear();
+    }
+    eavlCellSet *GetParent()
+    {
+        return parent;
+    }
+    StorageType GetStorageType() const
+    {
+        return storage;
+    }
+
+    void Clear()
+    {
+        storage = RANGES;
+        ncells = 0;
+        lastAdded = -1;
+        rangeStart.clear();
+        rangeOffset.clear();
+        rangeOffset.push_back(0);
+        bits.clear();
+        blockOffset.clear();
+        list.clear();
+    }
+    void AddCell(int index)
+    {
+        if (storage == LIST)
+        {
+            list.push_back(index);
+        }
+        else if (index <= lastAdded)
+        {
+            // out of order; only a list can keep it
+            ConvertToList();
+            list.push_back(index);
+        }
+        else if (storage == RANGES)
+        {
+            if (!rangeStart.empty() && index == lastAdded+1)
+            {
+                rangeOffset.back()++;
+            }
+            else
+            {
+                rangeStart.push_back(index);
+                rangeOffset.push_back(rangeOffset.back()+1);
+                if (RangesBytes(rangeStart.size()) > BitmapBytes())
+                    ConvertToBitmap();
+            }
+        }
+        else // BITMAP
+        {
+            bits[index/32] |= (1u << (index%32));
+        }
+        lastAdded = index;
+        ncells++;
     }
+    void AddCellRange(int start, int count)
+    {
+        if (storage == RANGES && start > lastAdded && count > 0)
+        {
+            if (!rangeStart.empty() && start == lastAdded+1)
+            {
+                rangeOffset.back() += count;
+            }
+            else
+            {
+                rangeStart.push_back(start);
+                rangeOffset.push_back(rangeOffset.back()+count);
+            }
+            lastAdded = start + count - 1;
+            ncells += count;
+            return;
+        }
+        for (int i=0; i<count; i++)
+            AddCell(start+i);
+    }
+    void Finalize()
+    {
+        // pick the smallest representation for what we ended up with
+        long long listBytes = (long long)ncells * sizeof(int);
+        if (storage == RANGES && listBytes < RangesBytes(rangeStart.size()))
+            ConvertToList();
+        else if (storage == BITMAP && listBytes < BitmapBytes())
+            ConvertToList();
+
+        if (storage == BITMAP)
+        {
+            int nwords = bits.size();
+            int nblocks = (nwords + EAVL_SUBSET_BITMAP_BLOCK-1) /
+                          EAVL_SUBSET_BITMAP_BLOCK;
+            blockOffset.resize(nblocks+1);
+            int count = 0;
+            for (int w=0; w<nwords; w++)
+            {
+                if (w % EAVL_SUBSET_BITMAP_BLOCK == 0)
+                    blockOffset[w / EAVL_SUBSET_BITMAP_BLOCK] = count;
+                count += PopCount(bits[w]);
+            }
+            blockOffset[nblocks] = count;
+        }
+    }
+    void SetCells(const vector<int> &ids)
+    {
+        Clear();
+        for (size_t i=0; i<ids.size(); i++)
+            AddCell(ids[i]);
+        Finalize();
+    }
+
+    void GetParentIndices(int *ids) const;
+    int GetParentIndex(int index) const
+    {
+        if (storage == LIST)
+            return list[index];
+        if (storage == RANGES)
+        {
+            int r = std::upper_bound(rangeOffset.begin(), rangeOffset.end(),
+                                     index) - rangeOffset.begin() - 1;
+            return rangeStart[r] + (index - rangeOffset[r]);
+        }
+        // BITMAP
+        int b = std::upper_bound(blockOffset.begin(), blockOffset.end(),
+                                 index) - blockOffset.begin() - 1;
+        int remaining = index - blockOffset[b];
+        int w = b * EAVL_SUBSET_BITMAP_BLOCK;
+        for (;;)
+        {
+            int c = PopCount(bits[w]);
+            if (remaining < c)
+                break;
+            remaining -= c;
+            w++;
+        }
+        unsigned int word = bits[w];
+        for (int i=0; i<remaining; i++)
+            word &= word - 1;
+        return w*32 + LowestBit(word);
+    }
+
     virtual void PrintSummary(ostream &out)
     {
         out << "    eavlCellSetSubset:\n";
@@ -44,26 +246,295 @@ class eavlCellSetSubset : public eavlCellSet
         out << "        dimensionality = "<<dimensionality<<endl;
         out << "        nCells = "<<GetNumCells()<<endl;
         out << "        parent = "<<parent<<endl;
-        out << "        subset["<<subset.size()<<"] = ";
-        PrintVectorSummary(out, subset);
+        if (storage == RANGES)
+        {
+            out << "        rangeStart["<<rangeStart.size()<<"] = ";
+            PrintVectorSummary(out, rangeStart);
+        }
+        else if (storage == BITMAP)
+        {
+            out << "        bitmap["<<bits.size()<<"] = ";
+            PrintVectorSummary(out, bits);
+        }
+        else
+        {
+            out << "        subset["<<list.size()<<"] = ";
+            PrintVectorSummary(out, list);
+        }
         out << endl;
     }
     virtual int GetNumCells()
     {
-        return subset.size();
+        return ncells;
     }
     virtual eavlCell GetCellNodes(int index)
     {
-        return parent->GetCellNodes(subset[index]);
+        int p = GetParentIndex(index);
+        if (parentStructured)
+        {
+            eavlCell c;
+            c.type = (eavlCellShape)parentStructured->GetRegularStructure().
+                                         GetCellNodes(p, c.numIndices, c.indices);
+            return c;
+        }
+        return parent->GetCellNodes(p);
     }
     virtual long long GetMemoryUsage()
     {
         long long mem = 0;
         mem += sizeof(eavlCellSet*);
-        mem += sizeof(vector<int>);
-        mem += subset.size() * sizeof(int);
+        mem += sizeof(eavlCellSetAllStructured*);
+        mem += sizeof(StorageType);
+        mem += 2 * sizeof(int);
+        mem += 5 * sizeof(vector<int>);
+        mem += rangeStart.size() * sizeof(int);
+        mem += rangeOffset.size() * sizeof(int);
+        mem += bits.size() * sizeof(unsigned int);
+        mem += blockOffset.size() * sizeof(int);
+        mem += list.size() * sizeof(int);
         return mem + eavlCellSet::GetMemoryUsage();
     }
+
+  protected:
+    static int PopCount(unsigned int v)
+    {
+#ifdef __GNUC__
+        return __builtin_popcount(v);
+#else
+        v = v - ((v >> 1) & 0x55555555u);
+        v = (v & 0x33333333u) + ((v >> 2) & 0x33333333u);
+        return (((v + (v >> 4)) & 0x0f0f0f0fu) * 0x01010101u) >> 24;
+#endif
+    }
+    static int LowestBit(unsigned int v)
+    {
+#ifdef __GNUC__
+        return __builtin_ctz(v);
+#else
+        int b = 0;
+        while (!(v & 1u))
+        {
+            v >>= 1;
+            b++;
+        }
+        return b;
+#endif
+    }
+    long long RangesBytes(long long nranges) const
+    {
+        return nranges * 2 * sizeof(int);
+    }
+    long long BitmapBytes() const
+    {
+        long long nwords = (parent->GetNumCells() + 31) / 32;
+        long long nblocks = nwords / EAVL_SUBSET_BITMAP_BLOCK + 2;
+        return nwords * sizeof(unsigned int) + nblocks * sizeof(int);
+    }
+    void ConvertToBitmap()
+    {
+        bits.clear();
+        bits.resize((parent->GetNumCells() + 31) / 32, 0u);
+        for (size_t r=0; r<rangeStart.size(); r++)
+        {
+            int n = rangeOffset[r+1] - rangeOffset[r];
+            for (int i=0; i<n; i++)
+            {
+                int c = rangeStart[r] + i;
+                bits[c/32] |= (1u << (c%32));
+            }
+        }
+        rangeStart.clear();
+        rangeOffset.clear();
+        storage = BITMAP;
+    }
+    void ConvertToList()
+    {
+        if (storage == LIST)
+            return;
+        vector<int> ids;
+        ids.reserve(ncells);
+        if (storage == RANGES)
+        {
+            for (size_t r=0; r<rangeStart.size(); r++)
+            {
+                int n = rangeOffset[r+1] - rangeOffset[r];
+                for (int i=0; i<n; i++)
+                    ids.push_back(rangeStart[r] + i);
+            }
+        }
+        else
+        {
+            for (size_t w=0; w<bits.size(); w++)
+            {
+                unsigned int word = bits[w];
+                while (word)
+                {
+                    ids.push_back(w*32 + LowestBit(word));
+                    word &= word - 1;
+                }
+            }
+        }
+        list.swap(ids);
+        rangeStart.clear();
+        rangeOffset.clear();
+        bits.clear();
+        blockOffset.clear();
+        storage = LIST;
+    }
+
+    friend class Iterator;
+};
+
+// ****************************************************************************
+// Class:  eavlCellSetSubset::Iterator
+//
+// Purpose:
+///   Walk the cells of a subset from a given subset index, returning
+///   each subset index together with the parent cell it refers to.
+///   Starting anywhere costs one random lookup; each step after that
+///   is constant time (amortized over a bitmap word), so threads can
+///   each take a contiguous chunk of the subset.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlCellSetSubset::Iterator
+{
+  protected:
+    const eavlCellSetSubset *s;
+    int index, end;
+    int range, parentIndex;
+    int word;
+    unsigned int wordBits;
+  public:
+    Iterator(const eavlCellSetSubset *subset, int first, int last)
+        : s(subset), index(first), end(last)
+    {
+        if (end > s->ncells)
+            end = s->ncells;
+        if (index >= end)
+            return;
+        if (s->storage == RANGES)
+        {
+            range = std::upper_bound(s->rangeOffset.begin(),
+                                     s->rangeOffset.end(), index) -
+                    s->rangeOffset.begin() - 1;
+            parentIndex = s->rangeStart[range] + (index - s->rangeOffset[range]);
+        }
+        else if (s->storage == BITMAP)
+        {
+            int p = s->GetParentIndex(index);
+            word = p / 32;
+            wordBits = s->bits[word] & (~0u << (p % 32));
+        }
+    }
+    bool Next(int &subsetIndex, int &parentCell)
+    {
+        if (index >= end)
+            return false;
+        subsetIndex = index;
+        if (s->storage == LIST)
+        {
+            parentCell = s->list[index];
+        }
+        else if (s->storage == RANGES)
+        {
+            if (index >= s->rangeOffset[range+1])
+            {
+                range++;
+                parentIndex = s->rangeStart[range];
+            }
+            parentCell = parentIndex++;
+        }
+        else
+        {
+            while (wordBits == 0)
+                wordBits = s->bits[++word];
+            parentCell = word*32 + eavlCellSetSubset::LowestBit(wordBits);
+            wordBits &= wordBits - 1;
+        }
+        index++;
+        return true;
+    }
+};
+
+// ****************************************************************************
+// Method:  eavlCellSetSubset::GetParentIndices
+//
+// Purpose:
+///   Write the parent cell index of every subset cell into ids, which
+///   must have room for GetNumCells() values.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+inline void
+eavlCellSetSubset::GetParentIndices(int *ids) const
+{
+    int nblocks = (ncells + EAVL_SUBSET_ITERATOR_BLOCK - 1) /
+                  EAVL_SUBSET_ITERATOR_BLOCK;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int b = 0; b < nblocks; b++)
+    {
+        int index, cell;
+        Iterator it(this, b * EAVL_SUBSET_ITERATOR_BLOCK,
+                    (b+1) * EAVL_SUBSET_ITERATOR_BLOCK);
+        while (it.Next(index, cell))
+            ids[index] = cell;
+    }
+}
+
+// ****************************************************************************
+// Class:  eavlSubsetConnectivity<C>
+//
+// Purpose:
+///   Pairs a subset with the connectivity of its parent so operations
+///   can iterate the subset and look up each kept cell through the
+///   parent's own (regular or explicit) connectivity.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+template <class C>
+struct eavlSubsetConnectivity
+{
+    eavlCellSetSubset *subset;
+    C                 &conn;
+    eavlSubsetConnectivity(eavlCellSetSubset *s, C &c) : subset(s), conn(c)
+    {
+    }
+};
+
+// ****************************************************************************
+// Class:  eavlIndexedConnectivity<C>
+//
+// Purpose:
+///   Looks up element i of a connectivity through a flat array of
+///   element ids; this is how device kernels walk a subset, since the
+///   Iterator only runs on the host.  It holds copies of the connectivity
+///   and the id pointer so it can be passed by value to a kernel.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+template <class C>
+struct eavlIndexedConnectivity
+{
+    C    conn;
+    int *ids;
+    eavlIndexedConnectivity(const C &c, int *i) : conn(c), ids(i)
+    {
+    }
+    EAVL_HOSTDEVICE int GetElementComponents(int index, int &npts, int *pts)
+    {
+        return conn.GetElementComponents(ids[index], npts, pts);
+    }
 };
 
 #endif
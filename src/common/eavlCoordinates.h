@@ -114,6 +114,18 @@ class eavlCoordinateAxisRegular : public eavlCoordinateAxis
     {
         out << "          eavlCoordinateAxisRegular origin='"<<origin<<"' delta="<<delta<<endl;
     }
+    int GetLogicalDim()
+    {
+        return logicaldim;
+    }
+    double GetOrigin()
+    {
+        return origin;
+    }
+    double GetDelta()
+    {
+        return delta;
+    }
     virtual double GetValue(int pointIndex,
                             vector<int> &indexDivs,
                             vector<int> &indexMods,
@@ -263,6 +275,10 @@ class eavlCoordinatesCartesian : public eavlCoordinates
         //cerr << "GetCartesianPoint, i="<<i<<" c="<<c<<" axisIndex="<<axisIndex<<endl;
         return GetRawPoint(i, axisIndex, fd);
     }
+    CartesianAxisType GetAxisType(int i)
+    {
+        return axisTypes[i];
+    }
     virtual void PrintSummary(ostream &out)
     {
         out << "   eavlCoordinatesCartesian, ndims="<<axes.size()<<": " << endl;
@@ -124,6 +124,12 @@ struct eavlExplicitConnectivity
 
         mapCellToIndex.clear();
     }
+    EAVL_HOSTONLY long long GetMemoryUsage() const
+    {
+        return shapetype.GetMemoryUsage() +
+               connectivity.GetMemoryUsage() +
+               mapCellToIndex.GetMemoryUsage();
+    }
     EAVL_HOSTONLY void PrintSummary(ostream &out)
     {
         out << "        shapetype["<<shapetype.size()<<"] = ";
@@ -6,6 +6,7 @@
 #include "eavl.h"
 #include "eavlException.h"
 #include "eavlCUDA.h"
+#include "eavlMemoryTracker.h"
 
 #ifdef HAVE_CUDA
 #include <cuda.h>
@@ -70,7 +71,11 @@ class eavlFlatArray
     void operator=(const eavlFlatArray &a)
     {
         if (host)
+        {
+            eavlMemoryTracker::Free(eavlMemoryTracker::CONNECTIVITY,
+                                    (long long)capacity * sizeof(T));
             delete[] host;
+        }
 #ifdef HAVE_CUDA
         if (device)
             cudaFree(device);
@@ -89,6 +94,8 @@ class eavlFlatArray
     {
         if (len > 0)
         {
+            eavlMemoryTracker::Allocate(eavlMemoryTracker::CONNECTIVITY,
+                                        (long long)len * sizeof(T));
             host = new T[len];
         }
         else
@@ -108,7 +115,11 @@ class eavlFlatArray
         if (!copied)
         {
             if (host)
+            {
+                eavlMemoryTracker::Free(eavlMemoryTracker::CONNECTIVITY,
+                                        (long long)capacity * sizeof(T));
                 delete[] host;
+            }
             host = NULL;
 #ifdef HAVE_CUDA
             if (device)
@@ -133,6 +144,10 @@ class eavlFlatArray
         if (capacity == newcap)
             return;
 
+        eavlMemoryTracker::Change(eavlMemoryTracker::CONNECTIVITY,
+                                  (long long)(host ? capacity : 0) * sizeof(T),
+                                  newcap * sizeof(T));
+
         // copy old to new
         T *newhost = new T[newcap];
         for (int i=0; i<length; ++i)
@@ -218,6 +233,13 @@ class eavlFlatArray
     {
         return length;
     }
+    EAVL_HOSTONLY long long GetMemoryUsage() const
+    {
+        long long mem = sizeof(eavlFlatArray<T>);
+        if (host && !copied)
+            mem += (long long)capacity * sizeof(T);
+        return mem;
+    }
 
     ///\todo: it's dumb that even with hostonly and deviceonly
     /// we have to ifdef out one of the two.  Check if newer CUDA versions
@@ -0,0 +1,106 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_GHOST_CELLS_H
+#define EAVL_GHOST_CELLS_H
+
+#include "STL.h"
+#include "eavlArray.h"
+#include "eavlDataSet.h"
+#include "eavlMemoryTracker.h"
+
+/// The name of the cell field marking ghost cells: nonzero for a cell
+/// which duplicates one owned by a neighboring domain.
+#define EAVL_GHOST_FIELD_NAME ".ghost"
+
+// ****************************************************************************
+// Class:  eavlGhostCells
+//
+// Purpose:
+///   The ghost cell flags of a cell set, i.e. its EAVL_GHOST_FIELD_NAME
+///   field, if it has one.  Importers which decompose a mesh add a layer
+///   of ghost cells around each domain so that anything computed near
+///   the domain boundaries (gradients, isosurfaces, external faces)
+///   matches the undecomposed result; filters and renderers then leave
+///   the ghost cells themselves out of what they produce.
+///
+///   The flags are available as a byte per cell, either the field's own
+///   array or a converted copy, so a cell set without ghosts costs
+///   nothing but the field lookup.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlGhostCells
+{
+  protected:
+    eavlByteArray *array;
+    bool           ownarray;
+    const byte    *flags;
+
+  public:
+    eavlGhostCells(eavlDataSet *ds, int cellSetIndex)
+        : array(NULL), ownarray(false), flags(NULL)
+    {
+        if (cellSetIndex < 0)
+            return;
+        int ncells = ds->GetCellSet(cellSetIndex)->GetNumCells();
+        eavlArray *ghost = NULL;
+        for (int i=0; i<ds->GetNumFields(); i++)
+        {
+            eavlField *f = ds->GetField(i);
+            if (f->GetArray()->GetName() == EAVL_GHOST_FIELD_NAME &&
+                f->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+                f->GetAssocCellSet() == cellSetIndex &&
+                f->GetArray()->GetNumberOfTuples() == ncells)
+            {
+                ghost = f->GetArray();
+                break;
+            }
+        }
+        if (!ghost || ncells == 0)
+            return;
+
+        array = dynamic_cast<eavlByteArray*>(ghost);
+        if (!array || array->GetNumberOfComponents() != 1)
+        {
+            {
+                eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+                array = new eavlByteArray(EAVL_GHOST_FIELD_NAME, 1, ncells);
+            }
+            ownarray = true;
+            for (int i=0; i<ncells; i++)
+                array->SetValue(i, ghost->GetComponentAsDouble(i,0) != 0);
+        }
+        flags = (const byte*)array->GetHostArray();
+    }
+    ~eavlGhostCells()
+    {
+        if (ownarray)
+            delete array;
+    }
+
+    bool HasGhosts() const
+    {
+        return flags != NULL;
+    }
+    bool IsGhost(int cell) const
+    {
+        return flags && flags[cell];
+    }
+    /// One byte per cell, nonzero for ghosts, or NULL if there are none.
+    const byte *GetFlags() const
+    {
+        return flags;
+    }
+    /// The flags as an array, for use in operations, or NULL.
+    eavlByteArray *GetArray() const
+    {
+        return array;
+    }
+
+  private:
+    eavlGhostCells(const eavlGhostCells&);
+    void operator=(const eavlGhostCells&);
+};
+
+#endif
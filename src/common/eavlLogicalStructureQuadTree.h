@@ -1,253 +1,295 @@
-// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
-#ifndef EAVL_LOGICAL_STRUCTURE_QUADTREE_H
-#define EAVL_LOGICAL_STRUCTURE_QUADTREE_H
-
-#include "eavlException.h"
-
-class eavlLogicalStructureQuadTree : public eavlLogicalStructure
-{
-  public:
-    class QuadTreeCell
-    {
-      public:
-        int lvl, x, y;
-        float xmin, xmax, ymin, ymax;
-        std::vector<QuadTreeCell> children;
-#define K 3
-        float coeffs[K][K];
-        void Print(std::ostream&,int=0);
-        bool  HasValue(float x, float y);
-        float GetValue(float x, float y);
-        int GetNumCells(bool leafOnly);
-        QuadTreeCell *GetNthCell(int i);
-    };
-    QuadTreeCell root;
-    vector<QuadTreeCell*> celllist;
-    void BuildLeafCellList()
-    {
-        int n = root.GetNumCells(true);
-        for (int i=0; i<n; i++)
-        {
-            QuadTreeCell *cell = root.GetNthCell(i);
-            celllist.push_back(cell);
-        }
-    }
-
-    eavlLogicalStructureQuadTree() : eavlLogicalStructure(1) { }
-    virtual void PrintSummary(ostream &out)
-    {
-        out << "   eavlLogicalStructureQuadTree:"<<endl;
-        out << "     total number of cells = "<<root.GetNumCells(true)<<endl;
-    }
-};
-
-///\todo: This isn't a clean inheritance from eavlCoordinates;
-///       the base class functionality is totally ignored and changed.
-class eavlCoordinatesQuadTree : public eavlCoordinates
-{
-    ///\todo: a specific example: do we need the logical structure
-    /// passed into eavlCoordinates constructure?  NULL is a 
-    /// horrible idea here; need to change that, too.
-  public:
-    eavlCoordinatesQuadTree() : eavlCoordinates(2, NULL)
-    {
-        SetAxis(0, new eavlCoordinateAxisRegular(0, 0.0, 1.0));
-        SetAxis(1, new eavlCoordinateAxisRegular(1, 0.0, 1.0));
-    }
-    virtual double GetCartesianPoint(int i, int c,
-                                     eavlLogicalStructure *log,
-                                     vector<eavlField*>&fd)
-    {
-        eavlLogicalStructureQuadTree *l = dynamic_cast<eavlLogicalStructureQuadTree*>(log);
-        if (!l)
-            THROW(eavlException,"Expected eavlLogicalStructureQuadTree in GetPoint");
-        if (l->celllist.size() == 0)
-            THROW(eavlException,"Haven't yet built leaf cell list for logical structure");
-        if ((i/4) >= (int)l->celllist.size())
-            THROW(eavlException,"Asked for more cells than we have in quad tree");
-        //cerr << "Asking for point "<<i<<" cell "<<(i/4)<<":\n";
-        eavlLogicalStructureQuadTree::QuadTreeCell *cell = l->celllist[i/4];
-        int which = i%4;
-        if (c == 0) // x
-        {
-            if (which==0 || which==2)
-                return cell->xmin;
-            else
-                return cell->xmax;
-        }
-        else if (c == 1) // y
-        {
-            if (which==0 || which==1)
-                return cell->ymin;
-            else
-                return cell->ymax;
-        }
-        else
-        {
-            ///\todo: throw: why is someone asking for this?
-            return 0;
-        }
-    }
-    virtual int GetDimension() { return 2; }
-    virtual void PrintSummary(ostream &out)
-    {
-        out << "    eavlCoordinatesQuadTree"<<endl;
-    }
-};
-
-/*
-// note: this is the code for the case where we're using internal tree nodes, too
-eavlLogicalStructureQuadTree::QuadTreeCell*
-eavlLogicalStructureQuadTree::QuadTreeCell::GetNthCell(int i)
-{
-    if (i == 0)
-        return this;
-    i -= 1; // not this node
-    for (int j=0; j<children.size(); j++)
-    {
-        int n = children[j].GetNumCells(false);
-        if (i < n)
-            return children[j].GetNthCell(i);
-        i -= n;
-    }
-
-    THROW(eavlException,"not enough cells in the mesh!");
-}
-*/
-
-eavlLogicalStructureQuadTree::QuadTreeCell*
-eavlLogicalStructureQuadTree::QuadTreeCell::GetNthCell(int i)
-{
-    //cerr << "  i="<<i<<endl;
-    for (size_t j=0; j<children.size(); j++)
-    {
-        int n = children[j].GetNumCells(true);
-        //cerr << "    child #"<<j<<" has "<<n<<" cells\n";
-        if (i < n)
-        {
-            //cerr << "      -- descending\n";
-            return children[j].GetNthCell(i);
-        }
-        i -= n;
-    }
-    if (i == 0)
-    {
-        //cerr << "      -- found it\n";
-        return this;
-    }
-    
-    THROW(eavlException,"not enough cells in the mesh!");
-}
-
-void
-eavlLogicalStructureQuadTree::QuadTreeCell::Print(std::ostream &out,int lvl)
-{
-    out << string(lvl*3,' ');
-    out << "("<<lvl<<",["<<x<<","<<y<<"])  "
-        <<"    extents="<<xmin<<","<<xmax<<","<<ymin<<","<<ymax<<"\n";
-    if (children.size() > 0)
-    {
-        for (size_t i=0; i<children.size(); i++)
-            children[i].Print(out,lvl+1);
-    }
-    else
-    {
-        for (int i=0; i<3; i++)
-        {
-            out << string(lvl*3,' ');
-            out << " coeffs["<<i<<",*] = ";
-            for (int j=0; j<3; j++)
-            {
-                out << coeffs[i][j]<<" ";
-            }
-            out << endl;
-        }
-    }
-}
-
-bool
-eavlLogicalStructureQuadTree::QuadTreeCell::HasValue(float x, float y)
-{
-    bool val = (x>=xmin &&
-                x<=xmax &&
-                y>=ymin &&
-                y<=ymax);
-    //cerr << "hasvalue, level="<<lvl<<"  extents="<<xmin<<","<<xmax<<","<<ymin<<","<<ymax<<"\n";
-    return val;
-}
- 
-float Legendre(int i, float x)
-{
-    float scale = sqrt(2 * i + 1);
-    switch (i)
-    {
-      case 0:    return scale * 1;
-      case 1:    return scale * x;
-      case 2:    return scale * (3. * x*x -1) / 2.;
-    }
-    return -99999999;
-}
-
-int
-eavlLogicalStructureQuadTree::QuadTreeCell::GetNumCells(bool leafOnly)
-{
-    int subTree = 0;
-    for (size_t i=0; i<children.size(); i++)
-        subTree += children[i].GetNumCells(leafOnly);
-    if (!leafOnly || children.size() == 0)
-        subTree++;
-    return subTree;
-}
-
-float
-eavlLogicalStructureQuadTree::QuadTreeCell::GetValue(float X, float Y)
-{
-    if (children.size() > 0)
-    {
-        for (size_t i=0; i<children.size(); i++)
-        {
-            if (children[i].HasValue(X,Y))
-                return children[i].GetValue(X,Y);
-        }
-        //cerr << "eh?\n";
-    }
-    //cerr << "Evaluating at level="<<lvl<<"  x,y="<<x<<","<<y<<"\n";
-    //Print(cerr);
-    // no children had it, so it's gotta be us
-    float xx = -1 + 2. * (X - xmin) / (xmax - xmin);
-    float yy = -1 + 2. * (Y - ymin) / (ymax - ymin);
-    float scale = sqrt(1 << (lvl-1));
-    float sum = 0;
-    /*float x0 = Legendre(0, xx);
-    float x1 = Legendre(1, xx);
-    float x2 = Legendre(2, xx);
-    float y0 = Legendre(0, yy);
-    float y1 = Legendre(1, yy);
-    float y2 = Legendre(2, yy);*/
-
-    /*
-    cerr << "scale="<<scale<<endl;
-    for (int i=0; i<3; i++)
-        cerr << "Legendre("<<i<<", x="<<xx<<") = "<<Legendre(i,xx)<<endl;
-    for (int j=0; j<3; j++)
-        cerr << "Legendre("<<j<<", y="<<yy<<") = "<<Legendre(j,yy)<<endl;
-
-    for (int i=0; i<3; i++)
-        cerr << "scaled Legendre("<<i<<", x="<<xx<<") = "<<Legendre(i,xx)*scale<<endl;
-    for (int j=0; j<3; j++)
-        cerr << "scaled Legendre("<<j<<", y="<<yy<<") = "<<Legendre(j,yy)*scale<<endl;
-    */
-
-    for (int i=0; i<3; i++)
-    {
-        for (int j=0; j<3; j++)
-        {
-            float v = coeffs[i][j] * Legendre(i, xx) * Legendre(j, yy) *scale*scale;
-            //cerr << "i="<<i<<" j="<<j<<" val="<<v<<endl;
-            sum += v;
-        }
-    }
-    return sum;
-}
-
-#endif
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_LOGICAL_STRUCTURE_QUADTREE_H
+#define EAVL_LOGICAL_STRUCTURE_QUADTREE_H
+
+#include "eavlConfig.h"
+#include "eavlException.h"
+
+// ****************************************************************************
+// Class:  eavlLogicalStructureQuadTree
+//
+// Purpose:
+///   A quadtree of cells carrying K x K Legendre coefficients (e.g. from
+///   MADNESS).  The tree is parsed into QuadTreeCells and then flattened
+///   by BuildFlatTree into level-ordered arrays: the four children of a
+///   node are contiguous, per-node bounds and coefficients are packed,
+///   and each node knows the first leaf (in depth-first order) of its
+///   subtree.  Leaf lookup is then a single array index, and per-leaf
+///   work can run in parallel.  The pointer tree is released once it
+///   has been flattened.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    January 31, 2012
+//
+// Modifications:
+//   agent, Sun Oct 18 2026
+//   Store the tree as flat level-ordered arrays with precomputed leaf
+//   offsets instead of recursively counting leaves on every lookup.
+//
+// ****************************************************************************
+class eavlLogicalStructureQuadTree : public eavlLogicalStructure
+{
+  public:
+    class QuadTreeCell
+    {
+      public:
+        int lvl, x, y;
+        float xmin, xmax, ymin, ymax;
+        std::vector<QuadTreeCell> children;
+#define K 3
+        float coeffs[K][K];
+        void Print(std::ostream&,int=0);
+    };
+    QuadTreeCell root;
+
+    // flattened, level-ordered tree
+    vector<int>   levelStart;  ///< first node of each level (plus end)
+    vector<int>   nodeLevel;
+    vector<int>   firstChild;  ///< four contiguous children, or -1 for a leaf
+    vector<int>   leafStart;   ///< leaves before this node's subtree
+    vector<int>   leafCount;   ///< leaves in this node's subtree
+    vector<float> bounds;      ///< xmin,xmax,ymin,ymax per node
+    vector<float> coeffs;      ///< K*K per node
+    vector<int>   leafNode;    ///< node index of each leaf
+
+    void BuildFlatTree();
+
+    int GetNumLeaves() const
+    {
+        return leafNode.size();
+    }
+    int GetLeafNode(int leaf) const
+    {
+        return leafNode[leaf];
+    }
+    const float *GetBounds(int node) const
+    {
+        return &bounds[node*4];
+    }
+    float GetValue(int node, float X, float Y) const;
+
+    eavlLogicalStructureQuadTree() : eavlLogicalStructure(1) { }
+    virtual void PrintSummary(ostream &out)
+    {
+        out << "   eavlLogicalStructureQuadTree:"<<endl;
+        out << "     total number of cells = "<<GetNumLeaves()<<endl;
+    }
+};
+
+///\todo: This isn't a clean inheritance from eavlCoordinates;
+///       the base class functionality is totally ignored and changed.
+class eavlCoordinatesQuadTree : public eavlCoordinates
+{
+    ///\todo: a specific example: do we need the logical structure
+    /// passed into eavlCoordinates constructure?  NULL is a 
+    /// horrible idea here; need to change that, too.
+  public:
+    eavlCoordinatesQuadTree() : eavlCoordinates(2, NULL)
+    {
+        SetAxis(0, new eavlCoordinateAxisRegular(0, 0.0, 1.0));
+        SetAxis(1, new eavlCoordinateAxisRegular(1, 0.0, 1.0));
+    }
+    virtual double GetCartesianPoint(int i, int c,
+                                     eavlLogicalStructure *log,
+                                     vector<eavlField*>&fd)
+    {
+        eavlLogicalStructureQuadTree *l = dynamic_cast<eavlLogicalStructureQuadTree*>(log);
+        if (!l)
+            THROW(eavlException,"Expected eavlLogicalStructureQuadTree in GetPoint");
+        if (l->GetNumLeaves() == 0)
+            THROW(eavlException,"Haven't yet built flat tree for logical structure");
+        if ((i/4) >= l->GetNumLeaves())
+            THROW(eavlException,"Asked for more cells than we have in quad tree");
+        //cerr << "Asking for point "<<i<<" cell "<<(i/4)<<":\n";
+        const float *b = l->GetBounds(l->GetLeafNode(i/4));
+        int which = i%4;
+        if (c == 0) // x
+        {
+            if (which==0 || which==2)
+                return b[0];
+            else
+                return b[1];
+        }
+        else if (c == 1) // y
+        {
+            if (which==0 || which==1)
+                return b[2];
+            else
+                return b[3];
+        }
+        else
+        {
+            ///\todo: throw: why is someone asking for this?
+            return 0;
+        }
+    }
+    virtual int GetDimension() { return 2; }
+    virtual void PrintSummary(ostream &out)
+    {
+        out << "    eavlCoordinatesQuadTree"<<endl;
+    }
+};
+
+void
+eavlLogicalStructureQuadTree::QuadTreeCell::Print(std::ostream &out,int lvl)
+{
+    out << string(lvl*3,' ');
+    out << "("<<lvl<<",["<<x<<","<<y<<"])  "
+        <<"    extents="<<xmin<<","<<xmax<<","<<ymin<<","<<ymax<<"\n";
+    if (children.size() > 0)
+    {
+        for (size_t i=0; i<children.size(); i++)
+            children[i].Print(out,lvl+1);
+    }
+    else
+    {
+        for (int i=0; i<3; i++)
+        {
+            out << string(lvl*3,' ');
+            out << " coeffs["<<i<<",*] = ";
+            for (int j=0; j<3; j++)
+            {
+                out << coeffs[i][j]<<" ";
+            }
+            out << endl;
+        }
+    }
+}
+
+float Legendre(int i, float x)
+{
+    float scale = sqrt(2 * i + 1);
+    switch (i)
+    {
+      case 0:    return scale * 1;
+      case 1:    return scale * x;
+      case 2:    return scale * (3. * x*x -1) / 2.;
+    }
+    return -99999999;
+}
+
+void
+eavlLogicalStructureQuadTree::BuildFlatTree()
+{
+    // breadth-first walk; each node's children are appended together,
+    // so they land contiguously, and each level is contiguous
+    vector<QuadTreeCell*> nodes;
+    nodes.push_back(&root);
+    levelStart.clear();
+    levelStart.push_back(0);
+    size_t levelEnd = 1;
+    firstChild.clear();
+    for (size_t n=0; n<nodes.size(); n++)
+    {
+        if (n == levelEnd)
+        {
+            levelStart.push_back(n);
+            levelEnd = nodes.size();
+        }
+        QuadTreeCell *cell = nodes[n];
+        if (cell->children.size() == 0)
+        {
+            firstChild.push_back(-1);
+        }
+        else if (cell->children.size() == 4)
+        {
+            firstChild.push_back(nodes.size());
+            for (int c=0; c<4; c++)
+                nodes.push_back(&(cell->children[c]));
+        }
+        else
+        {
+            THROW(eavlException,"Quadtree nodes must have zero or four children");
+        }
+    }
+    levelStart.push_back(nodes.size());
+
+    int nnodes = nodes.size();
+    nodeLevel.resize(nnodes);
+    bounds.resize(nnodes*4);
+    coeffs.resize(nnodes*K*K);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int n=0; n<nnodes; n++)
+    {
+        QuadTreeCell *cell = nodes[n];
+        nodeLevel[n] = cell->lvl;
+        bounds[n*4+0] = cell->xmin;
+        bounds[n*4+1] = cell->xmax;
+        bounds[n*4+2] = cell->ymin;
+        bounds[n*4+3] = cell->ymax;
+        for (int i=0; i<K; i++)
+            for (int j=0; j<K; j++)
+                coeffs[n*K*K + i*K + j] = cell->coeffs[i][j];
+    }
+
+    // children always come after their parent, so leaf counts can be
+    // accumulated bottom-up and leaf offsets handed out top-down
+    leafCount.resize(nnodes);
+    for (int n=nnodes-1; n>=0; n--)
+    {
+        if (firstChild[n] < 0)
+            leafCount[n] = 1;
+        else
+            leafCount[n] = leafCount[firstChild[n]+0] +
+                           leafCount[firstChild[n]+1] +
+                           leafCount[firstChild[n]+2] +
+                           leafCount[firstChild[n]+3];
+    }
+    leafStart.resize(nnodes);
+    leafStart[0] = 0;
+    leafNode.resize(leafCount[0]);
+    for (int n=0; n<nnodes; n++)
+    {
+        if (firstChild[n] < 0)
+        {
+            leafNode[leafStart[n]] = n;
+            continue;
+        }
+        int offset = leafStart[n];
+        for (int c=0; c<4; c++)
+        {
+            leafStart[firstChild[n]+c] = offset;
+            offset += leafCount[firstChild[n]+c];
+        }
+    }
+
+    // the flat arrays are all we need from here on
+    vector<QuadTreeCell>().swap(root.children);
+}
+
+float
+eavlLogicalStructureQuadTree::GetValue(int node, float X, float Y) const
+{
+    // descend to the finest node containing the point
+    while (firstChild[node] >= 0)
+    {
+        int next = -1;
+        for (int c=0; c<4 && next<0; c++)
+        {
+            const float *b = GetBounds(firstChild[node]+c);
+            if (X>=b[0] && X<=b[1] && Y>=b[2] && Y<=b[3])
+                next = firstChild[node]+c;
+        }
+        if (next < 0)
+            break;
+        node = next;
+    }
+
+    const float *b = GetBounds(node);
+    const float *cf = &coeffs[node*K*K];
+    float xx = -1 + 2. * (X - b[0]) / (b[1] - b[0]);
+    float yy = -1 + 2. * (Y - b[2]) / (b[3] - b[2]);
+    float scale = sqrt(1 << (nodeLevel[node]-1));
+    float sum = 0;
+    for (int i=0; i<K; i++)
+    {
+        for (int j=0; j<K; j++)
+        {
+            sum += cf[i*K+j] * Legendre(i, xx) * Legendre(j, yy) *scale*scale;
+        }
+    }
+    return sum;
+}
+#endif
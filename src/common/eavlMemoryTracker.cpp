@@ -0,0 +1,283 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlMemoryTracker.h"
+#include "eavlConfig.h"
+#include "eavlException.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+long long eavlMemoryTracker::current[eavlMemoryTracker::NUM_CATEGORIES] = {0};
+long long eavlMemoryTracker::peak[eavlMemoryTracker::NUM_CATEGORIES] = {0};
+long long eavlMemoryTracker::totalCurrent = 0;
+long long eavlMemoryTracker::totalPeak = 0;
+long long eavlMemoryTracker::budget = 0;
+bool      eavlMemoryTracker::budgetInitialized = false;
+eavlMemoryTracker::Category eavlMemoryTracker::arrayCategory = eavlMemoryTracker::ARRAY;
+
+// ****************************************************************************
+//  Method:  eavlMemoryTracker::InitializeBudget
+//
+//  Purpose:
+///   Pick up a soft budget (in megabytes) from the EAVL_MEMORY_BUDGET
+///   environment variable the first time we need it.
+//
+//  Programmer:  agent
+//  Creation:    October 18, 2026
+//
+// ****************************************************************************
+void
+eavlMemoryTracker::InitializeBudget()
+{
+    if (budgetInitialized)
+        return;
+    budgetInitialized = true;
+    const char *env = getenv("EAVL_MEMORY_BUDGET");
+    if (env)
+        budget = (long long)(atof(env) * 1024. * 1024.);
+}
+
+// ****************************************************************************
+//  Method:  eavlMemoryTracker::Allocate
+//
+//  Purpose:
+///   Record that a container is about to hold this many more bytes.
+///   Throws, without recording anything, if that would exceed the
+///   soft budget.
+//
+//  Programmer:  agent
+//  Creation:    October 18, 2026
+//
+// ****************************************************************************
+void
+eavlMemoryTracker::Allocate(Category c, long long bytes)
+{
+    if (bytes <= 0)
+        return;
+    InitializeBudget();
+
+    bool overBudget = false;
+    long long attempted = 0;
+#ifdef HAVE_OPENMP
+#pragma omp critical(eavlMemoryTracker)
+#endif
+    {
+        if (budget > 0 && totalCurrent + bytes > budget)
+        {
+            overBudget = true;
+            attempted = totalCurrent + bytes;
+        }
+        else
+        {
+            current[c] += bytes;
+            totalCurrent += bytes;
+            if (current[c] > peak[c])
+                peak[c] = current[c];
+            if (totalCurrent > totalPeak)
+                totalPeak = totalCurrent;
+        }
+    }
+
+    if (overBudget)
+    {
+        char msg[1024];
+        sprintf(msg, "Allocating %lld %s bytes would bring usage to %lld, "
+                "over the memory budget of %lld bytes",
+                bytes, GetCategoryName(c), attempted, budget);
+        THROW(eavlException, msg);
+    }
+}
+
+// ****************************************************************************
+//  Method:  eavlMemoryTracker::Free
+//
+//  Purpose:
+///   Record that a container has released this many bytes.
+//
+//  Programmer:  agent
+//  Creation:    October 18, 2026
+//
+// ****************************************************************************
+void
+eavlMemoryTracker::Free(Category c, long long bytes)
+{
+    if (bytes <= 0)
+        return;
+#ifdef HAVE_OPENMP
+#pragma omp critical(eavlMemoryTracker)
+#endif
+    {
+        current[c] -= bytes;
+        totalCurrent -= bytes;
+    }
+}
+
+// ****************************************************************************
+//  Method:  eavlMemoryTracker::Change
+//
+//  Purpose:
+///   Convenience for a container whose allocation went from oldbytes
+///   to newbytes.  Growth is checked against the budget.
+//
+//  Programmer:  agent
+//  Creation:    October 18, 2026
+//
+// ****************************************************************************
+void
+eavlMemoryTracker::Change(Category c, long long oldbytes, long long newbytes)
+{
+    if (newbytes > oldbytes)
+        Allocate(c, newbytes - oldbytes);
+    else
+        Free(c, oldbytes - newbytes);
+}
+
+// ****************************************************************************
+//  Method:  eavlMemoryTracker::CheckBudget
+//
+//  Purpose:
+///   Let a filter check up front whether it can afford an expected
+///   amount of output before doing any work, and fail with a
+///   description of what it was trying to do if not.
+//
+//  Programmer:  agent
+//  Creation:    October 18, 2026
+//
+// ****************************************************************************
+void
+eavlMemoryTracker::CheckBudget(long long bytes, const std::string &descr)
+{
+    InitializeBudget();
+    if (budget > 0 && totalCurrent + bytes > budget)
+    {
+        char msg[1024];
+        sprintf(msg, "%s needs %lld bytes but only %lld of the %lld "
+                "byte memory budget remain",
+                descr.c_str(), bytes, budget - totalCurrent, budget);
+        THROW(eavlException, msg);
+    }
+}
+
+long long
+eavlMemoryTracker::GetCurrent(Category c)
+{
+    return current[c];
+}
+
+long long
+eavlMemoryTracker::GetPeak(Category c)
+{
+    return peak[c];
+}
+
+long long
+eavlMemoryTracker::GetTotalCurrent()
+{
+    return totalCurrent;
+}
+
+long long
+eavlMemoryTracker::GetTotalPeak()
+{
+    return totalPeak;
+}
+
+// ****************************************************************************
+//  Method:  eavlMemoryTracker::ResetPeaks
+//
+//  Purpose:
+///   Set the high-water marks back to the current usage, e.g. to
+///   measure the peak of a single pipeline stage.
+//
+//  Programmer:  agent
+//  Creation:    October 18, 2026
+//
+// ****************************************************************************
+void
+eavlMemoryTracker::ResetPeaks()
+{
+#ifdef HAVE_OPENMP
+#pragma omp critical(eavlMemoryTracker)
+#endif
+    {
+        for (int i=0; i<NUM_CATEGORIES; i++)
+            peak[i] = current[i];
+        totalPeak = totalCurrent;
+    }
+}
+
+void
+eavlMemoryTracker::SetSoftBudget(long long bytes)
+{
+    budgetInitialized = true;
+    budget = bytes;
+}
+
+long long
+eavlMemoryTracker::GetSoftBudget()
+{
+    InitializeBudget();
+    return budget;
+}
+
+eavlMemoryTracker::Category
+eavlMemoryTracker::GetArrayCategory()
+{
+    return arrayCategory;
+}
+
+void
+eavlMemoryTracker::SetArrayCategory(Category c)
+{
+    arrayCategory = c;
+}
+
+const char *
+eavlMemoryTracker::GetCategoryName(Category c)
+{
+    switch (c)
+    {
+      case ARRAY:        return "array";
+      case CONNECTIVITY: return "connectivity";
+      case TEMPORARY:    return "temporary";
+      case RENDER:       return "render";
+      default:           break;
+    }
+    return "unknown";
+}
+
+// ****************************************************************************
+//  Method:  eavlMemoryTracker::Dump
+//
+//  Purpose:
+///   Print current and peak usage per category, in the same spirit
+///   as eavlTimer::Dump.
+//
+//  Arguments:
+//    out        the stream to print to.
+//
+//  Programmer:  agent
+//  Creation:    October 18, 2026
+//
+// ****************************************************************************
+void
+eavlMemoryTracker::Dump(std::ostream &out)
+{
+    InitializeBudget();
+    out << "\nMemory (MB)\n-----------\n";
+    char line[1024];
+    sprintf(line, "%-14s %12s %12s", "category", "current", "peak");
+    out << line << std::endl;
+    for (int i=0; i<NUM_CATEGORIES; i++)
+    {
+        sprintf(line, "%-14s %12.3f %12.3f", GetCategoryName(Category(i)),
+                current[i] / (1024.*1024.), peak[i] / (1024.*1024.));
+        out << line << std::endl;
+    }
+    sprintf(line, "%-14s %12.3f %12.3f", "total",
+            totalCurrent / (1024.*1024.), totalPeak / (1024.*1024.));
+    out << line << std::endl;
+    if (budget > 0)
+    {
+        sprintf(line, "%-14s %12.3f", "budget", budget / (1024.*1024.));
+        out << line << std::endl;
+    }
+}
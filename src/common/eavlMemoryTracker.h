@@ -0,0 +1,92 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_MEMORY_TRACKER_H
+#define EAVL_MEMORY_TRACKER_H
+
+#include <string>
+#include <iostream>
+
+// ****************************************************************************
+//  Class:  eavlMemoryTracker
+//
+//  Purpose:
+///   Process-wide accounting of the host memory held by EAVL containers.
+///   The containers themselves (eavlConcreteArray, eavlFlatArray, render
+///   surfaces) report each change in their allocated capacity, and the
+///   bytes are attributed to a category.  Current and peak usage are
+///   kept per category and in total.
+///
+///   An optional soft budget (SetSoftBudget, or the EAVL_MEMORY_BUDGET
+///   environment variable in megabytes) makes any allocation that
+///   would exceed it throw an eavlException before the memory is
+///   requested, so a filter fails fast rather than driving the machine
+///   into swap.
+///
+///   Arrays take their category from the current default array
+///   category, which a filter can switch to TEMPORARY for its scratch
+///   arrays with a ScopedArrayCategory.
+//
+//  Programmer:  agent
+//  Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlMemoryTracker
+{
+  public:
+    enum Category
+    {
+        ARRAY,
+        CONNECTIVITY,
+        TEMPORARY,
+        RENDER,
+        NUM_CATEGORIES
+    };
+
+    static void        Allocate(Category c, long long bytes);
+    static void        Free(Category c, long long bytes);
+    static void        Change(Category c, long long oldbytes, long long newbytes);
+    static void        CheckBudget(long long bytes, const std::string &descr);
+
+    static long long   GetCurrent(Category c);
+    static long long   GetPeak(Category c);
+    static long long   GetTotalCurrent();
+    static long long   GetTotalPeak();
+    static void        ResetPeaks();
+
+    static void        SetSoftBudget(long long bytes);
+    static long long   GetSoftBudget();
+
+    static Category    GetArrayCategory();
+    static void        SetArrayCategory(Category c);
+
+    static const char *GetCategoryName(Category c);
+    static void        Dump(std::ostream&);
+
+    class ScopedArrayCategory
+    {
+      protected:
+        Category saved;
+      public:
+        ScopedArrayCategory(Category c)
+        {
+            saved = GetArrayCategory();
+            SetArrayCategory(c);
+        }
+        ~ScopedArrayCategory()
+        {
+            SetArrayCategory(saved);
+        }
+    };
+
+  private:
+    static long long current[NUM_CATEGORIES];
+    static long long peak[NUM_CATEGORIES];
+    static long long totalCurrent;
+    static long long totalPeak;
+    static long long budget;
+    static bool      budgetInitialized;
+    static Category  arrayCategory;
+
+    static void      InitializeBudget();
+};
+
+#endif
@@ -0,0 +1,176 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_NODE_POSITIONS_H
+#define EAVL_NODE_POSITIONS_H
+
+#include "STL.h"
+#include "eavlDataSet.h"
+#include "eavlCoordinates.h"
+#include "eavlLogicalStructureRegular.h"
+
+// ****************************************************************************
+// Class:  eavlNodePositions
+//
+// Purpose:
+///   Cartesian positions of the points of a data set, for filters which
+///   look them up from inside (possibly parallel) cell loops.
+///
+///   For plain Cartesian coordinates whose axes are regular, stored per
+///   logical dimension (rectilinear), or stored per point, each position
+///   component is read straight from a float array (regular axes and
+///   non-float arrays are converted once up front).  Anything else goes
+///   through eavlDataSet::GetPoint, whose field lookups are warmed up
+///   here so that later calls are safe to make in parallel.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlNodePositions
+{
+  protected:
+    eavlDataSet   *ds;
+    bool           direct;
+    const float   *ptr[3];
+    int            stride[3];
+    int            div[3];
+    int            mod[3];
+    vector<float>  copy[3];
+    vector<eavlField*> coordFields;
+
+  public:
+    eavlNodePositions(eavlDataSet *data) : ds(data), direct(false)
+    {
+        for (int c=0; c<3; c++)
+        {
+            ptr[c] = NULL;
+            stride[c] = 0;
+            div[c] = 1;
+            mod[c] = 1;
+        }
+
+        eavlCoordinates *cs = ds->GetCoordinateSystem(0);
+        eavlCoordinatesCartesian *cart =
+            dynamic_cast<eavlCoordinatesCartesian*>(cs);
+        for (int a=0; a<cs->GetDimension(); a++)
+        {
+            eavlCoordinateAxisField *fa =
+                dynamic_cast<eavlCoordinateAxisField*>(cs->GetAxis(a));
+            if (fa)
+                coordFields.push_back(ds->GetField(fa->GetFieldName()));
+        }
+
+        direct = (cart &&
+                  !dynamic_cast<eavlCoordinatesCartesianWithTransform*>(cs));
+        for (int a=0; direct && a<cs->GetDimension(); a++)
+            direct = SetUpAxis(cs->GetAxis(a), cart->GetAxisType(a));
+
+        if (!direct && ds->GetNumPoints() > 0)
+        {
+            for (int c=0; c<3; c++)
+                ds->GetPoint(0, c);
+        }
+    }
+
+    /// The fields the coordinates are stored in, which filters usually
+    /// replace rather than carry along to their output.
+    bool IsCoordinateField(eavlField *f) const
+    {
+        for (size_t i=0; i<coordFields.size(); i++)
+        {
+            if (coordFields[i] == f)
+                return true;
+        }
+        return false;
+    }
+
+    void Get(int node, float &x, float &y, float &z) const
+    {
+        if (direct)
+        {
+            x = ptr[0] ? ptr[0][((node/div[0])%mod[0])*stride[0]] : 0.f;
+            y = ptr[1] ? ptr[1][((node/div[1])%mod[1])*stride[1]] : 0.f;
+            z = ptr[2] ? ptr[2][((node/div[2])%mod[2])*stride[2]] : 0.f;
+        }
+        else
+        {
+            x = ds->GetPoint(node, 0);
+            y = ds->GetPoint(node, 1);
+            z = ds->GetPoint(node, 2);
+        }
+    }
+
+  protected:
+    bool GetLogicalDivMod(int d, int &dv, int &md)
+    {
+        eavlLogicalStructureRegular *log =
+            dynamic_cast<eavlLogicalStructureRegular*>(ds->GetLogicalStructure());
+        if (!log)
+            return false;
+        eavlRegularStructure &reg = log->GetRegularStructure();
+        if (d < 0 || d >= reg.dimension)
+            return false;
+        dv = reg.CalculateNodeIndexDivForDimension(d);
+        md = reg.CalculateNodeIndexModForDimension(d);
+        return true;
+    }
+
+    bool SetUpAxis(eavlCoordinateAxis *axis, int c)
+    {
+        eavlCoordinateAxisRegular *ra =
+            dynamic_cast<eavlCoordinateAxisRegular*>(axis);
+        if (ra)
+        {
+            if (!GetLogicalDivMod(ra->GetLogicalDim(), div[c], mod[c]))
+                return false;
+            copy[c].resize(mod[c]);
+            for (int i=0; i<mod[c]; i++)
+                copy[c][i] = ra->GetOrigin() + i*ra->GetDelta();
+            ptr[c] = &copy[c][0];
+            stride[c] = 1;
+            return true;
+        }
+
+        eavlCoordinateAxisField *fa =
+            dynamic_cast<eavlCoordinateAxisField*>(axis);
+        if (!fa)
+            return false;
+        eavlField *f = ds->GetField(fa->GetFieldName());
+        if (f->GetAssociation() == eavlField::ASSOC_POINTS)
+        {
+            div[c] = 1;
+            mod[c] = ds->GetNumPoints();
+        }
+        else if (f->GetAssociation() == eavlField::ASSOC_LOGICALDIM)
+        {
+            if (!GetLogicalDivMod(f->GetAssocLogicalDim(), div[c], mod[c]))
+                return false;
+        }
+        else
+        {
+            return false;
+        }
+        if (mod[c] < 1)
+            return false;
+
+        eavlArray *arr = f->GetArray();
+        eavlFloatArray *farr = dynamic_cast<eavlFloatArray*>(arr);
+        if (farr)
+        {
+            stride[c] = farr->GetNumberOfComponents();
+            ptr[c] = (const float*)farr->GetHostArray() + fa->GetComponent();
+            return true;
+        }
+        copy[c].resize(mod[c]);
+        for (int i=0; i<mod[c]; i++)
+            copy[c][i] = arr->GetComponentAsDouble(i, fa->GetComponent());
+        ptr[c] = &copy[c][0];
+        stride[c] = 1;
+        return true;
+    }
+
+  private:
+    eavlNodePositions(const eavlNodePositions&);
+    void operator=(const eavlNodePositions&);
+};
+
+#endif
@@ -143,6 +143,108 @@ struct eavlMinFunctor
     T identity();
 };
 
+template<class T>
+struct eavlPowFunctor
+{
+    EAVL_FUNCTOR T operator()(T a, T b) { return pow(a, b); }
+};
+
+template<class T>
+struct eavlAtan2Functor
+{
+    EAVL_FUNCTOR T operator()(T a, T b) { return atan2(a, b); }
+};
+
+template<class T>
+struct eavlNegateFunctor
+{
+    EAVL_FUNCTOR T operator()(T a) { return -a; }
+};
+
+template<class T>
+struct eavlSquareFunctor
+{
+    EAVL_FUNCTOR T operator()(T a) { return a * a; }
+};
+
+template<class T>
+struct eavlCubeFunctor
+{
+    EAVL_FUNCTOR T operator()(T a) { return a * a * a; }
+};
+
+template<class T>
+struct eavlSqrtFunctor
+{
+    EAVL_FUNCTOR T operator()(T a) { return sqrt(a); }
+};
+
+template<class T>
+struct eavlAbsFunctor
+{
+    EAVL_FUNCTOR T operator()(T a) { return (a < 0) ? -a : a; }
+};
+
+template<class T>
+struct eavlExpFunctor
+{
+    EAVL_FUNCTOR T operator()(T a) { return exp(a); }
+};
+
+template<class T>
+struct eavlLnFunctor
+{
+    EAVL_FUNCTOR T operator()(T a) { return log(a); }
+};
+
+template<class T>
+struct eavlLog10Functor
+{
+    EAVL_FUNCTOR T operator()(T a) { return log10(a); }
+};
+
+template<class T>
+struct eavlLog2Functor
+{
+    EAVL_FUNCTOR T operator()(T a) { return log(a) / log(T(2)); }
+};
+
+template<class T>
+struct eavlSinFunctor
+{
+    EAVL_FUNCTOR T operator()(T a) { return sin(a); }
+};
+
+template<class T>
+struct eavlCosFunctor
+{
+    EAVL_FUNCTOR T operator()(T a) { return cos(a); }
+};
+
+template<class T>
+struct eavlTanFunctor
+{
+    EAVL_FUNCTOR T operator()(T a) { return tan(a); }
+};
+
+template<class T>
+struct eavlAsinFunctor
+{
+    EAVL_FUNCTOR T operator()(T a) { return asin(a); }
+};
+
+template<class T>
+struct eavlAcosFunctor
+{
+    EAVL_FUNCTOR T operator()(T a) { return acos(a); }
+};
+
+template<class T>
+struct eavlAtanFunctor
+{
+    EAVL_FUNCTOR T operator()(T a) { return atan(a); }
+};
+
 template<class T>
 struct eavlLessThanConstFunctor
 {
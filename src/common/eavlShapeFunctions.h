@@ -0,0 +1,450 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_SHAPE_FUNCTIONS_H
+#define EAVL_SHAPE_FUNCTIONS_H
+
+#include "eavl.h"
+#include "eavlCell.h"
+
+// ****************************************************************************
+// Function:  eavlShapeFunctions
+//
+// Purpose:
+///   Evaluate the linear interpolation weights of a cell at the
+///   parametric location (r,s,t).  Node ordering matches the VTK-style
+///   ordering used by the EAVL cell sets (note that pixels and voxels
+///   are ordered by logical index, not counterclockwise).
+///   Returns the number of weights, or 0 for unsupported shapes.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+EAVL_HOSTDEVICE int eavlShapeFunctions(int shapeType,
+                                       double r, double s, double t,
+                                       double w[])
+{
+    switch (shapeType)
+    {
+      case EAVL_BEAM:
+        w[0] = 1-r;
+        w[1] = r;
+        return 2;
+      case EAVL_TRI:
+        w[0] = 1-r-s;
+        w[1] = r;
+        w[2] = s;
+        return 3;
+      case EAVL_QUAD:
+        w[0] = (1-r)*(1-s);
+        w[1] = r    *(1-s);
+        w[2] = r    *s;
+        w[3] = (1-r)*s;
+        return 4;
+      case EAVL_PIXEL:
+        w[0] = (1-r)*(1-s);
+        w[1] = r    *(1-s);
+        w[2] = (1-r)*s;
+        w[3] = r    *s;
+        return 4;
+      case EAVL_TET:
+        w[0] = 1-r-s-t;
+        w[1] = r;
+        w[2] = s;
+        w[3] = t;
+        return 4;
+      case EAVL_PYRAMID:
+        w[0] = (1-r)*(1-s)*(1-t);
+        w[1] = r    *(1-s)*(1-t);
+        w[2] = r    *s    *(1-t);
+        w[3] = (1-r)*s    *(1-t);
+        w[4] = t;
+        return 5;
+      case EAVL_WEDGE:
+        w[0] = (1-r-s)*(1-t);
+        w[1] = r      *(1-t);
+        w[2] = s      *(1-t);
+        w[3] = (1-r-s)*t;
+        w[4] = r      *t;
+        w[5] = s      *t;
+        return 6;
+      case EAVL_HEX:
+        w[0] = (1-r)*(1-s)*(1-t);
+        w[1] = r    *(1-s)*(1-t);
+        w[2] = r    *s    *(1-t);
+        w[3] = (1-r)*s    *(1-t);
+        w[4] = (1-r)*(1-s)*t;
+        w[5] = r    *(1-s)*t;
+        w[6] = r    *s    *t;
+        w[7] = (1-r)*s    *t;
+        return 8;
+      case EAVL_VOXEL:
+        w[0] = (1-r)*(1-s)*(1-t);
+        w[1] = r    *(1-s)*(1-t);
+        w[2] = (1-r)*s    *(1-t);
+        w[3] = r    *s    *(1-t);
+        w[4] = (1-r)*(1-s)*t;
+        w[5] = r    *(1-s)*t;
+        w[6] = (1-r)*s    *t;
+        w[7] = r    *s    *t;
+        return 8;
+    }
+    return 0;
+}
+
+// ****************************************************************************
+// Function:  eavlShapeDerivatives
+//
+// Purpose:
+///   Evaluate the parametric derivatives (d/dr, d/ds, d/dt) of the
+///   interpolation weights from eavlShapeFunctions.
+///   Returns the number of weights, or 0 for unsupported shapes.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+EAVL_HOSTDEVICE int eavlShapeDerivatives(int shapeType,
+                                         double r, double s, double t,
+                                         double dr[], double ds[], double dt[])
+{
+    switch (shapeType)
+    {
+      case EAVL_BEAM:
+        dr[0] = -1;  ds[0] = 0;  dt[0] = 0;
+        dr[1] = +1;  ds[1] = 0;  dt[1] = 0;
+        return 2;
+      case EAVL_TRI:
+        dr[0] = -1;  ds[0] = -1;  dt[0] = 0;
+        dr[1] = +1;  ds[1] =  0;  dt[1] = 0;
+        dr[2] =  0;  ds[2] = +1;  dt[2] = 0;
+        return 3;
+      case EAVL_QUAD:
+        dr[0] = -(1-s);  ds[0] = -(1-r);  dt[0] = 0;
+        dr[1] =  (1-s);  ds[1] = -r;      dt[1] = 0;
+        dr[2] =  s;      ds[2] =  r;      dt[2] = 0;
+        dr[3] = -s;      ds[3] =  (1-r);  dt[3] = 0;
+        return 4;
+      case EAVL_PIXEL:
+        dr[0] = -(1-s);  ds[0] = -(1-r);  dt[0] = 0;
+        dr[1] =  (1-s);  ds[1] = -r;      dt[1] = 0;
+        dr[2] = -s;      ds[2] =  (1-r);  dt[2] = 0;
+        dr[3] =  s;      ds[3] =  r;      dt[3] = 0;
+        return 4;
+      case EAVL_TET:
+        dr[0] = -1;  ds[0] = -1;  dt[0] = -1;
+        dr[1] = +1;  ds[1] =  0;  dt[1] =  0;
+        dr[2] =  0;  ds[2] = +1;  dt[2] =  0;
+        dr[3] =  0;  ds[3] =  0;  dt[3] = +1;
+        return 4;
+      case EAVL_PYRAMID:
+        dr[0] = -(1-s)*(1-t);  ds[0] = -(1-r)*(1-t);  dt[0] = -(1-r)*(1-s);
+        dr[1] =  (1-s)*(1-t);  ds[1] = -r    *(1-t);  dt[1] = -r    *(1-s);
+        dr[2] =  s    *(1-t);  ds[2] =  r    *(1-t);  dt[2] = -r    *s;
+        dr[3] = -s    *(1-t);  ds[3] =  (1-r)*(1-t);  dt[3] = -(1-r)*s;
+        dr[4] =  0;            ds[4] =  0;            dt[4] =  1;
+        return 5;
+      case EAVL_WEDGE:
+        dr[0] = -(1-t);  ds[0] = -(1-t);  dt[0] = -(1-r-s);
+        dr[1] =  (1-t);  ds[1] =  0;      dt[1] = -r;
+        dr[2] =  0;      ds[2] =  (1-t);  dt[2] = -s;
+        dr[3] = -t;      ds[3] = -t;      dt[3] =  (1-r-s);
+        dr[4] =  t;      ds[4] =  0;      dt[4] =  r;
+        dr[5] =  0;      ds[5] =  t;      dt[5] =  s;
+        return 6;
+      case EAVL_HEX:
+        dr[0] = -(1-s)*(1-t); ds[0] = -(1-r)*(1-t); dt[0] = -(1-r)*(1-s);
+        dr[1] =  (1-s)*(1-t); ds[1] = -r    *(1-t); dt[1] = -r    *(1-s);
+        dr[2] =  s    *(1-t); ds[2] =  r    *(1-t); dt[2] = -r    *s;
+        dr[3] = -s    *(1-t); ds[3] =  (1-r)*(1-t); dt[3] = -(1-r)*s;
+        dr[4] = -(1-s)*t;     ds[4] = -(1-r)*t;     dt[4] =  (1-r)*(1-s);
+        dr[5] =  (1-s)*t;     ds[5] = -r    *t;     dt[5] =  r    *(1-s);
+        dr[6] =  s    *t;     ds[6] =  r    *t;     dt[6] =  r    *s;
+        dr[7] = -s    *t;     ds[7] =  (1-r)*t;     dt[7] =  (1-r)*s;
+        return 8;
+      case EAVL_VOXEL:
+        dr[0] = -(1-s)*(1-t); ds[0] = -(1-r)*(1-t); dt[0] = -(1-r)*(1-s);
+        dr[1] =  (1-s)*(1-t); ds[1] = -r    *(1-t); dt[1] = -r    *(1-s);
+        dr[2] = -s    *(1-t); ds[2] =  (1-r)*(1-t); dt[2] = -(1-r)*s;
+        dr[3] =  s    *(1-t); ds[3] =  r    *(1-t); dt[3] = -r    *s;
+        dr[4] = -(1-s)*t;     ds[4] = -(1-r)*t;     dt[4] =  (1-r)*(1-s);
+        dr[5] =  (1-s)*t;     ds[5] = -r    *t;     dt[5] =  r    *(1-s);
+        dr[6] = -s    *t;     ds[6] =  (1-r)*t;     dt[6] =  (1-r)*s;
+        dr[7] =  s    *t;     ds[7] =  r    *t;     dt[7] =  r    *s;
+        return 8;
+    }
+    return 0;
+}
+
+// ****************************************************************************
+// Function:  eavlShapeTopologicalDimension
+//
+// Purpose:
+///   Return the number of parametric dimensions of a cell shape.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+EAVL_HOSTDEVICE int eavlShapeTopologicalDimension(int shapeType)
+{
+    switch (shapeType)
+    {
+      case EAVL_POINT:
+        return 0;
+      case EAVL_BEAM:
+        return 1;
+      case EAVL_TRI:
+      case EAVL_QUAD:
+      case EAVL_PIXEL:
+      case EAVL_TRISTRIP:
+      case EAVL_POLYGON:
+        return 2;
+    }
+    return 3;
+}
+
+// ****************************************************************************
+// Function:  eavlParametricIsInside
+//
+// Purpose:
+///   Check whether a parametric location lies inside the reference cell,
+///   with a tolerance to avoid cracks between neighboring cells.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+EAVL_HOSTDEVICE bool eavlParametricIsInside(int shapeType,
+                                            double r, double s, double t,
+                                            double tol)
+{
+    switch (shapeType)
+    {
+      case EAVL_BEAM:
+        return (r >= -tol && r <= 1+tol);
+      case EAVL_TRI:
+        return (r >= -tol && s >= -tol && r+s <= 1+tol);
+      case EAVL_QUAD:
+      case EAVL_PIXEL:
+        return (r >= -tol && r <= 1+tol &&
+                s >= -tol && s <= 1+tol);
+      case EAVL_TET:
+        return (r >= -tol && s >= -tol && t >= -tol && r+s+t <= 1+tol);
+      case EAVL_WEDGE:
+        return (r >= -tol && s >= -tol && r+s <= 1+tol &&
+                t >= -tol && t <= 1+tol);
+      case EAVL_PYRAMID:
+      case EAVL_HEX:
+      case EAVL_VOXEL:
+        return (r >= -tol && r <= 1+tol &&
+                s >= -tol && s <= 1+tol &&
+                t >= -tol && t <= 1+tol);
+    }
+    return false;
+}
+
+// ****************************************************************************
+// Function:  eavlWorldToParametric
+//
+// Purpose:
+///   Invert the isoparametric mapping of a cell using Newton iteration.
+///   "pts" holds the world coordinates of the cell nodes as xyz triples,
+///   and "dim" is the number of world coordinates considered (2 for planar
+///   cells, 3 for volumetric ones).  Linear shapes converge in a single
+///   step.  Returns false if the iteration did not converge.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+EAVL_HOSTDEVICE bool eavlWorldToParametric(int shapeType, int npts,
+                                           const double *pts,
+                                           const double p[3], int dim,
+                                           double rst[3])
+{
+    double w[12], dr[12], ds[12], dt[12];
+    int tdim = eavlShapeTopologicalDimension(shapeType);
+    if (tdim != dim || npts > 12)
+        return false;
+
+    rst[0] = rst[1] = rst[2] = 0.25;
+    for (int iter = 0; iter < 10; iter++)
+    {
+        eavlShapeFunctions(shapeType, rst[0], rst[1], rst[2], w);
+        eavlShapeDerivatives(shapeType, rst[0], rst[1], rst[2], dr, ds, dt);
+
+        // residual and jacobian
+        double f[3] = {-p[0], -p[1], -p[2]};
+        double J[3][3] = {{0,0,0},{0,0,0},{0,0,0}};
+        for (int n=0; n<npts; n++)
+        {
+            for (int c=0; c<3; c++)
+            {
+                f[c]    += w[n]  * pts[3*n+c];
+                J[c][0] += dr[n] * pts[3*n+c];
+                J[c][1] += ds[n] * pts[3*n+c];
+                J[c][2] += dt[n] * pts[3*n+c];
+            }
+        }
+
+        double d[3] = {0,0,0};
+        if (dim == 3)
+        {
+            double det = J[0][0]*(J[1][1]*J[2][2]-J[1][2]*J[2][1]) -
+                         J[0][1]*(J[1][0]*J[2][2]-J[1][2]*J[2][0]) +
+                         J[0][2]*(J[1][0]*J[2][1]-J[1][1]*J[2][0]);
+            if (det == 0)
+                return false;
+            d[0] = (f[0]*(J[1][1]*J[2][2]-J[1][2]*J[2][1]) -
+                    J[0][1]*(f[1]*J[2][2]-J[1][2]*f[2]) +
+                    J[0][2]*(f[1]*J[2][1]-J[1][1]*f[2])) / det;
+            d[1] = (J[0][0]*(f[1]*J[2][2]-J[1][2]*f[2]) -
+                    f[0]*(J[1][0]*J[2][2]-J[1][2]*J[2][0]) +
+                    J[0][2]*(J[1][0]*f[2]-f[1]*J[2][0])) / det;
+            d[2] = (J[0][0]*(J[1][1]*f[2]-f[1]*J[2][1]) -
+                    J[0][1]*(J[1][0]*f[2]-f[1]*J[2][0]) +
+                    f[0]*(J[1][0]*J[2][1]-J[1][1]*J[2][0])) / det;
+        }
+        else if (dim == 2)
+        {
+            double det = J[0][0]*J[1][1] - J[0][1]*J[1][0];
+            if (det == 0)
+                return false;
+            d[0] = (f[0]*J[1][1] - J[0][1]*f[1]) / det;
+            d[1] = (J[0][0]*f[1] - f[0]*J[1][0]) / det;
+        }
+        else
+        {
+            if (J[0][0] == 0)
+                return false;
+            d[0] = f[0] / J[0][0];
+        }
+
+        rst[0] -= d[0];
+        rst[1] -= d[1];
+        rst[2] -= d[2];
+        if (d[0]*d[0] + d[1]*d[1] + d[2]*d[2] < 1.e-12)
+            return true;
+    }
+    return false;
+}
+
+// ****************************************************************************
+// Function:  eavlCellMeasure
+//
+// Purpose:
+///   Return the length, area, or volume of a cell (by its topological
+///   dimension), integrating the Jacobian of the isoparametric mapping
+///   with a Gauss rule that is exact for linear cells.  "pts" holds the
+///   world coordinates of the cell nodes as xyz triples.  Returns 0 for
+///   points and unsupported shapes.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+EAVL_HOSTDEVICE double eavlCellMeasure(int shapeType, int npts,
+                                       const double *pts)
+{
+    const double g0 = 0.5 - 0.5/sqrt(3.), g1 = 0.5 + 0.5/sqrt(3.);
+    const double third = 1./3.;
+
+    // parametric sample points and their weights (reference measure
+    // times the quadrature weight)
+    double rst[8][3];
+    double wt;
+    int nsamples;
+    switch (shapeType)
+    {
+      case EAVL_BEAM:
+        rst[0][0] = .5; rst[0][1] = 0; rst[0][2] = 0;
+        nsamples = 1; wt = 1;
+        break;
+      case EAVL_TRI:
+        rst[0][0] = third; rst[0][1] = third; rst[0][2] = 0;
+        nsamples = 1; wt = 1./2.;
+        break;
+      case EAVL_TET:
+        rst[0][0] = .25; rst[0][1] = .25; rst[0][2] = .25;
+        nsamples = 1; wt = 1./6.;
+        break;
+      case EAVL_QUAD:
+      case EAVL_PIXEL:
+        for (int i=0; i<4; i++)
+        {
+            rst[i][0] = (i&1) ? g1 : g0;
+            rst[i][1] = (i&2) ? g1 : g0;
+            rst[i][2] = 0;
+        }
+        nsamples = 4; wt = 1./4.;
+        break;
+      case EAVL_WEDGE:
+        for (int i=0; i<2; i++)
+        {
+            rst[i][0] = third;
+            rst[i][1] = third;
+            rst[i][2] = (i&1) ? g1 : g0;
+        }
+        nsamples = 2; wt = 1./4.;
+        break;
+      case EAVL_PYRAMID:
+      case EAVL_HEX:
+      case EAVL_VOXEL:
+        for (int i=0; i<8; i++)
+        {
+            rst[i][0] = (i&1) ? g1 : g0;
+            rst[i][1] = (i&2) ? g1 : g0;
+            rst[i][2] = (i&4) ? g1 : g0;
+        }
+        nsamples = 8; wt = 1./8.;
+        break;
+      default:
+        return 0;
+    }
+
+    int tdim = eavlShapeTopologicalDimension(shapeType);
+    double dr[12], ds[12], dt[12];
+    double measure = 0;
+    for (int q=0; q<nsamples; q++)
+    {
+        if (eavlShapeDerivatives(shapeType, rst[q][0], rst[q][1], rst[q][2],
+                                 dr, ds, dt) != npts)
+            return 0;
+
+        double J[3][3] = {{0,0,0},{0,0,0},{0,0,0}};
+        for (int n=0; n<npts; n++)
+        {
+            for (int c=0; c<3; c++)
+            {
+                J[0][c] += dr[n] * pts[3*n+c];
+                J[1][c] += ds[n] * pts[3*n+c];
+                J[2][c] += dt[n] * pts[3*n+c];
+            }
+        }
+
+        double d;
+        if (tdim == 3)
+        {
+            d = J[0][0]*(J[1][1]*J[2][2]-J[1][2]*J[2][1]) -
+                J[0][1]*(J[1][0]*J[2][2]-J[1][2]*J[2][0]) +
+                J[0][2]*(J[1][0]*J[2][1]-J[1][1]*J[2][0]);
+            if (d < 0)
+                d = -d;
+        }
+        else if (tdim == 2)
+        {
+            double cx = J[0][1]*J[1][2] - J[0][2]*J[1][1];
+            double cy = J[0][2]*J[1][0] - J[0][0]*J[1][2];
+            double cz = J[0][0]*J[1][1] - J[0][1]*J[1][0];
+            d = sqrt(cx*cx + cy*cy + cz*cz);
+        }
+        else
+        {
+            d = sqrt(J[0][0]*J[0][0] + J[0][1]*J[0][1] + J[0][2]*J[0][2]);
+        }
+        measure += wt * d;
+    }
+    return measure;
+}
+
+#endif
@@ -0,0 +1,295 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlStatistics.h"
+#include "eavlException.h"
+
+#include <cfloat>
+#include <cmath>
+
+// unmerged values are folded into the centroids once there are this
+// many times the compression of them
+#define STATISTICS_BUFFER_FACTOR 5
+
+// ----------------------------------------------------------------------------
+// the t-digest scale function, which limits centroids to a unit range
+// of k, and its inverse; centroids are smallest near q=0 and q=1
+static inline double
+QuantileToScale(double q, double compression)
+{
+    return compression / (2*M_PI) * asin(2*q - 1);
+}
+
+static inline double
+ScaleToQuantile(double k, double compression)
+{
+    double a = k * 2*M_PI / compression;
+    if (a > M_PI/2)
+        a = M_PI/2;
+    return (sin(a) + 1) / 2;
+}
+
+eavlStatistics::eavlStatistics(double c)
+    : n(0), minval(+DBL_MAX), maxval(-DBL_MAX),
+      mean(0), m2(0), m3(0), m4(0), compression(c)
+{
+    if (compression < 10)
+        compression = 10;
+}
+
+void
+eavlStatistics::Add(double x)
+{
+    if (x != x)
+        return;
+
+    if (x < minval)
+        minval = x;
+    if (x > maxval)
+        maxval = x;
+
+    double n1 = n;
+    n += 1;
+    double delta = x - mean;
+    double dn = delta / n;
+    double dn2 = dn * dn;
+    double term1 = delta * dn * n1;
+    mean += dn;
+    m4 += term1 * dn2 * (n*n - 3*n + 3) + 6 * dn2 * m2 - 4 * dn * m3;
+    m3 += term1 * dn * (n - 2) - 3 * dn * m2;
+    m2 += term1;
+
+    buffer.push_back(pair<double,double>(x, 1));
+    if (buffer.size() >= STATISTICS_BUFFER_FACTOR * compression)
+    {
+        centroids.insert(centroids.end(), buffer.begin(), buffer.end());
+        buffer.clear();
+        Compress(centroids, compression);
+    }
+}
+
+void
+eavlStatistics::Merge(const eavlStatistics &s)
+{
+    if (s.n == 0)
+        return;
+    if (n == 0)
+    {
+        double c = compression;
+        *this = s;
+        compression = c;
+        return;
+    }
+
+    double na = n, nb = s.n;
+    double nn = na + nb;
+    double delta = s.mean - mean;
+    double d2 = delta * delta;
+    double d3 = d2 * delta;
+    double d4 = d2 * d2;
+
+    double newm4 = m4 + s.m4 +
+        d4 * na * nb * (na*na - na*nb + nb*nb) / (nn*nn*nn) +
+        6 * d2 * (na*na * s.m2 + nb*nb * m2) / (nn*nn) +
+        4 * delta * (na * s.m3 - nb * m3) / nn;
+    double newm3 = m3 + s.m3 +
+        d3 * na * nb * (na - nb) / (nn*nn) +
+        3 * delta * (na * s.m2 - nb * m2) / nn;
+    double newm2 = m2 + s.m2 + d2 * na * nb / nn;
+
+    mean += delta * nb / nn;
+    m2 = newm2;
+    m3 = newm3;
+    m4 = newm4;
+    n = nn;
+    if (s.minval < minval)
+        minval = s.minval;
+    if (s.maxval > maxval)
+        maxval = s.maxval;
+
+    centroids.insert(centroids.end(), buffer.begin(), buffer.end());
+    centroids.insert(centroids.end(), s.centroids.begin(), s.centroids.end());
+    centroids.insert(centroids.end(), s.buffer.begin(), s.buffer.end());
+    buffer.clear();
+    Compress(centroids, compression);
+}
+
+double
+eavlStatistics::GetVariance() const
+{
+    return (n > 1) ? m2 / (n - 1) : 0;
+}
+
+double
+eavlStatistics::GetStandardDeviation() const
+{
+    return sqrt(GetVariance());
+}
+
+double
+eavlStatistics::GetSkewness() const
+{
+    if (n < 2 || m2 <= 0)
+        return 0;
+    return sqrt(n) * m3 / pow(m2, 1.5);
+}
+
+double
+eavlStatistics::GetKurtosis() const
+{
+    if (n < 2 || m2 <= 0)
+        return 0;
+    return n * m4 / (m2 * m2) - 3;
+}
+
+// ****************************************************************************
+// Method:  eavlStatistics::GetQuantile
+//
+// Purpose:
+///   Interpolate linearly between the centroids, each of which sits at
+///   the middle of the range of ranks it covers; the min and max anchor
+///   the two ends.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+double
+eavlStatistics::GetQuantile(double q) const
+{
+    if (n == 0)
+        return 0;
+    if (q <= 0)
+        return minval;
+    if (q >= 1)
+        return maxval;
+
+    vector<pair<double,double> > cents(centroids);
+    if (!buffer.empty())
+    {
+        cents.insert(cents.end(), buffer.begin(), buffer.end());
+        Compress(cents, compression);
+    }
+
+    double total = 0;
+    for (size_t i=0; i<cents.size(); i++)
+        total += cents[i].second;
+    double target = q * total;
+
+    double prevRank = 0, prevValue = minval;
+    double cum = 0;
+    for (size_t i=0; i<cents.size(); i++)
+    {
+        double rank = cum + cents[i].second / 2;
+        if (target < rank)
+        {
+            double t = (target - prevRank) / (rank - prevRank);
+            return prevValue + t * (cents[i].first - prevValue);
+        }
+        prevRank = rank;
+        prevValue = cents[i].first;
+        cum += cents[i].second;
+    }
+    if (total <= prevRank)
+        return maxval;
+    double t = (target - prevRank) / (total - prevRank);
+    return prevValue + t * (maxval - prevValue);
+}
+
+// ****************************************************************************
+// Method:  eavlStatistics::Compress
+//
+// Purpose:
+///   Merge sorted neighboring centroids while the result spans less than
+///   one unit of the scale function.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+void
+eavlStatistics::Compress(vector<pair<double,double> > &cents,
+                         double compression)
+{
+    if (cents.size() < 2)
+        return;
+    std::sort(cents.begin(), cents.end());
+
+    double total = 0;
+    for (size_t i=0; i<cents.size(); i++)
+        total += cents[i].second;
+
+    size_t nout = 0;
+    pair<double,double> cur = cents[0];
+    double sofar = 0;
+    double limit = total * ScaleToQuantile(QuantileToScale(0, compression) + 1,
+                                           compression);
+    for (size_t i=1; i<cents.size(); i++)
+    {
+        const pair<double,double> &c = cents[i];
+        if (sofar + cur.second + c.second <= limit)
+        {
+            cur.second += c.second;
+            cur.first += (c.first - cur.first) * c.second / cur.second;
+        }
+        else
+        {
+            sofar += cur.second;
+            cents[nout++] = cur;
+            limit = total * ScaleToQuantile(
+                QuantileToScale(sofar / total, compression) + 1, compression);
+            cur = c;
+        }
+    }
+    cents[nout++] = cur;
+    cents.resize(nout);
+}
+
+void
+eavlStatistics::GetState(vector<double> &state) const
+{
+    vector<pair<double,double> > cents(centroids);
+    if (!buffer.empty())
+    {
+        cents.insert(cents.end(), buffer.begin(), buffer.end());
+        Compress(cents, compression);
+    }
+
+    state.clear();
+    state.push_back(n);
+    state.push_back(minval);
+    state.push_back(maxval);
+    state.push_back(mean);
+    state.push_back(m2);
+    state.push_back(m3);
+    state.push_back(m4);
+    state.push_back(compression);
+    state.push_back(cents.size());
+    for (size_t i=0; i<cents.size(); i++)
+    {
+        state.push_back(cents[i].first);
+        state.push_back(cents[i].second);
+    }
+}
+
+void
+eavlStatistics::SetState(const vector<double> &state)
+{
+    if (state.size() < 9 ||
+        state.size() != 9 + 2 * size_t(state[8]))
+        THROW(eavlException,"eavlStatistics: malformed state");
+
+    n = state[0];
+    minval = state[1];
+    maxval = state[2];
+    mean = state[3];
+    m2 = state[4];
+    m3 = state[5];
+    m4 = state[6];
+    compression = state[7];
+    centroids.resize(size_t(state[8]));
+    for (size_t i=0; i<centroids.size(); i++)
+    {
+        centroids[i].first = state[9 + 2*i];
+        centroids[i].second = state[10 + 2*i];
+    }
+    buffer.clear();
+}
@@ -0,0 +1,72 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_STATISTICS_H
+#define EAVL_STATISTICS_H
+
+#include "STL.h"
+
+// ****************************************************************************
+// Class:  eavlStatistics
+//
+// Purpose:
+///   Descriptive statistics of a stream of values: count, min, max, mean,
+///   variance, skewness and kurtosis, plus approximate quantiles.
+///
+///   Values are accumulated as central moments, updated one value at a
+///   time with Welford-style recurrences and combined with the pairwise
+///   formulas of Chan et al. and Pebay, which avoid the cancellation of
+///   summing raw powers.  Quantiles come from a merging t-digest: the
+///   values are kept as weighted centroids whose size is bounded by the
+///   compression parameter (about 2x that many centroids at most), with
+///   small centroids near the tails so extreme quantiles stay accurate.
+///
+///   Two accumulators for disjoint sets of values can be merged into
+///   the accumulator of their union, so chunks or domains can each be
+///   summarized separately and only the summaries combined.  GetState
+///   and SetState convert an accumulator to and from a flat array of
+///   doubles for sending between processes.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlStatistics
+{
+  protected:
+    // moments
+    double n;
+    double minval, maxval;
+    double mean, m2, m3, m4;
+
+    // t-digest: centroids sorted by mean, plus unmerged values
+    double compression;
+    vector<pair<double,double> > centroids;
+    vector<pair<double,double> > buffer;
+
+  public:
+    eavlStatistics(double compression = 100);
+
+    void Add(double x);
+    void Merge(const eavlStatistics &s);
+
+    double GetCount() const     { return n; }
+    double GetMin() const       { return n ? minval : 0; }
+    double GetMax() const       { return n ? maxval : 0; }
+    double GetMean() const      { return mean; }
+    /// The sample variance, i.e. divided by n-1.
+    double GetVariance() const;
+    double GetStandardDeviation() const;
+    double GetSkewness() const;
+    /// The excess kurtosis, i.e. 0 for a normal distribution.
+    double GetKurtosis() const;
+    /// The approximate value below which a fraction q of the values lie.
+    double GetQuantile(double q) const;
+
+    void GetState(vector<double> &state) const;
+    void SetState(const vector<double> &state);
+
+  protected:
+    static void Compress(vector<pair<double,double> > &cents,
+                         double compression);
+};
+
+#endif
@@ -0,0 +1,264 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlBinaryExporter.h"
+#include "eavlBinaryFormat.h"
+#include "eavlCellSetExplicit.h"
+#include "eavlCellSetAllStructured.h"
+#include "eavlCellSetSubset.h"
+#include "eavlLogicalStructureRegular.h"
+#include "eavlCoordinates.h"
+#include "eavlException.h"
+
+void
+eavlBinaryExporter::Export(ostream &out)
+{
+    pos = 0;
+    WriteBytes(out, EAVL_BINARY_MAGIC, 8);
+    WriteInt(out, EAVL_BINARY_VERSION);
+    WriteInt(out, EAVL_BINARY_ENDIANCHECK);
+
+    WriteInt(out, data->GetNumPoints());
+    ExportLogicalStructure(out);
+    ExportCoordinates(out);
+    ExportCellSets(out);
+    ExportFields(out);
+}
+
+void
+eavlBinaryExporter::ExportLogicalStructure(ostream &out)
+{
+    eavlLogicalStructure *log = data->GetLogicalStructure();
+    eavlLogicalStructureRegular *logReg =
+        dynamic_cast<eavlLogicalStructureRegular*>(log);
+    if (!log)
+    {
+        WriteInt(out, EAVL_BINARY_LOGICAL_NONE);
+    }
+    else if (logReg)
+    {
+        eavlRegularStructure &reg = logReg->GetRegularStructure();
+        WriteInt(out, EAVL_BINARY_LOGICAL_REGULAR);
+        WriteInt(out, logReg->GetDimension());
+        WriteInt(out, reg.dimension);
+        for (int d=0; d<reg.dimension; d++)
+            WriteInt(out, reg.nodeDims[d]);
+    }
+    else
+    {
+        THROW(eavlException,"eavlBinaryExporter: unsupported logical structure");
+    }
+}
+
+void
+eavlBinaryExporter::ExportCoordinates(ostream &out)
+{
+    int ncs = data->GetNumCoordinateSystems();
+    WriteInt(out, ncs);
+    for (int i=0; i<ncs; i++)
+    {
+        eavlCoordinatesCartesian *cs =
+            dynamic_cast<eavlCoordinatesCartesian*>(data->GetCoordinateSystem(i));
+        eavlCoordinatesCartesianWithTransform *csx =
+            dynamic_cast<eavlCoordinatesCartesianWithTransform*>(cs);
+        if (!cs)
+            THROW(eavlException,"eavlBinaryExporter: unsupported coordinate system");
+
+        if (csx)
+        {
+            WriteInt(out, EAVL_BINARY_COORDS_CARTESIAN_WITH_TRANSFORM);
+            eavlMatrix4x4 m = csx->GetTransform();
+            for (int r=0; r<4; r++)
+                for (int c=0; c<4; c++)
+                    WriteDouble(out, m(r,c));
+        }
+        else
+        {
+            WriteInt(out, EAVL_BINARY_COORDS_CARTESIAN);
+        }
+
+        int ndims = cs->GetDimension();
+        WriteInt(out, ndims);
+        for (int d=0; d<ndims; d++)
+        {
+            WriteInt(out, int(cs->GetAxisType(d)));
+            eavlCoordinateAxisField *af =
+                dynamic_cast<eavlCoordinateAxisField*>(cs->GetAxis(d));
+            eavlCoordinateAxisRegular *ar =
+                dynamic_cast<eavlCoordinateAxisRegular*>(cs->GetAxis(d));
+            if (af)
+            {
+                WriteInt(out, EAVL_BINARY_AXIS_FIELD);
+                WriteString(out, af->GetFieldName());
+                WriteInt(out, af->GetComponent());
+            }
+            else if (ar)
+            {
+                WriteInt(out, EAVL_BINARY_AXIS_REGULAR);
+                WriteInt(out, ar->GetLogicalDim());
+                WriteDouble(out, ar->GetOrigin());
+                WriteDouble(out, ar->GetDelta());
+            }
+            else
+            {
+                THROW(eavlException,"eavlBinaryExporter: unsupported coordinate axis");
+            }
+        }
+    }
+}
+
+void
+eavlBinaryExporter::ExportCellSets(ostream &out)
+{
+    int ncs = data->GetNumCellSets();
+    WriteInt(out, ncs);
+    for (int i=0; i<ncs; i++)
+    {
+        eavlCellSet *cs = data->GetCellSet(i);
+        eavlCellSetAllStructured *csStr =
+            dynamic_cast<eavlCellSetAllStructured*>(cs);
+        eavlCellSetExplicit *csExp =
+            dynamic_cast<eavlCellSetExplicit*>(cs);
+        eavlCellSetSubset *csSub =
+            dynamic_cast<eavlCellSetSubset*>(cs);
+        if (csStr)
+        {
+            eavlRegularStructure &reg = csStr->GetRegularStructure();
+            WriteInt(out, EAVL_BINARY_CELLSET_STRUCTURED);
+            WriteString(out, cs->GetName());
+            WriteInt(out, cs->GetDimensionality());
+            WriteInt(out, reg.dimension);
+            for (int d=0; d<reg.dimension; d++)
+                WriteInt(out, reg.nodeDims[d]);
+        }
+        else if (csExp)
+        {
+            eavlExplicitConnectivity &conn =
+                csExp->GetConnectivity(EAVL_NODES_OF_CELLS);
+            long long ncells = conn.shapetype.size();
+            long long nconn  = conn.connectivity.size();
+            if (conn.mapCellToIndex.size() != ncells)
+                conn.CreateReverseIndex();
+
+            WriteInt(out, EAVL_BINARY_CELLSET_EXPLICIT);
+            WriteString(out, cs->GetName());
+            WriteInt(out, cs->GetDimensionality());
+            WriteLong(out, ncells);
+            WriteLong(out, nconn);
+            WritePadding(out);
+            if (ncells > 0)
+                WriteBytes(out, &(conn.shapetype[0]), ncells*sizeof(int));
+            WritePadding(out);
+            if (nconn > 0)
+                WriteBytes(out, &(conn.connectivity[0]), nconn*sizeof(int));
+            WritePadding(out);
+            if (ncells > 0)
+                WriteBytes(out, &(conn.mapCellToIndex[0]), ncells*sizeof(int));
+        }
+        else if (csSub)
+        {
+            int parent = -1;
+            for (int j=0; j<i; j++)
+                if (data->GetCellSet(j) == csSub->GetParent())
+                    parent = j;
+            if (parent < 0)
+                THROW(eavlException,"eavlBinaryExporter: subset parent must be an earlier cell set in the data set");
+
+            long long n = csSub->GetNumCells();
+            WriteInt(out, EAVL_BINARY_CELLSET_SUBSET);
+            WriteString(out, cs->GetName());
+            WriteInt(out, cs->GetDimensionality());
+            WriteInt(out, parent);
+            WriteLong(out, n);
+            WritePadding(out);
+            eavlCellSetSubset::Iterator it(csSub, 0, n);
+            int index, cell;
+            while (it.Next(index, cell))
+                WriteInt(out, cell);
+        }
+        else
+        {
+            THROW(eavlException,"eavlBinaryExporter: unsupported cell set type");
+        }
+    }
+}
+
+void
+eavlBinaryExporter::ExportFields(ostream &out)
+{
+    int nf = data->GetNumFields();
+    WriteInt(out, nf);
+    for (int i=0; i<nf; i++)
+    {
+        eavlField *f = data->GetField(i);
+        eavlArray *a = f->GetArray();
+        int assocvalue = -1;
+        if (f->GetAssociation() == eavlField::ASSOC_CELL_SET)
+            assocvalue = f->GetAssocCellSet();
+        else if (f->GetAssociation() == eavlField::ASSOC_LOGICALDIM)
+            assocvalue = f->GetAssocLogicalDim();
+
+        string type = a->GetBasicType();
+        int typesize;
+        if (type == "float")
+            typesize = sizeof(float);
+        else if (type == "int")
+            typesize = sizeof(int);
+        else if (type == "byte")
+            typesize = sizeof(byte);
+        else
+            THROW(eavlException,"eavlBinaryExporter: unsupported array type");
+
+        long long ntuples = a->GetNumberOfTuples();
+        int ncomp = a->GetNumberOfComponents();
+        WriteString(out, a->GetName());
+        WriteString(out, type);
+        WriteInt(out, f->GetOrder());
+        WriteInt(out, int(f->GetAssociation()));
+        WriteInt(out, assocvalue);
+        WriteInt(out, ncomp);
+        WriteLong(out, ntuples);
+        WritePadding(out);
+        if (ntuples > 0 && ncomp > 0)
+            WriteBytes(out, a->GetHostArray(), ntuples * ncomp * typesize);
+    }
+}
+
+void
+eavlBinaryExporter::WriteBytes(ostream &out, const void *p, long long n)
+{
+    out.write((const char*)p, n);
+    pos += n;
+}
+
+void
+eavlBinaryExporter::WriteInt(ostream &out, int v)
+{
+    WriteBytes(out, &v, sizeof(int));
+}
+
+void
+eavlBinaryExporter::WriteLong(ostream &out, long long v)
+{
+    WriteBytes(out, &v, sizeof(long long));
+}
+
+void
+eavlBinaryExporter::WriteDouble(ostream &out, double v)
+{
+    WriteBytes(out, &v, sizeof(double));
+}
+
+void
+eavlBinaryExporter::WriteString(ostream &out, const string &s)
+{
+    WriteInt(out, s.length());
+    WriteBytes(out, s.c_str(), s.length());
+}
+
+void
+eavlBinaryExporter::WritePadding(ostream &out)
+{
+    static const char zeros[EAVL_BINARY_ALIGNMENT] = {0};
+    int rem = pos % EAVL_BINARY_ALIGNMENT;
+    if (rem != 0)
+        WriteBytes(out, zeros, EAVL_BINARY_ALIGNMENT - rem);
+}
@@ -0,0 +1,46 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_BINARY_EXPORTER_H
+#define EAVL_BINARY_EXPORTER_H
+
+#include "STL.h"
+#include "eavlExporter.h"
+#include "eavlDataSet.h"
+
+// ****************************************************************************
+// Class :  eavlBinaryExporter
+//
+// Purpose:
+///   Write a data set in the native EAVL binary format (see
+///   eavlBinaryFormat.h), which eavlBinaryImporter can map back in
+///   without parsing the bulk data.  The stream must be opened in
+///   binary mode.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+
+class eavlBinaryExporter : public eavlExporter
+{
+  public:
+    eavlBinaryExporter(eavlDataSet *data_) : eavlExporter(data_), pos(0)
+    {}
+    virtual void Export(ostream &out);
+
+  protected:
+    long long pos;
+
+    void ExportLogicalStructure(ostream &out);
+    void ExportCoordinates(ostream &out);
+    void ExportCellSets(ostream &out);
+    void ExportFields(ostream &out);
+
+    void WriteBytes(ostream &out, const void *p, long long n);
+    void WriteInt(ostream &out, int v);
+    void WriteLong(ostream &out, long long v);
+    void WriteDouble(ostream &out, double v);
+    void WriteString(ostream &out, const string &s);
+    void WritePadding(ostream &out);
+};
+
+#endif
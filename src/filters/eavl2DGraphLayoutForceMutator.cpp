@@ -1,16 +1,186 @@
 // Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
-#include "eavl2DGraphLayoutMutator.h"
+#include "eavl2DGraphLayoutForceMutator.h"
+#include "eavlCoordinates.h"
 #include "eavlCellSetExplicit.h"
+#include "eavlException.h"
 
-eavl2DGraphLayoutMutator::eavl2DGraphLayoutMutator()
+// ****************************************************************************
+// Class:  GraphLayoutQuadTree
+//
+// Purpose:
+///   A quadtree over the current point positions, each node holding the
+///   number of points below it and their center of mass, used for the
+///   Barnes-Hut approximation of the repulsive forces.  Leaves hold a
+///   few points, listed contiguously in "order".
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class GraphLayoutQuadTree
+{
+  public:
+    static const int maxLeafPoints = 8;
+    static const int maxDepth = 24;
+
+    struct Node
+    {
+        float cx, cy;   // center of mass
+        float mass;     // number of points
+        float size;     // width of the (square) node
+        int   first;    // range in "order"
+        int   count;
+        int   child;    // first of four children, or -1 for a leaf
+    };
+
+    vector<Node> nodes;
+    vector<int>  order;
+
+    void Build(int npts, const float *x, const float *y)
+    {
+        nodes.clear();
+        order.resize(npts);
+        for (int i=0; i<npts; ++i)
+            order[i] = i;
+        if (npts == 0)
+            return;
+
+        float x0 = x[0], x1 = x[0], y0 = y[0], y1 = y[0];
+        for (int i=1; i<npts; ++i)
+        {
+            x0 = std::min(x0, x[i]);
+            x1 = std::max(x1, x[i]);
+            y0 = std::min(y0, y[i]);
+            y1 = std::max(y1, y[i]);
+        }
+        float size = std::max(x1 - x0, y1 - y0);
+        nodes.push_back(Node());
+        BuildNode(0, 0, npts, x0, y0, size, 0, x, y);
+    }
+
+    // Sum the repulsion on a point at (px,py), skipping point "self".
+    void Repulsion(int self, float px, float py, float k2, float theta2,
+                   const float *x, const float *y,
+                   float &fx, float &fy) const
+    {
+        fx = 0;
+        fy = 0;
+        if (nodes.empty())
+            return;
+
+        int stack[4*maxDepth + 4];
+        int nstack = 0;
+        stack[nstack++] = 0;
+        while (nstack > 0)
+        {
+            const Node &n = nodes[stack[--nstack]];
+            if (n.count == 0)
+                continue;
+            if (n.child < 0)
+            {
+                for (int k=n.first; k<n.first+n.count; ++k)
+                {
+                    int j = order[k];
+                    if (j == self)
+                        continue;
+                    float dx = px - x[j];
+                    float dy = py - y[j];
+                    float len2 = dx*dx + dy*dy;
+                    ///\todo: if dx==dy==0, assume some small random displacement
+                    if (len2 == 0)
+                        continue;
+                    fx += dx * k2 / len2;
+                    fy += dy * k2 / len2;
+                }
+                continue;
+            }
+
+            float dx = px - n.cx;
+            float dy = py - n.cy;
+            float len2 = dx*dx + dy*dy;
+            if (n.size*n.size < theta2 * len2)
+            {
+                fx += n.mass * dx * k2 / len2;
+                fy += n.mass * dy * k2 / len2;
+            }
+            else
+            {
+                for (int c=0; c<4; ++c)
+                    stack[nstack++] = n.child + c;
+            }
+        }
+    }
+
+  protected:
+    struct CoordBelow
+    {
+        const float *coord;
+        float        split;
+        bool operator()(int i) const { return coord[i] < split; }
+    };
+
+    void BuildNode(int index, int first, int count,
+                   float x0, float y0, float size, int depth,
+                   const float *x, const float *y)
+    {
+        float cx = 0, cy = 0;
+        for (int k=first; k<first+count; ++k)
+        {
+            cx += x[order[k]];
+            cy += y[order[k]];
+        }
+
+        Node n;
+        n.mass = count;
+        n.cx = count > 0 ? cx / count : 0;
+        n.cy = count > 0 ? cy / count : 0;
+        n.size = size;
+        n.first = first;
+        n.count = count;
+        n.child = -1;
+        if (count <= maxLeafPoints || depth >= maxDepth)
+        {
+            nodes[index] = n;
+            return;
+        }
+
+        // split into quadrants: lower y first, then lower x in each half
+        float half = size / 2;
+        int *o = &order[0];
+        CoordBelow below = {y, y0 + half};
+        int *ymid = std::partition(o + first, o + first + count, below);
+        CoordBelow left = {x, x0 + half};
+        int *xmid0 = std::partition(o + first, ymid, left);
+        int *xmid1 = std::partition(ymid, o + first + count, left);
+
+        int bounds[5] = {first,
+                         int(xmid0 - o),
+                         int(ymid - o),
+                         int(xmid1 - o),
+                         first + count};
+        n.child = nodes.size();
+        nodes[index] = n;
+        nodes.resize(nodes.size() + 4);
+        for (int c=0; c<4; ++c)
+        {
+            BuildNode(n.child + c, bounds[c], bounds[c+1] - bounds[c],
+                      x0 + (c%2) * half, y0 + (c/2) * half, half, depth+1,
+                      x, y);
+        }
+    }
+};
+
+eavl2DGraphLayoutForceMutator::eavl2DGraphLayoutForceMutator()
 {
     niter = 30;
     startdist = 0.3;
     finaldist = 0.01;
+    theta = 0.8;
+    tolerance = 1.e-4;
 }
 
 void
-eavl2DGraphLayoutMutator::Execute()
+eavl2DGraphLayoutForceMutator::Execute()
 {
     eavlCellSet *cs = dataset->GetCellSet(cellsetname);
     eavlCellSetExplicit *cse = dynamic_cast<eavlCellSetExplicit*>(cs);
@@ -31,10 +201,14 @@ eavl2DGraphLayoutMutator::Execute()
     else
         dataset->SetCoordinateSystem(0, coords);
 
-    eavlFloatArray *x = new eavlFloatArray("newx", 1, npts);
-    eavlFloatArray *y = new eavlFloatArray("newy", 1, npts);
-    dataset->AddField(new eavlField(1, x, eavlField::ASSOC_POINTS));
-    dataset->AddField(new eavlField(1, y, eavlField::ASSOC_POINTS));
+    eavlFloatArray *xarr = new eavlFloatArray("newx", 1, npts);
+    eavlFloatArray *yarr = new eavlFloatArray("newy", 1, npts);
+    dataset->AddField(new eavlField(1, xarr, eavlField::ASSOC_POINTS));
+    dataset->AddField(new eavlField(1, yarr, eavlField::ASSOC_POINTS));
+    if (npts == 0)
+        return;
+    float *x = (float*)xarr->GetHostArray();
+    float *y = (float*)yarr->GetHostArray();
 
     //srand(npts+15);
     //srand(time(NULL));
@@ -43,8 +217,8 @@ eavl2DGraphLayoutMutator::Execute()
     for (int i=0; i<npts; ++i)
     {
         float a = float(i)/float(npts);
-        x->SetValue(i, cos(a * 2 * M_PI));
-        y->SetValue(i, sin(a * 2 * M_PI));
+        x[i] = cos(a * 2 * M_PI);
+        y[i] = sin(a * 2 * M_PI);
     }
 #elif 0 // second option: in a grid; less often correct for simple graphs
     int sq = sqrt(npts);
@@ -52,134 +226,121 @@ eavl2DGraphLayoutMutator::Execute()
     {
         int xx = i % sq;
         int yy = i / sq;
-        x->SetValue(i, float(xx)/float(sq));
-        y->SetValue(i, float(yy)/float(sq));
+        x[i] = float(xx)/float(sq);
+        y[i] = float(yy)/float(sq);
     }
 #else // third option: random
     for (int i=0; i<npts; ++i)
     {
         float xx = double(random()) / double(RAND_MAX);
         float yy = double(random()) / double(RAND_MAX);
-        x->SetValue(i, 2.*xx-1.);
-        y->SetValue(i, 2.*yy-1.);
+        x[i] = 2.*xx-1.;
+        y[i] = 2.*yy-1.;
     }
 #endif
 
+    // the edges at each point, so each point can sum its own
+    // attractive forces without contention
+    int ncells = cs->GetNumCells();
+    vector<int> edgeStart(npts+1, 0);
+    for (int c=0; c<ncells; ++c)
+    {
+        eavlCell cell = cs->GetCellNodes(c);
+        if (cell.numIndices != 2)
+            continue;
+        edgeStart[cell.indices[0]+1]++;
+        edgeStart[cell.indices[1]+1]++;
+    }
+    for (int i=0; i<npts; ++i)
+        edgeStart[i+1] += edgeStart[i];
+    vector<int> edgeOther(edgeStart[npts]);
+    vector<int> edgeFill(edgeStart.begin(), edgeStart.end()-1);
+    for (int c=0; c<ncells; ++c)
+    {
+        eavlCell cell = cs->GetCellNodes(c);
+        if (cell.numIndices != 2)
+            continue;
+        int i = cell.indices[0];
+        int j = cell.indices[1];
+        edgeOther[edgeFill[i]++] = j;
+        edgeOther[edgeFill[j]++] = i;
+    }
+
     float area = 1;
     float k = sqrt(area / npts);
     float k2 = k*k;
+    float theta2 = theta*theta;
     vector<float> vx(npts, 0);
     vector<float> vy(npts, 0);
+    GraphLayoutQuadTree tree;
     double distchange = finaldist / startdist;
     double distdelta  = niter==1 ? 1 : pow(distchange, 1. / double(niter-1));
     for (int iter = 0 ; iter < niter ; ++iter)
     {
         float maxdist = startdist * pow(distdelta, iter);
 
-        // init vels to 0
-        for (int i=0; i<npts; ++i)
-        {
-            vx[i] = 0;
-            vy[i] = 0;
-        }
-        
-#if 1
-        // repulsive force
+        tree.Build(npts, x, y);
+
+        float maxmove = 0;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for reduction(max:maxmove)
+#endif
         for (int i=0; i<npts; ++i)
         {
-            float ix = x->GetValue(i);
-            float iy = y->GetValue(i);
-            for (int j=i+1; j<npts; ++j)
-            {
-                float dx = ix - x->GetValue(j);
-                float dy = iy - y->GetValue(j);
-                ///\todo: if dx==dy==0, assume some small random displacement
+            float ix = x[i];
+            float iy = y[i];
 
-                /*
+            // repulsive force
+            float fx, fy;
+            tree.Repulsion(i, ix, iy, k2, theta2, x, y, fx, fy);
+
+            // attractive force
+            for (int e=edgeStart[i]; e<edgeStart[i+1]; ++e)
+            {
+                int j = edgeOther[e];
+                float dx = ix - x[j];
+                float dy = iy - y[j];
+                // (the unit direction times len*len/k)
                 float len = sqrt(dx*dx + dy*dy);
-                float udx = dx/len;
-                float udy = dy/len;
-
-                float frx = udx * (k*k / len);
-                float fry = udy * (k*k / len);
-                */
-                // same equation, just more efficient via simplification
-                float len2 = dx*dx + dy*dy;
-                float frx = dx * k2 / len2;
-                float fry = dy * k2 / len2;
-
-                vx[i] += frx;
-                vy[i] += fry;
-
-                vx[j] -= frx;
-                vy[j] -= fry;
+                fx -= dx * len / k;
+                fy -= dy * len / k;
             }
-        }
-#endif
-
-        // attractive force
-        for (int c=0; c<cs->GetNumCells(); ++c)
-        {
-            eavlCell cell = cs->GetCellNodes(c);
-            if (cell.numIndices != 2)
-                continue;
-            int i = cell.indices[0];
-            int j = cell.indices[1];
-
-            float dx = x->GetValue(i) - x->GetValue(j);
-            float dy = y->GetValue(i) - y->GetValue(j);
-            ///\todo: if dx==dy==0, assume some small random displacement
-            float len = sqrt(dx*dx + dy*dy);
-            float udx = dx/len;
-            float udy = dy/len;
-
-            float fax = udx * (len*len / k);
-            float fay = udy * (len*len / k);
-            vx[i] -= fax;
-            vy[i] -= fay;
-
-            vx[j] += fax;
-            vy[j] += fay;
-           
-        }
 
 #if 0
-        // attract to center to keep trees from escaping forest
-        for (int i=0; i<npts; ++i)
-        {
-            float dx = x->GetValue(i);
-            float dy = y->GetValue(i);
-            if (dx == 0 && dy == 0)
-                continue;
-
-            float len = sqrt(dx*dx + dy*dy);
-            float udx = dx/len;
-            float udy = dy/len;
-
-            float scale = 0.3;
-            float fcx = scale * udx * len / k;
-            float fcy = scale * udy * len / k;
-            vx[i] -= fcx;
-            vy[i] -= fcy;
-        }
+            // attract to center to keep trees from escaping forest
+            if (ix != 0 || iy != 0)
+            {
+                float scale = 0.3;
+                fx -= scale * ix / k;
+                fy -= scale * iy / k;
+            }
 #endif
 
-        // clamp to maxdist
-        for (int i=0; i<npts; ++i)
-        {
-            float len = sqrt(vx[i]*vx[i] + vy[i]*vy[i]);
+            // clamp to maxdist
+            float len = sqrt(fx*fx + fy*fy);
             if (len > maxdist)
             {
-                vx[i] = maxdist * vx[i] / len;
-                vy[i] = maxdist * vy[i] / len;
+                fx = maxdist * fx / len;
+                fy = maxdist * fy / len;
+                len = maxdist;
             }
+            vx[i] = fx;
+            vy[i] = fy;
+            if (len > maxmove)
+                maxmove = len;
         }
 
         // update point locations
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
         for (int i=0; i<npts; ++i)
         {
-            x->SetValue(i, x->GetValue(i) + vx[i]);
-            y->SetValue(i, y->GetValue(i) + vy[i]);
+            x[i] += vx[i];
+            y[i] += vy[i];
         }
+
+        if (maxmove < tolerance * k)
+            break;
     }
 }
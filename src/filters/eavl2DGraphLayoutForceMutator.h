@@ -1,6 +1,6 @@
 // Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
-#ifndef EAVL_2D_GRAPH_LAYOUT_MUTATOR_H
-#define EAVL_2D_GRAPH_LAYOUT_MUTATOR_H
+#ifndef EAVL_2D_GRAPH_LAYOUT_FORCE_MUTATOR_H
+#define EAVL_2D_GRAPH_LAYOUT_FORCE_MUTATOR_H
 
 #include "STL.h"
 #include "eavlDataSet.h"
@@ -8,24 +8,42 @@
 #include "eavlFilter.h"
 
 // ****************************************************************************
-// Class:  eavl2DGraphLayoutMutator
+// Class:  eavl2DGraphLayoutForceMutator
 //
 // Purpose:
-///  Add a field as the third spatial dimension of a spatially 2D grid.
+///  Lay out the points of a graph (the two-node cells of a cell set are
+///  its edges) in 2D with a force-directed method, adding "newx" and
+///  "newy" fields as its coordinates.  Every pair of points repels and
+///  every edge attracts; each step moves a point no more than a maximum
+///  distance which shrinks from the start to the final distance over the
+///  iterations.
+///
+///  Repulsion is approximated with a Barnes-Hut quadtree: a group of
+///  points whose tree cell is smaller than theta times its distance acts
+///  as one point at its center of mass.  A theta of zero gives the exact
+///  all-pairs result.  Iterations stop early once no point moves by more
+///  than the convergence tolerance (relative to the ideal edge length).
 //
 // Programmer:  Jeremy Meredith, Dave Pugmire, Sean Ahern
 // Creation:    February 3, 2012
 //
+// Modifications:
+//   agent, Sun Oct 18 2026
+//   Approximate repulsion with a quadtree, compute forces and moves in
+//   parallel, and stop once converged.  Renamed to match its file.
+//
 // ****************************************************************************
-class eavl2DGraphLayoutMutator : public eavlMutator
+class eavl2DGraphLayoutForceMutator : public eavlMutator
 {
   protected:
     string cellsetname;
     int niter;
     double startdist;
     double finaldist;
+    double theta;
+    double tolerance;
   public:
-    eavl2DGraphLayoutMutator();
+    eavl2DGraphLayoutForceMutator();
     void SetCellSet(const string &name)
     {
         cellsetname = name;
@@ -42,6 +60,14 @@ class eavl2DGraphLayoutMutator : public eavlMutator
     {
         finaldist = d;
     }
+    void SetTheta(double t)
+    {
+        theta = t;
+    }
+    void SetConvergenceTolerance(double t)
+    {
+        tolerance = t;
+    }
 
     virtual void Execute();
 };
@@ -6,25 +6,12 @@
 #include "eavlCellSet.h"
 #include "eavlField.h"
 #include "eavlDataSet.h"
-#include "eavl3X3NodeStencilOp_1_1.h"
+#include "eavlNodeStencilOp.h"
 #include "eavlField.h"
 #include "eavlVector3.h"
 #include "eavlException.h"
 #include "eavlExecutor.h"
 
-class AverageFunctor
-{
-  public:
-    EAVL_FUNCTOR float operator()(float x[])
-    {
-        float average = 0;
-        for(int i = 0; i < 9; i++)
-            average += x[i];
-
-        return average/9.0;
-    }
-};
-
 eavl3X3AverageMutator::eavl3X3AverageMutator()
 {
 }
@@ -50,12 +37,13 @@ eavl3X3AverageMutator::Execute()
     eavlFloatArray *out = new eavlFloatArray("3X3Average", 1,
                                              field->GetArray()->GetNumberOfTuples());
 
-    eavlExecutor::AddOperation(new eavl3X3NodeStencilOp_1_1<AverageFunctor>(
-                                      field,
-                                      reg,
-                                      field->GetArray(),
-                                      eavlArrayWithLinearIndex(out, 0),
-                                      AverageFunctor()),
+    // a 3x3 box average is separable into 1x3 and 3x1 passes
+    float weights[3] = {1.f/3.f, 1.f/3.f, 1.f/3.f};
+    eavlExecutor::AddOperation(new eavlNodeStencilOp<2,1>(reg,
+                                                          field->GetArray(),
+                                                          out,
+                                                          weights,
+                                                          true),
                                "3x3 node stencil");
     eavlExecutor::Go();
 
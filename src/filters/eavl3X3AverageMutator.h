@@ -14,6 +14,11 @@
 // Programmer:  Jeremy Meredith, Dave Pugmire, Sean Ahern, Rob Sisneros
 // Creation:    June 25, 2012
 //
+// Modifications:
+//   agent, Sun Oct 18 2026
+//   Use the separable eavlNodeStencilOp, which also runs on the CPU.
+//   Values past the grid edges now repeat the edge values.
+//
 // ****************************************************************************
 class eavl3X3AverageMutator : public eavlMutator
 {
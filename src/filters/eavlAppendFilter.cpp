@@ -0,0 +1,355 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlAppendFilter.h"
+#include "eavlCellSetExplicit.h"
+#include "eavlCoordinates.h"
+#include "eavlNodePositions.h"
+#include "eavlException.h"
+#include "eavlTimer.h"
+
+#include <cfloat>
+#include <cmath>
+
+// finest binning of the points, in bins along the longest axis; this
+// keeps the bin keys within 64 bits
+#define APPEND_MAX_BINS (1<<20)
+
+// ----------------------------------------------------------------------------
+// the fields holding a data set's coordinates, which aren't appended
+static vector<string>
+GetCoordinateFieldNames(eavlDataSet *ds)
+{
+    vector<string> names;
+    names.push_back("coords");
+    for (int c=0; c<ds->GetNumCoordinateSystems(); c++)
+    {
+        eavlCoordinates *cs = ds->GetCoordinateSystem(c);
+        for (int d=0; d<cs->GetDimension(); d++)
+        {
+            eavlCoordinateAxisField *axis =
+                dynamic_cast<eavlCoordinateAxisField*>(cs->GetAxis(d));
+            if (axis)
+                names.push_back(axis->GetFieldName());
+        }
+    }
+    return names;
+}
+
+// ----------------------------------------------------------------------------
+// the field in ds matching f from another input by name, association and
+// number of components, or NULL if there isn't one
+static eavlField *
+FindMatchingField(eavlDataSet *ds, int cellSetIndex, eavlField *f)
+{
+    if (ds->GetNumFields() == 0)
+        return NULL;
+    int index = ds->GetFieldIndex(f->GetArray()->GetName());
+    if (index < 0)
+        return NULL;
+    eavlField *match = ds->GetField(index);
+    if (match->GetAssociation() != f->GetAssociation() ||
+        match->GetArray()->GetNumberOfComponents() !=
+            f->GetArray()->GetNumberOfComponents())
+        return NULL;
+    if (match->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+        match->GetAssocCellSet() != cellSetIndex)
+        return NULL;
+    return match;
+}
+
+eavlAppendFilter::eavlAppendFilter()
+    : mergepoints(true), tolerance(0)
+{
+}
+
+void
+eavlAppendFilter::Execute()
+{
+    int ninputs = inputs.size();
+    if (ninputs == 0)
+        THROW(eavlException,"eavlAppendFilter needs at least one input");
+    if (tolerance < 0)
+        THROW(eavlException,"eavlAppendFilter tolerance must not be negative");
+
+    vector<int> cellSetIndex(ninputs);
+    vector<int> pointStart(ninputs+1, 0), cellStart(ninputs+1, 0);
+    for (int j=0; j<ninputs; j++)
+    {
+        cellSetIndex[j] = inputs[j]->GetCellSetIndex(cellsetname);
+        if (cellSetIndex[j] < 0)
+            THROW(eavlException,"eavlAppendFilter: an input is missing the cell set");
+        pointStart[j+1] = pointStart[j] + inputs[j]->GetNumPoints();
+        cellStart[j+1] = cellStart[j] +
+            inputs[j]->GetCellSet(cellSetIndex[j])->GetNumCells();
+    }
+    int npts = pointStart[ninputs];
+    int ncells = cellStart[ninputs];
+
+    //
+    // gather the points of all the inputs
+    //
+    int th_gather = eavlTimer::Start();
+    vector<float> pts(3*npts);
+    for (int j=0; j<ninputs; j++)
+    {
+        eavlNodePositions positions(inputs[j]);
+        int n = inputs[j]->GetNumPoints();
+        float *p = npts ? &(pts[3*pointStart[j]]) : NULL;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int i = 0; i < n; i++)
+            positions.Get(i, p[3*i+0], p[3*i+1], p[3*i+2]);
+    }
+    eavlTimer::Stop(th_gather, "append gather points");
+
+    //
+    // point each point at the lowest-numbered point it merges with
+    //
+    int th_merge = eavlTimer::Start();
+    vector<int> parent(npts);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < npts; i++)
+        parent[i] = i;
+
+    if (mergepoints && npts > 0)
+    {
+        double lo[3], hi[3];
+        for (int d=0; d<3; d++)
+        {
+            lo[d] = +DBL_MAX;
+            hi[d] = -DBL_MAX;
+        }
+        for (int i=0; i<npts; i++)
+        {
+            for (int d=0; d<3; d++)
+            {
+                if (pts[3*i+d] < lo[d])
+                    lo[d] = pts[3*i+d];
+                if (pts[3*i+d] > hi[d])
+                    hi[d] = pts[3*i+d];
+            }
+        }
+
+        // bins no smaller than the tolerance, so any two points which
+        // merge are in the same or neighboring bins
+        double extent = 0;
+        for (int d=0; d<3; d++)
+            extent = std::max(extent, hi[d] - lo[d]);
+        double binsize = std::max(tolerance, extent / APPEND_MAX_BINS);
+        if (binsize <= 0)
+            binsize = 1;
+        long long dims[3];
+        for (int d=0; d<3; d++)
+            dims[d] = (long long)((hi[d] - lo[d]) / binsize) + 1;
+
+        vector<pair<long long,int> > order(npts);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int i = 0; i < npts; i++)
+        {
+            long long b[3];
+            for (int d=0; d<3; d++)
+                b[d] = std::min(dims[d]-1,
+                                (long long)((pts[3*i+d] - lo[d]) / binsize));
+            order[i].first = (b[0]*dims[1] + b[1])*dims[2] + b[2];
+            order[i].second = i;
+        }
+        std::sort(order.begin(), order.end());
+
+        // identical points always share a bin; only a nonzero
+        // tolerance reaches into the neighboring ones
+        int reach = (tolerance > 0) ? 1 : 0;
+        double tol2 = tolerance * tolerance;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for (int i = 0; i < npts; i++)
+        {
+            long long b[3];
+            for (int d=0; d<3; d++)
+                b[d] = std::min(dims[d]-1,
+                                (long long)((pts[3*i+d] - lo[d]) / binsize));
+            int best = i;
+            for (long long bi = b[0]-reach; bi <= b[0]+reach; bi++)
+            for (long long bj = b[1]-reach; bj <= b[1]+reach; bj++)
+            for (long long bk = b[2]-reach; bk <= b[2]+reach; bk++)
+            {
+                if (bi < 0 || bj < 0 || bk < 0 ||
+                    bi >= dims[0] || bj >= dims[1] || bk >= dims[2])
+                    continue;
+                long long key = (bi*dims[1] + bj)*dims[2] + bk;
+                // a bin's points are in increasing order, so the first
+                // close one is its lowest
+                vector<pair<long long,int> >::const_iterator it =
+                    std::lower_bound(order.begin(), order.end(),
+                                     pair<long long,int>(key, -1));
+                for (; it != order.end() && it->first == key &&
+                       it->second < best; ++it)
+                {
+                    int k = it->second;
+                    double dist2 = 0;
+                    for (int d=0; d<3; d++)
+                    {
+                        double delta = double(pts[3*k+d]) - pts[3*i+d];
+                        dist2 += delta * delta;
+                    }
+                    if (dist2 <= tol2)
+                    {
+                        best = k;
+                        break;
+                    }
+                }
+            }
+            parent[i] = best;
+        }
+
+        // every link goes to a lower point, so in increasing order each
+        // parent is already resolved
+        for (int i=0; i<npts; i++)
+            parent[i] = parent[parent[i]];
+    }
+
+    // number the surviving points in order
+    vector<int> newIndex(npts);
+    vector<int> outPoint;
+    for (int i=0; i<npts; i++)
+    {
+        if (parent[i] == i)
+        {
+            newIndex[i] = outPoint.size();
+            outPoint.push_back(i);
+        }
+        else
+            newIndex[i] = newIndex[parent[i]];
+    }
+    int noutPts = outPoint.size();
+    eavlTimer::Stop(th_merge, "append merge points");
+
+    //
+    // set up the output mesh
+    //
+    int th_output = eavlTimer::Start();
+    output->SetNumPoints(noutPts);
+
+    eavlFloatArray *coords = new eavlFloatArray("coords", 3, noutPts);
+    float *coordsp = (float*)coords->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < noutPts; i++)
+        for (int d=0; d<3; d++)
+            coordsp[3*i+d] = pts[3*outPoint[i]+d];
+    output->AddField(new eavlField(1, coords, eavlField::ASSOC_POINTS));
+
+    eavlExplicitConnectivity conn;
+    for (int j=0; j<ninputs; j++)
+    {
+        eavlCellSet *cs = inputs[j]->GetCellSet(cellSetIndex[j]);
+        int n = cs->GetNumCells();
+        for (int c=0; c<n; c++)
+        {
+            eavlCell cell = cs->GetCellNodes(c);
+            int ids[12];
+            for (int k=0; k<cell.numIndices; k++)
+                ids[k] = newIndex[pointStart[j] + cell.indices[k]];
+            conn.AddElement(cell.type, cell.numIndices, ids);
+        }
+    }
+    int dim = inputs[0]->GetCellSet(cellSetIndex[0])->GetDimensionality();
+    eavlCellSetExplicit *outCellSet = new eavlCellSetExplicit(cellsetname, dim);
+    outCellSet->SetCellNodeConnectivity(conn);
+    output->AddCellSet(outCellSet);
+
+    eavlCoordinatesCartesian *coordsys =
+        new eavlCoordinatesCartesian(NULL,
+                                     eavlCoordinatesCartesian::X,
+                                     eavlCoordinatesCartesian::Y,
+                                     eavlCoordinatesCartesian::Z);
+    coordsys->SetAxis(0, new eavlCoordinateAxisField("coords", 0));
+    coordsys->SetAxis(1, new eavlCoordinateAxisField("coords", 1));
+    coordsys->SetAxis(2, new eavlCoordinateAxisField("coords", 2));
+    output->AddCoordinateSystem(coordsys);
+
+    //
+    // append the point and cell fields every input has; merged points
+    // take their values from the lowest-numbered one
+    //
+    vector<string> coordFieldNames = GetCoordinateFieldNames(inputs[0]);
+    for (int f=0; f<inputs[0]->GetNumFields(); f++)
+    {
+        eavlField *field = inputs[0]->GetField(f);
+        eavlArray *a = field->GetArray();
+        bool onPoints = (field->GetAssociation() == eavlField::ASSOC_POINTS);
+        bool onCells = (field->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+                        field->GetAssocCellSet() == cellSetIndex[0]);
+        if (!onPoints && !onCells)
+            continue;
+        if (onPoints &&
+            std::find(coordFieldNames.begin(), coordFieldNames.end(),
+                      a->GetName()) != coordFieldNames.end())
+            continue;
+
+        vector<eavlArray*> arrays(ninputs, (eavlArray*)NULL);
+        bool everywhere = true;
+        for (int j=0; j<ninputs && everywhere; j++)
+        {
+            eavlField *match = FindMatchingField(inputs[j], cellSetIndex[j],
+                                                 field);
+            if (onPoints && match)
+            {
+                vector<string> names = GetCoordinateFieldNames(inputs[j]);
+                if (std::find(names.begin(), names.end(), a->GetName()) !=
+                    names.end())
+                    match = NULL;
+            }
+            if (match)
+                arrays[j] = match->GetArray();
+            else
+                everywhere = false;
+        }
+        if (!everywhere)
+            continue;
+
+        int nc = a->GetNumberOfComponents();
+        if (onPoints)
+        {
+            eavlArray *out = a->Create(a->GetName(), nc, noutPts);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+            for (int i = 0; i < noutPts; i++)
+            {
+                int p = outPoint[i];
+                // find the input holding this point
+                int j = std::upper_bound(pointStart.begin(), pointStart.end(),
+                                         p) - pointStart.begin() - 1;
+                for (int k=0; k<nc; k++)
+                    out->SetComponentFromDouble(i, k,
+                        arrays[j]->GetComponentAsDouble(p - pointStart[j], k));
+            }
+            output->AddField(new eavlField(field->GetOrder(), out,
+                                           eavlField::ASSOC_POINTS));
+        }
+        else
+        {
+            eavlArray *out = a->Create(a->GetName(), nc, ncells);
+            for (int j=0; j<ninputs; j++)
+            {
+                int n = cellStart[j+1] - cellStart[j];
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+                for (int c = 0; c < n; c++)
+                    for (int k=0; k<nc; k++)
+                        out->SetComponentFromDouble(cellStart[j] + c, k,
+                            arrays[j]->GetComponentAsDouble(c, k));
+            }
+            output->AddField(new eavlField(field->GetOrder(), out,
+                                           eavlField::ASSOC_CELL_SET, 0));
+        }
+    }
+    eavlTimer::Stop(th_output, "append output");
+}
@@ -0,0 +1,75 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_APPEND_FILTER_H
+#define EAVL_APPEND_FILTER_H
+
+#include "STL.h"
+#include "eavlDataSet.h"
+#include "eavlCellSet.h"
+#include "eavlFilter.h"
+
+// ****************************************************************************
+// Class:  eavlAppendFilter
+//
+// Purpose:
+///   Combine several data sets, e.g. the chunks of a mesh read one at a
+///   time from an importer, into a single data set.  The points of all
+///   the inputs are concatenated, and the named cell set of each input
+///   is appended into one explicit cell set of the same name.  Point
+///   fields, and fields on the cell set, are appended when every input
+///   has them with the same number of components.
+///
+///   By default, coincident points (those within the tolerance of each
+///   other) are merged, so chunk boundaries don't leave duplicated
+///   seams, and the connectivity is rewritten to match.  Each point
+///   maps to the lowest-numbered point within the tolerance, following
+///   those links to the end, and merged points keep the position and
+///   field values of that lowest-numbered point.  Points are binned on
+///   a uniform grid no finer than the tolerance, sorted by bin, and
+///   each searches only its neighboring bins, so the extra memory is a
+///   few values per point.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlAppendFilter : public eavlFilter
+{
+  protected:
+    vector<eavlDataSet*> inputs;
+    string cellsetname;
+    bool   mergepoints;
+    double tolerance;
+  public:
+    eavlAppendFilter();
+    /// Sets the first input, clearing any others.
+    virtual void SetInput(eavlDataSet *ds)
+    {
+        eavlFilter::SetInput(ds);
+        inputs.clear();
+        inputs.push_back(ds);
+    }
+    void AddInput(eavlDataSet *ds)
+    {
+        if (inputs.empty())
+            SetInput(ds);
+        else
+            inputs.push_back(ds);
+    }
+    void SetCellSet(const string &name)
+    {
+        cellsetname = name;
+    }
+    void SetMergePoints(bool merge)
+    {
+        mergepoints = merge;
+    }
+    /// Points closer than this are merged; 0 merges only identical points.
+    void SetTolerance(double tol)
+    {
+        tolerance = tol;
+    }
+
+    virtual void Execute();
+};
+
+#endif
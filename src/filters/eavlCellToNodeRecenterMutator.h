@@ -8,11 +8,15 @@
 //
 // Purpose:
 ///   Recenters a field from a cellset to the mesh points.
+///   See eavlRecenterMutator for weighting and the other direction.
 //
 // Programmer:  Jeremy Meredith
 // Creation:    November 28, 2012
 //
 // Modifications:
+//   agent, Sun Oct 18 2026
+//   Handle any number of components in a single pass.
+//
 // ****************************************************************************
 class eavlCellToNodeRecenterMutator : public eavlMutator
 {
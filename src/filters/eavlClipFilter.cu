@@ -0,0 +1,665 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlClipFilter.h"
+#include "eavlCellSetExplicit.h"
+#include "eavlCellComponents.h"
+#include "eavlCoordinates.h"
+#include "eavlException.h"
+#include "eavlNodePositions.h"
+
+eavlClipFilter::eavlClipFilter() : invert(false)
+{
+}
+
+// ----------------------------------------------------------------------------
+// An output point: input node a, the point on the edge between nodes
+// a < b, the center of cell a, or the point on the edge from the center
+// of cell a to its node b.  t is measured from a (or the center).
+// ----------------------------------------------------------------------------
+struct ClipPoint
+{
+    enum Kind { NODE, EDGE, CENTER, CENTER_EDGE };
+    int   kind;
+    int   a, b;
+    float t;
+    bool operator<(const ClipPoint &p) const
+    {
+        if (kind != p.kind)
+            return kind < p.kind;
+        if (a != p.a)
+            return a < p.a;
+        return b < p.b;
+    }
+    bool SamePoint(const ClipPoint &p) const
+    {
+        return kind == p.kind && a == p.a && b == p.b;
+    }
+};
+
+struct ClipCorner
+{
+    ClipPoint p;
+    int       pos;   // where it goes in the output connectivity
+    bool operator<(const ClipCorner &c) const
+    {
+        if (p < c.p)
+            return true;
+        if (c.p < p)
+            return false;
+        return pos < c.pos;
+    }
+};
+
+// A corner of a (sub-)cell being clipped, with its function value;
+// it is kept when the value is not positive.
+struct ClipVertex
+{
+    ClipPoint p;
+    float     g;
+};
+
+#define CLIP_MAX_PIECES  16
+#define CLIP_MAX_CORNERS 96
+
+// The output cells generated from one input cell.
+struct ClipPieces
+{
+    int       npieces;
+    int       ncorners;
+    int       shape[CLIP_MAX_PIECES];
+    int       size[CLIP_MAX_PIECES];
+    ClipPoint corners[CLIP_MAX_CORNERS];
+
+    void Add(int shapeType, int n, const ClipPoint *pts)
+    {
+        shape[npieces] = shapeType;
+        size[npieces] = n;
+        npieces++;
+        for (int i=0; i<n; i++)
+            corners[ncorners++] = pts[i];
+    }
+};
+
+static ClipPoint
+ClipEdgePoint(const ClipVertex &in, const ClipVertex &out)
+{
+    ClipPoint p;
+    if (in.p.kind == ClipPoint::CENTER || out.p.kind == ClipPoint::CENTER)
+    {
+        const ClipVertex &c = (in.p.kind == ClipPoint::CENTER) ? in : out;
+        const ClipVertex &n = (in.p.kind == ClipPoint::CENTER) ? out : in;
+        p.kind = ClipPoint::CENTER_EDGE;
+        p.a = c.p.a;
+        p.b = n.p.a;
+        p.t = c.g / (c.g - n.g);
+    }
+    else
+    {
+        // order by node id so both cells sharing the edge agree
+        const ClipVertex &lo = (in.p.a < out.p.a) ? in : out;
+        const ClipVertex &hi = (in.p.a < out.p.a) ? out : in;
+        p.kind = ClipPoint::EDGE;
+        p.a = lo.p.a;
+        p.b = hi.p.a;
+        p.t = lo.g / (lo.g - hi.g);
+    }
+    return p;
+}
+
+static bool
+ClipOddPermutation(const int *o, int n)
+{
+    int inversions = 0;
+    for (int i=0; i<n; i++)
+        for (int j=i+1; j<n; j++)
+            inversions += (o[i] > o[j]);
+    return inversions % 2;
+}
+
+// Clip a tet, keeping its orientation: one kept node leaves a smaller
+// tet, two or three leave a wedge.
+static void
+ClipTet(const ClipVertex *v, ClipPieces &out)
+{
+    int in[4], ex[4];
+    int nin = 0, nex = 0;
+    for (int i=0; i<4; i++)
+    {
+        if (v[i].g <= 0)
+            in[nin++] = i;
+        else
+            ex[nex++] = i;
+    }
+
+    ClipPoint pts[6];
+    if (nin == 4)
+    {
+        for (int i=0; i<4; i++)
+            pts[i] = v[i].p;
+        out.Add(EAVL_TET, 4, pts);
+    }
+    else if (nin == 1)
+    {
+        for (int i=0; i<4; i++)
+            pts[i] = (i == in[0]) ? v[i].p : ClipEdgePoint(v[in[0]], v[i]);
+        out.Add(EAVL_TET, 4, pts);
+    }
+    else if (nin == 2)
+    {
+        int o[4] = {in[0], in[1], ex[0], ex[1]};
+        if (ClipOddPermutation(o, 4))
+            std::swap(o[2], o[3]);
+        pts[0] = v[o[0]].p;
+        pts[1] = ClipEdgePoint(v[o[0]], v[o[3]]);
+        pts[2] = ClipEdgePoint(v[o[0]], v[o[2]]);
+        pts[3] = v[o[1]].p;
+        pts[4] = ClipEdgePoint(v[o[1]], v[o[3]]);
+        pts[5] = ClipEdgePoint(v[o[1]], v[o[2]]);
+        out.Add(EAVL_WEDGE, 6, pts);
+    }
+    else if (nin == 3)
+    {
+        int o[4] = {in[0], in[1], in[2], ex[0]};
+        if (ClipOddPermutation(o, 4))
+            std::swap(o[1], o[2]);
+        pts[0] = v[o[0]].p;
+        pts[1] = v[o[2]].p;
+        pts[2] = v[o[1]].p;
+        pts[3] = ClipEdgePoint(v[o[0]], v[o[3]]);
+        pts[4] = ClipEdgePoint(v[o[2]], v[o[3]]);
+        pts[5] = ClipEdgePoint(v[o[1]], v[o[3]]);
+        out.Add(EAVL_WEDGE, 6, pts);
+    }
+}
+
+// Clip a triangle, keeping its orientation: one kept node leaves a
+// smaller triangle, two leave a quad.
+static void
+ClipTri(const ClipVertex &v0, const ClipVertex &v1, const ClipVertex &v2,
+        ClipPieces &out)
+{
+    const ClipVertex *v[3] = {&v0, &v1, &v2};
+    int nin = 0, in = 0, ex = 0;
+    for (int i=0; i<3; i++)
+    {
+        if (v[i]->g <= 0)
+        {
+            nin++;
+            in = i;
+        }
+        else
+            ex = i;
+    }
+
+    ClipPoint pts[4];
+    if (nin == 3)
+    {
+        for (int i=0; i<3; i++)
+            pts[i] = v[i]->p;
+        out.Add(EAVL_TRI, 3, pts);
+    }
+    else if (nin == 1)
+    {
+        for (int i=0; i<3; i++)
+            pts[i] = (i == in) ? v[i]->p : ClipEdgePoint(*v[in], *v[i]);
+        out.Add(EAVL_TRI, 3, pts);
+    }
+    else if (nin == 2)
+    {
+        const ClipVertex &a = *v[(ex+1)%3];
+        const ClipVertex &b = *v[(ex+2)%3];
+        const ClipVertex &o = *v[ex];
+        pts[0] = a.p;
+        pts[1] = b.p;
+        pts[2] = ClipEdgePoint(b, o);
+        pts[3] = ClipEdgePoint(a, o);
+        out.Add(EAVL_QUAD, 4, pts);
+    }
+}
+
+// Split the quad q0..q3 (in ring order) into two triangles along the
+// diagonal through its lowest node id.
+static void
+SplitClipQuad(const int *ids, const int *q, int tris[2][3])
+{
+    int m = 0;
+    for (int i=1; i<4; i++)
+    {
+        if (ids[q[i]] < ids[q[m]])
+            m = i;
+    }
+    int s = m % 2;
+    tris[0][0] = q[s];  tris[0][1] = q[s+1];     tris[0][2] = q[s+2];
+    tris[1][0] = q[s];  tris[1][1] = q[s+2];     tris[1][2] = q[(s+3)%4];
+}
+
+static void
+ClipRing(const int *ids, const ClipVertex *v, const int *ring, int n,
+         ClipPieces &out)
+{
+    if (n == 4)
+    {
+        int tris[2][3];
+        SplitClipQuad(ids, ring, tris);
+        for (int i=0; i<2; i++)
+            ClipTri(v[tris[i][0]], v[tris[i][1]], v[tris[i][2]], out);
+    }
+    else
+    {
+        for (int i=1; i+1<n; i++)
+            ClipTri(v[ring[0]], v[ring[i]], v[ring[i+1]], out);
+    }
+}
+
+static void
+GetClipFaceTables(int shapeType,
+                  int &ntris, signed char (*&tris)[3],
+                  int &nquads, signed char (*&quads)[4])
+{
+    ntris = nquads = 0;
+    tris = NULL;
+    quads = NULL;
+    switch (shapeType)
+    {
+      case EAVL_PYRAMID:
+        ntris = 4;   tris = eavlPyramidTriangleFaces;
+        nquads = 1;  quads = eavlPyramidQuadFaces;
+        break;
+      case EAVL_WEDGE:
+        ntris = 2;   tris = eavlWedgeTriangleFaces;
+        nquads = 3;  quads = eavlWedgeQuadFaces;
+        break;
+      case EAVL_HEX:
+        nquads = 6;  quads = eavlHexQuadFaces;
+        break;
+      case EAVL_VOXEL:
+        nquads = 6;  quads = eavlVoxQuadFaces;
+        break;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Generate the clipped pieces of one cell.
+// ----------------------------------------------------------------------------
+static void
+ClipCell(eavlCellSet *cells, int c, const eavlNodePositions &positions,
+         const eavlImplicitFunction &func, float sign, ClipPieces &out)
+{
+    out.npieces = 0;
+    out.ncorners = 0;
+
+    eavlCell cell = cells->GetCellNodes(c);
+    int n = cell.numIndices;
+    ClipVertex v[12];
+    float cx = 0, cy = 0, cz = 0;
+    int nin = 0;
+    for (int i=0; i<n; i++)
+    {
+        float x, y, z;
+        positions.Get(cell.indices[i], x, y, z);
+        cx += x;
+        cy += y;
+        cz += z;
+        v[i].p.kind = ClipPoint::NODE;
+        v[i].p.a = cell.indices[i];
+        v[i].p.b = 0;
+        v[i].p.t = 0;
+        v[i].g = sign * func.Eval(x, y, z);
+        if (v[i].g <= 0)
+            nin++;
+    }
+    if (nin == 0)
+        return;
+
+    if (nin == n)
+    {
+        ClipPoint pts[12];
+        for (int i=0; i<n; i++)
+            pts[i] = v[i].p;
+        out.Add(cell.type, n, pts);
+        return;
+    }
+
+    switch (cell.type)
+    {
+      case EAVL_BEAM:
+        {
+        ClipPoint pts[2];
+        for (int i=0; i<2; i++)
+            pts[i] = (v[i].g <= 0) ? v[i].p : ClipEdgePoint(v[1-i], v[i]);
+        out.Add(EAVL_BEAM, 2, pts);
+        }
+        break;
+      case EAVL_TRI:
+        ClipTri(v[0], v[1], v[2], out);
+        break;
+      case EAVL_QUAD:
+      case EAVL_POLYGON:
+        {
+        int ring[12];
+        for (int i=0; i<n; i++)
+            ring[i] = i;
+        ClipRing(cell.indices, v, ring, n, out);
+        }
+        break;
+      case EAVL_PIXEL:
+        {
+        int ring[4] = {0, 1, 3, 2};
+        ClipRing(cell.indices, v, ring, 4, out);
+        }
+        break;
+      case EAVL_TRISTRIP:
+        for (int i=0; i+2<n; i++)
+        {
+            if (i % 2 == 0)
+                ClipTri(v[i], v[i+1], v[i+2], out);
+            else
+                ClipTri(v[i+1], v[i], v[i+2], out);
+        }
+        break;
+      case EAVL_TET:
+        ClipTet(v, out);
+        break;
+      case EAVL_PYRAMID:
+      case EAVL_WEDGE:
+      case EAVL_HEX:
+      case EAVL_VOXEL:
+        {
+        // tets from each (outward) face triangle to the cell center
+        ClipVertex center;
+        center.p.kind = ClipPoint::CENTER;
+        center.p.a = c;
+        center.p.b = 0;
+        center.p.t = 0;
+        center.g = sign * func.Eval(cx/n, cy/n, cz/n);
+
+        int ntris, nquads;
+        signed char (*tris)[3];
+        signed char (*quads)[4];
+        GetClipFaceTables(cell.type, ntris, tris, nquads, quads);
+        ClipVertex tet[4];
+        tet[3] = center;
+        for (int f=0; f<ntris; f++)
+        {
+            tet[0] = v[tris[f][0]];
+            tet[1] = v[tris[f][2]];
+            tet[2] = v[tris[f][1]];
+            ClipTet(tet, out);
+        }
+        for (int f=0; f<nquads; f++)
+        {
+            int q[4] = {quads[f][0], quads[f][1], quads[f][2], quads[f][3]};
+            int halves[2][3];
+            SplitClipQuad(cell.indices, q, halves);
+            for (int h=0; h<2; h++)
+            {
+                tet[0] = v[halves[h][0]];
+                tet[1] = v[halves[h][2]];
+                tet[2] = v[halves[h][1]];
+                ClipTet(tet, out);
+            }
+        }
+        }
+        break;
+      default:
+        THROW(eavlException,"eavlClipFilter can't clip this cell shape.");
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Positions and field values of the output points.
+// ----------------------------------------------------------------------------
+static void
+GetClipPointPosition(const ClipPoint &p, eavlCellSet *cells,
+                     const eavlNodePositions &positions,
+                     float &x, float &y, float &z)
+{
+    if (p.kind == ClipPoint::NODE || p.kind == ClipPoint::EDGE)
+    {
+        positions.Get(p.a, x, y, z);
+        if (p.kind == ClipPoint::NODE)
+            return;
+        float xb, yb, zb;
+        positions.Get(p.b, xb, yb, zb);
+        x += p.t * (xb - x);
+        y += p.t * (yb - y);
+        z += p.t * (zb - z);
+        return;
+    }
+
+    eavlCell cell = cells->GetCellNodes(p.a);
+    x = y = z = 0;
+    for (int i=0; i<cell.numIndices; i++)
+    {
+        float xi, yi, zi;
+        positions.Get(cell.indices[i], xi, yi, zi);
+        x += xi;
+        y += yi;
+        z += zi;
+    }
+    x /= cell.numIndices;
+    y /= cell.numIndices;
+    z /= cell.numIndices;
+    if (p.kind == ClipPoint::CENTER_EDGE)
+    {
+        float xb, yb, zb;
+        positions.Get(p.b, xb, yb, zb);
+        x += p.t * (xb - x);
+        y += p.t * (yb - y);
+        z += p.t * (zb - z);
+    }
+}
+
+static double
+GetClipPointValue(const ClipPoint &p, eavlCellSet *cells,
+                  eavlArray *arr, int comp)
+{
+    if (p.kind == ClipPoint::NODE)
+        return arr->GetComponentAsDouble(p.a, comp);
+    if (p.kind == ClipPoint::EDGE)
+    {
+        double va = arr->GetComponentAsDouble(p.a, comp);
+        double vb = arr->GetComponentAsDouble(p.b, comp);
+        return va + p.t * (vb - va);
+    }
+
+    eavlCell cell = cells->GetCellNodes(p.a);
+    double vc = 0;
+    for (int i=0; i<cell.numIndices; i++)
+        vc += arr->GetComponentAsDouble(cell.indices[i], comp);
+    vc /= cell.numIndices;
+    if (p.kind == ClipPoint::CENTER)
+        return vc;
+    double vb = arr->GetComponentAsDouble(p.b, comp);
+    return vc + p.t * (vb - vc);
+}
+
+// ****************************************************************************
+// Method:  eavlClipFilter::Execute
+//
+// Purpose:
+///   Count the output cells and corners of every input cell, scan the
+///   counts, then revisit the cells to generate them.  Sorting the
+///   corners by the point they refer to merges the shared points, and
+///   the output fields are interpolated from the input nodes.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+void
+eavlClipFilter::Execute()
+{
+    int inCellSetIndex = input->GetCellSetIndex(cellsetname);
+    eavlCellSet *inCells = input->GetCellSet(cellsetname);
+
+    eavlNodePositions positions(input);
+    float sign = invert ? -1 : 1;
+
+    //
+    // count the pieces of each cell
+    //
+    int ncells = inCells->GetNumCells();
+    vector<int> pieceStart(ncells+1), cornerStart(ncells+1);
+    pieceStart[0] = 0;
+    cornerStart[0] = 0;
+    // exceptions can't leave a parallel loop, so note unsupported
+    // shapes and throw afterwards
+    bool badShape = false;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for reduction(||:badShape)
+#endif
+    for (int c=0; c<ncells; c++)
+    {
+        ClipPieces pieces;
+        try
+        {
+            ClipCell(inCells, c, positions, function, sign, pieces);
+        }
+        catch (const eavlException &)
+        {
+            badShape = true;
+            pieces.npieces = pieces.ncorners = 0;
+        }
+        pieceStart[c+1] = pieces.npieces;
+        cornerStart[c+1] = pieces.ncorners;
+    }
+    if (badShape)
+        THROW(eavlException,"eavlClipFilter can't clip this cell shape.");
+    for (int c=0; c<ncells; c++)
+    {
+        pieceStart[c+1] += pieceStart[c];
+        cornerStart[c+1] += cornerStart[c];
+    }
+    int npieces = pieceStart[ncells];
+    int ncorners = cornerStart[ncells];
+
+    //
+    // generate them
+    //
+    eavlExplicitConnectivity conn;
+    conn.shapetype.resize(npieces);
+    conn.connectivity.resize(npieces + ncorners);
+    vector<ClipCorner> corners(ncorners);
+    vector<int> pieceCell(npieces);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int c=0; c<ncells; c++)
+    {
+        if (pieceStart[c+1] == pieceStart[c])
+            continue;
+        ClipPieces pieces;
+        ClipCell(inCells, c, positions, function, sign, pieces);
+        int piece = pieceStart[c];
+        int corner = cornerStart[c];
+        int pos = piece + corner;
+        int k = 0;
+        for (int j=0; j<pieces.npieces; j++, piece++)
+        {
+            conn.shapetype[piece] = pieces.shape[j];
+            pieceCell[piece] = c;
+            conn.connectivity[pos++] = pieces.size[j];
+            for (int s=0; s<pieces.size[j]; s++, k++)
+            {
+                corners[corner+k].p = pieces.corners[k];
+                corners[corner+k].pos = pos++;
+            }
+        }
+    }
+
+    //
+    // merge corners referring to the same point
+    //
+    std::sort(corners.begin(), corners.end());
+    vector<int> firstCorner;
+    for (int i=0; i<ncorners; i++)
+    {
+        if (i == 0 || !corners[i].p.SamePoint(corners[i-1].p))
+            firstCorner.push_back(i);
+        conn.connectivity[corners[i].pos] = firstCorner.size() - 1;
+    }
+    int noutpts = firstCorner.size();
+
+    //
+    // set up the output mesh
+    //
+    output->SetNumPoints(noutpts);
+    eavlCellSetExplicit *outCellSet =
+        new eavlCellSetExplicit("clip", inCells->GetDimensionality());
+    outCellSet->SetCellNodeConnectivity(conn);
+    output->AddCellSet(outCellSet);
+
+    eavlFloatArray *newx = new eavlFloatArray("newx", 1, noutpts);
+    eavlFloatArray *newy = new eavlFloatArray("newy", 1, noutpts);
+    eavlFloatArray *newz = new eavlFloatArray("newz", 1, noutpts);
+    if (noutpts > 0)
+    {
+        float *x = (float*)newx->GetHostArray();
+        float *y = (float*)newy->GetHostArray();
+        float *z = (float*)newz->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int p=0; p<noutpts; p++)
+        {
+            GetClipPointPosition(corners[firstCorner[p]].p, inCells,
+                                 positions, x[p], y[p], z[p]);
+        }
+    }
+    output->AddField(new eavlField(1, newx, eavlField::ASSOC_POINTS));
+    output->AddField(new eavlField(1, newy, eavlField::ASSOC_POINTS));
+    output->AddField(new eavlField(1, newz, eavlField::ASSOC_POINTS));
+
+    eavlCoordinatesCartesian *coordsys =
+        new eavlCoordinatesCartesian(NULL,
+                                     eavlCoordinatesCartesian::X,
+                                     eavlCoordinatesCartesian::Y,
+                                     eavlCoordinatesCartesian::Z);
+    coordsys->SetAxis(0, new eavlCoordinateAxisField("newx", 0));
+    coordsys->SetAxis(1, new eavlCoordinateAxisField("newy", 0));
+    coordsys->SetAxis(2, new eavlCoordinateAxisField("newz", 0));
+    output->AddCoordinateSystem(coordsys);
+
+    //
+    // interpolate the point fields and copy the cell fields
+    //
+    for (int i=0; i<input->GetNumFields(); i++)
+    {
+        eavlField *f = input->GetField(i);
+        eavlArray *a = f->GetArray();
+        int ncomp = a->GetNumberOfComponents();
+        if (f->GetAssociation() == eavlField::ASSOC_POINTS)
+        {
+            if (positions.IsCoordinateField(f))
+                continue;
+            eavlArray *outArr = a->Create(a->GetName(), ncomp, noutpts);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+            for (int p=0; p<noutpts; p++)
+            {
+                const ClipPoint &pt = corners[firstCorner[p]].p;
+                for (int j=0; j<ncomp; j++)
+                    outArr->SetComponentFromDouble(p, j,
+                                  GetClipPointValue(pt, inCells, a, j));
+            }
+            output->AddField(new eavlField(1, outArr, eavlField::ASSOC_POINTS));
+        }
+        else if (f->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+                 f->GetAssocCellSet() == inCellSetIndex)
+        {
+            eavlArray *outArr = a->Create(a->GetName(), ncomp, npieces);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+            for (int p=0; p<npieces; p++)
+            {
+                for (int j=0; j<ncomp; j++)
+                    outArr->SetComponentFromDouble(p, j,
+                                 a->GetComponentAsDouble(pieceCell[p], j));
+            }
+            output->AddField(new eavlField(f->GetOrder(), outArr,
+                                           eavlField::ASSOC_CELL_SET, 0));
+        }
+    }
+}
@@ -0,0 +1,60 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_CLIP_FILTER_H
+#define EAVL_CLIP_FILTER_H
+
+#include "STL.h"
+#include "eavlDataSet.h"
+#include "eavlCellSet.h"
+#include "eavlFilter.h"
+#include "eavlImplicitFunction.h"
+
+// ****************************************************************************
+// Class:  eavlClipFilter
+//
+// Purpose:
+///   Keep the part of a cell set where an implicit function (plane,
+///   sphere, box) is negative, or positive when inverted.  The function
+///   is evaluated at the cells' nodes as they are classified, so no
+///   distance field is stored.
+///
+///   Cells entirely on the kept side are passed through unchanged.  Cut
+///   3D cells are split into tets around their center, with quad faces
+///   split along the diagonal through their lowest node id so that
+///   neighboring cut cells agree; each tet then clips to a tet or a
+///   wedge.  Cut 2D cells are split into triangles the same way and clip
+///   to triangles or quads; lines clip to lines.
+///
+///   Output points are merged by the input node, edge or cell center
+///   they came from.  All components of every point field are
+///   interpolated onto them and the cell set's cell fields are copied to
+///   the sub-cells.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlClipFilter : public eavlFilter
+{
+  protected:
+    string cellsetname;
+    eavlImplicitFunction function;
+    bool invert;
+  public:
+    eavlClipFilter();
+    void SetCellSet(const string &name)
+    {
+        cellsetname = name;
+    }
+    void SetFunction(const eavlImplicitFunction &f)
+    {
+        function = f;
+    }
+    void SetInvert(bool inv)
+    {
+        invert = inv;
+    }
+
+    virtual void Execute();
+};
+
+#endif
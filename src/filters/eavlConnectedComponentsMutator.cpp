@@ -0,0 +1,416 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlConnectedComponentsMutator.h"
+#include "eavlCellComponents.h"
+#include "eavlShapeFunctions.h"
+#include "eavlException.h"
+#include "eavlTimer.h"
+
+// most sides of any cell: a 12-node triangle strip has 21 edges
+#define CC_MAX_SIDES 24
+
+// cells whose face neighbors are found by each parallel task
+#define CC_BLOCK_SIZE 4096
+
+template <int W>
+static void
+AddSides(const eavlCell &cell, signed char (*table)[W], int n,
+         int sides[][4], int sidesize[], int &nsides)
+{
+    for (int i=0; i<n; i++)
+    {
+        sidesize[nsides] = W;
+        for (int j=0; j<W; j++)
+            sides[nsides][j] = cell.indices[table[i][j]];
+        nsides++;
+    }
+}
+
+// ****************************************************************************
+// Function:  GetCellSides
+//
+// Purpose:
+///   List the sides of a cell as node lists: the faces of a volume cell,
+///   the edges of a surface cell, and the end nodes of a line cell.
+///   Two cells are face adjacent if all the nodes of a side of one of
+///   them are in the other.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+static int
+GetCellSides(const eavlCell &cell, int sides[CC_MAX_SIDES][4],
+             int sidesize[CC_MAX_SIDES])
+{
+    int n = 0;
+    int nn = cell.numIndices;
+    switch (cell.type)
+    {
+      case EAVL_TET:
+        AddSides(cell, eavlTetTriangleFaces, 4, sides, sidesize, n);
+        break;
+      case EAVL_PYRAMID:
+        AddSides(cell, eavlPyramidTriangleFaces, 4, sides, sidesize, n);
+        AddSides(cell, eavlPyramidQuadFaces, 1, sides, sidesize, n);
+        break;
+      case EAVL_WEDGE:
+        AddSides(cell, eavlWedgeTriangleFaces, 2, sides, sidesize, n);
+        AddSides(cell, eavlWedgeQuadFaces, 3, sides, sidesize, n);
+        break;
+      case EAVL_HEX:
+        AddSides(cell, eavlHexQuadFaces, 6, sides, sidesize, n);
+        break;
+      case EAVL_VOXEL:
+        AddSides(cell, eavlVoxQuadFaces, 6, sides, sidesize, n);
+        break;
+      case EAVL_TRI:
+        AddSides(cell, eavlTriEdges, 3, sides, sidesize, n);
+        break;
+      case EAVL_QUAD:
+        AddSides(cell, eavlQuadEdges, 4, sides, sidesize, n);
+        break;
+      case EAVL_PIXEL:
+        AddSides(cell, eavlPixelEdges, 4, sides, sidesize, n);
+        break;
+      case EAVL_POLYGON:
+        for (int i=0; i<nn; i++)
+        {
+            sidesize[n] = 2;
+            sides[n][0] = cell.indices[i];
+            sides[n][1] = cell.indices[(i+1) % nn];
+            n++;
+        }
+        break;
+      case EAVL_TRISTRIP:
+        // the edges of each triangle in the strip
+        for (int i=0; i+1<nn; i++)
+        {
+            sidesize[n] = 2;
+            sides[n][0] = cell.indices[i];
+            sides[n][1] = cell.indices[i+1];
+            n++;
+            if (i+2 < nn)
+            {
+                sidesize[n] = 2;
+                sides[n][0] = cell.indices[i];
+                sides[n][1] = cell.indices[i+2];
+                n++;
+            }
+        }
+        break;
+      case EAVL_BEAM:
+        if (nn > 0)
+        {
+            sidesize[n] = 1;
+            sides[n++][0] = cell.indices[0];
+            sidesize[n] = 1;
+            sides[n++][0] = cell.indices[nn-1];
+        }
+        break;
+      default:
+        for (int i=0; i<nn; i++)
+        {
+            sidesize[n] = 1;
+            sides[n++][0] = cell.indices[i];
+        }
+        break;
+    }
+    return n;
+}
+
+// ----------------------------------------------------------------------------
+// find the higher-numbered cells sharing a side with cell c, using the
+// cells around the least-used node of each side
+static void
+FindFaceNeighbors(eavlCellSet *cs, int c,
+                  const vector<int> &nodeCellStart,
+                  const vector<int> &nodeCells,
+                  vector<int> &neighbors)
+{
+    eavlCell cell = cs->GetCellNodes(c);
+    int sides[CC_MAX_SIDES][4], sidesize[CC_MAX_SIDES];
+    int nsides = GetCellSides(cell, sides, sidesize);
+
+    neighbors.clear();
+    for (int s=0; s<nsides; s++)
+    {
+        int best = sides[s][0];
+        for (int j=1; j<sidesize[s]; j++)
+        {
+            int node = sides[s][j];
+            if (nodeCellStart[node+1] - nodeCellStart[node] <
+                nodeCellStart[best+1] - nodeCellStart[best])
+                best = node;
+        }
+
+        for (int i=nodeCellStart[best]; i<nodeCellStart[best+1]; i++)
+        {
+            int d = nodeCells[i];
+            if (d <= c)
+                continue;
+            eavlCell other = cs->GetCellNodes(d);
+            bool shared = true;
+            for (int j=0; j<sidesize[s] && shared; j++)
+            {
+                shared = false;
+                for (int k=0; k<other.numIndices; k++)
+                {
+                    if (other.indices[k] == sides[s][j])
+                    {
+                        shared = true;
+                        break;
+                    }
+                }
+            }
+            if (!shared)
+                continue;
+
+            // several sides can match the same neighbor (e.g. the
+            // nodes of a line cell which shares both of them)
+            if (std::find(neighbors.begin(), neighbors.end(), d) ==
+                neighbors.end())
+                neighbors.push_back(d);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+static inline int
+ReadParent(const int *parent, int c)
+{
+    int p;
+#ifdef HAVE_OPENMP
+#pragma omp atomic read
+#endif
+    p = parent[c];
+    return p;
+}
+
+// find the root of a cell, halving the path on the way: each cell
+// visited is pointed at its grandparent.  The swap only moves a cell to
+// an ancestor, so it is safe against concurrent hooks and halvings, and
+// a lost swap just leaves that shortcut for a later search.
+static inline int
+FindRoot(int *parent, int c)
+{
+    while (true)
+    {
+        int p = ReadParent(parent, c);
+        if (p == c)
+            return c;
+        int gp = ReadParent(parent, p);
+        if (gp == p)
+            return p;
+        __sync_bool_compare_and_swap(&parent[c], p, gp);
+        c = gp;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// join the trees of cells a and b: the larger root is swapped over to
+// the smaller only if it is still a root, and if another thread got
+// there first, the new roots are found and the link retried
+static inline void
+Hook(int *parent, int a, int b)
+{
+    while (true)
+    {
+        a = FindRoot(parent, a);
+        b = FindRoot(parent, b);
+        if (a == b)
+            return;
+        int hi = (a > b) ? a : b;
+        int lo = (a > b) ? b : a;
+        if (__sync_bool_compare_and_swap(&parent[hi], hi, lo))
+            return;
+    }
+}
+
+eavlConnectedComponentsMutator::eavlConnectedComponentsMutator()
+    : prefix("component"), adjacency(NodeAdjacency)
+{
+}
+
+void
+eavlConnectedComponentsMutator::Execute()
+{
+    int cellSetIndex = dataset->GetCellSetIndex(cellsetname);
+    eavlCellSet *cs = dataset->GetCellSet(cellsetname);
+    int ncells = cs->GetNumCells();
+    int npts = dataset->GetNumPoints();
+
+    //
+    // the cells around each node
+    //
+    int th_adjacency = eavlTimer::Start();
+    vector<int> nodeCellStart(npts+1, 0);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int c = 0; c < ncells; c++)
+    {
+        eavlCell cell = cs->GetCellNodes(c);
+        for (int n=0; n<cell.numIndices; n++)
+        {
+#ifdef HAVE_OPENMP
+#pragma omp atomic
+#endif
+            nodeCellStart[cell.indices[n]+1]++;
+        }
+    }
+    for (int n=0; n<npts; n++)
+        nodeCellStart[n+1] += nodeCellStart[n];
+    vector<int> nodeCells(nodeCellStart[npts]);
+    {
+        // filled in cell order, so each node's list is sorted
+        vector<int> cursor(nodeCellStart.begin(), nodeCellStart.end()-1);
+        for (int c = 0; c < ncells; c++)
+        {
+            eavlCell cell = cs->GetCellNodes(c);
+            for (int n=0; n<cell.numIndices; n++)
+                nodeCells[cursor[cell.indices[n]]++] = c;
+        }
+    }
+
+    //
+    // for face adjacency, the side-sharing neighbors of each cell
+    //
+    vector<int> neighborStart, neighbors;
+    if (adjacency == FaceAdjacency)
+    {
+        // each block of cells keeps its neighbors in one list, which
+        // is copied into place once the counts are summed
+        int nblocks = (ncells + CC_BLOCK_SIZE - 1) / CC_BLOCK_SIZE;
+        vector<vector<int> > blockNeighbors(nblocks);
+        neighborStart.resize(ncells+1, 0);
+#ifdef HAVE_OPENMP
+#pragma omp parallel
+#endif
+        {
+            vector<int> found;
+#ifdef HAVE_OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+            for (int b = 0; b < nblocks; b++)
+            {
+                int end = std::min(ncells, (b+1) * CC_BLOCK_SIZE);
+                for (int c = b * CC_BLOCK_SIZE; c < end; c++)
+                {
+                    FindFaceNeighbors(cs, c, nodeCellStart, nodeCells, found);
+                    neighborStart[c+1] = found.size();
+                    blockNeighbors[b].insert(blockNeighbors[b].end(),
+                                             found.begin(), found.end());
+                }
+            }
+        }
+        for (int c=0; c<ncells; c++)
+            neighborStart[c+1] += neighborStart[c];
+        neighbors.resize(neighborStart[ncells]);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (int b = 0; b < nblocks; b++)
+        {
+            std::copy(blockNeighbors[b].begin(), blockNeighbors[b].end(),
+                      neighbors.begin() + neighborStart[b * CC_BLOCK_SIZE]);
+            vector<int>().swap(blockNeighbors[b]);
+        }
+    }
+    eavlTimer::Stop(th_adjacency, "connected components adjacency");
+
+    //
+    // union-find: link every adjacent pair, then find each cell's root
+    //
+    int th_union = eavlTimer::Start();
+    vector<int> parentv(ncells);
+    int *parent = ncells ? &(parentv[0]) : NULL;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int c = 0; c < ncells; c++)
+        parent[c] = c;
+
+    if (adjacency == NodeAdjacency)
+    {
+#ifdef HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for (int n = 0; n < npts; n++)
+        {
+            for (int i=nodeCellStart[n]+1; i<nodeCellStart[n+1]; i++)
+                Hook(parent, nodeCells[nodeCellStart[n]], nodeCells[i]);
+        }
+    }
+    else
+    {
+#ifdef HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1024)
+#endif
+        for (int c = 0; c < ncells; c++)
+        {
+            for (int i=neighborStart[c]; i<neighborStart[c+1]; i++)
+                Hook(parent, c, neighbors[i]);
+        }
+    }
+
+    // pointer jumping: with the trees complete, point every cell at its
+    // grandparent until each one points at its root
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for reduction(||:changed)
+#endif
+        for (int c = 0; c < ncells; c++)
+        {
+            int p = ReadParent(parent, c);
+            int gp = ReadParent(parent, p);
+            if (gp != p)
+            {
+#ifdef HAVE_OPENMP
+#pragma omp atomic write
+#endif
+                parent[c] = gp;
+                changed = true;
+            }
+        }
+    }
+    const vector<int> &root = parentv;
+    eavlTimer::Stop(th_union, "connected components union-find");
+
+    //
+    // number the roots, which are the lowest cell of each component
+    //
+    vector<int> label(ncells, -1);
+    int ncomponents = 0;
+    for (int c=0; c<ncells; c++)
+    {
+        if (root[c] == c)
+            label[c] = ncomponents++;
+    }
+
+    eavlIntArray *ids = new eavlIntArray(prefix + "_id", 1, ncells);
+    eavlIntArray *counts = new eavlIntArray(prefix + "_cell_count", 1,
+                                            ncomponents);
+    int *idp = (int*)ids->GetHostArray();
+    int *countp = (int*)counts->GetHostArray();
+    for (int i=0; i<ncomponents; i++)
+        countp[i] = 0;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int c = 0; c < ncells; c++)
+    {
+        int id = label[root[c]];
+        idp[c] = id;
+#ifdef HAVE_OPENMP
+#pragma omp atomic
+#endif
+        countp[id]++;
+    }
+
+    dataset->AddField(new eavlField(0, ids, eavlField::ASSOC_CELL_SET,
+                                    cellSetIndex));
+    dataset->AddField(new eavlField(0, counts, eavlField::ASSOC_WHOLEMESH));
+}
@@ -0,0 +1,59 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_CONNECTED_COMPONENTS_MUTATOR_H
+#define EAVL_CONNECTED_COMPONENTS_MUTATOR_H
+
+#include "STL.h"
+#include "eavlFilter.h"
+
+// ****************************************************************************
+// Class:  eavlConnectedComponentsMutator
+//
+// Purpose:
+///   Label the connected pieces of a cell set.  Cells are connected if
+///   they share a node, or with face adjacency, if they share a whole
+///   side: a face for volume cells, an edge for surface cells, and a
+///   node for line cells.
+///
+///   Adds an integer field "<prefix>_id" on the cell set numbering the
+///   components from 0, in order of their lowest cell index, and a
+///   whole-mesh field "<prefix>_cell_count" holding the number of cells
+///   in each component.  The prefix defaults to "component".
+///
+///   Components are found with a parallel union-find over the cells.
+///   Each adjacency links the larger of the two roots onto the smaller
+///   with a compare-and-swap, retrying from the new roots if another
+///   thread linked one of them first, so one pass joins everything.
+///   Root searches halve the paths they walk, and pointer-jumping
+///   rounds then point every cell directly at its root.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlConnectedComponentsMutator : public eavlMutator
+{
+  public:
+    enum Adjacency { NodeAdjacency, FaceAdjacency };
+  protected:
+    string    cellsetname;
+    string    prefix;
+    Adjacency adjacency;
+  public:
+    eavlConnectedComponentsMutator();
+    void SetCellSet(const string &name)
+    {
+        cellsetname = name;
+    }
+    void SetAdjacency(Adjacency a)
+    {
+        adjacency = a;
+    }
+    void SetResultPrefix(const string &p)
+    {
+        prefix = p;
+    }
+
+    virtual void Execute();
+};
+
+#endif
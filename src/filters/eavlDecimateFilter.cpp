@@ -0,0 +1,629 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlDecimateFilter.h"
+#include "eavlCellSetExplicit.h"
+#include "eavlCoordinates.h"
+#include "eavlNodePositions.h"
+#include "eavlException.h"
+#include "eavlTimer.h"
+
+#include <cfloat>
+#include <cmath>
+
+// finest grid we'll search, in bins along the longest axis
+#define DECIMATE_MAX_DIVISIONS 8192
+
+// ----------------------------------------------------------------------------
+// split a surface cell into triangles, keeping its orientation
+static int
+GetCellTriangles(const eavlCell &cell, int tris[12][3])
+{
+    int n = 0;
+    switch (cell.type)
+    {
+      case EAVL_TRI:
+      case EAVL_QUAD:
+      case EAVL_POLYGON:
+        for (int t=0; t+2<cell.numIndices; t++)
+        {
+            tris[n][0] = cell.indices[0];
+            tris[n][1] = cell.indices[t+1];
+            tris[n][2] = cell.indices[t+2];
+            n++;
+        }
+        break;
+      case EAVL_PIXEL:
+        tris[0][0] = cell.indices[0];
+        tris[0][1] = cell.indices[1];
+        tris[0][2] = cell.indices[3];
+        tris[1][0] = cell.indices[0];
+        tris[1][1] = cell.indices[3];
+        tris[1][2] = cell.indices[2];
+        n = 2;
+        break;
+      case EAVL_TRISTRIP:
+        for (int t=0; t+2<cell.numIndices; t++)
+        {
+            // every other triangle is flipped
+            tris[n][0] = cell.indices[t + (t%2)];
+            tris[n][1] = cell.indices[t + 1 - (t%2)];
+            tris[n][2] = cell.indices[t + 2];
+            n++;
+        }
+        break;
+      default:
+        break;
+    }
+    return n;
+}
+
+// ----------------------------------------------------------------------------
+// eigenvalues w and eigenvectors (the columns of V) of a symmetric 3x3
+// matrix, by Jacobi rotations; A is destroyed
+static void
+SymmetricEigen(double A[3][3], double w[3], double V[3][3])
+{
+    for (int i=0; i<3; i++)
+        for (int j=0; j<3; j++)
+            V[i][j] = (i == j) ? 1 : 0;
+
+    for (int sweep = 0; sweep < 50; sweep++)
+    {
+        double off = A[0][1]*A[0][1] + A[0][2]*A[0][2] + A[1][2]*A[1][2];
+        double diag = A[0][0]*A[0][0] + A[1][1]*A[1][1] + A[2][2]*A[2][2];
+        if (off <= 1.e-24 * diag)
+            break;
+        for (int p=0; p<2; p++)
+        {
+            for (int q=p+1; q<3; q++)
+            {
+                if (A[p][q] == 0)
+                    continue;
+                double theta = (A[q][q] - A[p][p]) / (2. * A[p][q]);
+                double t = 1. / (fabs(theta) + sqrt(theta*theta + 1.));
+                if (theta < 0)
+                    t = -t;
+                double c = 1. / sqrt(t*t + 1.);
+                double s = t * c;
+                for (int k=0; k<3; k++)
+                {
+                    double akp = A[k][p], akq = A[k][q];
+                    A[k][p] = c*akp - s*akq;
+                    A[k][q] = s*akp + c*akq;
+                }
+                for (int k=0; k<3; k++)
+                {
+                    double apk = A[p][k], aqk = A[q][k];
+                    A[p][k] = c*apk - s*aqk;
+                    A[q][k] = s*apk + c*aqk;
+                }
+                for (int k=0; k<3; k++)
+                {
+                    double vkp = V[k][p], vkq = V[k][q];
+                    V[k][p] = c*vkp - s*vkq;
+                    V[k][q] = s*vkp + c*vkq;
+                }
+            }
+        }
+    }
+    for (int i=0; i<3; i++)
+        w[i] = A[i][i];
+}
+
+// ****************************************************************************
+// Function:  MinimizeQuadric
+//
+// Purpose:
+///   Find the point minimizing x'Ax + 2b'x, given A as (A00, A01, A02,
+///   A11, A12, A22) and b in q[0..8].  Directions in which A is nearly
+///   singular (e.g. along a flat or creased surface) are left at the
+///   given starting point, so the result is the point nearest it among
+///   the minima.  Returns false if A is entirely zero.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+static bool
+MinimizeQuadric(const double *q, const double start[3], double x[3])
+{
+    double A[3][3] = {{q[0], q[1], q[2]},
+                      {q[1], q[3], q[4]},
+                      {q[2], q[4], q[5]}};
+    // residual of A x = -b at the starting point
+    double r[3];
+    for (int i=0; i<3; i++)
+        r[i] = -(A[i][0]*start[0] + A[i][1]*start[1] + A[i][2]*start[2] +
+                 q[6+i]);
+
+    double w[3], V[3][3];
+    SymmetricEigen(A, w, V);
+    double wmax = fabs(w[0]);
+    if (fabs(w[1]) > wmax)
+        wmax = fabs(w[1]);
+    if (fabs(w[2]) > wmax)
+        wmax = fabs(w[2]);
+    if (!(wmax > 0))
+        return false;
+
+    for (int i=0; i<3; i++)
+        x[i] = start[i];
+    for (int e=0; e<3; e++)
+    {
+        if (fabs(w[e]) < 1.e-3 * wmax)
+            continue;
+        double proj = (V[0][e]*r[0] + V[1][e]*r[1] + V[2][e]*r[2]) / w[e];
+        for (int i=0; i<3; i++)
+            x[i] += proj * V[i][e];
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// a uniform grid of cubical bins over a box
+struct eavlDecimateGrid
+{
+    double origin[3];
+    double size;
+    int    dims[3];
+
+    eavlDecimateGrid(const double lo[3], const double hi[3], int divisions)
+    {
+        double ext = 0;
+        for (int d=0; d<3; d++)
+        {
+            origin[d] = lo[d];
+            if (hi[d] - lo[d] > ext)
+                ext = hi[d] - lo[d];
+        }
+        if (!(ext > 0))
+            ext = 1;
+        size = ext / double(divisions);
+        for (int d=0; d<3; d++)
+        {
+            int n = int(ceil((hi[d] - lo[d]) / size));
+            dims[d] = (n < 1) ? 1 : n;
+        }
+    }
+    long long GetBin(const float *p) const
+    {
+        int ijk[3];
+        for (int d=0; d<3; d++)
+        {
+            int i = int(floor((p[d] - origin[d]) / size));
+            ijk[d] = (i < 0) ? 0 : ((i >= dims[d]) ? dims[d]-1 : i);
+        }
+        return ((long long)ijk[2]*dims[1] + ijk[1])*dims[0] + ijk[0];
+    }
+};
+
+// ----------------------------------------------------------------------------
+// bin every point, and count the triangles left with corners in three
+// different bins
+static int
+BinPoints(const eavlDecimateGrid &grid, int npts, const vector<float> &pts,
+          int ntris, const vector<int> &tris, vector<long long> &bins)
+{
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < npts; i++)
+        bins[i] = grid.GetBin(&(pts[3*i]));
+
+    int count = 0;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for reduction(+:count)
+#endif
+    for (int t = 0; t < ntris; t++)
+    {
+        long long a = bins[tris[3*t+0]];
+        long long b = bins[tris[3*t+1]];
+        long long c = bins[tris[3*t+2]];
+        if (a != b && b != c && a != c)
+            count++;
+    }
+    return count;
+}
+
+struct eavlDecimateTriangle
+{
+    int v[3];
+    bool operator<(const eavlDecimateTriangle &o) const
+    {
+        if (v[0] != o.v[0])
+            return v[0] < o.v[0];
+        if (v[1] != o.v[1])
+            return v[1] < o.v[1];
+        return v[2] < o.v[2];
+    }
+    bool operator==(const eavlDecimateTriangle &o) const
+    {
+        return v[0] == o.v[0] && v[1] == o.v[1] && v[2] == o.v[2];
+    }
+};
+
+eavlDecimateFilter::eavlDecimateFilter()
+    : divisions(256), targettriangles(0)
+{
+}
+
+void
+eavlDecimateFilter::Execute()
+{
+    eavlCellSet *inCells = input->GetCellSet(cellsetname);
+    if (inCells->GetDimensionality() != 2)
+        THROW(eavlException,"eavlDecimateFilter expects a surface cell set");
+    if (targettriangles <= 0 && divisions <= 0)
+        THROW(eavlException,"eavlDecimateFilter needs a number of divisions or a target triangle count");
+
+    //
+    // cache the points and split the cells into triangles
+    //
+    int th_setup = eavlTimer::Start();
+    int npts = input->GetNumPoints();
+    vector<float> pts(3*npts);
+    eavlNodePositions positions(input);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < npts; i++)
+        positions.Get(i, pts[3*i+0], pts[3*i+1], pts[3*i+2]);
+
+    int ncells = inCells->GetNumCells();
+    vector<int> triStart(ncells+1, 0);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int c = 0; c < ncells; c++)
+    {
+        int t[12][3];
+        triStart[c+1] = GetCellTriangles(inCells->GetCellNodes(c), t);
+    }
+    for (int c=0; c<ncells; c++)
+        triStart[c+1] += triStart[c];
+    int ntris = triStart[ncells];
+    vector<int> tris(3*ntris);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int c = 0; c < ncells; c++)
+    {
+        int t[12][3];
+        int n = GetCellTriangles(inCells->GetCellNodes(c), t);
+        for (int i=0; i<n; i++)
+            for (int j=0; j<3; j++)
+                tris[3*(triStart[c]+i) + j] = t[i][j];
+    }
+
+    // bounds of the points used by the triangles
+    vector<bool> used(npts, false);
+    for (int i=0; i<3*ntris; i++)
+        used[tris[i]] = true;
+    double lo[3], hi[3];
+    for (int d=0; d<3; d++)
+    {
+        lo[d] = +DBL_MAX;
+        hi[d] = -DBL_MAX;
+    }
+    for (int i=0; i<npts; i++)
+    {
+        if (!used[i])
+            continue;
+        for (int d=0; d<3; d++)
+        {
+            if (pts[3*i+d] < lo[d])
+                lo[d] = pts[3*i+d];
+            if (pts[3*i+d] > hi[d])
+                hi[d] = pts[3*i+d];
+        }
+    }
+    if (ntris == 0)
+    {
+        for (int d=0; d<3; d++)
+            lo[d] = hi[d] = 0;
+    }
+    eavlTimer::Stop(th_setup, "decimate setup");
+
+    //
+    // pick the grid: for a target, double the resolution until the
+    // result is too big, then bisect for the finest which fits
+    //
+    int th_grid = eavlTimer::Start();
+    vector<long long> bins(npts);
+    int res = divisions;
+    if (targettriangles > 0)
+    {
+        int good = 1, bad = 0;
+        for (int r = 2; ; r *= 2)
+        {
+            if (r > DECIMATE_MAX_DIVISIONS)
+                break;
+            eavlDecimateGrid g(lo, hi, r);
+            if (BinPoints(g, npts, pts, ntris, tris, bins) > targettriangles)
+            {
+                bad = r;
+                break;
+            }
+            good = r;
+        }
+        while (bad > 0 && bad - good > 1)
+        {
+            int mid = (good + bad) / 2;
+            eavlDecimateGrid g(lo, hi, mid);
+            if (BinPoints(g, npts, pts, ntris, tris, bins) > targettriangles)
+                bad = mid;
+            else
+                good = mid;
+        }
+        res = good;
+    }
+    eavlDecimateGrid grid(lo, hi, res);
+    BinPoints(grid, npts, pts, ntris, tris, bins);
+    eavlTimer::Stop(th_grid, "decimate choose grid");
+
+    //
+    // number the occupied bins ("clusters"), with the points of each
+    // one contiguous in sorted order
+    //
+    int th_cluster = eavlTimer::Start();
+    vector<pair<long long,int> > order;
+    order.reserve(npts);
+    for (int i=0; i<npts; i++)
+    {
+        if (used[i])
+            order.push_back(pair<long long,int>(bins[i], i));
+    }
+    std::sort(order.begin(), order.end());
+    int nused = order.size();
+    vector<int> pointCluster(npts, -1);
+    vector<int> clusterStart;
+    for (int i=0; i<nused; i++)
+    {
+        if (i == 0 || order[i].first != order[i-1].first)
+            clusterStart.push_back(i);
+        pointCluster[order[i].second] = clusterStart.size() - 1;
+    }
+    int nclusters = clusterStart.size();
+    clusterStart.push_back(nused);
+
+    //
+    // the area-weighted plane quadric of each triangle
+    //
+    vector<double> triQuadrics(10*ntris, 0.);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int t = 0; t < ntris; t++)
+    {
+        const float *p0 = &(pts[3*tris[3*t+0]]);
+        const float *p1 = &(pts[3*tris[3*t+1]]);
+        const float *p2 = &(pts[3*tris[3*t+2]]);
+        double e1[3], e2[3], n[3];
+        for (int d=0; d<3; d++)
+        {
+            e1[d] = p1[d] - p0[d];
+            e2[d] = p2[d] - p0[d];
+        }
+        n[0] = e1[1]*e2[2] - e1[2]*e2[1];
+        n[1] = e1[2]*e2[0] - e1[0]*e2[2];
+        n[2] = e1[0]*e2[1] - e1[1]*e2[0];
+        double len = sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+        if (!(len > 0))
+            continue;
+        for (int d=0; d<3; d++)
+            n[d] /= len;
+        double area = 0.5 * len;
+        double dist = -(n[0]*p0[0] + n[1]*p0[1] + n[2]*p0[2]);
+        double q[10] = {n[0]*n[0], n[0]*n[1], n[0]*n[2],
+                        n[1]*n[1], n[1]*n[2], n[2]*n[2],
+                        dist*n[0], dist*n[1], dist*n[2], dist*dist};
+        for (int k=0; k<10; k++)
+            triQuadrics[10*t+k] = area * q[k];
+    }
+
+    //
+    // sum them around each cluster; the triangle corners are bucketed
+    // by cluster in triangle order, so every cluster adds up its
+    // triangles in the same order whatever the thread count
+    //
+    vector<int> cornerStart(nclusters+1, 0);
+    for (int i = 0; i < 3*ntris; i++)
+        cornerStart[pointCluster[tris[i]]+1]++;
+    for (int c = 0; c < nclusters; c++)
+        cornerStart[c+1] += cornerStart[c];
+    vector<int> cornerTri(3*ntris);
+    {
+        vector<int> fill(cornerStart.begin(), cornerStart.end()-1);
+        for (int i = 0; i < 3*ntris; i++)
+            cornerTri[fill[pointCluster[tris[i]]]++] = i / 3;
+    }
+    vector<double> quadrics(10*nclusters, 0.);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int c = 0; c < nclusters; c++)
+    {
+        double *cq = &(quadrics[10*c]);
+        for (int i = cornerStart[c]; i < cornerStart[c+1]; i++)
+        {
+            const double *tq = &(triQuadrics[10*cornerTri[i]]);
+            for (int k=0; k<10; k++)
+                cq[k] += tq[k];
+        }
+    }
+
+    //
+    // place each cluster's point at the minimum of its quadric, if that
+    // lies near its bin, and otherwise at the average of its points
+    //
+    vector<float> clusterPts(3*nclusters);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int c = 0; c < nclusters; c++)
+    {
+        double mean[3] = {0, 0, 0};
+        int n = clusterStart[c+1] - clusterStart[c];
+        for (int i=clusterStart[c]; i<clusterStart[c+1]; i++)
+            for (int d=0; d<3; d++)
+                mean[d] += pts[3*order[i].second + d];
+        for (int d=0; d<3; d++)
+            mean[d] /= double(n);
+
+        double x[3];
+        bool ok = (n > 1) && MinimizeQuadric(&(quadrics[10*c]), mean, x);
+        if (ok)
+        {
+            long long bin = order[clusterStart[c]].first;
+            int ijk[3];
+            ijk[0] = bin % grid.dims[0];
+            ijk[1] = (bin / grid.dims[0]) % grid.dims[1];
+            ijk[2] = bin / ((long long)grid.dims[0] * grid.dims[1]);
+            for (int d=0; d<3; d++)
+            {
+                double blo = grid.origin[d] + (ijk[d] - 0.5) * grid.size;
+                double bhi = grid.origin[d] + (ijk[d] + 1.5) * grid.size;
+                if (!(x[d] >= blo && x[d] <= bhi))
+                    ok = false;
+            }
+        }
+        for (int d=0; d<3; d++)
+            clusterPts[3*c+d] = ok ? x[d] : mean[d];
+    }
+    eavlTimer::Stop(th_cluster, "decimate cluster points");
+
+    //
+    // keep the triangles with three different clusters, rotated so the
+    // lowest comes first, and drop repeats
+    //
+    int th_tris = eavlTimer::Start();
+    vector<eavlDecimateTriangle> outTris;
+    outTris.reserve(ntris / 4);
+    for (int t=0; t<ntris; t++)
+    {
+        int a = pointCluster[tris[3*t+0]];
+        int b = pointCluster[tris[3*t+1]];
+        int c = pointCluster[tris[3*t+2]];
+        if (a == b || b == c || a == c)
+            continue;
+        eavlDecimateTriangle tri;
+        if (a < b && a < c)
+        {
+            tri.v[0] = a; tri.v[1] = b; tri.v[2] = c;
+        }
+        else if (b < c)
+        {
+            tri.v[0] = b; tri.v[1] = c; tri.v[2] = a;
+        }
+        else
+        {
+            tri.v[0] = c; tri.v[1] = a; tri.v[2] = b;
+        }
+        outTris.push_back(tri);
+    }
+    std::sort(outTris.begin(), outTris.end());
+    outTris.erase(std::unique(outTris.begin(), outTris.end()),
+                  outTris.end());
+    int noutTris = outTris.size();
+
+    // keep only the clusters the remaining triangles use
+    vector<int> outIndex(nclusters+1, 0);
+    for (int t=0; t<noutTris; t++)
+        for (int j=0; j<3; j++)
+            outIndex[outTris[t].v[j]+1] = 1;
+    for (int c=0; c<nclusters; c++)
+        outIndex[c+1] += outIndex[c];
+    int noutPts = outIndex[nclusters];
+    vector<int> outCluster(noutPts);
+    for (int c=0; c<nclusters; c++)
+    {
+        if (outIndex[c+1] > outIndex[c])
+            outCluster[outIndex[c]] = c;
+    }
+    eavlTimer::Stop(th_tris, "decimate triangles");
+
+    //
+    // set up the output mesh
+    //
+    int th_output = eavlTimer::Start();
+    output->SetNumPoints(noutPts);
+
+    eavlFloatArray *coords = new eavlFloatArray("coords", 3, noutPts);
+    float *coordsp = (float*)coords->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < noutPts; i++)
+        for (int d=0; d<3; d++)
+            coordsp[3*i+d] = clusterPts[3*outCluster[i]+d];
+    output->AddField(new eavlField(1, coords, eavlField::ASSOC_POINTS));
+
+    eavlExplicitConnectivity conn;
+    for (int t=0; t<noutTris; t++)
+    {
+        int ids[3];
+        for (int j=0; j<3; j++)
+            ids[j] = outIndex[outTris[t].v[j]];
+        conn.AddElement(EAVL_TRI, 3, ids);
+    }
+    eavlCellSetExplicit *outCellSet = new eavlCellSetExplicit(cellsetname, 2);
+    outCellSet->SetCellNodeConnectivity(conn);
+    output->AddCellSet(outCellSet);
+
+    eavlCoordinatesCartesian *coordsys =
+        new eavlCoordinatesCartesian(NULL,
+                                     eavlCoordinatesCartesian::X,
+                                     eavlCoordinatesCartesian::Y,
+                                     eavlCoordinatesCartesian::Z);
+    coordsys->SetAxis(0, new eavlCoordinateAxisField("coords", 0));
+    coordsys->SetAxis(1, new eavlCoordinateAxisField("coords", 1));
+    coordsys->SetAxis(2, new eavlCoordinateAxisField("coords", 2));
+    output->AddCoordinateSystem(coordsys);
+
+    //
+    // average the point fields over each cluster, skipping the input
+    // coordinates
+    //
+    vector<string> coordFieldNames;
+    eavlCoordinates *cs = input->GetCoordinateSystem(0);
+    for (int d=0; d<cs->GetDimension(); d++)
+    {
+        eavlCoordinateAxisField *axis =
+            dynamic_cast<eavlCoordinateAxisField*>(cs->GetAxis(d));
+        if (axis)
+            coordFieldNames.push_back(axis->GetFieldName());
+    }
+
+    for (int f=0; f<input->GetNumFields(); f++)
+    {
+        eavlField *field = input->GetField(f);
+        if (field->GetAssociation() != eavlField::ASSOC_POINTS)
+            continue;
+        eavlArray *a = field->GetArray();
+        if (std::find(coordFieldNames.begin(), coordFieldNames.end(),
+                      a->GetName()) != coordFieldNames.end() ||
+            a->GetName() == "coords")
+            continue;
+
+        int nc = a->GetNumberOfComponents();
+        eavlFloatArray *out = new eavlFloatArray(a->GetName(), nc, noutPts);
+        float *outp = (float*)out->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int i = 0; i < noutPts; i++)
+        {
+            int c = outCluster[i];
+            int n = clusterStart[c+1] - clusterStart[c];
+            for (int k=0; k<nc; k++)
+            {
+                double sum = 0;
+                for (int j=clusterStart[c]; j<clusterStart[c+1]; j++)
+                    sum += a->GetComponentAsDouble(order[j].second, k);
+                outp[i*nc+k] = sum / double(n);
+            }
+        }
+        output->AddField(new eavlField(field->GetOrder(), out,
+                                       eavlField::ASSOC_POINTS));
+    }
+    eavlTimer::Stop(th_output, "decimate output");
+}
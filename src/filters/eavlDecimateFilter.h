@@ -0,0 +1,63 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_DECIMATE_FILTER_H
+#define EAVL_DECIMATE_FILTER_H
+
+#include "STL.h"
+#include "eavlDataSet.h"
+#include "eavlCellSet.h"
+#include "eavlFilter.h"
+
+// ****************************************************************************
+// Class:  eavlDecimateFilter
+//
+// Purpose:
+///   Reduce a surface by vertex clustering.  The surface's bounding box
+///   is divided into a uniform grid of cubical bins, all the points in
+///   a bin are merged into one, and triangles which collapse (or which
+///   duplicate another) are dropped.  Each merged point is placed where
+///   it best fits the planes of the triangles around it, i.e. at the
+///   minimum of their summed quadric error, falling back to the average
+///   position of the merged points where that is ill-determined.
+///
+///   The grid can be given by the number of bins along the longest axis
+///   of the bounds, or chosen as the finest grid whose result fits
+///   within a target number of triangles.
+///
+///   The input cell set may hold any surface cells; they are split into
+///   triangles first.  The output is an explicit cell set of triangles
+///   with the same name, and every point field of the input, averaged
+///   over each bin's points.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlDecimateFilter : public eavlFilter
+{
+  protected:
+    string cellsetname;
+    int    divisions;
+    int    targettriangles;
+  public:
+    eavlDecimateFilter();
+    void SetCellSet(const string &name)
+    {
+        cellsetname = name;
+    }
+    /// The number of bins along the longest axis of the bounds; ignored
+    /// if a target triangle count is set.
+    void SetDivisions(int n)
+    {
+        divisions = n;
+    }
+    /// Choose the grid so the result has at most this many triangles;
+    /// 0 means use the given number of divisions.
+    void SetTargetTriangles(int n)
+    {
+        targettriangles = n;
+    }
+
+    virtual void Execute();
+};
+
+#endif
@@ -0,0 +1,350 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlExpressionMutator.h"
+#include "eavlException.h"
+#include "eavlExecutor.h"
+#include "eavlExpressionMapOp.h"
+
+// ****************************************************************************
+// Class:  ExpressionCompiler
+//
+// Purpose:
+///   A recursive-descent parser for field expressions which emits the
+///   postfix instructions of an eavlExpressionProgram as it goes.  Each
+///   distinct field and component used becomes one input of the program.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class ExpressionCompiler
+{
+  public:
+    eavlExpressionProgram            program;
+    vector<eavlArrayWithLinearIndex> inputs;
+    vector<eavlField*>               fields;
+
+  protected:
+    eavlDataSet            *ds;
+    string                  text;
+    size_t                  pos;
+    int                     depth;
+    vector<pair<int,int> >  inputKeys; // (field index, component)
+
+  public:
+    ExpressionCompiler(eavlDataSet *data, const string &expr)
+        : ds(data), text(expr), pos(0), depth(0)
+    {
+        ParseSum();
+        SkipSpace();
+        if (pos < text.size())
+            Error("unexpected '" + text.substr(pos, 1) + "'");
+    }
+
+  protected:
+    void Error(const string &msg)
+    {
+        ostringstream out;
+        out << "In expression \"" << text << "\" at position " << pos
+            << ": " << msg;
+        THROW(eavlException, out.str());
+    }
+
+    void SkipSpace()
+    {
+        while (pos < text.size() && isspace(text[pos]))
+            pos++;
+    }
+
+    bool Accept(char c)
+    {
+        SkipSpace();
+        if (pos < text.size() && text[pos] == c)
+        {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+
+    void Expect(char c)
+    {
+        if (!Accept(c))
+            Error(string("expected '") + c + "'");
+    }
+
+    void Emit(int op, int input = 0, float constant = 0)
+    {
+        if (program.ninstructions >= EAVL_EXPRESSION_MAX_INSTRUCTIONS)
+            Error("expression is too long");
+        int k = program.ninstructions++;
+        program.opcode[k] = op;
+        program.input[k] = input;
+        program.constant[k] = constant;
+
+        if (op == eavlExpressionProgram::PushConstant ||
+            op == eavlExpressionProgram::PushInput)
+        {
+            if (++depth > EAVL_EXPRESSION_MAX_STACK)
+                Error("expression is nested too deeply");
+        }
+        else if (!eavlExpressionProgram::IsUnary(op))
+        {
+            --depth;
+        }
+    }
+
+    // sum := product (('+'|'-') product)*
+    void ParseSum()
+    {
+        ParseProduct();
+        while (true)
+        {
+            if (Accept('+'))
+            {
+                ParseProduct();
+                Emit(eavlExpressionProgram::Add);
+            }
+            else if (Accept('-'))
+            {
+                ParseProduct();
+                Emit(eavlExpressionProgram::Subtract);
+            }
+            else
+                break;
+        }
+    }
+
+    // product := unary (('*'|'/') unary)*
+    void ParseProduct()
+    {
+        ParseUnary();
+        while (true)
+        {
+            if (Accept('*'))
+            {
+                ParseUnary();
+                Emit(eavlExpressionProgram::Multiply);
+            }
+            else if (Accept('/'))
+            {
+                ParseUnary();
+                Emit(eavlExpressionProgram::Divide);
+            }
+            else
+                break;
+        }
+    }
+
+    // unary := ('-'|'+') unary | power
+    void ParseUnary()
+    {
+        if (Accept('-'))
+        {
+            ParseUnary();
+            Emit(eavlExpressionProgram::Negate);
+        }
+        else if (Accept('+'))
+        {
+            ParseUnary();
+        }
+        else
+        {
+            ParsePower();
+        }
+    }
+
+    // power := primary ('^' unary)?
+    // (so -a^2 is -(a^2), and a^b^c is a^(b^c))
+    void ParsePower()
+    {
+        ParsePrimary();
+        if (Accept('^'))
+        {
+            ParseUnary();
+            Emit(eavlExpressionProgram::Power);
+        }
+    }
+
+    // primary := number | '(' sum ')' | function '(' sum [',' sum] ')'
+    //          | field ['[' component ']']
+    void ParsePrimary()
+    {
+        SkipSpace();
+        if (pos >= text.size())
+            Error("unexpected end of expression");
+
+        char c = text[pos];
+        if (Accept('('))
+        {
+            ParseSum();
+            Expect(')');
+        }
+        else if (isdigit(c) || c == '.')
+        {
+            const char *start = text.c_str() + pos;
+            char *end;
+            double value = strtod(start, &end);
+            if (end == start)
+                Error("expected a number");
+            pos += end - start;
+            Emit(eavlExpressionProgram::PushConstant, 0, value);
+        }
+        else if (c == '"')
+        {
+            size_t end = text.find('"', pos+1);
+            if (end == string::npos)
+                Error("unterminated quoted field name");
+            string name = text.substr(pos+1, end-pos-1);
+            pos = end+1;
+            ParseField(name);
+        }
+        else if (isalpha(c) || c == '_')
+        {
+            size_t start = pos;
+            while (pos < text.size() && (isalnum(text[pos]) || text[pos] == '_'))
+                pos++;
+            string name = text.substr(start, pos-start);
+            SkipSpace();
+            if (pos < text.size() && text[pos] == '(')
+                ParseFunction(name);
+            else
+                ParseField(name);
+        }
+        else
+        {
+            Error(string("unexpected '") + c + "'");
+        }
+    }
+
+    void ParseFunction(const string &name)
+    {
+        static const struct { const char *name; int op; int nargs; } functions[] =
+        {
+            {"sqrt",  eavlExpressionProgram::Sqrt,  1},
+            {"abs",   eavlExpressionProgram::Abs,   1},
+            {"exp",   eavlExpressionProgram::Exp,   1},
+            {"ln",    eavlExpressionProgram::Ln,    1},
+            {"log",   eavlExpressionProgram::Ln,    1},
+            {"log10", eavlExpressionProgram::Log10, 1},
+            {"log2",  eavlExpressionProgram::Log2,  1},
+            {"sin",   eavlExpressionProgram::Sin,   1},
+            {"cos",   eavlExpressionProgram::Cos,   1},
+            {"tan",   eavlExpressionProgram::Tan,   1},
+            {"asin",  eavlExpressionProgram::Asin,  1},
+            {"acos",  eavlExpressionProgram::Acos,  1},
+            {"atan",  eavlExpressionProgram::Atan,  1},
+            {"min",   eavlExpressionProgram::Min,   2},
+            {"max",   eavlExpressionProgram::Max,   2},
+            {"pow",   eavlExpressionProgram::Power, 2},
+            {"atan2", eavlExpressionProgram::Atan2, 2}
+        };
+        int nfunctions = sizeof(functions) / sizeof(functions[0]);
+
+        for (int i=0; i<nfunctions; i++)
+        {
+            if (name != functions[i].name)
+                continue;
+            Expect('(');
+            ParseSum();
+            for (int a=1; a<functions[i].nargs; a++)
+            {
+                Expect(',');
+                ParseSum();
+            }
+            Expect(')');
+            Emit(functions[i].op);
+            return;
+        }
+        Error("unknown function '" + name + "'");
+    }
+
+    void ParseField(const string &name)
+    {
+        int index = ds->GetFieldIndex(name);
+        if (index < 0)
+            Error("unknown field '" + name + "'");
+        eavlField *f = ds->GetField(index);
+        int ncomp = f->GetArray()->GetNumberOfComponents();
+
+        int component = 0;
+        if (Accept('['))
+        {
+            SkipSpace();
+            const char *start = text.c_str() + pos;
+            char *end;
+            component = strtol(start, &end, 10);
+            if (end == start)
+                Error("expected a component index");
+            pos += end - start;
+            Expect(']');
+            if (component < 0 || component >= ncomp)
+                Error("component out of range for field '" + name + "'");
+        }
+        else if (ncomp != 1)
+        {
+            Error("field '" + name + "' has multiple components; "
+                  "select one with [component]");
+        }
+
+        pair<int,int> key(index, component);
+        size_t k = std::find(inputKeys.begin(), inputKeys.end(), key) -
+                   inputKeys.begin();
+        if (k == inputKeys.size())
+        {
+            if (k >= EAVL_EXPRESSION_MAX_INPUTS)
+                Error("expression uses too many fields");
+            inputKeys.push_back(key);
+            inputs.push_back(eavlArrayWithLinearIndex(f->GetArray(), component));
+            fields.push_back(f);
+            program.ninputs++;
+        }
+        Emit(eavlExpressionProgram::PushInput, k);
+    }
+};
+
+
+eavlExpressionMutator::eavlExpressionMutator()
+{
+}
+
+
+void
+eavlExpressionMutator::Execute()
+{
+    ExpressionCompiler compiler(dataset, expression);
+    if (compiler.fields.empty())
+    {
+        THROW(eavlException,
+              "eavlExpressionMutator expects an expression using a field");
+    }
+
+    eavlField *field0 = compiler.fields[0];
+    int n = field0->GetArray()->GetNumberOfTuples();
+    for (size_t i=1; i<compiler.fields.size(); i++)
+    {
+        eavlField *f = compiler.fields[i];
+        if (f->GetAssociation() != field0->GetAssociation() ||
+            f->GetAssocCellSet() != field0->GetAssocCellSet() ||
+            f->GetAssocLogicalDim() != field0->GetAssocLogicalDim())
+        {
+            THROW(eavlException,
+                  "eavlExpressionMutator expects fields with the same association");
+        }
+        if (f->GetArray()->GetNumberOfTuples() != n)
+        {
+            THROW(eavlException,
+                  "eavlExpressionMutator expects arrays with same length");
+        }
+    }
+
+    eavlArray *result = new eavlFloatArray(resultname, 1, n);
+    eavlExecutor::AddOperation(
+        new eavlExpressionMapOp(compiler.program, compiler.inputs,
+                                eavlArrayWithLinearIndex(result)),
+        "evaluate expression");
+    eavlExecutor::Go();
+
+    // copy association, order, etc. from first field
+    eavlField *newfield = new eavlField(field0, result);
+    dataset->AddField(newfield);
+}
@@ -0,0 +1,50 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_EXPRESSION_MUTATOR_H
+#define EAVL_EXPRESSION_MUTATOR_H
+
+#include "eavlDataSet.h"
+#include "eavlFilter.h"
+
+// ****************************************************************************
+// Class:  eavlExpressionMutator
+//
+// Purpose:
+///  Add a field computed from an arithmetic expression of existing
+///  fields, e.g. "sqrt(u*u + v*v + w*w) * rho".  The expression may use
+///  numbers, fields (a component of a multi-component field is selected
+///  as vel[1]; names with unusual characters may be quoted), the
+///  operators + - * / ^, parentheses, and the functions sqrt, abs, exp,
+///  ln (or log), log10, log2, sin, cos, tan, asin, acos, atan, min, max,
+///  pow and atan2.
+///
+///  The expression is compiled once into an eavlExpressionProgram and
+///  evaluated in a single pass over the data, with no intermediate
+///  fields.  All fields it uses must have the same association and
+///  length; the result is a single-component float field with the
+///  association of the first of them.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlExpressionMutator : public eavlMutator
+{
+  public:
+    eavlExpressionMutator();
+    void SetExpression(const string &expr)
+    {
+        expression = expr;
+    }
+    void SetResultName(const string &name)
+    {
+        resultname = name;
+    }
+
+    virtual void Execute();
+
+  protected:
+    string expression;
+    string resultname;
+};
+
+#endif
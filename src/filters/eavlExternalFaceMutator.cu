@@ -0,0 +1,466 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlExternalFaceMutator.h"
+#include "eavlCellSetExplicit.h"
+#include "eavlCellSetAllStructured.h"
+#include "eavlCellComponents.h"
+#include "eavlException.h"
+#include "eavlGhostCells.h"
+#include "eavlExecutor.h"
+#include "eavlGatherOp_1.h"
+#include "eavlPrefixSumOp_1.h"
+#include "eavlReduceOp_1.h"
+#include "eavlSimpleReverseIndexOp.h"
+#include "eavlMemoryTracker.h"
+
+eavlExternalFaceMutator::eavlExternalFaceMutator()
+{
+}
+
+// ----------------------------------------------------------------------------
+// Faces of a cell, in the same order as the face connectivity the
+// explicit cell set builds: triangles first, then quads.
+// ----------------------------------------------------------------------------
+static int
+GetExtFaceTables(int shape,
+                 int &ntris, signed char (*&tris)[3],
+                 int &nquads, signed char (*&quads)[4])
+{
+    ntris = 0;
+    tris = NULL;
+    nquads = 0;
+    quads = NULL;
+    switch (shape)
+    {
+      case EAVL_HEX:
+        nquads = 6;
+        quads = eavlHexQuadFaces;
+        break;
+      case EAVL_VOXEL:
+        nquads = 6;
+        quads = eavlVoxQuadFaces;
+        break;
+      case EAVL_TET:
+        ntris = 4;
+        tris = eavlTetTriangleFaces;
+        break;
+      case EAVL_PYRAMID:
+        ntris = 4;
+        tris = eavlPyramidTriangleFaces;
+        nquads = 1;
+        quads = eavlPyramidQuadFaces;
+        break;
+      case EAVL_WEDGE:
+        ntris = 2;
+        tris = eavlWedgeTriangleFaces;
+        nquads = 3;
+        quads = eavlWedgeQuadFaces;
+        break;
+      default:
+        break;
+    }
+    return ntris + nquads;
+}
+
+static int
+GetExtFaceNodes(const eavlCell &cell, int f, int *ids)
+{
+    int ntris, nquads;
+    signed char (*tris)[3];
+    signed char (*quads)[4];
+    GetExtFaceTables(cell.type, ntris, tris, nquads, quads);
+    if (f < ntris)
+    {
+        for (int n=0; n<3; n++)
+            ids[n] = cell.indices[tris[f][n]];
+        return 3;
+    }
+    for (int n=0; n<4; n++)
+        ids[n] = cell.indices[quads[f-ntris][n]];
+    return 4;
+}
+
+// ----------------------------------------------------------------------------
+// A face is identified by its three lowest node ids, sorted, just as
+// the explicit cell set's face connectivity identifies them.
+// ----------------------------------------------------------------------------
+struct ExtFaceKey
+{
+    int a, b, c;
+    bool operator==(const ExtFaceKey &o) const
+    {
+        return a == o.a && b == o.b && c == o.c;
+    }
+};
+
+static ExtFaceKey
+MakeExtFaceKey(int n, const int *ids)
+{
+    int v[4];
+    for (int i=0; i<n; i++)
+        v[i] = ids[i];
+    // insertion sort; faces have at most four nodes
+    for (int i=1; i<n; i++)
+    {
+        int x = v[i], j = i;
+        for (; j>0 && v[j-1] > x; j--)
+            v[j] = v[j-1];
+        v[j] = x;
+    }
+    ExtFaceKey key;
+    key.a = v[0];
+    key.b = v[1];
+    key.c = v[2];
+    return key;
+}
+
+// ****************************************************************************
+// Function:  FindExternalFacesByKey
+//
+// Purpose:
+///   Find the external faces of any cell set.  Every face of every cell
+///   is emitted with its sorted node key, the faces are counting-sorted
+///   into buckets on the lowest node id, and a face is external when no
+///   other face in its bucket has the same key.  The external faces are
+///   returned in the order of the emitting cells, which is the same
+///   order a face connectivity built by first encounter would have.
+///   Faces of ghost cells are never external, but they still hide the
+///   faces they share with real cells.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+static int
+FindExternalFacesByKey(eavlCellSet *inCells, const byte *ghost,
+                       eavlExplicitConnectivity &conn,
+                       vector<int> &extCell)
+{
+    int nc = inCells->GetNumCells();
+
+    // number the face slots of every cell
+    vector<int> slotStart(nc+1);
+    slotStart[0] = 0;
+    {
+        vector<int> nfaces(nc);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int i=0; i<nc; i++)
+        {
+            int ntris, nquads;
+            signed char (*tris)[3];
+            signed char (*quads)[4];
+            nfaces[i] = GetExtFaceTables(inCells->GetCellNodes(i).type,
+                                         ntris, tris, nquads, quads);
+        }
+        for (int i=0; i<nc; i++)
+            slotStart[i+1] = slotStart[i] + nfaces[i];
+    }
+    int nslots = slotStart[nc];
+
+    // emit the key of each face slot
+    vector<ExtFaceKey> slotKey(nslots);
+    vector<int> slotCell(nslots);
+    vector<int> slotNodes(nslots);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i=0; i<nc; i++)
+    {
+        eavlCell cell = inCells->GetCellNodes(i);
+        for (int s=slotStart[i]; s<slotStart[i+1]; s++)
+        {
+            int ids[4];
+            int n = GetExtFaceNodes(cell, s - slotStart[i], ids);
+            slotKey[s] = MakeExtFaceKey(n, ids);
+            slotCell[s] = i;
+            slotNodes[s] = n;
+        }
+    }
+
+    // counting sort the slots on the lowest node id; neighboring cells
+    // share nodes, so this keeps the buckets cache-friendly
+    int nbuckets = 0;
+    for (int s=0; s<nslots; s++)
+    {
+        if (slotKey[s].a >= nbuckets)
+            nbuckets = slotKey[s].a + 1;
+    }
+    vector<int> bucketStart(nbuckets+1, 0);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int s=0; s<nslots; s++)
+    {
+#ifdef HAVE_OPENMP
+#pragma omp atomic
+#endif
+        bucketStart[slotKey[s].a + 1]++;
+    }
+    for (int b=0; b<nbuckets; b++)
+        bucketStart[b+1] += bucketStart[b];
+
+    vector<int> bucketFill(bucketStart.begin(), bucketStart.end()-1);
+    vector<ExtFaceKey> bucketKeys(nslots);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int s=0; s<nslots; s++)
+    {
+        int pos;
+#ifdef HAVE_OPENMP
+#pragma omp atomic capture
+#endif
+        pos = bucketFill[slotKey[s].a]++;
+        bucketKeys[pos] = slotKey[s];
+    }
+
+    // a face is external if no other slot has its key (and it isn't
+    // on a ghost cell)
+    eavlIntArray *extFlag, *extIndex, *total;
+    {
+        eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+        extFlag = new eavlIntArray("extfaceflag", 1, nslots);
+        extIndex = new eavlIntArray("extfaceindex", 1, nslots);
+        total = new eavlIntArray("nextfaces", 1, 1);
+    }
+    int *flag = (nslots > 0) ? (int*)extFlag->GetHostArray() : NULL;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int s=0; s<nslots; s++)
+    {
+        const ExtFaceKey &key = slotKey[s];
+        int count = 0;
+        for (int p=bucketStart[key.a]; p<bucketStart[key.a+1]; p++)
+        {
+            if (bucketKeys[p] == key)
+                count++;
+        }
+        flag[s] = (count == 1 && !(ghost && ghost[slotCell[s]])) ? 1 : 0;
+    }
+
+    int n_ext = 0;
+    if (nslots > 0)
+    {
+        eavlExecutor::AddOperation(
+            new eavlPrefixSumOp_1(extFlag, extIndex, false),
+            "scan to generate output index of external faces");
+        eavlExecutor::AddOperation(
+            new eavlReduceOp_1<eavlAddFunctor<int> >(extFlag,
+                                                     total,
+                                                     eavlAddFunctor<int>()),
+            "sumreduce to count external faces");
+        eavlExecutor::Go();
+        n_ext = total->GetValue(0);
+    }
+
+    eavlIntArray *extSlots;
+    {
+        eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+        extSlots = new eavlIntArray("extfaceslots", 1, n_ext);
+    }
+    if (n_ext > 0)
+    {
+        eavlExecutor::AddOperation(
+            new eavlSimpleReverseIndexOp(extFlag, extIndex, extSlots),
+            "generate reverse lookup: external face to face slot");
+        eavlExecutor::Go();
+    }
+
+    // copy out the external faces
+    const int *slots = (n_ext > 0) ? (const int*)extSlots->GetHostArray() : NULL;
+    vector<int> connStart(n_ext+1);
+    connStart[0] = 0;
+    for (int e=0; e<n_ext; e++)
+        connStart[e+1] = connStart[e] + 1 + slotNodes[slots[e]];
+
+    extCell.resize(n_ext);
+    conn.shapetype.resize(n_ext);
+    conn.connectivity.resize(connStart[n_ext]);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int e=0; e<n_ext; e++)
+    {
+        int s = slots[e];
+        int c = slotCell[s];
+        int ids[4];
+        int n = GetExtFaceNodes(inCells->GetCellNodes(c), s - slotStart[c], ids);
+        int index = connStart[e];
+        conn.shapetype[e] = (n == 3) ? int(EAVL_TRI) : int(EAVL_QUAD);
+        conn.connectivity[index] = n;
+        for (int j=0; j<n; j++)
+            conn.connectivity[index + 1 + j] = ids[j];
+        extCell[e] = c;
+    }
+
+    delete extFlag;
+    delete extIndex;
+    delete total;
+    delete extSlots;
+    return n_ext;
+}
+
+// ****************************************************************************
+// Function:  FindExternalFacesOfStructured
+//
+// Purpose:
+///   The external faces of a 3D structured grid are exactly its boundary
+///   faces, so generate them directly, in increasing face index order
+///   (z-low and z-high XY faces, then the XZ faces on the y boundaries,
+///   then the YZ faces on the x boundaries), along with the one cell
+///   each belongs to.  Faces of ghost cells are then dropped; with a
+///   ghost layer, those are the faces on the seams between domains.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+static int
+FindExternalFacesOfStructured(eavlRegularStructure &reg, const byte *ghost,
+                              eavlExplicitConnectivity &conn,
+                              vector<int> &extCell)
+{
+    int xc = reg.cellDims[0];
+    int yc = reg.cellDims[1];
+    int zc = reg.cellDims[2];
+    int xn = reg.nodeDims[0];
+    int yn = reg.nodeDims[1];
+    int numXY = xc * yc * (zc+1);
+    int numXZ = xc * yn * zc;
+
+    int nXY = xc * yc;
+    int nXZ = xc * zc;
+    int nYZ = yc * zc;
+    int n_ext = (xc*yc*zc > 0) ? 2 * (nXY + nXZ + nYZ) : 0;
+
+    extCell.resize(n_ext);
+    conn.shapetype.resize(n_ext);
+    conn.connectivity.resize(n_ext * 5);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int e=0; e<n_ext; e++)
+    {
+        int face, cell;
+        if (e < 2*nXY)
+        {
+            int r = e % nXY;
+            bool high = (e >= nXY);
+            face = (high ? zc : 0) * nXY + r;
+            cell = (high ? zc-1 : 0) * nXY + r;
+        }
+        else if (e < 2*(nXY + nXZ))
+        {
+            int r = e - 2*nXY;
+            int z = r / (2*xc);
+            int side = (r % (2*xc)) / xc;
+            int x = r % xc;
+            face = numXY + z*xc*yn + (side ? yc : 0)*xc + x;
+            cell = z*nXY + (side ? yc-1 : 0)*xc + x;
+        }
+        else
+        {
+            int r = e - 2*(nXY + nXZ);
+            int z = r / (2*yc);
+            int y = (r % (2*yc)) / 2;
+            int side = r % 2;
+            face = numXY + numXZ + z*xn*yc + y*xn + (side ? xc : 0);
+            cell = z*nXY + y*xc + (side ? xc-1 : 0);
+        }
+
+        int npts;
+        int *pts = &conn.connectivity[e*5 + 1];
+        conn.shapetype[e] = reg.GetFaceNodes(face, npts, pts);
+        conn.connectivity[e*5] = npts;
+        extCell[e] = cell;
+    }
+
+    if (ghost)
+    {
+        int n = 0;
+        for (int e=0; e<n_ext; e++)
+        {
+            if (ghost[extCell[e]])
+                continue;
+            if (n != e)
+            {
+                extCell[n] = extCell[e];
+                conn.shapetype[n] = conn.shapetype[e];
+                for (int j=0; j<5; j++)
+                    conn.connectivity[n*5 + j] = conn.connectivity[e*5 + j];
+            }
+            n++;
+        }
+        n_ext = n;
+        extCell.resize(n_ext);
+        conn.shapetype.resize(n_ext);
+        conn.connectivity.resize(n_ext * 5);
+    }
+    return n_ext;
+}
+
+void
+eavlExternalFaceMutator::Execute()
+{
+    int inCellSetIndex = dataset->GetCellSetIndex(cellsetname);
+    eavlCellSet *inCells = dataset->GetCellSet(cellsetname);
+
+    eavlGhostCells ghosts(dataset, inCellSetIndex);
+    eavlExplicitConnectivity conn;
+    vector<int> extCell;
+    int n_ext;
+
+    eavlCellSetAllStructured *cellsAllStruc =
+        dynamic_cast<eavlCellSetAllStructured*>(inCells);
+    if (cellsAllStruc && cellsAllStruc->GetDimensionality() == 3)
+        n_ext = FindExternalFacesOfStructured(cellsAllStruc->GetRegularStructure(),
+                                              ghosts.GetFlags(), conn, extCell);
+    else
+        n_ext = FindExternalFacesByKey(inCells, ghosts.GetFlags(), conn, extCell);
+
+    eavlCellSetExplicit *outCells =
+        new eavlCellSetExplicit(string("extface_of_")+inCells->GetName(), 2);
+    outCells->SetCellNodeConnectivity(conn);
+    dataset->AddCellSet(outCells);
+
+    // copy any cell fields
+    eavlIntArray *from;
+    {
+        eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+        from = new eavlIntArray("extfacecell", 1, n_ext);
+    }
+    if (n_ext > 0)
+        std::copy(extCell.begin(), extCell.end(), (int*)from->GetHostArray());
+
+    int nOldFields = dataset->GetNumFields();
+    for (int i=0; i < nOldFields; ++i)
+    {
+        eavlField *inField = dataset->GetField(i);
+        if (inField->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+            inField->GetAssocCellSet() == inCellSetIndex)
+        {
+            eavlArray *inArray = inField->GetArray();
+            int nc = inArray->GetNumberOfComponents();
+            // I guess it's most appropriate to re-use the input
+            // field name directly?
+            eavlArray *outArray = inArray->Create(inArray->GetName(),
+                                                  nc, n_ext);
+            for (int c=0; c<nc && n_ext>0; c++)
+            {
+                eavlExecutor::AddOperation(
+                    new eavlGatherOp_1(eavlArrayWithLinearIndex(inArray, c),
+                                       eavlArrayWithLinearIndex(outArray, c),
+                                       from),
+                    "gather cell field to external faces");
+            }
+            eavlField *outField = new eavlField(0, outArray,
+                                                eavlField::ASSOC_CELL_SET,
+                                                dataset->GetNumCellSets()-1);
+            dataset->AddField(outField);
+        }
+    }
+    eavlExecutor::Go();
+    delete from;
+}
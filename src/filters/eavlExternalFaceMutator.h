@@ -1,34 +1,52 @@
-// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
-#ifndef EAVL_EXTERNAL_FACE_MUTATOR_H
-#define EAVL_EXTERNAL_FACE_MUTATOR_H
-
-#include "STL.h"
-#include "eavlDataSet.h"
-#include "eavlCellSet.h"
-#include "eavlFilter.h"
-
-// ****************************************************************************
-// Class:  eavlExternalFaceMutator
-//
-// Purpose:
-///   Extract non-duplicated (external) faces from a topologically 3D data set.
-//
-// Programmer:  Jeremy Meredith, Dave Pugmire, Sean Ahern
-// Creation:    March 14, 2011
-//
-// ****************************************************************************
-class eavlExternalFaceMutator : public eavlMutator
-{
-  protected:
-    string cellsetname;
-  public:
-    eavlExternalFaceMutator();
-    void SetCellSet(const string &name)
-    {
-        cellsetname = name;
-    }
-    
-    virtual void Execute();
-};
-
-#endif
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_EXTERNAL_FACE_MUTATOR_H
+#define EAVL_EXTERNAL_FACE_MUTATOR_H
+
+#include "STL.h"
+#include "eavlDataSet.h"
+#include "eavlCellSet.h"
+#include "eavlFilter.h"
+
+// ****************************************************************************
+// Class:  eavlExternalFaceMutator
+//
+// Purpose:
+///   Extract non-duplicated (external) faces from a topologically 3D data set.
+///
+///   3D structured cell sets take their boundary faces directly.  Any
+///   other cell set has the faces of each cell keyed by sorted node ids
+///   and grouped on the lowest one, so the input's full face
+///   connectivity is never built.
+///
+///   Ghost cells (see eavlGhostCells) contribute no faces, and real
+///   cells' faces shared with them aren't external, so decomposed
+///   domains with a ghost layer leave no faces on their seams.
+//
+// Programmer:  Jeremy Meredith, Dave Pugmire, Sean Ahern
+// Creation:    March 14, 2011
+//
+// Modifications:
+//   agent, Sun Oct 18 2026
+//   Find external faces directly and in parallel instead of through the
+//   cell set's map-based face connectivity.  Cell fields keep their
+//   array type.
+//
+//   agent, Sun Oct 18 2026
+//   Leave out the faces of ghost cells.
+//
+// ****************************************************************************
+class eavlExternalFaceMutator : public eavlMutator
+{
+  protected:
+    string cellsetname;
+  public:
+    eavlExternalFaceMutator();
+    void SetCellSet(const string &name)
+    {
+        cellsetname = name;
+    }
+    
+    virtual void Execute();
+};
+
+#endif
@@ -0,0 +1,404 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlGradientMutator.h"
+#include "eavlCellSetAllStructured.h"
+#include "eavlCellSetSubset.h"
+#include "eavlException.h"
+#include "eavlExecutor.h"
+#include "eavlNodePositions.h"
+#include "eavlShapeFunctions.h"
+#include "eavlTopologyAverageOp.h"
+
+// ----------------------------------------------------------------------------
+// read-only access to the components of a field's values, converted to
+// float once up front if they aren't already
+class GradientFieldValues
+{
+  protected:
+    const float   *ptr;
+    int            ncomp;
+    vector<float>  copy;
+  public:
+    GradientFieldValues(eavlArray *arr)
+    {
+        ncomp = arr->GetNumberOfComponents();
+        eavlFloatArray *farr = dynamic_cast<eavlFloatArray*>(arr);
+        if (farr)
+        {
+            ptr = (const float*)farr->GetHostArray();
+            return;
+        }
+        int n = arr->GetNumberOfTuples();
+        copy.resize(n * ncomp);
+        for (int i=0; i<n; i++)
+            for (int c=0; c<ncomp; c++)
+                copy[i*ncomp + c] = arr->GetComponentAsDouble(i, c);
+        ptr = copy.empty() ? NULL : &copy[0];
+    }
+    float Get(int i, int c) const
+    {
+        return ptr[i*ncomp + c];
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Given the derivatives of the positions (J[a] = dX/da) and of each field
+// component (dF[3*c+a]) along "dim" logical or parametric axes, find the
+// world space gradient of each component.  With fewer than three axes
+// this uses the pseudo-inverse, which gives the gradient tangent to them.
+// Returns false if the axes are degenerate.
+static bool
+SolveGradient(int dim, const double J[3][3],
+              int ncomp, const double *dF, float *grad)
+{
+    double M[3][3], Minv[3][3];
+    for (int a=0; a<dim; a++)
+        for (int b=0; b<dim; b++)
+            M[a][b] = J[a][0]*J[b][0] + J[a][1]*J[b][1] + J[a][2]*J[b][2];
+
+    if (dim == 3)
+    {
+        double det = M[0][0]*(M[1][1]*M[2][2]-M[1][2]*M[2][1]) -
+                     M[0][1]*(M[1][0]*M[2][2]-M[1][2]*M[2][0]) +
+                     M[0][2]*(M[1][0]*M[2][1]-M[1][1]*M[2][0]);
+        if (!(det > 0))
+            return false;
+        Minv[0][0] =  (M[1][1]*M[2][2]-M[1][2]*M[2][1]) / det;
+        Minv[0][1] = -(M[0][1]*M[2][2]-M[0][2]*M[2][1]) / det;
+        Minv[0][2] =  (M[0][1]*M[1][2]-M[0][2]*M[1][1]) / det;
+        Minv[1][0] = -(M[1][0]*M[2][2]-M[1][2]*M[2][0]) / det;
+        Minv[1][1] =  (M[0][0]*M[2][2]-M[0][2]*M[2][0]) / det;
+        Minv[1][2] = -(M[0][0]*M[1][2]-M[0][2]*M[1][0]) / det;
+        Minv[2][0] =  (M[1][0]*M[2][1]-M[1][1]*M[2][0]) / det;
+        Minv[2][1] = -(M[0][0]*M[2][1]-M[0][1]*M[2][0]) / det;
+        Minv[2][2] =  (M[0][0]*M[1][1]-M[0][1]*M[1][0]) / det;
+    }
+    else if (dim == 2)
+    {
+        double det = M[0][0]*M[1][1] - M[0][1]*M[1][0];
+        if (!(det > 0))
+            return false;
+        Minv[0][0] =  M[1][1] / det;
+        Minv[0][1] = -M[0][1] / det;
+        Minv[1][0] = -M[1][0] / det;
+        Minv[1][1] =  M[0][0] / det;
+    }
+    else if (dim == 1)
+    {
+        if (!(M[0][0] > 0))
+            return false;
+        Minv[0][0] = 1. / M[0][0];
+    }
+    else
+    {
+        return false;
+    }
+
+    for (int c=0; c<ncomp; c++)
+    {
+        double y[3];
+        for (int a=0; a<dim; a++)
+        {
+            y[a] = 0;
+            for (int b=0; b<dim; b++)
+                y[a] += Minv[a][b] * dF[3*c+b];
+        }
+        for (int k=0; k<3; k++)
+        {
+            double g = 0;
+            for (int a=0; a<dim; a++)
+                g += y[a] * J[a][k];
+            grad[3*c+k] = g;
+        }
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// vorticity, divergence, and Q-criterion from a velocity gradient,
+// where g[3*i+j] is du_i/dx_j; outputs may be NULL
+static void
+DeriveFromGradient(const float *g, float *vort, float *div, float *q)
+{
+    if (vort)
+    {
+        vort[0] = g[7] - g[5];
+        vort[1] = g[2] - g[6];
+        vort[2] = g[3] - g[1];
+    }
+    if (div)
+    {
+        *div = g[0] + g[4] + g[8];
+    }
+    if (q)
+    {
+        // Q = (|Omega|^2 - |S|^2) / 2 for the rotation and strain rates
+        double oo = 0, ss = 0;
+        for (int i=0; i<3; i++)
+        {
+            for (int j=0; j<3; j++)
+            {
+                double s = .5 * (g[3*i+j] + g[3*j+i]);
+                double o = .5 * (g[3*i+j] - g[3*j+i]);
+                ss += s*s;
+                oo += o*o;
+            }
+        }
+        *q = .5 * (oo - ss);
+    }
+}
+
+// ----------------------------------------------------------------------------
+static void
+GetParametricCenter(int shapeType, double rst[3])
+{
+    switch (shapeType)
+    {
+      case EAVL_TRI:
+        rst[0] = rst[1] = 1./3.; rst[2] = 0;
+        return;
+      case EAVL_TET:
+        rst[0] = rst[1] = rst[2] = .25;
+        return;
+      case EAVL_WEDGE:
+        rst[0] = rst[1] = 1./3.; rst[2] = .5;
+        return;
+    }
+    rst[0] = rst[1] = rst[2] = .5;
+}
+
+
+eavlGradientMutator::eavlGradientMutator()
+    : cellcentered(false), vorticity(false), divergence(false),
+      qcriterion(false)
+{
+}
+
+
+void
+eavlGradientMutator::Execute()
+{
+    eavlField *field = dataset->GetField(fieldname);
+    if (field->GetAssociation() != eavlField::ASSOC_POINTS)
+        THROW(eavlException, "eavlGradientMutator expects a point field");
+
+    eavlArray *array = field->GetArray();
+    int ncomp = array->GetNumberOfComponents();
+    if ((vorticity || divergence || qcriterion) && ncomp != 3)
+        THROW(eavlException, "vorticity, divergence, and Q-criterion need a 3-component field");
+
+    int cellSetIndex = dataset->GetCellSetIndex(cellsetname);
+    eavlCellSet *cellSet = dataset->GetCellSet(cellsetname);
+    if (!cellcentered && dynamic_cast<eavlCellSetSubset*>(cellSet))
+        THROW(eavlException, "eavlGradientMutator can't average point gradients over a cell set subset; use cell-centered gradients");
+    int npts = dataset->GetNumPoints();
+    int ncells = cellSet->GetNumCells();
+    int n = cellcentered ? ncells : npts;
+
+    string gname = (resultname != "") ? resultname : "gradient_" + fieldname;
+    eavlFloatArray *grad = new eavlFloatArray(gname, 3*ncomp, n);
+    eavlFloatArray *vort = NULL, *div = NULL, *q = NULL;
+    if (vorticity)
+        vort = new eavlFloatArray("vorticity_" + fieldname, 3, n);
+    if (divergence)
+        div = new eavlFloatArray("divergence_" + fieldname, 1, n);
+    if (qcriterion)
+        q = new eavlFloatArray("qcriterion_" + fieldname, 1, n);
+
+    float *g_ptr = (float*)grad->GetHostArray();
+    float *v_ptr = vort ? (float*)vort->GetHostArray() : NULL;
+    float *d_ptr = div  ? (float*)div->GetHostArray()  : NULL;
+    float *q_ptr = q    ? (float*)q->GetHostArray()    : NULL;
+
+    eavlNodePositions positions(dataset);
+    GradientFieldValues values(array);
+
+    eavlCellSetAllStructured *elStr =
+        dynamic_cast<eavlCellSetAllStructured*>(cellSet);
+    if (!cellcentered && elStr)
+    {
+        // central differences along each logical axis of the points
+        eavlRegularStructure reg = elStr->GetRegularStructure();
+        int dim = reg.dimension;
+#ifdef HAVE_OPENMP
+#pragma omp parallel
+#endif
+        {
+            vector<double> dF(3*ncomp);
+#ifdef HAVE_OPENMP
+#pragma omp for
+#endif
+            for (int node = 0; node < npts; node++)
+            {
+                int ijk[3] = {0,0,0};
+                if (dim == 1)
+                    reg.CalculateLogicalNodeIndices1D(node, ijk[0]);
+                else if (dim == 2)
+                    reg.CalculateLogicalNodeIndices2D(node, ijk[0], ijk[1]);
+                else
+                    reg.CalculateLogicalNodeIndices3D(node, ijk[0], ijk[1], ijk[2]);
+
+                double J[3][3];
+                for (int a=0; a<dim; a++)
+                {
+                    int lo[3] = {ijk[0], ijk[1], ijk[2]};
+                    int hi[3] = {ijk[0], ijk[1], ijk[2]};
+                    if (lo[a] > 0)
+                        lo[a]--;
+                    if (hi[a] < reg.nodeDims[a]-1)
+                        hi[a]++;
+                    int nlo, nhi;
+                    if (dim == 1)
+                    {
+                        nlo = reg.CalculateNodeIndex1D(lo[0]);
+                        nhi = reg.CalculateNodeIndex1D(hi[0]);
+                    }
+                    else if (dim == 2)
+                    {
+                        nlo = reg.CalculateNodeIndex2D(lo[0], lo[1]);
+                        nhi = reg.CalculateNodeIndex2D(hi[0], hi[1]);
+                    }
+                    else
+                    {
+                        nlo = reg.CalculateNodeIndex3D(lo[0], lo[1], lo[2]);
+                        nhi = reg.CalculateNodeIndex3D(hi[0], hi[1], hi[2]);
+                    }
+
+                    float xl, yl, zl, xh, yh, zh;
+                    positions.Get(nlo, xl, yl, zl);
+                    positions.Get(nhi, xh, yh, zh);
+                    J[a][0] = xh - xl;
+                    J[a][1] = yh - yl;
+                    J[a][2] = zh - zl;
+                    for (int c=0; c<ncomp; c++)
+                        dF[3*c+a] = values.Get(nhi, c) - values.Get(nlo, c);
+                }
+
+                float *g = g_ptr + node*3*ncomp;
+                if (!SolveGradient(dim, J, ncomp, &dF[0], g))
+                {
+                    for (int k=0; k<3*ncomp; k++)
+                        g[k] = 0;
+                }
+                DeriveFromGradient(g,
+                                   v_ptr ? v_ptr + 3*node : NULL,
+                                   d_ptr ? d_ptr + node : NULL,
+                                   q_ptr ? q_ptr + node : NULL);
+            }
+        }
+    }
+    else
+    {
+        // shape function derivatives at the center of each cell
+        eavlFloatArray *cellgrad = cellcentered ? grad :
+            new eavlFloatArray("cellgradient", 3*ncomp, ncells);
+        float *cg_ptr = (float*)cellgrad->GetHostArray();
+        bool badShape = false;
+#ifdef HAVE_OPENMP
+#pragma omp parallel
+#endif
+        {
+            vector<double> dF(3*ncomp);
+#ifdef HAVE_OPENMP
+#pragma omp for reduction(||:badShape)
+#endif
+            for (int cell = 0; cell < ncells; cell++)
+            {
+                eavlCell c = cellSet->GetCellNodes(cell);
+                int dim = eavlShapeTopologicalDimension(c.type);
+                double rst[3], dr[12], ds[12], dt[12];
+                GetParametricCenter(c.type, rst);
+
+                float *g = cg_ptr + cell*3*ncomp;
+                // shapes without shape functions (e.g. polygons and
+                // triangle strips) fail the whole call, below; cells
+                // that are merely degenerate get a zero gradient
+                bool ok = (c.numIndices <= 12 &&
+                           eavlShapeDerivatives(c.type, rst[0], rst[1], rst[2],
+                                                dr, ds, dt) == c.numIndices);
+                if (!ok)
+                    badShape = true;
+                if (ok)
+                {
+                    double J[3][3] = {{0,0,0},{0,0,0},{0,0,0}};
+                    for (int k=0; k<3*ncomp; k++)
+                        dF[k] = 0;
+                    for (int p=0; p<c.numIndices; p++)
+                    {
+                        int id = c.indices[p];
+                        float x, y, z;
+                        positions.Get(id, x, y, z);
+                        double d[3] = {dr[p], ds[p], dt[p]};
+                        for (int a=0; a<dim; a++)
+                        {
+                            J[a][0] += d[a] * x;
+                            J[a][1] += d[a] * y;
+                            J[a][2] += d[a] * z;
+                        }
+                        for (int comp=0; comp<ncomp; comp++)
+                        {
+                            float v = values.Get(id, comp);
+                            for (int a=0; a<dim; a++)
+                                dF[3*comp+a] += d[a] * v;
+                        }
+                    }
+                    ok = SolveGradient(dim, J, ncomp, &dF[0], g);
+                }
+                if (!ok)
+                {
+                    for (int k=0; k<3*ncomp; k++)
+                        g[k] = 0;
+                }
+                if (cellcentered)
+                {
+                    DeriveFromGradient(g,
+                                       v_ptr ? v_ptr + 3*cell : NULL,
+                                       d_ptr ? d_ptr + cell : NULL,
+                                       q_ptr ? q_ptr + cell : NULL);
+                }
+            }
+        }
+        if (badShape)
+            THROW(eavlException, "eavlGradientMutator can't find the gradient for this cell shape.");
+
+        if (!cellcentered)
+        {
+            // average the cell gradients around each point, then derive
+            // the other quantities from those
+            eavlExecutor::AddOperation(new eavlTopologyAverageOp(cellSet,
+                                                                 EAVL_CELLS_OF_NODES,
+                                                                 cellgrad,
+                                                                 grad),
+                                       "average gradients to the nodes");
+            eavlExecutor::Go();
+            delete cellgrad;
+
+            if (vort || div || q)
+            {
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+                for (int node = 0; node < npts; node++)
+                {
+                    DeriveFromGradient(g_ptr + node*9,
+                                       v_ptr ? v_ptr + 3*node : NULL,
+                                       d_ptr ? d_ptr + node : NULL,
+                                       q_ptr ? q_ptr + node : NULL);
+                }
+            }
+        }
+    }
+
+    eavlFloatArray *results[4] = {grad, vort, div, q};
+    for (int i=0; i<4; i++)
+    {
+        if (!results[i])
+            continue;
+        if (cellcentered)
+            dataset->AddField(new eavlField(0, results[i],
+                                            eavlField::ASSOC_CELL_SET,
+                                            cellSetIndex));
+        else
+            dataset->AddField(new eavlField(0, results[i],
+                                            eavlField::ASSOC_POINTS));
+    }
+}
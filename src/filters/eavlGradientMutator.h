@@ -0,0 +1,85 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_GRADIENT_MUTATOR_H
+#define EAVL_GRADIENT_MUTATOR_H
+
+#include "STL.h"
+#include "eavlFilter.h"
+
+// ****************************************************************************
+// Class:  eavlGradientMutator
+//
+// Purpose:
+///   Add the spatial gradient of a point field, either at the points or
+///   at the cells of a cell set.  For an N-component field the result
+///   has 3N components: (d/dx, d/dy, d/dz) of each input component.
+///
+///   On a structured cell set the point gradients use central
+///   differences along each logical axis (one-sided at the boundaries),
+///   mapped to world space through the same differences of the point
+///   coordinates, so rectilinear and curvilinear grids are handled alike.
+///   Otherwise, and for all cell gradients, the shape function
+///   derivatives at each cell center are used, and point gradients are
+///   the average of those of the cells around each point.  On surfaces
+///   and curves the gradient is the one tangent to the cells.  Shapes
+///   without shape functions (vertices, polygons, triangle strips)
+///   raise an eavlException unless the point gradients can be taken
+///   from the logical structure.  Point gradients over a cell set
+///   subset raise an eavlException too, since the subset has no cells
+///   around each point to average; cell gradients work on any cell set.
+///
+///   For a 3-component (e.g. velocity) field, the vorticity, divergence,
+///   and Q-criterion can be derived from the gradient as it is computed,
+///   without reading the field again.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlGradientMutator : public eavlMutator
+{
+  protected:
+    string fieldname;
+    string cellsetname;
+    string resultname;
+    bool   cellcentered;
+    bool   vorticity;
+    bool   divergence;
+    bool   qcriterion;
+  public:
+    eavlGradientMutator();
+    void SetField(const string &name)
+    {
+        fieldname = name;
+    }
+    void SetCellSet(const string &name)
+    {
+        cellsetname = name;
+    }
+    /// Defaults to "gradient_<field>".  Derived quantities are named
+    /// "vorticity_<field>", "divergence_<field>" and "qcriterion_<field>".
+    void SetResultName(const string &name)
+    {
+        resultname = name;
+    }
+    /// Compute the gradient at the cells instead of at the points.
+    void SetCellCentered(bool c)
+    {
+        cellcentered = c;
+    }
+    void SetComputeVorticity(bool v)
+    {
+        vorticity = v;
+    }
+    void SetComputeDivergence(bool d)
+    {
+        divergence = d;
+    }
+    void SetComputeQCriterion(bool q)
+    {
+        qcriterion = q;
+    }
+
+    virtual void Execute();
+};
+
+#endif
@@ -0,0 +1,112 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_IMPLICIT_FUNCTION_H
+#define EAVL_IMPLICIT_FUNCTION_H
+
+#include "eavl.h"
+#include "STL.h"
+
+// ****************************************************************************
+// Class:  eavlImplicitFunction
+//
+// Purpose:
+///   A simple implicit function of position, negative on one side of
+///   its zero surface:
+///     - Plane:  signed distance along the (normalized) normal from
+///               the origin point; negative behind the plane.
+///     - Sphere: distance from the center minus the radius; negative
+///               inside.
+///     - Box:    the largest distance outside any of the axis-aligned
+///               box's slabs; negative inside.
+///   It is a small value type so it can be evaluated directly inside
+///   filter kernels, with no field of function values ever created.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlImplicitFunction
+{
+  public:
+    enum FunctionType { PLANE, SPHERE, BOX };
+  protected:
+    FunctionType type;
+    float        p[6];
+  public:
+    eavlImplicitFunction() : type(PLANE)
+    {
+        p[0] = p[1] = p[2] = 0;
+        p[3] = p[4] = 0;
+        p[5] = 1;
+    }
+    static eavlImplicitFunction Plane(double ox, double oy, double oz,
+                                      double nx, double ny, double nz)
+    {
+        double len = sqrt(nx*nx + ny*ny + nz*nz);
+        if (len == 0)
+            len = 1;
+        eavlImplicitFunction f;
+        f.type = PLANE;
+        f.p[0] = ox;
+        f.p[1] = oy;
+        f.p[2] = oz;
+        f.p[3] = nx / len;
+        f.p[4] = ny / len;
+        f.p[5] = nz / len;
+        return f;
+    }
+    static eavlImplicitFunction Sphere(double cx, double cy, double cz,
+                                       double radius)
+    {
+        eavlImplicitFunction f;
+        f.type = SPHERE;
+        f.p[0] = cx;
+        f.p[1] = cy;
+        f.p[2] = cz;
+        f.p[3] = radius;
+        f.p[4] = f.p[5] = 0;
+        return f;
+    }
+    static eavlImplicitFunction Box(double x0, double y0, double z0,
+                                    double x1, double y1, double z1)
+    {
+        eavlImplicitFunction f;
+        f.type = BOX;
+        f.p[0] = (x0 < x1) ? x0 : x1;
+        f.p[1] = (y0 < y1) ? y0 : y1;
+        f.p[2] = (z0 < z1) ? z0 : z1;
+        f.p[3] = (x0 < x1) ? x1 : x0;
+        f.p[4] = (y0 < y1) ? y1 : y0;
+        f.p[5] = (z0 < z1) ? z1 : z0;
+        return f;
+    }
+    FunctionType GetType() const
+    {
+        return type;
+    }
+    EAVL_HOSTDEVICE float Eval(float x, float y, float z) const
+    {
+        switch (type)
+        {
+          case PLANE:
+            return (x-p[0])*p[3] + (y-p[1])*p[4] + (z-p[2])*p[5];
+          case SPHERE:
+            {
+            float dx = x-p[0], dy = y-p[1], dz = z-p[2];
+            return sqrt(dx*dx + dy*dy + dz*dz) - p[3];
+            }
+          case BOX:
+            {
+            float d = p[0] - x;
+            if (x - p[3] > d) d = x - p[3];
+            if (p[1] - y > d) d = p[1] - y;
+            if (y - p[4] > d) d = y - p[4];
+            if (p[2] - z > d) d = p[2] - z;
+            if (z - p[5] > d) d = z - p[5];
+            return d;
+            }
+        }
+        return 0;
+    }
+};
+
+#endif
@@ -2,54 +2,162 @@
 #include "eavlIsosurfaceFilter.h"
 
 #include "eavlExecutor.h"
-#include "eavlCellMapOp_1_1.h"
+#include "eavlCellSetAllStructured.h"
 #include "eavlCellSetExplicit.h"
 #include "eavlCellSparseMapOp_2_3.h"
 #include "eavlConnectivityDereferenceOp_3.h"
 #include "eavlCoordinates.h"
 #include "eavlGatherOp_1.h"
 #include "eavlMapOp_1_1.h"
+#include "eavlMapOp_2_1.h"
 #include "eavlPrefixSumOp_1.h"
 #include "eavlReduceOp_1.h"
 #include "eavlReverseIndexOp.h"
-#include "eavlSimpleReverseIndexOp.h"
 #include "eavlTopologyGatherMapOp_1_0_1.h"
 #include "eavlTopologyGatherMapOp_1_1_1.h"
 #include "eavlTopologyMapOp_1_0_1.h"
 #include "eavlTopologyMapOp_3_0_3.h"
 #include "eavlException.h"
+#include "eavlGhostCells.h"
 
 #include "eavlNewIsoTables.h"
+#include "eavlCellComponents.h"
 #include "eavlTimer.h"
+#include "eavlMemoryTracker.h"
+#include "eavlMetaCellIndex.h"
 
-class HiLoToCaseFunctor
+// The band of a scalar is the number of (sorted) isovalues at or
+// below it.  A node in band b is "lo" (below the isovalue) for every
+// level k >= b, so an element whose nodes span bands [lo,hi) crosses
+// exactly levels lo through hi-1.
+EAVL_HOSTDEVICE int FindIsoBand(const eavlConstArray<float> &levels,
+                                int nlevels, float x)
 {
+    int lo = 0, hi = nlevels;
+    while (lo < hi)
+    {
+        int mid = (lo + hi) / 2;
+        if (levels[mid] <= x)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+class IsoBandFunctor
+{
+    eavlConstArray<float> levels;
+    int nlevels;
   public:
-    ///\todo: hilo should be Int, not Float
+    IsoBandFunctor(eavlConstArray<float> *levels_, int nlevels_)
+        : levels(*levels_), nlevels(nlevels_) { }
+    EAVL_FUNCTOR int operator()(float x)
+    {
+        return FindIsoBand(levels, nlevels, x);
+    }
+};
+
+class BandSpanFunctor
+{
+  public:
+    ///\todo: bands should be Int, not Float
     /// but there's a chain of compile problems we need to fix
-    EAVL_FUNCTOR int operator()(int shapeType, int n,
-                                float hilo[])
+    EAVL_FUNCTOR int operator()(int shapeType, int n, float bands[])
+    {
+        if (n <= 0)
+            return 0;
+        int lo = bands[0], hi = bands[0];
+        for (int i=1; i<n; ++i)
+        {
+            if (bands[i] < lo)
+                lo = bands[i];
+            if (bands[i] > hi)
+                hi = bands[i];
+        }
+        return hi - lo;
+    }
+};
+
+class MinBandFunctor
+{
+  public:
+    EAVL_FUNCTOR int operator()(int shapeType, int n, float bands[])
     {
-        int caseindex = hilo[n-1];
-        for (int i=n-2; i>=0; --i)
-            caseindex = 2*caseindex + hilo[i];
-        return caseindex;
+        if (n <= 0)
+            return 0;
+        int lo = bands[0];
+        for (int i=1; i<n; ++i)
+            if (bands[i] < lo)
+                lo = bands[i];
+        return lo;
+    }
+};
+
+// Ghost cells cross no levels, so they generate no output.
+class IsoSkipGhostFunctor
+{
+  public:
+    template <class T>
+    EAVL_FUNCTOR int operator()(int numlevels, T ghost)
+    {
+        return ghost ? 0 : numlevels;
+    }
+};
+
+// Given the index of a level among those a cell spans, return the
+// global level index.
+class PairLevelFunctor
+{
+  public:
+    EAVL_FUNCTOR int operator()(int shapeType, int n, float bands[],
+                                float subindex)
+    {
+        if (n <= 0)
+            return 0;
+        int lo = bands[0];
+        for (int i=1; i<n; ++i)
+            if (bands[i] < lo)
+                lo = bands[i];
+        return lo + int(subindex);
+    }
+};
+
+EAVL_HOSTDEVICE int IsoCaseForLevel(int n, float bands[], int level)
+{
+    int caseindex = (bands[n-1] <= level);
+    for (int i=n-2; i>=0; --i)
+        caseindex = 2*caseindex + (bands[i] <= level);
+    return caseindex;
+}
+
+class PairCaseFunctor
+{
+  public:
+    EAVL_FUNCTOR int operator()(int shapeType, int n, float bands[],
+                                float level)
+    {
+        return IsoCaseForLevel(n, bands, int(level));
     }
 };
 
 
 class CalcAlphaFunctor
 {
-    float target;
+    eavlConstArray<float> levels;
+    int nlevels;
   public:
-    CalcAlphaFunctor(float tgt) : target(tgt) { }
-    EAVL_FUNCTOR float operator()(int shapeType, int n, float vals[])
-    {
-        // we're assuming vals[0] != vals[1] here, but note
-        // that we only call this routine for edges which will
-        // be present in the final output, which only happens
-        // if one edge node was > tgt and one was <= tgt, so 
-        // they must be different in the way we call it.
+    CalcAlphaFunctor(eavlConstArray<float> *levels_, int nlevels_)
+        : levels(*levels_), nlevels(nlevels_) { }
+    EAVL_FUNCTOR float operator()(int shapeType, int n, float vals[],
+                                  float subindex)
+    {
+        // we only call this routine for edges which will be present
+        // in the final output, i.e. whose nodes are in different
+        // bands, so vals[0] != vals[1] here.
+        int b0 = FindIsoBand(levels, nlevels, vals[0]);
+        int b1 = FindIsoBand(levels, nlevels, vals[1]);
+        float target = levels[(b0 < b1 ? b0 : b1) + int(subindex)];
         return (target - vals[0]) / (vals[1] - vals[0]);
     }
 };
@@ -63,16 +171,14 @@ class LinterpFunctor
     }
 };
 
-
-class FirstTwoItemsDifferFunctor
+class LevelValueFunctor
 {
+    eavlConstArray<float> levels;
   public:
-    ///\todo: vals should be Int, not Float
-    /// but there's a chain of compile problems we need to fix
-    EAVL_FUNCTOR int operator()(int shapeType, int n,
-                                float vals[])
+    LevelValueFunctor(eavlConstArray<float> *levels_) : levels(*levels_) { }
+    EAVL_FUNCTOR float operator()(int level)
     {
-        return vals[0] != vals[1];
+        return levels[level];
     }
 };
 
@@ -111,6 +217,18 @@ class Iso3DLookupCounts
     }
 };
 
+class PairCountFunctor
+{
+    Iso3DLookupCounts counts;
+  public:
+    PairCountFunctor(const Iso3DLookupCounts &counts_) : counts(counts_) { }
+    EAVL_FUNCTOR int operator()(int shapeType, int n, float bands[],
+                                float level)
+    {
+        return counts(shapeType, IsoCaseForLevel(n, bands, int(level)));
+    }
+};
+
 
 class Iso3DLookupTris
 {
@@ -184,46 +302,529 @@ class Iso3DLookupTris
 };
 
 
+// ----------------------------------------------------------------------------
+// Output point identification by edge key (see SetUseEdgeKeys)
+// ----------------------------------------------------------------------------
+
+struct IsoEdgeKey
+{
+    int a, b;    // edge end nodes, a < b
+    int level;
+    int corner;  // triangle corner (3*tri + i) which uses this point
+    bool operator<(const IsoEdgeKey &k) const
+    {
+        if (a != k.a)
+            return a < k.a;
+        if (b != k.b)
+            return b < k.b;
+        if (level != k.level)
+            return level < k.level;
+        return corner < k.corner;
+    }
+    bool SamePoint(const IsoEdgeKey &k) const
+    {
+        return a == k.a && b == k.b && level == k.level;
+    }
+};
+
+static signed char (*IsoCellEdges(int shapeType))[2]
+{
+    switch (shapeType)
+    {
+      case EAVL_TET:     return eavlTetEdges;
+      case EAVL_PYRAMID: return eavlPyramidEdges;
+      case EAVL_WEDGE:   return eavlWedgeEdges;
+      case EAVL_HEX:     return eavlHexEdges;
+      case EAVL_VOXEL:   return eavlVoxEdges;
+    }
+    return NULL;
+}
+
+// ****************************************************************************
+// Function:  MergeIsoPointsByEdgeKey
+//
+// Purpose:
+///   Given the cell-local edge of each output triangle corner, key each
+///   corner by its edge's end nodes and level, and sort the keys so
+///   corners on the same edge at the same level get the same output
+///   point.  This fills in the triangle connectivity and returns a
+///   cell set of two-node cells (one per output point, ordered by key)
+///   plus an identity index and the level offset within the edge, so
+///   points can be interpolated just like from the global edges.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+static int
+MergeIsoPointsByEdgeKey(eavlCellSet *inCells, int noutgeom,
+                        eavlIntArray *revInputIndex,
+                        eavlIntArray *localouttriArray,
+                        eavlIntArray *outlevelArray,
+                        eavlByteArray *bandArray,
+                        eavlIntArray *outconn,
+                        eavlCellSetExplicit *&edgeCells,
+                        eavlIntArray *&revPtEdgeIndex,
+                        eavlIntArray *&revPtEdgeSubindex)
+{
+    int ncorners = 3 * noutgeom;
+    vector<IsoEdgeKey> keys(ncorners);
+    if (ncorners > 0)
+    {
+        const int *cellindex = (const int*)revInputIndex->GetHostArray();
+        const int *localedge = (const int*)localouttriArray->GetHostArray();
+        const int *level     = (const int*)outlevelArray->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int t=0; t<noutgeom; t++)
+        {
+            eavlCell cell = inCells->GetCellNodes(cellindex[t]);
+            signed char (*edges)[2] = IsoCellEdges(cell.type);
+            for (int c=0; c<3; c++)
+            {
+                int e = localedge[3*t + c];
+                int a = cell.indices[edges[e][0]];
+                int b = cell.indices[edges[e][1]];
+                IsoEdgeKey &k = keys[3*t + c];
+                k.a = (a < b) ? a : b;
+                k.b = (a < b) ? b : a;
+                k.level = level[t];
+                k.corner = 3*t + c;
+            }
+        }
+        std::sort(keys.begin(), keys.end());
+    }
+
+    // assign one output point to each distinct key
+    vector<int> firstCorner;
+    int *conn = (ncorners > 0) ? (int*)outconn->GetHostArray() : NULL;
+    for (int i=0; i<ncorners; i++)
+    {
+        if (i == 0 || !keys[i].SamePoint(keys[i-1]))
+            firstCorner.push_back(i);
+        conn[keys[i].corner] = firstCorner.size() - 1;
+    }
+    int noutpts = firstCorner.size();
+
+    eavlExplicitConnectivity econn;
+    econn.shapetype.resize(noutpts);
+    econn.connectivity.resize(3*noutpts);
+    {
+        eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+        revPtEdgeIndex = new eavlIntArray("revPtEdgeIndex", 1, noutpts);
+        revPtEdgeSubindex = new eavlIntArray("revPtEdgeSubindex", 1, noutpts);
+    }
+    if (noutpts > 0)
+    {
+        const byte *band = (const byte*)bandArray->GetHostArray();
+        int *ptedge = (int*)revPtEdgeIndex->GetHostArray();
+        int *ptsub  = (int*)revPtEdgeSubindex->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int p=0; p<noutpts; p++)
+        {
+            const IsoEdgeKey &k = keys[firstCorner[p]];
+            econn.shapetype[p] = EAVL_BEAM;
+            econn.connectivity[3*p+0] = 2;
+            econn.connectivity[3*p+1] = k.a;
+            econn.connectivity[3*p+2] = k.b;
+            int lo = (band[k.a] < band[k.b]) ? band[k.a] : band[k.b];
+            ptedge[p] = p;
+            ptsub[p] = k.level - lo;
+        }
+    }
+    edgeCells = new eavlCellSetExplicit("isoedges", 1);
+    edgeCells->SetCellNodeConnectivity(econn);
+    return noutpts;
+}
+
+
+// ****************************************************************************
+// Function:  AddIsoOutputFields
+//
+// Purpose:
+///   Interpolate the input's point fields onto the output points, given
+///   the two-node element each point lies on and its alpha along it,
+///   and gather the input's cell fields onto the output triangles.
+///   Fields in the skip list (the coordinates) are left alone.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+static void
+AddIsoOutputFields(eavlDataSet *input, eavlDataSet *output,
+                   int inCellSetIndex, eavlField *skip[3],
+                   eavlCellSet *ptCells, eavlTopology ptTopology,
+                   eavlIntArray *revPtEdgeIndex, eavlFloatArray *alpha,
+                   eavlIntArray *revInputIndex,
+                   int noutpts, int noutgeom)
+{
+    for (int i=0; i<input->GetNumFields(); i++)
+    {
+        eavlField *f = input->GetField(i);
+        eavlArray *a = f->GetArray();
+        if (f == skip[0] ||
+            f == skip[1] ||
+            f == skip[2])
+        {
+            // we already did the coord fields
+            continue;
+        }
+        if (f->GetArray()->GetNumberOfComponents() != 1)
+        {
+            ///\todo: currently only handle point and cell fields
+            continue;
+        }
+
+        if (f->GetAssociation() == eavlField::ASSOC_POINTS)
+        {
+            eavlArray *outArr = a->Create(a->GetName(), 1, noutpts);
+            eavlExecutor::AddOperation(
+              new eavlTopologyGatherMapOp_1_1_1<LinterpFunctor>
+                (ptCells,
+                 ptTopology,
+                 a,
+                 alpha,
+                 outArr,
+                 revPtEdgeIndex,
+                 LinterpFunctor()),
+              "interpolate nodal field");
+            output->AddField(new eavlField(1, outArr, eavlField::ASSOC_POINTS));
+        }
+        else if (f->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+                 f->GetAssocCellSet() == inCellSetIndex)
+        {
+            eavlArray *outArr = a->Create(a->GetName(), 1, noutgeom);
+            eavlExecutor::AddOperation(new eavlGatherOp_1(a,
+                                                          outArr,
+                                                          revInputIndex),
+                                       "gather cell field");
+            output->AddField(
+                new eavlField(1, outArr, eavlField::ASSOC_CELL_SET, 0));
+        }
+        else
+        {
+            // skip field: either wrong cell set or not nodal/zonal assoc
+        }
+    }
+}
+
+
+// ----------------------------------------------------------------------------
+// Row-based path for structured grids (see ExecuteStructured)
+// ----------------------------------------------------------------------------
+
+// A float view of one component of an array.  Float arrays are used
+// in place; anything else is converted once up front.  (Not copyable,
+// as the pointer may refer to our own copy.)
+class IsoFloatValues
+{
+  protected:
+    const float  *ptr;
+    int           stride;
+    vector<float> copy;
+  public:
+    IsoFloatValues() : ptr(NULL), stride(1) { }
+    void Set(eavlArray *arr, int comp)
+    {
+        eavlFloatArray *farr = dynamic_cast<eavlFloatArray*>(arr);
+        if (farr)
+        {
+            stride = farr->GetNumberOfComponents();
+            ptr = (const float*)farr->GetHostArray() + comp;
+            return;
+        }
+        int n = arr->GetNumberOfTuples();
+        copy.resize(n);
+        for (int i=0; i<n; i++)
+            copy[i] = arr->GetComponentAsDouble(i, comp);
+        stride = 1;
+        ptr = (n > 0) ? &copy[0] : NULL;
+    }
+    void SetRegular(int n, double origin, double delta)
+    {
+        copy.resize(n);
+        for (int i=0; i<n; i++)
+            copy[i] = origin + i*delta;
+        stride = 1;
+        ptr = (n > 0) ? &copy[0] : NULL;
+    }
+    float operator[](int i) const
+    {
+        return ptr[i*stride];
+    }
+  private:
+    IsoFloatValues(const IsoFloatValues&);
+    void operator=(const IsoFloatValues&);
+};
+
+// One coordinate axis at the nodes of a structured grid, stored either
+// along a single logical dimension (regular and rectilinear axes) or
+// for every node (curvilinear).
+class IsoStructuredAxis
+{
+  public:
+    int            logicaldim;
+    IsoFloatValues values;
+    float operator()(int node, const int ijk[3]) const
+    {
+        return values[logicaldim < 0 ? node : ijk[logicaldim]];
+    }
+};
+
+static bool
+SetUpIsoStructuredAxis(eavlDataSet *input, eavlCoordinateAxis *axis,
+                       eavlRegularStructure &reg,
+                       IsoStructuredAxis &out, eavlField *&coordfield)
+{
+    coordfield = NULL;
+    eavlCoordinateAxisRegular *regAxis =
+        dynamic_cast<eavlCoordinateAxisRegular*>(axis);
+    if (regAxis)
+    {
+        int d = regAxis->GetLogicalDim();
+        if (d < 0 || d >= 3)
+            return false;
+        out.logicaldim = d;
+        out.values.SetRegular(reg.nodeDims[d],
+                              regAxis->GetOrigin(), regAxis->GetDelta());
+        return true;
+    }
+
+    eavlCoordinateAxisField *fieldAxis =
+        dynamic_cast<eavlCoordinateAxisField*>(axis);
+    if (!fieldAxis)
+        return false;
+    coordfield = input->GetField(fieldAxis->GetFieldName());
+    if (coordfield->GetAssociation() == eavlField::ASSOC_POINTS)
+    {
+        out.logicaldim = -1;
+    }
+    else if (coordfield->GetAssociation() == eavlField::ASSOC_LOGICALDIM)
+    {
+        out.logicaldim = coordfield->GetAssocLogicalDim();
+        if (out.logicaldim < 0 || out.logicaldim >= 3)
+            return false;
+    }
+    else
+    {
+        return false;
+    }
+    out.values.Set(coordfield->GetArray(), fieldAxis->GetComponent());
+    return true;
+}
+
+// The edges of a structured grid, taken as rows of edges running along
+// x.  First come the x edges of each (j,k) node row, then the y edges
+// leaving each (j<yc,k) node row, then the z edges leaving each
+// (j,k<zc) node row; within a row, edges are in increasing i.  This is
+// the same as the structured grid's global edge order, so numbering
+// output points row by row matches the general path exactly.
+struct IsoEdgeRows
+{
+    int xn, yn, zn;
+    int xc, yc, zc;
+    int nxrows, nyrows, nzrows;
+
+    IsoEdgeRows(eavlRegularStructure &reg)
+    {
+        xn = reg.nodeDims[0];  yn = reg.nodeDims[1];  zn = reg.nodeDims[2];
+        xc = reg.cellDims[0];  yc = reg.cellDims[1];  zc = reg.cellDims[2];
+        nxrows = yn * zn;
+        nyrows = yc * zn;
+        nzrows = yn * zc;
+    }
+    int GetNumRows() const
+    {
+        return nxrows + nyrows + nzrows;
+    }
+    // the first node, the offset to the other node of each edge, the
+    // direction, and the number of edges in a row, plus the global id
+    // of its first edge
+    void GetRow(int r, int &node0, int &offset, int &dir,
+                int &nedges, int &edge0) const
+    {
+        if (r < nxrows)
+        {
+            node0  = r * xn;
+            offset = 1;
+            dir    = 0;
+            nedges = xc;
+            edge0  = r * xc;
+        }
+        else if (r < nxrows + nyrows)
+        {
+            int q = r - nxrows;
+            node0  = ((q / yc) * yn + (q % yc)) * xn;
+            offset = xn;
+            dir    = 1;
+            nedges = xn;
+            edge0  = xc*yn*zn + q * xn;
+        }
+        else
+        {
+            int q = r - nxrows - nyrows;
+            node0  = q * xn;
+            offset = xn * yn;
+            dir    = 2;
+            nedges = xn;
+            edge0  = xc*yn*zn + xn*yc*zn + q * xn;
+        }
+    }
+};
+
+// A cell row (j,k) touches x edge i of the x rows at (j,k), (j+1,k),
+// (j,k+1) and (j+1,k+1), y edges i and i+1 of the y rows at (j,k) and
+// (j,k+1), and z edges i and i+1 of the z rows at (j,k) and (j+1,k).
+// We keep a cursor to the first output point of edge i in each of
+// those eight rows; these are the voxel nodes of each cursor's edge.
+static const int isoCursorNodes[8][2] = {
+    {0,1}, {2,3}, {4,5}, {6,7},   // x rows
+    {0,2}, {4,6},                 // y rows
+    {0,4}, {2,6}                  // z rows
+};
+
+// Which cursor each voxel edge comes from, and whether it is the
+// cursor's edge i+1 rather than edge i.
+static void
+GetIsoVoxelEdgeCursors(int cursor[12], int next[12])
+{
+    for (int e=0; e<12; e++)
+    {
+        int a = eavlVoxEdges[e][0];
+        int b = eavlVoxEdges[e][1];
+        int lo = (a < b) ? a : b;
+        int di = lo & 1, dj = (lo >> 1) & 1, dk = (lo >> 2) & 1;
+        switch (a ^ b)
+        {
+          case 1:  cursor[e] = dj + 2*dk; next[e] = 0;  break;
+          case 2:  cursor[e] = 4 + dk;    next[e] = di; break;
+          default: cursor[e] = 6 + dj;    next[e] = di; break;
+        }
+    }
+}
+
+static inline int
+IsoBandDiff(byte a, byte b)
+{
+    return (a < b) ? (b - a) : (a - b);
+}
+
+// Flying-edges trimming.  Along an x row of nodes, those before its
+// first crossed x edge all share one band, as do those after its last
+// crossed x edge.  Between x rows (for a row of y or z edges, or a row
+// of cells) only the span from the earliest first crossing to the
+// latest last crossing needs looking at; everything before or after it
+// repeats what happens at the start or end of the rows.  Given the
+// x rows, this returns that span [lo,hi) in cells, which is widened to
+// the start or end if that has a crossing between the rows.
+static inline void
+GetIsoTrim(const byte *band, int xn,
+           const int *trimLo, const int *trimHi,
+           int nxrows, const int *xrows, int &lo, int &hi)
+{
+    int xc = xn - 1;
+    lo = xc;
+    hi = 0;
+    bool startDiffers = false, endDiffers = false;
+    const byte *first = band + xrows[0]*xn;
+    for (int q=0; q<nxrows; q++)
+    {
+        int x = xrows[q];
+        lo = (trimLo[x] < lo) ? trimLo[x] : lo;
+        hi = (trimHi[x] > hi) ? trimHi[x] : hi;
+        const byte *b = band + x*xn;
+        startDiffers |= (b[0]  != first[0]);
+        endDiffers   |= (b[xc] != first[xc]);
+    }
+    if (startDiffers)
+        lo = 0;
+    if (endDiffers)
+        hi = xc;
+}
+
+// Get the bands of a voxel's nodes, given its first node, and the
+// range of levels it crosses.  Returns false (without filling in the
+// bands) if it crosses none, which is by far the common case.
+static inline bool
+GetIsoVoxelBands(const byte *b, int xn, int slice,
+                 float cb[8], int &lo, int &hi)
+{
+    byte v[8] = {b[0], b[1], b[xn], b[xn+1],
+                 b[slice], b[slice+1], b[slice+xn], b[slice+xn+1]};
+    byte mn = v[0], mx = v[0];
+    for (int i=1; i<8; i++)
+    {
+        mn = (v[i] < mn) ? v[i] : mn;
+        mx = (v[i] > mx) ? v[i] : mx;
+    }
+    if (mn == mx)
+        return false;
+    for (int i=0; i<8; i++)
+        cb[i] = v[i];
+    lo = mn;
+    hi = mx;
+    return true;
+}
+
+static int
+IsoExclusiveScan(vector<int> &counts)
+{
+    int sum = 0;
+    for (size_t i=0; i<counts.size(); i++)
+    {
+        int c = counts[i];
+        counts[i] = sum;
+        sum += c;
+    }
+    return sum;
+}
+
+
 eavlIsosurfaceFilter::eavlIsosurfaceFilter()
 {
-    hiloArray = NULL;
-    caseArray = NULL;
-    numoutArray = NULL;
-    outindexArray = NULL;
-    totalout = NULL;
-    edgeInclArray = NULL;
+    bandArray = NULL;
+    numlevelsArray = NULL;
+    pairindexArray = NULL;
+    totalpairs = NULL;
+    edgeNumPtsArray = NULL;
     outpointindexArray = NULL;
+    edgeBaseArray = NULL;
     totaloutpts = NULL;
+    useMetaCells = false;
+    useEdgeKeys = false;
+    useStructuredPath = true;
+    metacells = NULL;
 }
 
 eavlIsosurfaceFilter::~eavlIsosurfaceFilter()
 {
-    if (hiloArray)
-        delete hiloArray;
-    if (caseArray)
-        delete caseArray;
-    if (numoutArray)
-        delete numoutArray;
-    if (outindexArray)
-        delete outindexArray;
-    if (totalout)
-        delete totalout;
-    if (edgeInclArray)
-        delete edgeInclArray;
+    if (bandArray)
+        delete bandArray;
+    if (numlevelsArray)
+        delete numlevelsArray;
+    if (pairindexArray)
+        delete pairindexArray;
+    if (totalpairs)
+        delete totalpairs;
+    if (edgeNumPtsArray)
+        delete edgeNumPtsArray;
     if (outpointindexArray)
         delete outpointindexArray;
+    if (edgeBaseArray)
+        delete edgeBaseArray;
     if (totaloutpts)
         delete totaloutpts;
+    if (metacells)
+        delete metacells;
 }
 
 void
 eavlIsosurfaceFilter::Execute()
 {
-    eavlTimer::Suspend();
-
-    int th_init = eavlTimer::Start();
-    eavlInitializeIsoTables();
-
     int inCellSetIndex = input->GetCellSetIndex(cellsetname);
     eavlCellSet *inCells = input->GetCellSet(cellsetname);
 
@@ -231,28 +832,90 @@ eavlIsosurfaceFilter::Execute()
     if (inField->GetAssociation() != eavlField::ASSOC_POINTS)
         THROW(eavlException,"Isosurface expected point-centered field");
 
+    //
+    // the levels must be sorted and distinct for the band
+    // classification; node bands are stored as bytes
+    //
+    vector<float> sortedvalues;
+    for (size_t i=0; i<values.size(); i++)
+        sortedvalues.push_back(values[i]);
+    std::sort(sortedvalues.begin(), sortedvalues.end());
+    sortedvalues.erase(std::unique(sortedvalues.begin(), sortedvalues.end()),
+                       sortedvalues.end());
+    int nlevels = sortedvalues.size();
+    if (nlevels == 0)
+        THROW(eavlException,"Isosurface needs at least one isovalue");
+    if (nlevels > 255)
+        THROW(eavlException,"Isosurface supports at most 255 isovalues per pass");
+
+    // structured grids have their own path (if it can handle the
+    // coordinates; otherwise we fall through to the general one)
+    if (useStructuredPath && ExecuteStructured(inCells, inField, sortedvalues))
+        return;
+
+    //
+    // with a metacell index, only classify cells in blocks which
+    // might intersect a level (the index reports its own timings,
+    // so do this before suspending the timers)
+    //
+    eavlIntArray *candidates = NULL;
+    if (useMetaCells)
+    {
+        if (!metacells)
+            metacells = new eavlMetaCellIndex;
+        if (!metacells->IsValidFor(inCells, inField))
+            metacells->Build(inCells, inField);
+        int th_query = eavlTimer::Start();
+        candidates = metacells->FindCandidateCells(sortedvalues);
+        eavlTimer::Stop(th_query, "find metacell candidate cells");
+    }
+
+    eavlTimer::Suspend();
+
+    int th_init = eavlTimer::Start();
+    eavlInitializeIsoTables();
+
+    eavlConstArray<float> levels(&sortedvalues[0], nlevels);
+
     int npts = input->GetNumPoints();
     int ncells = inCells->GetNumCells();
+    // (on explicit meshes, asking for the edges builds them)
+    int nedges = useEdgeKeys ? 0 : inCells->GetNumEdges();
+    int nclassify = candidates ? candidates->GetNumberOfTuples() : ncells;
 
     //
     // allocate internal storage arrays
     //
-    if (!hiloArray)
-        hiloArray = new eavlByteArray("hilo", 1, npts);
-    if (!caseArray)
-        caseArray = new eavlByteArray("isocase", 1, ncells);
-    if (!numoutArray)
-        numoutArray = new eavlIntArray("numout", 1, ncells);
-    if (!outindexArray)
-        outindexArray = new eavlIntArray("outindex", 1, ncells);
-    if (!totalout)
-        totalout = new eavlIntArray("totalout", 1, 1);
-    if (!edgeInclArray)
-        edgeInclArray = new eavlIntArray("edgeIncl", 1, inCells->GetNumEdges());
-    if (!outpointindexArray)
-        outpointindexArray = new eavlIntArray("outpointindex", 1, inCells->GetNumEdges());
-    if (!totaloutpts)
-        totaloutpts = new eavlIntArray("totaloutpts", 1, 1);
+    {
+        eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+        if (numlevelsArray && numlevelsArray->GetNumberOfTuples() != nclassify)
+        {
+            // the number of candidate cells changes between calls
+            delete numlevelsArray;
+            delete pairindexArray;
+            numlevelsArray = NULL;
+            pairindexArray = NULL;
+        }
+        if (!bandArray)
+            bandArray = new eavlByteArray("band", 1, npts);
+        if (!numlevelsArray)
+            numlevelsArray = new eavlIntArray("numlevels", 1, nclassify);
+        if (!pairindexArray)
+            pairindexArray = new eavlIntArray("pairindex", 1, nclassify);
+        if (!totalpairs)
+            totalpairs = new eavlIntArray("totalpairs", 1, 1);
+        if (!useEdgeKeys)
+        {
+            if (!edgeNumPtsArray)
+                edgeNumPtsArray = new eavlIntArray("edgeNumPts", 1, nedges);
+            if (!outpointindexArray)
+                outpointindexArray = new eavlIntArray("outpointindex", 1, nedges);
+            if (!edgeBaseArray)
+                edgeBaseArray = new eavlIntArray("edgeBase", 1, nedges);
+            if (!totaloutpts)
+                totaloutpts = new eavlIntArray("totaloutpts", 1, 1);
+        }
+    }
 
 
     //
@@ -266,132 +929,284 @@ eavlIsosurfaceFilter::Execute()
     // do isosurface
     //
 
-    // map scalars to above/below (hi/lo) booleans
+    // classify each scalar against all levels at once
     eavlExecutor::AddOperation(
-        new eavlMapOp_1_1<eavlLessThanConstFunctor<float> >(
-                                      inField->GetArray(),
-                                      hiloArray,
-                                      eavlLessThanConstFunctor<float>(value)),
-        "generate hi/lo boolean");
+        new eavlMapOp_1_1<IsoBandFunctor>(inField->GetArray(),
+                                          bandArray,
+                                          IsoBandFunctor(&levels, nlevels)),
+        "generate band (number of isovalues below) per node");
 
-    // map the cell nodes' hi/lo as a bitfield, i.e. into a case index
-    eavlExecutor::AddOperation(
-        new eavlTopologyMapOp_1_0_1<HiLoToCaseFunctor>(inCells,
-                                                    EAVL_NODES_OF_CELLS,
-                                                    hiloArray,
-                                                    caseArray,
-                                                       HiLoToCaseFunctor()),
-        "generate case index per cell");
-
-    // look up case index in the table to get output counts
-    eavlExecutor::AddOperation(
-        new eavlCellMapOp_1_1<Iso3DLookupCounts>
+    // each cell crosses the levels between its min and max node band;
+    // we call each such (cell, level) combination a pair
+    if (candidates)
+    {
+        eavlExecutor::AddOperation(
+            new eavlTopologyGatherMapOp_1_0_1<BandSpanFunctor>(inCells,
+                                                               EAVL_NODES_OF_CELLS,
+                                                               bandArray,
+                                                               numlevelsArray,
+                                                               candidates,
+                                                               BandSpanFunctor()),
+            "count levels crossed per candidate cell");
+    }
+    else
+    {
+        eavlExecutor::AddOperation(
+            new eavlTopologyMapOp_1_0_1<BandSpanFunctor>(inCells,
+                                                         EAVL_NODES_OF_CELLS,
+                                                         bandArray,
+                                                         numlevelsArray,
+                                                         BandSpanFunctor()),
+            "count levels crossed per cell");
+    }
+
+    eavlGhostCells ghosts(input, inCellSetIndex);
+    eavlByteArray *candidateGhosts = NULL;
+    if (ghosts.HasGhosts() && nclassify > 0)
+    {
+        eavlArray *ghostArray = ghosts.GetArray();
+        if (candidates)
+        {
+            {
+                eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+                candidateGhosts = new eavlByteArray("candidateghost", 1,
+                                                    nclassify);
+            }
+            eavlExecutor::AddOperation(
+                new eavlGatherOp_1(ghostArray,
+                                   candidateGhosts,
+                                   candidates),
+                "gather ghost flag per candidate cell");
+            ghostArray = candidateGhosts;
+        }
+        eavlExecutor::AddOperation(
+            new eavlMapOp_2_1<IsoSkipGhostFunctor>(numlevelsArray,
+                                                   ghostArray,
+                                                   numlevelsArray,
+                                                   IsoSkipGhostFunctor()),
+            "skip ghost cells");
+    }
+
+    if (nclassify > 0)
+    {
+        eavlExecutor::AddOperation(
+            new eavlPrefixSumOp_1(numlevelsArray,
+                                  pairindexArray,
+                                  false),
+            "scan to generate starting cell/level pair index");
+
+        eavlExecutor::AddOperation(
+            new eavlReduceOp_1<eavlAddFunctor<int> >
+                (numlevelsArray,
+                 totalpairs,
+                 eavlAddFunctor<int>()),
+            "sumreduce to count cell/level pairs");
+    }
+
+    // similarly, each edge generates one output point for every level
+    // between its two nodes' bands (unless we're identifying the
+    // output points by node pairs, later)
+    if (!useEdgeKeys)
+    {
+        ///\todo: if this int array is changed to a byte array, the prefix sum a little later fails.
+        /// I would expect it to throw an error (array types don't match because we're putting
+        /// the scan result into an int array), but I'm just getting a segfault?
+        eavlExecutor::AddOperation(new eavlTopologyMapOp_1_0_1<BandSpanFunctor>
             (inCells,
-             caseArray,
-             numoutArray,
-             Iso3DLookupCounts(eavlTetIsoTriCount,
-                               eavlPyrIsoTriCount,
-                               eavlWdgIsoTriCount,
-                               eavlHexIsoTriCount,
-                               eavlVoxIsoTriCount)),
-        "look up output tris per cell case");
-
-    // exclusive scan output counts to get output index
-    eavlExecutor::AddOperation(
-        new eavlPrefixSumOp_1(numoutArray,
-                              outindexArray,
-                              false),
-        "scan to generate starting out geom index");
+             EAVL_NODES_OF_EDGES,
+             bandArray,
+             edgeNumPtsArray,
+             BandSpanFunctor()),
+            "count levels crossed per edge as they will generate pts in output");
 
+        // generate output-point-to-input-edge map
+        // exclusive scan output edge counts to get output index
+        eavlExecutor::AddOperation(new eavlPrefixSumOp_1(edgeNumPtsArray,
+                                                         outpointindexArray,
+                                                         false),
+                                   "scan edge counts to find starting output point index for each input edge");
 
-    // count overall geometry
-    eavlExecutor::AddOperation(
-        new eavlReduceOp_1<eavlAddFunctor<int> >
-            (numoutArray,
-             totalout,
-             eavlAddFunctor<int>()),
-        "sumreduce to count output geom");
-
-    // figure out which edges we'll need in the end (not-equal hi-lo)
-
-    ///\todo: if this int array is changed to a byte array, the prefix sum a little later fails.
-    /// I would expect it to throw an error (array types don't match because we're putting
-    /// the scan result into an int array), but I'm just getting a segfault?
-    eavlExecutor::AddOperation(new eavlTopologyMapOp_1_0_1<FirstTwoItemsDifferFunctor>
-        (inCells,
-         EAVL_NODES_OF_EDGES,
-         hiloArray,
-         edgeInclArray,
-         FirstTwoItemsDifferFunctor()),
-        "flag edges that have differing hi/lo as they will generate pts in output");
-    //for (int i=0; i<inCells->GetNumEdges(); i++) {if (edgeInclArray->GetValue(i)) cerr << "USES EDGE: "<<i<<endl;}
-
-    // generate output-point-to-input-edge map
-    // exclusive scan output edge inclusion (i.e. count) to get output index
-    eavlExecutor::AddOperation(new eavlPrefixSumOp_1(edgeInclArray,
-                                                     outpointindexArray,
-                                                     false),
-                               "scan edge flags to find starting output point index for each input edge");
-    //for (int i=0; i<inCells->GetNumEdges(); i++) {if (edgeInclArray->GetValue(i)) cerr << "EDGE #: "<<i<<" is at index "<<outpointindexArray->GetValue(i)<<endl;}
-
-    // sum reduction to count edges
-    eavlExecutor::AddOperation(
-        new eavlReduceOp_1<eavlAddFunctor<int> >
-            (edgeInclArray,
-             totaloutpts,
-             eavlAddFunctor<int>()),
-        "sumreduce to count output pts (from edges)");
+        // sum reduction to count edges
+        eavlExecutor::AddOperation(
+            new eavlReduceOp_1<eavlAddFunctor<int> >
+                (edgeNumPtsArray,
+                 totaloutpts,
+                 eavlAddFunctor<int>()),
+            "sumreduce to count output pts (from edges)");
+
+        // the point for level k on an edge is at its starting index plus
+        // k minus the lowest level it crosses, so precompute the base
+        eavlExecutor::AddOperation(new eavlTopologyMapOp_1_0_1<MinBandFunctor>
+            (inCells,
+             EAVL_NODES_OF_EDGES,
+             bandArray,
+             edgeBaseArray,
+             MinBandFunctor()),
+            "find lowest band per edge");
+        eavlExecutor::AddOperation(
+            new eavlMapOp_2_1<eavlSubFunctor<int> >(outpointindexArray,
+                                                    edgeBaseArray,
+                                                    edgeBaseArray,
+                                                    eavlSubFunctor<int>()),
+            "subtract lowest band from output point index per edge");
+    }
 
     //
     // We can now execute the plan up to the point, and then
-    // we'll know how many output cells and nodes we'll have.
-    // That lets us create some final arrays and resize them,
-    // then execute the final stage.
+    // we'll know how many cell/level pairs and output nodes we'll
+    // have.  The pairs tell us the output cell counts.
     //
     eavlExecutor::Go();
-    int noutgeom = totalout->GetValue(0);
-    int noutpts = totaloutpts->GetValue(0);
+    delete candidateGhosts;
+    int npairs = (nclassify > 0) ? totalpairs->GetValue(0) : 0;
+    int noutpts = useEdgeKeys ? 0 : totaloutpts->GetValue(0);
+
+    eavlIntArray *pairCell, *pairSubindex, *pairLevel, *pairNumOut;
+    eavlIntArray *pairOutIndex, *totalout;
+    eavlByteArray *pairCase;
+    {
+        eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+        pairCell = new eavlIntArray("pairCell", 1, npairs);
+        pairSubindex = new eavlIntArray("pairSubindex", 1, npairs);
+        pairLevel = new eavlIntArray("pairLevel", 1, npairs);
+        pairCase = new eavlByteArray("pairCase", 1, npairs);
+        pairNumOut = new eavlIntArray("pairNumOut", 1, npairs);
+        pairOutIndex = new eavlIntArray("pairOutIndex", 1, npairs);
+        totalout = new eavlIntArray("totalout", 1, 1);
+    }
+
+    // (a reduction needs at least one value, and if no cell crosses
+    // any level there's nothing more to compute)
+    int noutgeom = 0;
+    if (npairs > 0)
+    {
+        // generate pair-to-input(cell) map
+        eavlExecutor::AddOperation(
+            new eavlReverseIndexOp(numlevelsArray,
+                                   pairindexArray,
+                                   pairCell,
+                                   pairSubindex,
+                                   nlevels),
+            "generate reverse lookup: cell/level pair to input cell");
+
+        // if we only classified candidates, that gave us an index
+        // into the candidate list; map it back to the input cell
+        if (candidates)
+        {
+            eavlExecutor::AddOperation(
+                new eavlGatherOp_1(candidates,
+                                   pairCell,
+                                   pairCell),
+                "map candidate index to input cell index per pair");
+        }
+
+        eavlExecutor::AddOperation(
+            new eavlTopologyGatherMapOp_1_1_1<PairLevelFunctor>
+                (inCells,
+                 EAVL_NODES_OF_CELLS,
+                 bandArray,
+                 pairSubindex,
+                 pairLevel,
+                 pairCell,
+                 PairLevelFunctor()),
+            "generate level index per cell/level pair");
+
+        // map the cell nodes' hi/lo for this level as a bitfield,
+        // i.e. into a case index
+        eavlExecutor::AddOperation(
+            new eavlTopologyGatherMapOp_1_1_1<PairCaseFunctor>
+                (inCells,
+                 EAVL_NODES_OF_CELLS,
+                 bandArray,
+                 pairLevel,
+                 pairCase,
+                 pairCell,
+                 PairCaseFunctor()),
+            "generate case index per cell/level pair");
+
+        // look up case index in the table to get output counts
+        eavlExecutor::AddOperation(
+            new eavlTopologyGatherMapOp_1_1_1<PairCountFunctor>
+                (inCells,
+                 EAVL_NODES_OF_CELLS,
+                 bandArray,
+                 pairLevel,
+                 pairNumOut,
+                 pairCell,
+                 PairCountFunctor(Iso3DLookupCounts(eavlTetIsoTriCount,
+                                                    eavlPyrIsoTriCount,
+                                                    eavlWdgIsoTriCount,
+                                                    eavlHexIsoTriCount,
+                                                    eavlVoxIsoTriCount))),
+            "look up output tris per cell/level pair case");
+
+        // exclusive scan output counts to get output index
+        eavlExecutor::AddOperation(
+            new eavlPrefixSumOp_1(pairNumOut,
+                                  pairOutIndex,
+                                  false),
+            "scan to generate starting out geom index");
+
+        // count overall geometry
+        eavlExecutor::AddOperation(
+            new eavlReduceOp_1<eavlAddFunctor<int> >
+                (pairNumOut,
+                 totalout,
+                 eavlAddFunctor<int>()),
+            "sumreduce to count output geom");
+
+        eavlExecutor::Go();
+        noutgeom = totalout->GetValue(0);
+    }
     //cerr << "TOTAL GEOMETRY = "<<noutgeom<<endl;
     //cerr << "TOTAL NEW OUTPUT POINTS = "<<noutpts<<endl;
 
 
     ///\todo: some of these are temporary and should be deleted eventually
     /// (though right now we put them all in the output for debugging)
-    eavlIntArray *revPtEdgeIndex = new eavlIntArray("revPtEdgeIndex",1,noutpts);
-    eavlIntArray *revInputIndex = new eavlIntArray("revInputIndex", 1, noutgeom);
-    eavlIntArray *revInputSubindex = new eavlIntArray("revInputSubindex", 1, noutgeom);
-    eavlByteArray *outcaseArray = new eavlByteArray("outcase", 1, noutgeom);
-    eavlIntArray *localouttriArray = new eavlIntArray("localouttri", 3, noutgeom);
-    eavlIntArray *outtriArray = new eavlIntArray("outtri", 3, noutgeom);
-    eavlIntArray *outconn = new eavlIntArray("outconn", 3, noutgeom);
-    eavlFloatArray *alpha = new eavlFloatArray("alpha", 1, noutpts);
-    eavlFloatArray *newx = new eavlFloatArray("newx", 1, noutpts);
-    eavlFloatArray *newy = new eavlFloatArray("newy", 1, noutpts);
-    eavlFloatArray *newz = new eavlFloatArray("newz", 1, noutpts);
-
-    // do reverse index for outpts to inedges
-    eavlExecutor::AddOperation(
-        new eavlSimpleReverseIndexOp(edgeInclArray,
-                                     outpointindexArray,
-                                     revPtEdgeIndex),
-        "generate reverse lookup: output point to input edge");
-
+    eavlIntArray *revPairIndex, *revInputIndex, *revInputSubindex;
+    eavlByteArray *outcaseArray;
+    eavlIntArray *outlevelArray;
+    eavlIntArray *localouttriArray, *outtriArray, *outconn;
+    {
+        eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+        revPairIndex = new eavlIntArray("revPairIndex", 1, noutgeom);
+        revInputIndex = new eavlIntArray("revInputIndex", 1, noutgeom);
+        revInputSubindex = new eavlIntArray("revInputSubindex", 1, noutgeom);
+        outcaseArray = new eavlByteArray("outcase", 1, noutgeom);
+        outlevelArray = new eavlIntArray("outlevel", 1, noutgeom);
+        localouttriArray = new eavlIntArray("localouttri", 3, noutgeom);
+        outtriArray = useEdgeKeys ? NULL : new eavlIntArray("outtri", 3, noutgeom);
+        outconn = new eavlIntArray("outconn", 3, noutgeom);
+    }
 
-    // generate output(tri)-to-input(cell) map
+    // generate output(tri)-to-pair map, and from there to input cells
     eavlExecutor::AddOperation(
-        new eavlReverseIndexOp(numoutArray,
-                               outindexArray,
-                               revInputIndex,
+        new eavlReverseIndexOp(pairNumOut,
+                               pairOutIndex,
+                               revPairIndex,
                                revInputSubindex,
                                5),
-        "generate reverse lookup: output triangle to input cell");
+        "generate reverse lookup: output triangle to cell/level pair");
 
-    // gather input cell lookup to output-length array
     eavlExecutor::AddOperation(
-        new eavlGatherOp_1(caseArray,
+        new eavlGatherOp_1(pairCell,
+                           revInputIndex,
+                           revPairIndex),
+        "copy input cell index from pairs to output array for each generated triangle");
+
+    // gather pair case and level to output-length arrays
+    eavlExecutor::AddOperation(
+        new eavlGatherOp_1(pairCase,
                            outcaseArray,
-                           revInputIndex),
-        "copy input case from cells to output array for each generated triangle");
+                           revPairIndex),
+        "copy input case from pairs to output array for each generated triangle");
+
+    eavlExecutor::AddOperation(
+        new eavlGatherOp_1(pairLevel,
+                           outlevelArray,
+                           revPairIndex),
+        "copy level from pairs to output array for each generated triangle");
 
     // look up case+subindex in the table using input cell to get output geom
     ///\todo: is this operation plus the gatherop prior to it not just a combined eavlTopologyGatherMapOp??
@@ -411,38 +1226,99 @@ eavlIsosurfaceFilter::Execute()
                              eavlVoxIsoTriStart, eavlVoxIsoTriGeom)),
         "generate cell-local output triangle edge indices");
 
+    //
+    // Now figure out the output points.  Either way, we end up with
+    // a set of two-node elements, and for each output point the
+    // element it lies on and its level offset along that element.
+    //
+    eavlCellSet *ptCells;
+    eavlTopology ptTopology;
+    eavlCellSetExplicit *edgeCells = NULL;
+    eavlIntArray *revPtEdgeIndex, *revPtEdgeSubindex;
+    if (useEdgeKeys)
+    {
+        eavlExecutor::Go();
+        noutpts = MergeIsoPointsByEdgeKey(inCells, noutgeom,
+                                          revInputIndex,
+                                          localouttriArray,
+                                          outlevelArray,
+                                          bandArray,
+                                          outconn,
+                                          edgeCells,
+                                          revPtEdgeIndex,
+                                          revPtEdgeSubindex);
+        ptCells = edgeCells;
+        ptTopology = EAVL_NODES_OF_CELLS;
+    }
+    else
+    {
+        ptCells = inCells;
+        ptTopology = EAVL_NODES_OF_EDGES;
+        {
+            eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+            revPtEdgeIndex = new eavlIntArray("revPtEdgeIndex",1,noutpts);
+            revPtEdgeSubindex = new eavlIntArray("revPtEdgeSubindex",1,noutpts);
+        }
 
-    // map local cell edges to global ones from input mesh
-    eavlExecutor::AddOperation(
-        new eavlConnectivityDereferenceOp_3
-            (inCells,
-             EAVL_EDGES_OF_CELLS,
-             eavlArrayWithLinearIndex(localouttriArray, 0),
-             eavlArrayWithLinearIndex(localouttriArray, 1),
-             eavlArrayWithLinearIndex(localouttriArray, 2),
-             eavlArrayWithLinearIndex(outtriArray, 0),
-             eavlArrayWithLinearIndex(outtriArray, 1),
-             eavlArrayWithLinearIndex(outtriArray, 2),
-             revInputIndex),
-        "dereference cell-local edges to global edge ids");
-
-    // map global edge indices for triangles to output point index
-    ///\todo: this would be better with a gatherop_3, but even better
-    /// if we had an easy way to flatten the 3-component array into a
-    /// single-component array, since all components are treated identically.
-    eavlExecutor::AddOperation(new eavlGatherOp_1(outpointindexArray,
-                                                  eavlArrayWithLinearIndex(outconn,0),
-                                                  eavlArrayWithLinearIndex(outtriArray,0)),
-                               "(a) turn input edge ids (for output triangles) into output point ids");
-    eavlExecutor::AddOperation(new eavlGatherOp_1(outpointindexArray,
-                                                  eavlArrayWithLinearIndex(outconn,1),
-                                                  eavlArrayWithLinearIndex(outtriArray,1)),
-                               "(b) turn input edge ids (for output triangles) into output point ids");
-    eavlExecutor::AddOperation(new eavlGatherOp_1(outpointindexArray,
-                                                  eavlArrayWithLinearIndex(outconn,2),
-                                                  eavlArrayWithLinearIndex(outtriArray,2)),
-                               "(c) turn input edge ids (for output triangles) into output point ids");
-    
+        // do reverse index for outpts to inedges
+        eavlExecutor::AddOperation(
+            new eavlReverseIndexOp(edgeNumPtsArray,
+                                   outpointindexArray,
+                                   revPtEdgeIndex,
+                                   revPtEdgeSubindex,
+                                   nlevels),
+            "generate reverse lookup: output point to input edge");
+
+        // map local cell edges to global ones from input mesh
+        eavlExecutor::AddOperation(
+            new eavlConnectivityDereferenceOp_3
+                (inCells,
+                 EAVL_EDGES_OF_CELLS,
+                 eavlArrayWithLinearIndex(localouttriArray, 0),
+                 eavlArrayWithLinearIndex(localouttriArray, 1),
+                 eavlArrayWithLinearIndex(localouttriArray, 2),
+                 eavlArrayWithLinearIndex(outtriArray, 0),
+                 eavlArrayWithLinearIndex(outtriArray, 1),
+                 eavlArrayWithLinearIndex(outtriArray, 2),
+                 revInputIndex),
+            "dereference cell-local edges to global edge ids");
+
+        // map global edge indices for triangles to output point index,
+        // i.e. the edge's base index plus the triangle's level
+        ///\todo: this would be better with a gatherop_3, but even better
+        /// if we had an easy way to flatten the 3-component array into a
+        /// single-component array, since all components are treated identically.
+        eavlExecutor::AddOperation(new eavlGatherOp_1(edgeBaseArray,
+                                                      eavlArrayWithLinearIndex(outconn,0),
+                                                      eavlArrayWithLinearIndex(outtriArray,0)),
+                                   "(a) turn input edge ids (for output triangles) into output point ids");
+        eavlExecutor::AddOperation(new eavlGatherOp_1(edgeBaseArray,
+                                                      eavlArrayWithLinearIndex(outconn,1),
+                                                      eavlArrayWithLinearIndex(outtriArray,1)),
+                                   "(b) turn input edge ids (for output triangles) into output point ids");
+        eavlExecutor::AddOperation(new eavlGatherOp_1(edgeBaseArray,
+                                                      eavlArrayWithLinearIndex(outconn,2),
+                                                      eavlArrayWithLinearIndex(outtriArray,2)),
+                                   "(c) turn input edge ids (for output triangles) into output point ids");
+        for (int c=0; c<3; c++)
+        {
+            eavlExecutor::AddOperation(
+                new eavlMapOp_2_1<eavlAddFunctor<int> >(eavlArrayWithLinearIndex(outconn,c),
+                                                        outlevelArray,
+                                                        eavlArrayWithLinearIndex(outconn,c),
+                                                        eavlAddFunctor<int>()),
+                "offset output point ids by level");
+        }
+    }
+
+    eavlFloatArray *alpha;
+    {
+        eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+        alpha = new eavlFloatArray("alpha", 1, noutpts);
+    }
+    eavlFloatArray *newx = new eavlFloatArray("newx", 1, noutpts);
+    eavlFloatArray *newy = new eavlFloatArray("newy", 1, noutpts);
+    eavlFloatArray *newz = new eavlFloatArray("newz", 1, noutpts);
                                                     
     //
     // get the original coordinate arrays
@@ -488,21 +1364,22 @@ eavlIsosurfaceFilter::Execute()
 
     // generate alphas for each output 
     eavlExecutor::AddOperation(
-        new eavlTopologyGatherMapOp_1_0_1<CalcAlphaFunctor>
-            (inCells,
-             EAVL_NODES_OF_EDGES,
+        new eavlTopologyGatherMapOp_1_1_1<CalcAlphaFunctor>
+            (ptCells,
+             ptTopology,
              inField->GetArray(),
+             revPtEdgeSubindex,
              alpha,
              revPtEdgeIndex,
-             CalcAlphaFunctor(value)),
+             CalcAlphaFunctor(&levels, nlevels)),
         "generate alphas");
 
     // using the alphas, interpolate to create the new coordinate arrays
     ///\todo: better if this were eavlTopologyGatherMapOp_3_1_1.
     eavlExecutor::AddOperation(
         new eavlTopologyGatherMapOp_1_1_1<LinterpFunctor>
-            (inCells,
-             EAVL_NODES_OF_EDGES,
+            (ptCells,
+             ptTopology,
              ali0,
              alpha,
              newx,
@@ -511,8 +1388,8 @@ eavlIsosurfaceFilter::Execute()
         "generate x coords");
     eavlExecutor::AddOperation(
         new eavlTopologyGatherMapOp_1_1_1<LinterpFunctor>
-            (inCells,
-             EAVL_NODES_OF_EDGES,
+            (ptCells,
+             ptTopology,
              ali1,
              alpha,
              newy,
@@ -521,8 +1398,8 @@ eavlIsosurfaceFilter::Execute()
         "generate y coords");
     eavlExecutor::AddOperation(
         new eavlTopologyGatherMapOp_1_1_1<LinterpFunctor>
-            (inCells,
-             EAVL_NODES_OF_EDGES,
+            (ptCells,
+             ptTopology,
              ali2,
              alpha,
              newz,
@@ -531,53 +1408,21 @@ eavlIsosurfaceFilter::Execute()
         "generate z coords");
 
     /// interpolate the point vars and gather the cell vars
-    for (unsigned int i=0; i<input->GetNumFields(); i++)
-    {
-        eavlField *f = input->GetField(i);
-        eavlArray *a = f->GetArray();
-        if (f == field0 ||
-            f == field1 ||
-            f == field2)
-        {
-            // we already did the coord fields
-            continue;
-        }
-        if (f->GetArray()->GetNumberOfComponents() != 1)
-        {
-            ///\todo: currently only handle point and cell fields
-            continue;
-        }
+    eavlField *coordfields[3] = {field0, field1, field2};
+    AddIsoOutputFields(input, output, inCellSetIndex, coordfields,
+                       ptCells, ptTopology, revPtEdgeIndex, alpha,
+                       revInputIndex, noutpts, noutgeom);
 
-        if (f->GetAssociation() == eavlField::ASSOC_POINTS)
-        {
-            eavlArray *outArr = a->Create(a->GetName(), 1, noutpts);
-            eavlExecutor::AddOperation(
-              new eavlTopologyGatherMapOp_1_1_1<LinterpFunctor>
-                (inCells,
-                 EAVL_NODES_OF_EDGES,
-                 a,
-                 alpha,
-                 outArr,
-                 revPtEdgeIndex,
-                 LinterpFunctor()),
-              "interpolate nodal field");
-            output->AddField(new eavlField(1, outArr, eavlField::ASSOC_POINTS));
-        }
-        else if (f->GetAssociation() == eavlField::ASSOC_CELL_SET &&
-                 f->GetAssocCellSet() == inCellSetIndex)
-        {
-            eavlArray *outArr = a->Create(a->GetName(), 1, noutgeom);
-            eavlExecutor::AddOperation(new eavlGatherOp_1(a,
-                                                          outArr,
-                                                          revInputIndex),
-                                       "gather cell field");
-            output->AddField(
-                new eavlField(1, outArr, eavlField::ASSOC_CELL_SET, 0));
-        }
-        else
-        {
-            // skip field: either wrong cell set or not nodal/zonal assoc
-        }
+    // with more than one level, tag each triangle with its isovalue
+    if (nlevels > 1)
+    {
+        eavlFloatArray *levelArr = new eavlFloatArray("level", 1, noutgeom);
+        eavlExecutor::AddOperation(
+            new eavlMapOp_1_1<LevelValueFunctor>(outlevelArray,
+                                                 levelArr,
+                                                 LevelValueFunctor(&levels)),
+            "look up isovalue for each output triangle");
+        output->AddField(new eavlField(0, levelArr, eavlField::ASSOC_CELL_SET, 0));
     }
 
     //
@@ -631,10 +1476,9 @@ eavlIsosurfaceFilter::Execute()
     if (false)
     {
         // note: if we do this, we can't delete them in the destructor
-        input->AddField(new eavlField(0, hiloArray, eavlField::ASSOC_POINTS));
-        input->AddField(new eavlField(0, caseArray, eavlField::ASSOC_CELL_SET, 0));
-        input->AddField(new eavlField(0, numoutArray, eavlField::ASSOC_CELL_SET, 0));
-        input->AddField(new eavlField(0, outindexArray, eavlField::ASSOC_CELL_SET, 0));
+        input->AddField(new eavlField(0, bandArray, eavlField::ASSOC_POINTS));
+        input->AddField(new eavlField(0, numlevelsArray, eavlField::ASSOC_CELL_SET, 0));
+        input->AddField(new eavlField(0, pairindexArray, eavlField::ASSOC_CELL_SET, 0));
     }
 
     if (false)
@@ -643,6 +1487,7 @@ eavlIsosurfaceFilter::Execute()
         output->AddField(new eavlField(0, revInputIndex, eavlField::ASSOC_CELL_SET, 0));
         output->AddField(new eavlField(0, revInputSubindex, eavlField::ASSOC_CELL_SET, 0));
         output->AddField(new eavlField(0, outcaseArray, eavlField::ASSOC_CELL_SET, 0));
+        output->AddField(new eavlField(0, outlevelArray, eavlField::ASSOC_CELL_SET, 0));
         output->AddField(new eavlField(0, localouttriArray, eavlField::ASSOC_CELL_SET, 0));
         output->AddField(new eavlField(0, outtriArray, eavlField::ASSOC_CELL_SET, 0));    
         output->AddField(new eavlField(0, outconn, eavlField::ASSOC_CELL_SET, 0));
@@ -651,17 +1496,429 @@ eavlIsosurfaceFilter::Execute()
     else
     {
         delete revPtEdgeIndex;
+        delete revPtEdgeSubindex;
+        delete revPairIndex;
         delete revInputIndex;
         delete revInputSubindex;
         delete outcaseArray;
+        delete outlevelArray;
         delete localouttriArray;
         delete outtriArray;
         delete outconn;
         delete alpha;
     }
+    if (candidates)
+        delete candidates;
+    if (edgeCells)
+        delete edgeCells;
+    delete pairCell;
+    delete pairSubindex;
+    delete pairLevel;
+    delete pairCase;
+    delete pairNumOut;
+    delete pairOutIndex;
+    delete totalout;
+
+    output->AddField(new eavlField(1, newx, eavlField::ASSOC_POINTS));
+    output->AddField(new eavlField(1, newy, eavlField::ASSOC_POINTS));
+    output->AddField(new eavlField(1, newz, eavlField::ASSOC_POINTS));
+    eavlTimer::Resume();
+}
+
+// ****************************************************************************
+// Method:  eavlIsosurfaceFilter::ExecuteStructured
+//
+// Purpose:
+///   Flying-edges style isosurface of a 3D structured grid.  After
+///   classifying the nodes into bands, one parallel pass over the rows
+///   of edges and the rows of cells counts the output points and
+///   triangles per row.  A scan of those counts gives each row its
+///   output offsets, and a second parallel pass over the rows writes
+///   the points (interpolating the implicit coordinates directly) and
+///   the triangles, keeping a running output point cursor for each
+///   edge row a cell row touches.  No per-edge or per-cell arrays are
+///   needed.
+///
+///   Returns false, having done nothing, if this isn't a 3D structured
+///   cell set or the coordinates aren't of a supported kind.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+bool
+eavlIsosurfaceFilter::ExecuteStructured(eavlCellSet *inCells,
+                                        eavlField *inField,
+                                        const vector<float> &sortedvalues)
+{
+    eavlCellSetAllStructured *structCells =
+        dynamic_cast<eavlCellSetAllStructured*>(inCells);
+    if (!structCells)
+        return false;
+    eavlRegularStructure &reg = structCells->GetRegularStructure();
+    if (reg.dimension != 3)
+        return false;
+    IsoEdgeRows rows(reg);
+    const int xn = rows.xn, yn = rows.yn, zn = rows.zn;
+    const int xc = rows.xc, yc = rows.yc;
+    const int slice = xn * yn;
+    const int npts = slice * zn;
+    if (input->GetNumPoints() != npts ||
+        inField->GetArray()->GetNumberOfTuples() != npts)
+        return false;
+
+    eavlCoordinates *cs = input->GetCoordinateSystem(0);
+    if (cs->GetDimension() != 3)
+        return false;
+    IsoStructuredAxis axes[3];
+    eavlField *coordfields[3];
+    for (int c=0; c<3; c++)
+    {
+        if (!SetUpIsoStructuredAxis(input, cs->GetAxis(c), reg,
+                                    axes[c], coordfields[c]))
+            return false;
+    }
+
+    eavlTimer::Suspend();
+
+    int th_init = eavlTimer::Start();
+    eavlInitializeIsoTables();
+    int inCellSetIndex = input->GetCellSetIndex(cellsetname);
+    int nlevels = sortedvalues.size();
+    eavlConstArray<float> levels((float*)&sortedvalues[0], nlevels);
+    const byte *voxcount = eavlVoxIsoTriCount->host;
+    const int  *voxstart = eavlVoxIsoTriStart->host;
+    const byte *voxgeom  = eavlVoxIsoTriGeom->host;
+    eavlGhostCells ghosts(input, inCellSetIndex);
+    const byte *ghost = ghosts.GetFlags();
+    int edgeCursor[12], edgeNext[12];
+    GetIsoVoxelEdgeCursors(edgeCursor, edgeNext);
+
+    IsoFloatValues scalars;
+    scalars.Set(inField->GetArray(), 0);
+    {
+        eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+        if (bandArray && bandArray->GetNumberOfTuples() != npts)
+        {
+            delete bandArray;
+            bandArray = NULL;
+        }
+        if (!bandArray)
+            bandArray = new eavlByteArray("band", 1, npts);
+    }
+    byte *band = (byte*)bandArray->GetHostArray();
+
+    eavlCellSetExplicit *outCellSet = new eavlCellSetExplicit("iso",2);
+    output->AddCellSet(outCellSet);
+    eavlTimer::Stop(th_init, "initialization");
+
+    //
+    // classify each node against all levels at once
+    //
+    int th_classify = eavlTimer::Start();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int n=0; n<npts; n++)
+        band[n] = FindIsoBand(levels, nlevels, scalars[n]);
+    eavlTimer::Stop(th_classify, "generate band per node");
+
+    //
+    // pass 1: count output points per edge row (one per level crossed
+    // by each edge), and output triangles per cell row.  The x rows
+    // come first, as they find the trimming for the rest.
+    //
+    int th_count = eavlTimer::Start();
+    const int nxrows = rows.nxrows;
+    const int ystart = rows.nxrows;
+    const int zstart = rows.nxrows + rows.nyrows;
+    int nrows = rows.GetNumRows();
+    int ncellrows = yc * rows.zc;
+    vector<int> rowPtStart(nrows + 1, 0);
+    vector<int> rowTriStart(ncellrows + 1, 0);
+    vector<int> trimLo(nxrows), trimHi(nxrows);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic,16)
+#endif
+    for (int r=0; r<nxrows; r++)
+    {
+        const byte *b = band + r*xn;
+        int n = 0, first = xc, last = 0;
+        for (int i=0; i<xc; i++)
+        {
+            int d = IsoBandDiff(b[i], b[i+1]);
+            if (d)
+            {
+                n += d;
+                first = (i < first) ? i : first;
+                last = i+1;
+            }
+        }
+        rowPtStart[r] = n;
+        trimLo[r] = first;
+        trimHi[r] = last;
+    }
+#ifdef HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic,16)
+#endif
+    for (int r=nxrows; r<nrows; r++)
+    {
+        int node0, offset, dir, nedges, edge0;
+        rows.GetRow(r, node0, offset, dir, nedges, edge0);
+        int xrows[2] = {node0 / xn, (node0 + offset) / xn};
+        int lo, hi;
+        GetIsoTrim(band, xn, &trimLo[0], &trimHi[0], 2, xrows, lo, hi);
+        const byte *b0 = band + node0;
+        const byte *b1 = b0 + offset;
+        int n = IsoBandDiff(b0[0], b1[0]) * lo;
+        if (lo < hi)
+        {
+            for (int i=lo; i<=hi; i++)
+                n += IsoBandDiff(b0[i], b1[i]);
+            n += IsoBandDiff(b0[xc], b1[xc]) * (xc - hi);
+        }
+        else
+        {
+            // (both rows hold a single band throughout)
+            n = IsoBandDiff(b0[0], b1[0]) * xn;
+        }
+        rowPtStart[r] = n;
+    }
+#ifdef HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic,16)
+#endif
+    for (int r=0; r<ncellrows; r++)
+    {
+        int x0 = (r / yc) * yn + (r % yc);
+        int xrows[4] = {x0, x0+1, x0+yn, x0+yn+1};
+        int lo, hi;
+        GetIsoTrim(band, xn, &trimLo[0], &trimHi[0], 4, xrows, lo, hi);
+        const byte *b = band + x0*xn + lo;
+        int n = 0;
+        for (int i=lo; i<hi; i++, b++)
+        {
+            int blo, bhi;
+            float cb[8];
+            if (!GetIsoVoxelBands(b, xn, slice, cb, blo, bhi))
+                continue;
+            if (ghost && ghost[r*xc + i])
+                continue;
+            for (int level=blo; level<bhi; level++)
+                n += voxcount[IsoCaseForLevel(8, cb, level)];
+        }
+        rowTriStart[r] = n;
+    }
+    int noutpts = IsoExclusiveScan(rowPtStart);
+    int noutgeom = IsoExclusiveScan(rowTriStart);
+    eavlTimer::Stop(th_count, "count output points and triangles per row");
+
+    //
+    // allocate the output
+    //
+    eavlIntArray *revPtEdgeIndex, *revInputIndex;
+    eavlFloatArray *alpha;
+    {
+        eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+        revPtEdgeIndex = new eavlIntArray("revPtEdgeIndex", 1, noutpts);
+        alpha = new eavlFloatArray("alpha", 1, noutpts);
+        revInputIndex = new eavlIntArray("revInputIndex", 1, noutgeom);
+    }
+    eavlFloatArray *newx = new eavlFloatArray("newx", 1, noutpts);
+    eavlFloatArray *newy = new eavlFloatArray("newy", 1, noutpts);
+    eavlFloatArray *newz = new eavlFloatArray("newz", 1, noutpts);
+    eavlFloatArray *levelArr = NULL;
+    if (nlevels > 1)
+        levelArr = new eavlFloatArray("level", 1, noutgeom);
+
+    eavlExplicitConnectivity conn;
+    conn.shapetype.resize(noutgeom);
+    conn.connectivity.resize(4*noutgeom);
+
+    //
+    // pass 2a: generate the points on each edge row
+    //
+    int th_points = eavlTimer::Start();
+    if (noutpts > 0)
+    {
+        int   *ptedge = (int*)revPtEdgeIndex->GetHostArray();
+        float *ptalpha = (float*)alpha->GetHostArray();
+        float *px = (float*)newx->GetHostArray();
+        float *py = (float*)newy->GetHostArray();
+        float *pz = (float*)newz->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic,16)
+#endif
+        for (int r=0; r<nrows; r++)
+        {
+            int p = rowPtStart[r];
+            if (p == rowPtStart[r+1])
+                continue;
+            int node0, offset, dir, nedges, edge0;
+            rows.GetRow(r, node0, offset, dir, nedges, edge0);
+            int first = 0, last = nedges;
+            if (r < nxrows)
+            {
+                first = trimLo[r];
+                last = trimHi[r];
+            }
+            int ijk0[3] = {first, (node0 / xn) % yn, node0 / slice};
+            int ijk1[3] = {ijk0[0], ijk0[1], ijk0[2]};
+            ijk1[dir]++;
+            for (int i=first; i<last; i++, ijk0[0]++, ijk1[0]++)
+            {
+                int n0 = node0 + i, n1 = n0 + offset;
+                int b0 = band[n0], b1 = band[n1];
+                if (b0 == b1)
+                    continue;
+                int lo = (b0 < b1) ? b0 : b1;
+                int cnt = (b0 < b1) ? (b1 - b0) : (b0 - b1);
+                float f0 = scalars[n0], f1 = scalars[n1];
+                float x0 = axes[0](n0, ijk0), x1 = axes[0](n1, ijk1);
+                float y0 = axes[1](n0, ijk0), y1 = axes[1](n1, ijk1);
+                float z0 = axes[2](n0, ijk0), z1 = axes[2](n1, ijk1);
+                for (int s=0; s<cnt; s++, p++)
+                {
+                    float a = (sortedvalues[lo + s] - f0) / (f1 - f0);
+                    ptedge[p] = edge0 + i;
+                    ptalpha[p] = a;
+                    px[p] = x0 + a*(x1-x0);
+                    py[p] = y0 + a*(y1-y0);
+                    pz[p] = z0 + a*(z1-z0);
+                }
+            }
+        }
+    }
+    eavlTimer::Stop(th_points, "generate output points per edge row");
+
+    //
+    // pass 2b: generate the triangles in each cell row
+    //
+    int th_tris = eavlTimer::Start();
+    if (noutgeom > 0)
+    {
+        int   *cellindex = (int*)revInputIndex->GetHostArray();
+        float *levelval = levelArr ? (float*)levelArr->GetHostArray() : NULL;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic,16)
+#endif
+        for (int r=0; r<ncellrows; r++)
+        {
+            int t = rowTriStart[r];
+            if (t == rowTriStart[r+1])
+                continue;
+            int j = r % yc, k = r / yc;
+            int x0 = k*yn + j;
+            int xrows[4] = {x0, x0+1, x0+yn, x0+yn+1};
+            int lo, hi;
+            GetIsoTrim(band, xn, &trimLo[0], &trimHi[0], 4, xrows, lo, hi);
+            int cursor[8] = {rowPtStart[k*yn + j],
+                             rowPtStart[k*yn + j+1],
+                             rowPtStart[(k+1)*yn + j],
+                             rowPtStart[(k+1)*yn + j+1],
+                             rowPtStart[ystart + k*yc + j],
+                             rowPtStart[ystart + (k+1)*yc + j],
+                             rowPtStart[zstart + k*yn + j],
+                             rowPtStart[zstart + k*yn + j+1]};
+            // every edge before the trimmed span has as many points
+            // as the first one in its row
+            const byte *b = band + x0*xn;
+            for (int c=0; c<8; c++)
+            {
+                int n0 = isoCursorNodes[c][0], n1 = isoCursorNodes[c][1];
+                int o0 = (n0 & 1) + ((n0 & 2) ? xn : 0) + ((n0 & 4) ? slice : 0);
+                int o1 = (n1 & 1) + ((n1 & 2) ? xn : 0) + ((n1 & 4) ? slice : 0);
+                cursor[c] += lo * IsoBandDiff(b[o0], b[o1]);
+            }
+
+            b += lo;
+            for (int i=lo; i<hi; i++, b++)
+            {
+                // (if no level is crossed, no edge has any points)
+                int blo, bhi;
+                float cb[8];
+                if (!GetIsoVoxelBands(b, xn, slice, cb, blo, bhi))
+                    continue;
+
+                int cnt[8];
+                for (int c=0; c<8; c++)
+                {
+                    int d = int(cb[isoCursorNodes[c][0]]) - int(cb[isoCursorNodes[c][1]]);
+                    cnt[c] = (d < 0) ? -d : d;
+                }
+                // the point for level L on local edge e is edgeBase[e]+L
+                int edgeBase[12];
+                for (int e=0; e<12; e++)
+                {
+                    int c = edgeCursor[e];
+                    float ba = cb[int(eavlVoxEdges[e][0])];
+                    float bb = cb[int(eavlVoxEdges[e][1])];
+                    edgeBase[e] = cursor[c] + (edgeNext[e] ? cnt[c] : 0) -
+                                  int(ba < bb ? ba : bb);
+                }
+
+                // (ghost cells still step the cursors past their edges)
+                int cell = r*xc + i;
+                if (ghost && ghost[cell])
+                    bhi = blo;
+                for (int level=blo; level<bhi; level++)
+                {
+                    int caseindex = IsoCaseForLevel(8, cb, level);
+                    int ntris = voxcount[caseindex];
+                    const byte *geom = voxgeom + voxstart[caseindex];
+                    for (int tri=0; tri<ntris; tri++, t++, geom+=3)
+                    {
+                        conn.shapetype[t] = EAVL_TRI;
+                        conn.connectivity[4*t+0] = 3;
+                        conn.connectivity[4*t+1] = edgeBase[geom[0]] + level;
+                        conn.connectivity[4*t+2] = edgeBase[geom[1]] + level;
+                        conn.connectivity[4*t+3] = edgeBase[geom[2]] + level;
+                        cellindex[t] = cell;
+                        if (levelval)
+                            levelval[t] = sortedvalues[level];
+                    }
+                }
+
+                for (int c=0; c<8; c++)
+                    cursor[c] += cnt[c];
+            }
+        }
+    }
+    eavlTimer::Stop(th_tris, "generate output triangles per cell row");
+
+    //
+    // the other fields are handled just like the general path, with
+    // the structured grid's own edges as the two-node elements
+    //
+    AddIsoOutputFields(input, output, inCellSetIndex, coordfields,
+                       inCells, EAVL_NODES_OF_EDGES, revPtEdgeIndex, alpha,
+                       revInputIndex, noutpts, noutgeom);
+    if (levelArr)
+        output->AddField(new eavlField(0, levelArr, eavlField::ASSOC_CELL_SET, 0));
+
+    output->SetNumPoints(noutpts);
+    eavlCoordinatesCartesian *coordsys =
+        new eavlCoordinatesCartesian(NULL,
+                                     eavlCoordinatesCartesian::X,
+                                     eavlCoordinatesCartesian::Y,
+                                     eavlCoordinatesCartesian::Z);
+    coordsys->SetAxis(0, new eavlCoordinateAxisField("newx", 0));
+    coordsys->SetAxis(1, new eavlCoordinateAxisField("newy", 0));
+    coordsys->SetAxis(2, new eavlCoordinateAxisField("newz", 0));
+    output->AddCoordinateSystem(coordsys);
+
+    eavlExecutor::Go();
+
+    int th_create_revindex = eavlTimer::Start();
+    outCellSet->SetCellNodeConnectivity(conn);
+    eavlTimer::Stop(th_create_revindex, "create reverse index for connectivity");
+
+    delete revPtEdgeIndex;
+    delete revInputIndex;
+    delete alpha;
 
     output->AddField(new eavlField(1, newx, eavlField::ASSOC_POINTS));
     output->AddField(new eavlField(1, newy, eavlField::ASSOC_POINTS));
     output->AddField(new eavlField(1, newz, eavlField::ASSOC_POINTS));
     eavlTimer::Resume();
+    return true;
 }
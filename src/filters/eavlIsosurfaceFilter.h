@@ -7,31 +7,86 @@
 #include "eavlCellSet.h"
 #include "eavlFilter.h"
 #include "eavlArray.h"
+#include "eavlMetaCellIndex.h"
 
 // ****************************************************************************
 // Class:  eavlIsosurfaceFilter
 //
 // Purpose:
 ///  Generate a triangle-mesh isosurface from volumetric elements.
+///  Any number of isovalues may be extracted in a single pass; each
+///  node is classified once into the band of isovalues it falls
+///  between, and a cell or edge only does work for the levels its
+///  nodes actually span.  With more than one isovalue, the output
+///  gets a "level" cell field holding each triangle's isovalue.
+///
+///  For repeated isosurfacing of the same field, SetUseMetaCells
+///  keeps a min/max metacell index across calls so that only cells
+///  in blocks whose value range spans an isovalue are classified.
+///  The index is rebuilt automatically when the cell set or field
+///  array changes; call InvalidateMetaCells after changing the field
+///  values in place.
+///
+///  By default output points are numbered through the input's global
+///  edge list, which explicit cell sets must build on first use.
+///  SetUseEdgeKeys instead identifies each output point by the
+///  (min node, max node) pair of the edge it lies on, plus its level.
+///  Only the edges the surface actually crosses are ever touched, and
+///  they are merged by sorting their keys.  The triangles are the
+///  same; only the order of the output points differs.
+///
+///  A 3D eavlCellSetAllStructured input (with regular, rectilinear or
+///  curvilinear coordinates) instead takes a flying-edges style path
+///  by default: edges are classified and output counted row by row,
+///  and after a scan over the row counts a second pass over the rows
+///  writes the points and triangles directly, using the implicit
+///  topology and coordinates in place of any global edge arrays or
+///  per-cell intermediates.  The output is identical to the general
+///  path's.  Metacells and edge keys only apply to the general path,
+///  which SetUseStructuredPath(false) forces.
+///
+///  Ghost cells (see eavlGhostCells) generate no triangles on either
+///  path.
 //
 // Programmer:  Jeremy Meredith, Dave Pugmire, Sean Ahern
 // Creation:    February 3, 2012
 //
+// Modifications:
+//   agent, Sun Oct 18 2026
+//   Accept a list of isovalues and contour all of them in one pass.
+//
+//   agent, Sun Oct 18 2026
+//   Optionally skip inactive cells using a metacell index.
+//
+//   agent, Sun Oct 18 2026
+//   Added a mode that merges points by edge node pairs instead of
+//   requiring global edge connectivity.
+//
+//   agent, Sun Oct 18 2026
+//   Added a row-based fast path for structured grids.
+//
+//   agent, Sun Oct 18 2026
+//   Skip ghost cells.
+//
 // ****************************************************************************
 class eavlIsosurfaceFilter : public eavlFilter
 {
   protected:
     string fieldname;
     string cellsetname;
-    double value;
+    vector<double> values;
+    bool useMetaCells;
+    bool useEdgeKeys;
+    bool useStructuredPath;
+    eavlMetaCellIndex *metacells;
 
-    eavlByteArray *hiloArray;
-    eavlByteArray *caseArray;
-    eavlIntArray *numoutArray;
-    eavlIntArray *outindexArray;
-    eavlIntArray *totalout;
-    eavlIntArray *edgeInclArray;
+    eavlByteArray *bandArray;
+    eavlIntArray *numlevelsArray;
+    eavlIntArray *pairindexArray;
+    eavlIntArray *totalpairs;
+    eavlIntArray *edgeNumPtsArray;
     eavlIntArray *outpointindexArray;
+    eavlIntArray *edgeBaseArray;
     eavlIntArray *totaloutpts;
 
   public:
@@ -47,10 +102,40 @@ class eavlIsosurfaceFilter : public eavlFilter
     }
     void SetIsoValue(double val)
     {
-        value = val;
+        values.clear();
+        values.push_back(val);
+    }
+    void SetIsoValues(const vector<double> &vals)
+    {
+        values = vals;
+    }
+    void SetUseMetaCells(bool use)
+    {
+        useMetaCells = use;
+    }
+    void SetUseEdgeKeys(bool use)
+    {
+        useEdgeKeys = use;
+    }
+    void SetUseStructuredPath(bool use)
+    {
+        useStructuredPath = use;
+    }
+    void InvalidateMetaCells()
+    {
+        if (metacells)
+            metacells->Invalidate();
+    }
+    eavlMetaCellIndex *GetMetaCellIndex()
+    {
+        return metacells;
     }
     
     virtual void Execute();
+
+  protected:
+    bool ExecuteStructured(eavlCellSet *inCells, eavlField *inField,
+                           const vector<float> &sortedvalues);
 };
 
 #endif
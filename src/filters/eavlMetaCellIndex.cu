@@ -0,0 +1,237 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlMetaCellIndex.h"
+
+#include "eavlExecutor.h"
+#include "eavlCellSetAllStructured.h"
+#include "eavlCellSetExplicit.h"
+#include "eavlTopologyMapOp_1_0_1.h"
+#include "eavlException.h"
+#include "eavlMemoryTracker.h"
+#include "eavlTimer.h"
+
+class CellMinValueFunctor
+{
+  public:
+    EAVL_FUNCTOR float operator()(int shapeType, int n, float vals[])
+    {
+        if (n <= 0)
+            return 0;
+        float v = vals[0];
+        for (int i=1; i<n; ++i)
+            if (vals[i] < v)
+                v = vals[i];
+        return v;
+    }
+};
+
+class CellMaxValueFunctor
+{
+  public:
+    EAVL_FUNCTOR float operator()(int shapeType, int n, float vals[])
+    {
+        if (n <= 0)
+            return 0;
+        float v = vals[0];
+        for (int i=1; i<n; ++i)
+            if (vals[i] > v)
+                v = vals[i];
+        return v;
+    }
+};
+
+eavlMetaCellIndex::eavlMetaCellIndex(int cellsPerBlock)
+    : blocksize(cellsPerBlock)
+{
+    if (blocksize < 1)
+        THROW(eavlException,"eavlMetaCellIndex needs at least one cell per block");
+    cells = NULL;
+    array = NULL;
+    ncells = 0;
+    npts = 0;
+    buildTime = 0;
+    Invalidate();
+}
+
+// ****************************************************************************
+// Method:  eavlMetaCellIndex::Build
+//
+// Purpose:
+///   Compute the value range of every metacell.  Each cell's range is
+///   found with the usual topology map (so any cell set type works),
+///   and then reduced per block of cells.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+void
+eavlMetaCellIndex::Build(eavlCellSet *inCells, eavlField *field)
+{
+    if (field->GetAssociation() != eavlField::ASSOC_POINTS)
+        THROW(eavlException,"eavlMetaCellIndex expected point-centered field");
+
+    int th = eavlTimer::Start();
+    cells = inCells;
+    array = field->GetArray();
+    ncells = cells->GetNumCells();
+    npts = array->GetNumberOfTuples();
+
+    eavlFloatArray *cellMin, *cellMax;
+    {
+        eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+        cellMin = new eavlFloatArray("cellmin", 1, ncells);
+        cellMax = new eavlFloatArray("cellmax", 1, ncells);
+    }
+    eavlExecutor::AddOperation(
+        new eavlTopologyMapOp_1_0_1<CellMinValueFunctor>(cells,
+                                                         EAVL_NODES_OF_CELLS,
+                                                         array,
+                                                         cellMin,
+                                                         CellMinValueFunctor()),
+        "find minimum node value per cell");
+    eavlExecutor::AddOperation(
+        new eavlTopologyMapOp_1_0_1<CellMaxValueFunctor>(cells,
+                                                         EAVL_NODES_OF_CELLS,
+                                                         array,
+                                                         cellMax,
+                                                         CellMaxValueFunctor()),
+        "find maximum node value per cell");
+    eavlExecutor::Go();
+
+    int nblocks = (ncells + blocksize - 1) / blocksize;
+    blockMin.resize(nblocks);
+    blockMax.resize(nblocks);
+    const float *mn = (const float*)cellMin->GetHostArray();
+    const float *mx = (const float*)cellMax->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int b=0; b<nblocks; b++)
+    {
+        int first = b * blocksize;
+        int last = std::min(first + blocksize, ncells);
+        float lo = mn[first], hi = mx[first];
+        for (int c=first+1; c<last; c++)
+        {
+            if (mn[c] < lo)
+                lo = mn[c];
+            if (mx[c] > hi)
+                hi = mx[c];
+        }
+        blockMin[b] = lo;
+        blockMax[b] = hi;
+    }
+
+    delete cellMin;
+    delete cellMax;
+
+    valid = true;
+    nqueries = 0;
+    lastCandidateBlocks = 0;
+    lastCandidateCells = 0;
+    buildTime = eavlTimer::Stop(th, "build metacell index");
+}
+
+bool
+eavlMetaCellIndex::IsValidFor(eavlCellSet *inCells, eavlField *field)
+{
+    return (valid &&
+            inCells == cells &&
+            field->GetArray() == array &&
+            inCells->GetNumCells() == ncells &&
+            array->GetNumberOfTuples() == npts);
+}
+
+void
+eavlMetaCellIndex::Invalidate()
+{
+    valid = false;
+    nqueries = 0;
+    lastCandidateBlocks = 0;
+    lastCandidateCells = 0;
+    blockMin.clear();
+    blockMax.clear();
+}
+
+// ****************************************************************************
+// Method:  eavlMetaCellIndex::FindCandidateCells
+//
+// Purpose:
+///   Return (as a new array owned by the caller) the indices of all
+///   cells in metacells that might intersect at least one of the
+///   given isovalues, in increasing order.  A cell whose nodes span
+///   [lo,hi] crosses isovalue v when lo < v <= hi, matching the
+///   hi/lo classification the isosurface filter uses.
+//
+// Arguments:
+//   sortedvalues   the isovalues, sorted increasing
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+eavlIntArray *
+eavlMetaCellIndex::FindCandidateCells(const vector<float> &sortedvalues)
+{
+    if (!valid)
+        THROW(eavlException,"eavlMetaCellIndex was queried before being built");
+
+    int nblocks = blockMin.size();
+    vector<int> blockStart(nblocks+1);
+    blockStart[0] = 0;
+    for (int b=0; b<nblocks; b++)
+    {
+        int lo = std::upper_bound(sortedvalues.begin(), sortedvalues.end(),
+                                  blockMin[b]) - sortedvalues.begin();
+        int hi = std::upper_bound(sortedvalues.begin(), sortedvalues.end(),
+                                  blockMax[b]) - sortedvalues.begin();
+        int n = 0;
+        if (lo != hi)
+            n = std::min(blocksize, ncells - b*blocksize);
+        blockStart[b+1] = blockStart[b] + n;
+    }
+
+    int ncandidates = blockStart[nblocks];
+    eavlIntArray *candidates;
+    {
+        eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+        candidates = new eavlIntArray("candidates", 1, ncandidates);
+    }
+    int *ids = (int*)candidates->GetHostArray();
+    int nactive = 0;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for reduction(+:nactive)
+#endif
+    for (int b=0; b<nblocks; b++)
+    {
+        int n = blockStart[b+1] - blockStart[b];
+        for (int i=0; i<n; i++)
+            ids[blockStart[b] + i] = b*blocksize + i;
+        if (n > 0)
+            nactive++;
+    }
+
+    nqueries++;
+    lastCandidateBlocks = nactive;
+    lastCandidateCells = ncandidates;
+    return candidates;
+}
+
+void
+eavlMetaCellIndex::PrintSummary(ostream &out)
+{
+    out << "eavlMetaCellIndex:" << endl;
+    out << "    cellsPerBlock = " << blocksize << endl;
+    out << "    valid = " << valid << endl;
+    out << "    ncells = " << ncells << endl;
+    out << "    nblocks = " << blockMin.size() << endl;
+    out << "    buildTime = " << buildTime << endl;
+    out << "    nqueries = " << nqueries << endl;
+    if (nqueries > 0 && ncells > 0)
+    {
+        out << "    lastQuery: " << lastCandidateBlocks << " blocks, "
+            << lastCandidateCells << " cells ("
+            << (100. * lastCandidateCells / ncells) << "% of all cells)"
+            << endl;
+    }
+}
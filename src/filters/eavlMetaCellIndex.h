@@ -0,0 +1,66 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_META_CELL_INDEX_H
+#define EAVL_META_CELL_INDEX_H
+
+#include "STL.h"
+#include "eavlCellSet.h"
+#include "eavlField.h"
+#include "eavlArray.h"
+
+// ****************************************************************************
+// Class:  eavlMetaCellIndex
+//
+// Purpose:
+///   A min/max interval index over a point-centered scalar for repeated
+///   isosurfacing.  Cells are grouped into metacells of a fixed number
+///   of consecutive cell indices, and the range of the node values of
+///   all cells in each metacell is recorded.  A query for a set of
+///   isovalues then returns only the cells of metacells whose range
+///   contains one of them, without touching any other cell.
+///
+///   The index remembers the cell set and field array it was built
+///   from and IsValidFor() only accepts the same ones with the same
+///   sizes.  Nothing can detect values being changed in place in the
+///   same array, so callers doing that must call Invalidate().
+///
+///   The build time and the fraction of cells returned by the most
+///   recent query are kept, so the build cost can be weighed against
+///   the per-query savings (see PrintSummary).
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlMetaCellIndex
+{
+  protected:
+    int           blocksize;
+    eavlCellSet  *cells;
+    eavlArray    *array;
+    int           ncells;
+    int           npts;
+    bool          valid;
+    vector<float> blockMin;
+    vector<float> blockMax;
+
+    double        buildTime;
+    int           nqueries;
+    int           lastCandidateBlocks;
+    int           lastCandidateCells;
+
+  public:
+    eavlMetaCellIndex(int cellsPerBlock = 64);
+
+    void   Build(eavlCellSet *cells, eavlField *field);
+    bool   IsValidFor(eavlCellSet *cells, eavlField *field);
+    void   Invalidate();
+
+    eavlIntArray *FindCandidateCells(const vector<float> &sortedvalues);
+
+    int    GetNumBlocks()               { return blockMin.size(); }
+    double GetBuildTime()               { return buildTime; }
+    int    GetLastNumCandidateCells()   { return lastCandidateCells; }
+    void   PrintSummary(ostream &out);
+};
+
+#endif
@@ -0,0 +1,112 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlNodeStencilMutator.h"
+#include "eavlException.h"
+#include "eavlExecutor.h"
+#include "eavlLogicalStructureRegular.h"
+#include "eavlNodeStencilOp.h"
+
+template <int D>
+static eavlOperation *
+NewNodeStencilOp(int radius, eavlRegularStructure &reg,
+                 eavlArray *in, eavlFloatArray *out,
+                 const float *weights, bool separable)
+{
+    switch (radius)
+    {
+      case 1:
+        return new eavlNodeStencilOp<D,1>(reg, in, out, weights, separable);
+      case 2:
+        return new eavlNodeStencilOp<D,2>(reg, in, out, weights, separable);
+      case 3:
+        return new eavlNodeStencilOp<D,3>(reg, in, out, weights, separable);
+    }
+    THROW(eavlException, "eavlNodeStencilMutator supports a radius of 1 to 3");
+}
+
+
+eavlNodeStencilMutator::eavlNodeStencilMutator()
+    : type(Smooth), radius(1)
+{
+}
+
+
+void
+eavlNodeStencilMutator::Execute()
+{
+    eavlField *field = dataset->GetField(fieldname);
+    if (field->GetAssociation() != eavlField::ASSOC_POINTS)
+        THROW(eavlException, "eavlNodeStencilMutator expects a point field");
+
+    eavlLogicalStructureRegular *logReg =
+        dynamic_cast<eavlLogicalStructureRegular*>(dataset->GetLogicalStructure());
+    if (!logReg)
+        THROW(eavlException, "eavlNodeStencilMutator expects a structured grid");
+    eavlRegularStructure &reg = logReg->GetRegularStructure();
+    int dim = reg.dimension;
+    if (dim < 1 || dim > 3)
+        THROW(eavlException, "eavlNodeStencilMutator expects a 1D, 2D, or 3D grid");
+
+    int r = (type == Laplacian) ? 1 : radius;
+    int width = 2*r + 1;
+    bool separable = (type != Laplacian);
+    vector<float> weights;
+    if (type == Box)
+    {
+        weights.resize(width, 1.f / float(width));
+    }
+    else if (type == Smooth)
+    {
+        // binomial coefficients, i.e. a row of Pascal's triangle
+        weights.resize(width, 0.f);
+        weights[0] = 1;
+        for (int row = 1; row < width; row++)
+            for (int i = row; i > 0; i--)
+                weights[i] += weights[i-1];
+        float sum = 0;
+        for (int i = 0; i < width; i++)
+            sum += weights[i];
+        for (int i = 0; i < width; i++)
+            weights[i] /= sum;
+    }
+    else
+    {
+        // 3^dim weights with x fastest: -2*dim at the center and 1 at
+        // the face neighbors
+        int nweights = (dim == 1) ? 3 : ((dim == 2) ? 9 : 27);
+        int center = nweights / 2;
+        weights.resize(nweights, 0.f);
+        weights[center] = -2.f * dim;
+        for (int d = 0, stride = 1; d < dim; d++, stride *= 3)
+        {
+            weights[center - stride] = 1;
+            weights[center + stride] = 1;
+        }
+    }
+
+    eavlArray *array = field->GetArray();
+    string name = resultname;
+    if (name == "")
+    {
+        if (type == Box)
+            name = "box_" + fieldname;
+        else if (type == Smooth)
+            name = "smooth_" + fieldname;
+        else
+            name = "laplacian_" + fieldname;
+    }
+    eavlFloatArray *out = new eavlFloatArray(name,
+                                             array->GetNumberOfComponents(),
+                                             array->GetNumberOfTuples());
+
+    eavlOperation *op;
+    if (dim == 1)
+        op = NewNodeStencilOp<1>(r, reg, array, out, &weights[0], separable);
+    else if (dim == 2)
+        op = NewNodeStencilOp<2>(r, reg, array, out, &weights[0], separable);
+    else
+        op = NewNodeStencilOp<3>(r, reg, array, out, &weights[0], separable);
+    eavlExecutor::AddOperation(op, "node stencil");
+    eavlExecutor::Go();
+
+    dataset->AddField(new eavlField(0, out, eavlField::ASSOC_POINTS));
+}
@@ -0,0 +1,58 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_NODE_STENCIL_MUTATOR_H
+#define EAVL_NODE_STENCIL_MUTATOR_H
+
+#include "STL.h"
+#include "eavlFilter.h"
+
+// ****************************************************************************
+// Class:  eavlNodeStencilMutator
+//
+// Purpose:
+///   Add a filtered copy of a point field on a 1D, 2D, or 3D structured
+///   grid, using eavlNodeStencilOp:
+///   - Box: the plain average of the (2r+1)^d nodes around each node.
+///   - Smooth: a binomial (approximately Gaussian) weighted average.
+///   - Laplacian: the discrete Laplacian in index space, i.e. the sum
+///     over the axes of the second difference with unit node spacing.
+///   Box and Smooth are separable; the radius r is 1, 2, or 3 and is
+///   ignored for the Laplacian.  Values past the grid edges repeat the
+///   edge values.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlNodeStencilMutator : public eavlMutator
+{
+  public:
+    enum StencilType { Box, Smooth, Laplacian };
+  protected:
+    string      fieldname;
+    string      resultname;
+    StencilType type;
+    int         radius;
+  public:
+    eavlNodeStencilMutator();
+    void SetField(const string &name)
+    {
+        fieldname = name;
+    }
+    /// Defaults to "box_<field>", "smooth_<field>", or "laplacian_<field>".
+    void SetResultName(const string &name)
+    {
+        resultname = name;
+    }
+    void SetType(StencilType t)
+    {
+        type = t;
+    }
+    void SetRadius(int r)
+    {
+        radius = r;
+    }
+
+    virtual void Execute();
+};
+
+#endif
@@ -0,0 +1,134 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlRecenterMutator.h"
+#include "eavlDataSet.h"
+#include "eavlException.h"
+#include "eavlExecutor.h"
+#include "eavlNodePositions.h"
+#include "eavlShapeFunctions.h"
+#include "eavlTopologyAverageOp.h"
+
+// ----------------------------------------------------------------------------
+// the length, area, or volume of each cell in a cell set
+static eavlFloatArray *
+GetCellMeasures(eavlDataSet *ds, eavlCellSet *cellSet)
+{
+    eavlNodePositions positions(ds);
+
+    int ncells = cellSet->GetNumCells();
+    eavlFloatArray *measures = new eavlFloatArray("measure", 1, ncells);
+    float *m = (float*)measures->GetHostArray();
+
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < ncells; i++)
+    {
+        eavlCell cell = cellSet->GetCellNodes(i);
+        double pts[3*12];
+        for (int n = 0; n < cell.numIndices && n < 12; n++)
+        {
+            float x, y, z;
+            positions.Get(cell.indices[n], x, y, z);
+            pts[3*n+0] = x;
+            pts[3*n+1] = y;
+            pts[3*n+2] = z;
+        }
+        m[i] = eavlCellMeasure(cell.type, cell.numIndices, pts);
+    }
+    return measures;
+}
+
+// ----------------------------------------------------------------------------
+// each point's share of the cells around it, i.e. a lumped volume
+static eavlFloatArray *
+GetPointMeasures(eavlDataSet *ds, eavlCellSet *cellSet)
+{
+    eavlFloatArray *cellMeasures = GetCellMeasures(ds, cellSet);
+
+    int npts = ds->GetNumPoints();
+    eavlFloatArray *measures = new eavlFloatArray("measure", 1, npts);
+    float *m = (float*)measures->GetHostArray();
+
+    int ncells = cellSet->GetNumCells();
+    for (int i = 0; i < ncells; i++)
+    {
+        eavlCell cell = cellSet->GetCellNodes(i);
+        float share = cellMeasures->GetValue(i) / float(cell.numIndices);
+        for (int n = 0; n < cell.numIndices; n++)
+            m[cell.indices[n]] += share;
+    }
+
+    delete cellMeasures;
+    return measures;
+}
+
+
+eavlRecenterMutator::eavlRecenterMutator() : volumeweighted(false)
+{
+}
+
+void eavlRecenterMutator::Execute()
+{
+    eavlField *field = dataset->GetField(fieldname);
+    eavlArray *array = field->GetArray();
+    int ncomp = array->GetNumberOfComponents();
+
+    if (field->GetAssociation() == eavlField::ASSOC_CELL_SET)
+    {
+        int cellSetIndex = field->GetAssocCellSet();
+        if (cellsetname != "" &&
+            dataset->GetCellSetIndex(cellsetname) != cellSetIndex)
+            THROW(eavlException, "expected field on the given cellset");
+        eavlCellSet *cellSet = dataset->GetCellSet(cellSetIndex);
+
+        int npts = dataset->GetNumPoints();
+        string name = (resultname != "") ? resultname :
+                                           "nodecentered_" + array->GetName();
+        eavlArray *result = array->Create(name, ncomp, npts);
+        eavlFloatArray *weights =
+            volumeweighted ? GetCellMeasures(dataset, cellSet) : NULL;
+
+        eavlExecutor::AddOperation(new eavlTopologyAverageOp(cellSet,
+                                                             EAVL_CELLS_OF_NODES,
+                                                             array,
+                                                             result,
+                                                             weights),
+                                   "recenter to the nodes");
+        eavlExecutor::Go();
+
+        delete weights;
+        dataset->AddField(new eavlField(0, result,
+                                        eavlField::ASSOC_POINTS));
+    }
+    else if (field->GetAssociation() == eavlField::ASSOC_POINTS)
+    {
+        if (cellsetname == "")
+            THROW(eavlException, "need a cellset to recenter a point field to");
+        int cellSetIndex = dataset->GetCellSetIndex(cellsetname);
+        eavlCellSet *cellSet = dataset->GetCellSet(cellsetname);
+
+        int ncells = cellSet->GetNumCells();
+        string name = (resultname != "") ? resultname :
+                                           "cellcentered_" + array->GetName();
+        eavlArray *result = array->Create(name, ncomp, ncells);
+        eavlFloatArray *weights =
+            volumeweighted ? GetPointMeasures(dataset, cellSet) : NULL;
+
+        eavlExecutor::AddOperation(new eavlTopologyAverageOp(cellSet,
+                                                             EAVL_NODES_OF_CELLS,
+                                                             array,
+                                                             result,
+                                                             weights),
+                                   "recenter to the cells");
+        eavlExecutor::Go();
+
+        delete weights;
+        dataset->AddField(new eavlField(0, result,
+                                        eavlField::ASSOC_CELL_SET,
+                                        cellSetIndex));
+    }
+    else
+    {
+        THROW(eavlException, "expected point or cellset field for recenter");
+    }
+}
@@ -0,0 +1,57 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_RECENTER_MUTATOR_H
+#define EAVL_RECENTER_MUTATOR_H
+#include "eavlFilter.h"
+
+// ****************************************************************************
+// Class:  eavlRecenterMutator
+//
+// Purpose:
+///   Recenters a field between a cell set and the mesh points, in the
+///   direction given by the field's association: a cell set field is
+///   averaged to the points around it, and a point field is averaged to
+///   the cells of the given cell set.  All components are handled in one
+///   pass, whatever their number.
+///
+///   With volume weighting, each cell counts in proportion to its length,
+///   area, or volume going to the points, and each point counts in
+///   proportion to its share of the volume of the cells around it going
+///   to the cells.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// Modifications:
+// ****************************************************************************
+class eavlRecenterMutator : public eavlMutator
+{
+  public:
+    eavlRecenterMutator();
+    void SetField(const string &name)
+    {
+        fieldname = name;
+    }
+    /// The cell set to recenter a point field to.  For a cell set field
+    /// this is optional, but must match the field's cell set if given.
+    void SetCellSet(const string &name)
+    {
+        cellsetname = name;
+    }
+    /// Defaults to "nodecentered_<field>" or "cellcentered_<field>".
+    void SetResultName(const string &name)
+    {
+        resultname = name;
+    }
+    void SetVolumeWeighted(bool w)
+    {
+        volumeweighted = w;
+    }
+    virtual void Execute();
+  protected:
+    string fieldname;
+    string cellsetname;
+    string resultname;
+    bool   volumeweighted;
+};
+
+#endif
@@ -0,0 +1,294 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlResampleFilter.h"
+#include "eavlCellSetAllStructured.h"
+#include "eavlLogicalStructureRegular.h"
+#include "eavlCellLocator.h"
+#include "eavlShapeFunctions.h"
+#include "eavlCoordinates.h"
+#include "eavlException.h"
+#include "eavlTimer.h"
+
+#include <cmath>
+
+// largest node count of the shapes eavlShapeFunctions supports
+#define RESAMPLE_MAX_NODES 8
+
+template <class T>
+inline T RoundForType(double v) { return T(floor(v + 0.5)); }
+template <>
+inline float RoundForType<float>(double v) { return float(v); }
+
+// ****************************************************************************
+// Function:  ResamplePointField
+//
+// Purpose:
+///   Interpolate all components of a point field to the sample points
+///   using the precomputed node lists and weights.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+template <class T>
+static void
+ResamplePointField(int nsamples, int nc, const T *in, T *out,
+                   const vector<int> &sampleCell,
+                   const vector<int> &sampleNumNodes,
+                   const vector<int> &sampleNodes,
+                   const vector<float> &sampleWeights)
+{
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i=0; i<nsamples; i++)
+    {
+        for (int c=0; c<nc; c++)
+        {
+            if (sampleCell[i] < 0)
+            {
+                out[i*nc+c] = 0;
+                continue;
+            }
+            double v = 0;
+            for (int n=0; n<sampleNumNodes[i]; n++)
+            {
+                int node = sampleNodes[i*RESAMPLE_MAX_NODES + n];
+                v += sampleWeights[i*RESAMPLE_MAX_NODES + n] * in[node*nc+c];
+            }
+            out[i*nc+c] = RoundForType<T>(v);
+        }
+    }
+}
+
+// ****************************************************************************
+// Function:  ResampleCellField
+//
+// Purpose:
+///   Copy all components of a cell field from the containing cell
+///   to each sample point.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+template <class T>
+static void
+ResampleCellField(int nsamples, int nc, const T *in, T *out,
+                  const vector<int> &sampleCell)
+{
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i=0; i<nsamples; i++)
+    {
+        int cell = sampleCell[i];
+        for (int c=0; c<nc; c++)
+            out[i*nc+c] = (cell < 0) ? T(0) : in[cell*nc+c];
+    }
+}
+
+template <class T>
+static bool
+ResampleField(eavlArray *inArr, eavlArray *outArr, bool pointField,
+              int nsamples,
+              const vector<int> &sampleCell,
+              const vector<int> &sampleNumNodes,
+              const vector<int> &sampleNodes,
+              const vector<float> &sampleWeights)
+{
+    eavlConcreteArray<T> *in = dynamic_cast<eavlConcreteArray<T>*>(inArr);
+    if (!in)
+        return false;
+    int nc = in->GetNumberOfComponents();
+    const T *inp = (const T*)in->GetHostArray();
+    T *outp = (T*)outArr->GetHostArray();
+    if (pointField)
+        ResamplePointField(nsamples, nc, inp, outp, sampleCell,
+                           sampleNumNodes, sampleNodes, sampleWeights);
+    else
+        ResampleCellField(nsamples, nc, inp, outp, sampleCell);
+    return true;
+}
+
+eavlResampleFilter::eavlResampleFilter()
+{
+    for (int d=0; d<3; d++)
+    {
+        origin[d] = 0;
+        spacing[d] = 1;
+    }
+}
+
+void
+eavlResampleFilter::Execute()
+{
+    if (reg.dimension < 2 || reg.dimension > 3)
+        THROW(eavlException,"eavlResampleFilter expects a 2D or 3D sample grid");
+
+    int inCellSetIndex = input->GetCellSetIndex(cellsetname);
+    eavlCellSet *inCells = input->GetCellSet(cellsetname);
+
+    int th_locator = eavlTimer::Start();
+    eavlCellLocator locator(input, inCells);
+    eavlTimer::Stop(th_locator, "build cell locator");
+
+    if (locator.GetSpatialDimension() < reg.dimension)
+        THROW(eavlException,"eavlResampleFilter sample grid has higher dimension than the cell set");
+
+    //
+    // locate every sample point.  we hand out rows of the sample grid
+    // so that each sample can use its neighbor's cell as a hint; the
+    // dynamic schedule keeps threads busy when some regions of the
+    // source mesh are much more refined than others.
+    //
+    int th_locate = eavlTimer::Start();
+    int nsamples = reg.GetNumNodes();
+    int nx = reg.nodeDims[0];
+    int nrows = nsamples / nx;
+    vector<int>   sampleCell(nsamples, -1);
+    vector<int>   sampleNumNodes(nsamples, 0);
+    vector<int>   sampleNodes(nsamples * RESAMPLE_MAX_NODES, 0);
+    vector<float> sampleWeights(nsamples * RESAMPLE_MAX_NODES, 0.f);
+
+#ifdef HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int row = 0; row < nrows; row++)
+    {
+        int j = row % reg.nodeDims[1];
+        int k = (reg.dimension == 3) ? row / reg.nodeDims[1] : 0;
+        double p[3];
+        p[1] = origin[1] + j * spacing[1];
+        p[2] = origin[2] + k * spacing[2];
+        int hint = -1;
+        for (int i = 0; i < nx; i++)
+        {
+            int index = row * nx + i;
+            p[0] = origin[0] + i * spacing[0];
+
+            double rst[3];
+            eavlCell cell;
+            int c = locator.FindCell(p, rst, cell, hint);
+            if (c < 0)
+                continue;
+            hint = c;
+
+            double w[12];
+            int nw = eavlShapeFunctions(cell.type, rst[0], rst[1], rst[2], w);
+            if (nw != cell.numIndices || nw > RESAMPLE_MAX_NODES)
+                continue;
+
+            sampleCell[index] = c;
+            sampleNumNodes[index] = nw;
+            for (int n=0; n<nw; n++)
+            {
+                sampleNodes[index*RESAMPLE_MAX_NODES + n] = cell.indices[n];
+                sampleWeights[index*RESAMPLE_MAX_NODES + n] = w[n];
+            }
+        }
+    }
+
+    eavlByteArray *mask = new eavlByteArray("valid_point_mask", 1, nsamples);
+    for (int i=0; i<nsamples; i++)
+        mask->SetValue(i, (sampleCell[i] >= 0) ? 1 : 0);
+    eavlTimer::Stop(th_locate, "locate sample points");
+
+    //
+    // set up the output mesh
+    //
+    output->SetNumPoints(nsamples);
+    eavlLogicalStructureRegular *log =
+        new eavlLogicalStructureRegular(reg.dimension, reg);
+    output->SetLogicalStructure(log);
+
+    eavlCoordinatesCartesian *coordsys;
+    if (reg.dimension == 3)
+    {
+        coordsys = new eavlCoordinatesCartesian(log,
+                                                eavlCoordinatesCartesian::X,
+                                                eavlCoordinatesCartesian::Y,
+                                                eavlCoordinatesCartesian::Z);
+        for (int d=0; d<3; d++)
+            coordsys->SetAxis(d, new eavlCoordinateAxisRegular(d, origin[d],
+                                                               spacing[d]));
+    }
+    else if (locator.GetSpatialDimension() == 3)
+    {
+        // a planar sample grid through a volume; the constant Z
+        // coordinate is stored as a whole-mesh field
+        coordsys = new eavlCoordinatesCartesian(log,
+                                                eavlCoordinatesCartesian::X,
+                                                eavlCoordinatesCartesian::Y,
+                                                eavlCoordinatesCartesian::Z);
+        for (int d=0; d<2; d++)
+            coordsys->SetAxis(d, new eavlCoordinateAxisRegular(d, origin[d],
+                                                               spacing[d]));
+        eavlFloatArray *zarr = new eavlFloatArray("resample_z", 1, 1);
+        zarr->SetValue(0, origin[2]);
+        output->AddField(new eavlField(1, zarr, eavlField::ASSOC_WHOLEMESH));
+        coordsys->SetAxis(2, new eavlCoordinateAxisField("resample_z", 0));
+    }
+    else
+    {
+        coordsys = new eavlCoordinatesCartesian(log,
+                                                eavlCoordinatesCartesian::X,
+                                                eavlCoordinatesCartesian::Y);
+        for (int d=0; d<2; d++)
+            coordsys->SetAxis(d, new eavlCoordinateAxisRegular(d, origin[d],
+                                                               spacing[d]));
+    }
+    output->AddCoordinateSystem(coordsys);
+    output->AddCellSet(new eavlCellSetAllStructured(cellsetname, reg));
+
+    //
+    // resample the fields, skipping the input coordinates
+    //
+    int th_fields = eavlTimer::Start();
+    vector<string> coordFieldNames;
+    eavlCoordinates *cs = input->GetCoordinateSystem(0);
+    for (int d=0; d<cs->GetDimension(); d++)
+    {
+        eavlCoordinateAxisField *axis =
+            dynamic_cast<eavlCoordinateAxisField*>(cs->GetAxis(d));
+        if (axis)
+            coordFieldNames.push_back(axis->GetFieldName());
+    }
+
+    for (int i=0; i<input->GetNumFields(); i++)
+    {
+        eavlField *f = input->GetField(i);
+        eavlArray *a = f->GetArray();
+        if (std::find(coordFieldNames.begin(), coordFieldNames.end(),
+                      a->GetName()) != coordFieldNames.end())
+            continue;
+
+        bool pointField;
+        if (f->GetAssociation() == eavlField::ASSOC_POINTS)
+            pointField = true;
+        else if (f->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+                 f->GetAssocCellSet() == inCellSetIndex)
+            pointField = false;
+        else
+            continue;
+
+        eavlArray *outArr = a->Create(a->GetName(),
+                                      a->GetNumberOfComponents(), nsamples);
+        if (!ResampleField<float>(a, outArr, pointField, nsamples,
+                                  sampleCell, sampleNumNodes,
+                                  sampleNodes, sampleWeights) &&
+            !ResampleField<int>(a, outArr, pointField, nsamples,
+                                sampleCell, sampleNumNodes,
+                                sampleNodes, sampleWeights) &&
+            !ResampleField<byte>(a, outArr, pointField, nsamples,
+                                 sampleCell, sampleNumNodes,
+                                 sampleNodes, sampleWeights))
+        {
+            delete outArr;
+            continue;
+        }
+        output->AddField(new eavlField(pointField ? 1 : 0, outArr,
+                                       eavlField::ASSOC_POINTS));
+    }
+    output->AddField(new eavlField(0, mask, eavlField::ASSOC_POINTS));
+    eavlTimer::Stop(th_fields, "resample fields");
+}
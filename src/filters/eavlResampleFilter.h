@@ -0,0 +1,54 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_RESAMPLE_FILTER_H
+#define EAVL_RESAMPLE_FILTER_H
+
+#include "STL.h"
+#include "eavlDataSet.h"
+#include "eavlCellSet.h"
+#include "eavlFilter.h"
+#include "eavlRegularStructure.h"
+
+// ****************************************************************************
+// Class:  eavlResampleFilter
+//
+// Purpose:
+///   Probe a data set at the nodes of a uniform grid.  Every sample point
+///   is located in the source cell set, point fields are interpolated
+///   with the cell's shape functions, and cell fields take the value of
+///   the containing cell.  The output is a structured data set with
+///   regular coordinates, holding all resampled fields as point fields
+///   plus a "valid_point_mask" byte field which is 1 for samples that
+///   fell inside the source mesh and 0 elsewhere.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlResampleFilter : public eavlFilter
+{
+  protected:
+    string               cellsetname;
+    eavlRegularStructure reg;
+    double               origin[3];
+    double               spacing[3];
+  public:
+    eavlResampleFilter();
+    void SetCellSet(const string &name)
+    {
+        cellsetname = name;
+    }
+    void SetSampleGrid(const eavlRegularStructure &rs,
+                       const double o[3], const double s[3])
+    {
+        reg = rs;
+        for (int d=0; d<3; d++)
+        {
+            origin[d] = o[d];
+            spacing[d] = s[d];
+        }
+    }
+
+    virtual void Execute();
+};
+
+#endif
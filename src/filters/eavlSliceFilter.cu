@@ -0,0 +1,331 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlSliceFilter.h"
+#include "eavlCellSetExplicit.h"
+#include "eavlCellComponents.h"
+#include "eavlCoordinates.h"
+#include "eavlException.h"
+#include "eavlMemoryTracker.h"
+#include "eavlNewIsoTables.h"
+#include "eavlNodePositions.h"
+
+eavlSliceFilter::eavlSliceFilter()
+{
+}
+
+// ----------------------------------------------------------------------------
+// Case tables for the 3D shapes, from the isosurface tables.
+// ----------------------------------------------------------------------------
+struct SliceShapeTables
+{
+    const byte *count;
+    const int  *start;
+    const byte *geom;
+    signed char (*edges)[2];
+};
+
+static bool
+GetSliceShapeTables(int shapeType, SliceShapeTables &t)
+{
+    switch (shapeType)
+    {
+      case EAVL_TET:
+        t.count = eavlTetIsoTriCount->host;
+        t.start = eavlTetIsoTriStart->host;
+        t.geom  = eavlTetIsoTriGeom->host;
+        t.edges = eavlTetEdges;
+        return true;
+      case EAVL_PYRAMID:
+        t.count = eavlPyrIsoTriCount->host;
+        t.start = eavlPyrIsoTriStart->host;
+        t.geom  = eavlPyrIsoTriGeom->host;
+        t.edges = eavlPyramidEdges;
+        return true;
+      case EAVL_WEDGE:
+        t.count = eavlWdgIsoTriCount->host;
+        t.start = eavlWdgIsoTriStart->host;
+        t.geom  = eavlWdgIsoTriGeom->host;
+        t.edges = eavlWedgeEdges;
+        return true;
+      case EAVL_HEX:
+        t.count = eavlHexIsoTriCount->host;
+        t.start = eavlHexIsoTriStart->host;
+        t.geom  = eavlHexIsoTriGeom->host;
+        t.edges = eavlHexEdges;
+        return true;
+      case EAVL_VOXEL:
+        t.count = eavlVoxIsoTriCount->host;
+        t.start = eavlVoxIsoTriStart->host;
+        t.geom  = eavlVoxIsoTriGeom->host;
+        t.edges = eavlVoxEdges;
+        return true;
+    }
+    return false;
+}
+
+// The case index of a cell for one function: as for isosurfaces, bit i
+// is set when node i is below the surface.
+static int
+GetSliceCase(int n, const float *vals)
+{
+    int caseindex = 0;
+    for (int i=n-1; i>=0; --i)
+        caseindex = 2*caseindex + (vals[i] < 0);
+    return caseindex;
+}
+
+// One triangle corner, keyed by the edge (a < b) and function it lies on.
+struct SliceCorner
+{
+    int   a, b;
+    int   func;
+    int   corner;
+    float t;      // position from a to b
+    bool operator<(const SliceCorner &k) const
+    {
+        if (a != k.a)
+            return a < k.a;
+        if (b != k.b)
+            return b < k.b;
+        if (func != k.func)
+            return func < k.func;
+        return corner < k.corner;
+    }
+    bool SamePoint(const SliceCorner &k) const
+    {
+        return a == k.a && b == k.b && func == k.func;
+    }
+};
+
+// ****************************************************************************
+// Method:  eavlSliceFilter::Execute
+//
+// Purpose:
+///   Count the triangles of every cell for every function, scan the
+///   counts, then revisit the cells to generate the triangle corners on
+///   their edges.  Sorting the corners by edge and function merges the
+///   shared points, and the output fields are interpolated along the
+///   edges.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+void
+eavlSliceFilter::Execute()
+{
+    int inCellSetIndex = input->GetCellSetIndex(cellsetname);
+    eavlCellSet *inCells = input->GetCellSet(cellsetname);
+
+    int nfuncs = functions.size();
+    if (nfuncs == 0)
+        THROW(eavlException,"Slice needs at least one implicit function");
+
+    eavlInitializeIsoTables();
+    eavlNodePositions positions(input);
+    const eavlImplicitFunction *funcs = &functions[0];
+
+    //
+    // count the triangles of each cell
+    //
+    int ncells = inCells->GetNumCells();
+    vector<int> triStart(ncells+1);
+    triStart[0] = 0;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int c=0; c<ncells; c++)
+    {
+        eavlCell cell = inCells->GetCellNodes(c);
+        SliceShapeTables tables;
+        int count = 0;
+        if (GetSliceShapeTables(cell.type, tables))
+        {
+            float pts[8][3];
+            for (int i=0; i<cell.numIndices; i++)
+                positions.Get(cell.indices[i], pts[i][0], pts[i][1], pts[i][2]);
+            for (int f=0; f<nfuncs; f++)
+            {
+                float vals[8];
+                for (int i=0; i<cell.numIndices; i++)
+                    vals[i] = funcs[f].Eval(pts[i][0], pts[i][1], pts[i][2]);
+                count += tables.count[GetSliceCase(cell.numIndices, vals)];
+            }
+        }
+        triStart[c+1] = count;
+    }
+    for (int c=0; c<ncells; c++)
+        triStart[c+1] += triStart[c];
+    int ntris = triStart[ncells];
+
+    //
+    // generate the corners of each triangle
+    //
+    vector<SliceCorner> corners(3*ntris);
+    vector<int> triCell(ntris);
+    vector<int> triFunc(ntris);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int c=0; c<ncells; c++)
+    {
+        if (triStart[c+1] == triStart[c])
+            continue;
+        eavlCell cell = inCells->GetCellNodes(c);
+        SliceShapeTables tables;
+        GetSliceShapeTables(cell.type, tables);
+        float pts[8][3];
+        for (int i=0; i<cell.numIndices; i++)
+            positions.Get(cell.indices[i], pts[i][0], pts[i][1], pts[i][2]);
+        int tri = triStart[c];
+        for (int f=0; f<nfuncs; f++)
+        {
+            float vals[8];
+            for (int i=0; i<cell.numIndices; i++)
+                vals[i] = funcs[f].Eval(pts[i][0], pts[i][1], pts[i][2]);
+            int caseindex = GetSliceCase(cell.numIndices, vals);
+            int n = tables.count[caseindex];
+            const byte *geom = tables.geom + tables.start[caseindex];
+            for (int j=0; j<n; j++, tri++)
+            {
+                triCell[tri] = c;
+                triFunc[tri] = f;
+                for (int k=0; k<3; k++)
+                {
+                    int e = geom[3*j + k];
+                    int i0 = tables.edges[e][0];
+                    int i1 = tables.edges[e][1];
+                    if (cell.indices[i0] > cell.indices[i1])
+                        std::swap(i0, i1);
+                    SliceCorner &corner = corners[3*tri + k];
+                    corner.a = cell.indices[i0];
+                    corner.b = cell.indices[i1];
+                    corner.func = f;
+                    corner.corner = 3*tri + k;
+                    corner.t = vals[i0] / (vals[i0] - vals[i1]);
+                }
+            }
+        }
+    }
+
+    //
+    // merge corners on the same edge for the same function
+    //
+    std::sort(corners.begin(), corners.end());
+    eavlExplicitConnectivity conn;
+    conn.shapetype.resize(ntris);
+    conn.connectivity.resize(4*ntris);
+    vector<int> firstCorner;
+    for (int i=0; i<3*ntris; i++)
+    {
+        if (i == 0 || !corners[i].SamePoint(corners[i-1]))
+            firstCorner.push_back(i);
+        int tri = corners[i].corner / 3;
+        conn.connectivity[4*tri + 1 + corners[i].corner % 3] = firstCorner.size() - 1;
+    }
+    for (int t=0; t<ntris; t++)
+    {
+        conn.shapetype[t] = EAVL_TRI;
+        conn.connectivity[4*t] = 3;
+    }
+    int noutpts = firstCorner.size();
+
+    //
+    // set up the output mesh
+    //
+    output->SetNumPoints(noutpts);
+    eavlCellSetExplicit *outCellSet = new eavlCellSetExplicit("slice", 2);
+    outCellSet->SetCellNodeConnectivity(conn);
+    output->AddCellSet(outCellSet);
+
+    eavlFloatArray *newx = new eavlFloatArray("newx", 1, noutpts);
+    eavlFloatArray *newy = new eavlFloatArray("newy", 1, noutpts);
+    eavlFloatArray *newz = new eavlFloatArray("newz", 1, noutpts);
+    if (noutpts > 0)
+    {
+        float *x = (float*)newx->GetHostArray();
+        float *y = (float*)newy->GetHostArray();
+        float *z = (float*)newz->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int p=0; p<noutpts; p++)
+        {
+            const SliceCorner &k = corners[firstCorner[p]];
+            float xa, ya, za, xb, yb, zb;
+            positions.Get(k.a, xa, ya, za);
+            positions.Get(k.b, xb, yb, zb);
+            x[p] = xa + k.t * (xb - xa);
+            y[p] = ya + k.t * (yb - ya);
+            z[p] = za + k.t * (zb - za);
+        }
+    }
+    output->AddField(new eavlField(1, newx, eavlField::ASSOC_POINTS));
+    output->AddField(new eavlField(1, newy, eavlField::ASSOC_POINTS));
+    output->AddField(new eavlField(1, newz, eavlField::ASSOC_POINTS));
+
+    eavlCoordinatesCartesian *coordsys =
+        new eavlCoordinatesCartesian(NULL,
+                                     eavlCoordinatesCartesian::X,
+                                     eavlCoordinatesCartesian::Y,
+                                     eavlCoordinatesCartesian::Z);
+    coordsys->SetAxis(0, new eavlCoordinateAxisField("newx", 0));
+    coordsys->SetAxis(1, new eavlCoordinateAxisField("newy", 0));
+    coordsys->SetAxis(2, new eavlCoordinateAxisField("newz", 0));
+    output->AddCoordinateSystem(coordsys);
+
+    //
+    // interpolate the point fields and copy the cell fields
+    //
+    for (int i=0; i<input->GetNumFields(); i++)
+    {
+        eavlField *f = input->GetField(i);
+        eavlArray *a = f->GetArray();
+        int ncomp = a->GetNumberOfComponents();
+        if (f->GetAssociation() == eavlField::ASSOC_POINTS)
+        {
+            if (positions.IsCoordinateField(f))
+                continue;
+            eavlArray *outArr = a->Create(a->GetName(), ncomp, noutpts);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+            for (int p=0; p<noutpts; p++)
+            {
+                const SliceCorner &k = corners[firstCorner[p]];
+                for (int j=0; j<ncomp; j++)
+                {
+                    double va = a->GetComponentAsDouble(k.a, j);
+                    double vb = a->GetComponentAsDouble(k.b, j);
+                    outArr->SetComponentFromDouble(p, j, va + k.t*(vb - va));
+                }
+            }
+            output->AddField(new eavlField(1, outArr, eavlField::ASSOC_POINTS));
+        }
+        else if (f->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+                 f->GetAssocCellSet() == inCellSetIndex)
+        {
+            eavlArray *outArr = a->Create(a->GetName(), ncomp, ntris);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+            for (int t=0; t<ntris; t++)
+            {
+                for (int j=0; j<ncomp; j++)
+                    outArr->SetComponentFromDouble(t, j,
+                                 a->GetComponentAsDouble(triCell[t], j));
+            }
+            output->AddField(new eavlField(f->GetOrder(), outArr,
+                                           eavlField::ASSOC_CELL_SET, 0));
+        }
+    }
+
+    if (nfuncs > 1)
+    {
+        eavlIntArray *sliceArr = new eavlIntArray("slice", 1, ntris);
+        if (ntris > 0)
+            std::copy(triFunc.begin(), triFunc.end(),
+                      (int*)sliceArr->GetHostArray());
+        output->AddField(new eavlField(0, sliceArr,
+                                       eavlField::ASSOC_CELL_SET, 0));
+    }
+}
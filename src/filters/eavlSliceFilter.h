@@ -0,0 +1,64 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_SLICE_FILTER_H
+#define EAVL_SLICE_FILTER_H
+
+#include "STL.h"
+#include "eavlDataSet.h"
+#include "eavlCellSet.h"
+#include "eavlFilter.h"
+#include "eavlImplicitFunction.h"
+
+// ****************************************************************************
+// Class:  eavlSliceFilter
+//
+// Purpose:
+///   Cut volumetric elements with the zero surface of one or more
+///   implicit functions (planes, spheres, boxes), producing a triangle
+///   mesh.  The functions are evaluated at each cell's nodes inside the
+///   classification and triangle-generation loops themselves, so no
+///   distance field is ever stored, and all functions are handled in the
+///   same traversal (e.g. an orthogonal three-slice).  Triangles come
+///   from the isosurface case tables.
+///
+///   Output points are merged by the edge they lie on and the function
+///   index.  All components of every point field are interpolated onto
+///   them and the cell set's cell fields are copied to the triangles.
+///   With more than one function, a "slice" cell field records which
+///   function produced each triangle.
+///
+///   Node positions of structured data with regular or rectilinear
+///   axes are read directly from the per-axis values.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlSliceFilter : public eavlFilter
+{
+  protected:
+    string cellsetname;
+    vector<eavlImplicitFunction> functions;
+  public:
+    eavlSliceFilter();
+    void SetCellSet(const string &name)
+    {
+        cellsetname = name;
+    }
+    void SetFunction(const eavlImplicitFunction &f)
+    {
+        functions.clear();
+        functions.push_back(f);
+    }
+    void AddFunction(const eavlImplicitFunction &f)
+    {
+        functions.push_back(f);
+    }
+    void ClearFunctions()
+    {
+        functions.clear();
+    }
+
+    virtual void Execute();
+};
+
+#endif
@@ -0,0 +1,86 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlStatisticsMutator.h"
+#include "eavlGhostCells.h"
+#include "eavlException.h"
+#include "eavlTimer.h"
+
+// values summarized by each parallel task
+#define STATISTICS_BLOCK_SIZE 65536
+
+eavlStatisticsMutator::eavlStatisticsMutator()
+    : component(0), compression(100)
+{
+    quantiles.push_back(0.05);
+    quantiles.push_back(0.25);
+    quantiles.push_back(0.50);
+    quantiles.push_back(0.75);
+    quantiles.push_back(0.95);
+}
+
+void
+eavlStatisticsMutator::Execute()
+{
+    eavlField *field = dataset->GetField(fieldname);
+    eavlArray *array = field->GetArray();
+    if (component < 0 || component >= array->GetNumberOfComponents())
+        THROW(eavlException,"Component index out of range for field");
+    for (size_t i=0; i<quantiles.size(); i++)
+    {
+        if (quantiles[i] < 0 || quantiles[i] > 1)
+            THROW(eavlException,"Quantiles must be between 0 and 1");
+    }
+
+    int cellSetIndex = -1;
+    if (field->GetAssociation() == eavlField::ASSOC_CELL_SET)
+        cellSetIndex = field->GetAssocCellSet();
+    eavlGhostCells ghosts(dataset, cellSetIndex);
+
+    int th = eavlTimer::Start();
+    int nvals = array->GetNumberOfTuples();
+    int nblocks = (nvals + STATISTICS_BLOCK_SIZE - 1) / STATISTICS_BLOCK_SIZE;
+    vector<eavlStatistics> blocks(nblocks, eavlStatistics(compression));
+#ifdef HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+    for (int b = 0; b < nblocks; b++)
+    {
+        int end = std::min(nvals, (b+1) * STATISTICS_BLOCK_SIZE);
+        for (int i = b * STATISTICS_BLOCK_SIZE; i < end; i++)
+        {
+            if (ghosts.IsGhost(i))
+                continue;
+            blocks[b].Add(array->GetComponentAsDouble(i, component));
+        }
+    }
+
+    // merge neighboring summaries level by level, a fixed order
+    // whatever the thread count
+    for (int stride = 1; stride < nblocks; stride *= 2)
+    {
+#ifdef HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (int b = 0; b < nblocks - stride; b += 2*stride)
+            blocks[b].Merge(blocks[b+stride]);
+    }
+    stats = nblocks ? blocks[0] : eavlStatistics(compression);
+    eavlTimer::Stop(th, "statistics");
+
+    string name = prefix.empty() ? fieldname : prefix;
+    eavlFloatArray *moments = new eavlFloatArray(name + "_statistics", 7, 1);
+    moments->SetComponentFromDouble(0, 0, stats.GetCount());
+    moments->SetComponentFromDouble(0, 1, stats.GetMin());
+    moments->SetComponentFromDouble(0, 2, stats.GetMax());
+    moments->SetComponentFromDouble(0, 3, stats.GetMean());
+    moments->SetComponentFromDouble(0, 4, stats.GetVariance());
+    moments->SetComponentFromDouble(0, 5, stats.GetSkewness());
+    moments->SetComponentFromDouble(0, 6, stats.GetKurtosis());
+
+    eavlFloatArray *values = new eavlFloatArray(name + "_quantiles", 1,
+                                                quantiles.size());
+    for (size_t i=0; i<quantiles.size(); i++)
+        values->SetComponentFromDouble(i, 0, stats.GetQuantile(quantiles[i]));
+
+    dataset->AddField(new eavlField(0, moments, eavlField::ASSOC_WHOLEMESH));
+    dataset->AddField(new eavlField(0, values, eavlField::ASSOC_WHOLEMESH));
+}
@@ -0,0 +1,73 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_STATISTICS_MUTATOR_H
+#define EAVL_STATISTICS_MUTATOR_H
+
+#include "STL.h"
+#include "eavlFilter.h"
+#include "eavlStatistics.h"
+
+// ****************************************************************************
+// Class:  eavlStatisticsMutator
+//
+// Purpose:
+///   Compute descriptive statistics of one component of a field in a
+///   single pass.  Adds two whole-mesh fields: "<prefix>_statistics",
+///   one tuple with the count, min, max, mean, variance, skewness and
+///   (excess) kurtosis as its seven components, and "<prefix>_quantiles",
+///   holding the approximate value at each requested quantile.  The
+///   prefix defaults to the field name.  Ghost cells are left out of
+///   statistics of cell fields.
+///
+///   The values are split into fixed-size blocks which are summarized
+///   in parallel, then the block summaries are merged pairwise in a
+///   tree, so the result doesn't depend on the number of threads.  The
+///   summary itself is available from GetStatistics; merging those of
+///   each chunk or domain gives the statistics of the whole data set
+///   without gathering its values.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlStatisticsMutator : public eavlMutator
+{
+  protected:
+    string         fieldname;
+    int            component;
+    string         prefix;
+    vector<double> quantiles;
+    double         compression;
+    eavlStatistics stats;
+  public:
+    eavlStatisticsMutator();
+    void SetField(const string &name)
+    {
+        fieldname = name;
+    }
+    void SetComponent(int c)
+    {
+        component = c;
+    }
+    void SetResultPrefix(const string &p)
+    {
+        prefix = p;
+    }
+    /// The fractions, from 0 to 1, at which to estimate values.
+    void SetQuantiles(const vector<double> &q)
+    {
+        quantiles = q;
+    }
+    /// Larger values give more accurate quantiles with a larger summary.
+    void SetCompression(double c)
+    {
+        compression = c;
+    }
+    const eavlStatistics &GetStatistics() const
+    {
+        return stats;
+    }
+
+    virtual void Execute();
+};
+
+#endif
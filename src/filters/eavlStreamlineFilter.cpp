@@ -0,0 +1,417 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlStreamlineFilter.h"
+#include "eavlCellSetExplicit.h"
+#include "eavlCellLocator.h"
+#include "eavlShapeFunctions.h"
+#include "eavlCoordinates.h"
+#include "eavlException.h"
+#include "eavlTimer.h"
+
+#include <cmath>
+
+// ****************************************************************************
+// Class:  eavlStreamlineField
+//
+// Purpose:
+///   Evaluates a vector field at arbitrary points of a cell set, by
+///   locating the containing cell and interpolating with its shape
+///   functions (or taking the cell's value, for a cell set field).
+///   Only the components up to the cell set's spatial dimension are
+///   used; the rest are zero.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlStreamlineField
+{
+  protected:
+    const eavlCellLocator &locator;
+    eavlArray             *array;
+    const float           *values;
+    int                    ncomp;
+    int                    dim;
+    bool                   pointField;
+  public:
+    eavlStreamlineField(const eavlCellLocator &loc, eavlArray *arr, bool pf)
+        : locator(loc), array(arr), pointField(pf)
+    {
+        eavlFloatArray *farr = dynamic_cast<eavlFloatArray*>(array);
+        values = farr ? (const float*)farr->GetHostArray() : NULL;
+        ncomp = array->GetNumberOfComponents();
+        dim = locator.GetSpatialDimension();
+    }
+    double GetValue(int index, int c) const
+    {
+        if (values)
+            return values[index*ncomp + c];
+        return array->GetComponentAsDouble(index, c);
+    }
+    /// Return false if p is outside the cell set.  The hint is the cell
+    /// to test first, and is updated to the cell containing p.
+    bool Evaluate(const double p[3], int &hint, double v[3]) const
+    {
+        double rst[3];
+        eavlCell cell;
+        int c = locator.FindCell(p, rst, cell, hint);
+        if (c < 0)
+            return false;
+        hint = c;
+
+        v[0] = v[1] = v[2] = 0;
+        if (!pointField)
+        {
+            for (int d=0; d<dim; d++)
+                v[d] = GetValue(c, d);
+            return true;
+        }
+
+        double w[12];
+        int nw = eavlShapeFunctions(cell.type, rst[0], rst[1], rst[2], w);
+        if (nw != cell.numIndices)
+            return false;
+        for (int n=0; n<nw; n++)
+            for (int d=0; d<dim; d++)
+                v[d] += w[n] * GetValue(cell.indices[n], d);
+        return true;
+    }
+};
+
+struct eavlStreamlineParameters
+{
+    int    maxsteps;
+    double maxtime;
+    double steplength;
+    double minsteplength;
+    double tolerance;
+};
+
+static inline double
+Magnitude(const double v[3])
+{
+    return sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+}
+
+// ----------------------------------------------------------------------------
+// one fourth-order Runge-Kutta step of (signed) size h from p, where k1 is
+// the field at p; false if any of the samples falls outside the cell set
+static bool
+RK4Step(const eavlStreamlineField &field,
+        const double p[3], const double k1[3], double h,
+        int &hint, double out[3])
+{
+    double q[3], k2[3], k3[3], k4[3];
+    for (int d=0; d<3; d++)
+        q[d] = p[d] + 0.5*h*k1[d];
+    if (!field.Evaluate(q, hint, k2))
+        return false;
+    for (int d=0; d<3; d++)
+        q[d] = p[d] + 0.5*h*k2[d];
+    if (!field.Evaluate(q, hint, k3))
+        return false;
+    for (int d=0; d<3; d++)
+        q[d] = p[d] + h*k3[d];
+    if (!field.Evaluate(q, hint, k4))
+        return false;
+    for (int d=0; d<3; d++)
+        out[d] = p[d] + h/6. * (k1[d] + 2*k2[d] + 2*k3[d] + k4[d]);
+    return true;
+}
+
+// ****************************************************************************
+// Function:  TraceParticle
+//
+// Purpose:
+///   Advance a particle from a seed point forward (sign=+1) or backward
+///   (sign=-1) through the field, appending every point after the seed,
+///   along with its integration time and the field magnitude there.
+///
+///   Each step is taken both whole and as two half steps.  The two
+///   results differ by about 15 times the error of the half steps, so
+///   the step is retried with a smaller size if that is over tolerance,
+///   and the next step grows or shrinks to aim just under it.  A step
+///   leaving the cell set is retried at half the size, down to the
+///   minimum step length, so particles stop close to the boundary.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+static void
+TraceParticle(const eavlStreamlineField &field,
+              const eavlStreamlineParameters &params,
+              const double seed[3], double sign,
+              vector<double> &points,
+              vector<double> &times,
+              vector<double> &speeds)
+{
+    double p[3] = {seed[0], seed[1], seed[2]};
+    double k1[3];
+    int hint = -1;
+    if (!field.Evaluate(p, hint, k1))
+        return;
+
+    double speed = Magnitude(k1);
+    double t = 0;
+    double h = (speed > 0) ? params.steplength / speed : 0;
+    for (int step = 0; step < params.maxsteps && speed > 0; step++)
+    {
+        // h is in units of time; limit it by the step length and the
+        // time remaining
+        double hmax = params.steplength / speed;
+        double hmin = params.minsteplength / speed;
+        if (h > hmax)
+            h = hmax;
+        if (params.maxtime > 0 && t + h > params.maxtime)
+            h = params.maxtime - t;
+        if (h <= 0)
+            break;
+
+        bool accepted = false;
+        double err = 0;
+        double y1[3], ym[3], y2[3], km[3], k2[3];
+        int hint2 = hint;
+        while (true)
+        {
+            int hint1 = hint;
+            hint2 = hint;
+            bool inside =
+                RK4Step(field, p, k1, sign*h, hint1, y1) &&
+                RK4Step(field, p, k1, sign*h/2, hint2, ym) &&
+                field.Evaluate(ym, hint2, km) &&
+                RK4Step(field, ym, km, sign*h/2, hint2, y2) &&
+                field.Evaluate(y2, hint2, k2);
+
+            if (!inside)
+            {
+                if (h <= hmin)
+                    break;
+                h = (h/2 < hmin) ? hmin : h/2;
+                continue;
+            }
+
+            err = 0;
+            for (int d=0; d<3; d++)
+                err += (y2[d]-y1[d]) * (y2[d]-y1[d]);
+            err = sqrt(err) / 15.;
+            if (err > params.tolerance && h > hmin)
+            {
+                double f = 0.9 * pow(params.tolerance / err, 0.2);
+                h *= (f < 0.2) ? 0.2 : f;
+                if (h < hmin)
+                    h = hmin;
+                continue;
+            }
+            accepted = true;
+            break;
+        }
+        if (!accepted)
+            break;
+
+        for (int d=0; d<3; d++)
+        {
+            p[d] = y2[d];
+            k1[d] = k2[d];
+        }
+        hint = hint2;
+        t += h;
+        speed = Magnitude(k1);
+        for (int d=0; d<3; d++)
+            points.push_back(p[d]);
+        times.push_back(sign * t);
+        speeds.push_back(speed);
+
+        double f = (err > 0) ? 0.9 * pow(params.tolerance / err, 0.2) : 4.;
+        h *= (f > 4.) ? 4. : ((f < 0.2) ? 0.2 : f);
+    }
+}
+
+eavlStreamlineFilter::eavlStreamlineFilter()
+    : direction(Forward), maxsteps(1000), maxtime(0),
+      steplength(0), tolerance(0)
+{
+}
+
+void
+eavlStreamlineFilter::AddSeedLine(const double p0[3], const double p1[3],
+                                  int n)
+{
+    for (int i=0; i<n; i++)
+    {
+        double a = (n > 1) ? double(i) / double(n-1) : 0.;
+        for (int d=0; d<3; d++)
+            seeds.push_back(p0[d] + a * (p1[d] - p0[d]));
+    }
+}
+
+void
+eavlStreamlineFilter::AddSeedPlane(const double origin[3],
+                                   const double u[3], const double v[3],
+                                   int nu, int nv)
+{
+    for (int j=0; j<nv; j++)
+    {
+        double b = (nv > 1) ? double(j) / double(nv-1) : 0.;
+        for (int i=0; i<nu; i++)
+        {
+            double a = (nu > 1) ? double(i) / double(nu-1) : 0.;
+            for (int d=0; d<3; d++)
+                seeds.push_back(origin[d] + a * u[d] + b * v[d]);
+        }
+    }
+}
+
+void
+eavlStreamlineFilter::Execute()
+{
+    int nseeds = seeds.size() / 3;
+    if (nseeds == 0)
+        THROW(eavlException,"eavlStreamlineFilter needs at least one seed point");
+    if (direction != Forward && direction != Backward && direction != Both)
+        THROW(eavlException,"eavlStreamlineFilter: unknown direction");
+
+    int inCellSetIndex = input->GetCellSetIndex(cellsetname);
+    eavlCellSet *inCells = input->GetCellSet(cellsetname);
+
+    eavlField *inField = input->GetField(fieldname);
+    bool pointField;
+    if (inField->GetAssociation() == eavlField::ASSOC_POINTS)
+        pointField = true;
+    else if (inField->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+             inField->GetAssocCellSet() == inCellSetIndex)
+        pointField = false;
+    else
+        THROW(eavlException,"eavlStreamlineFilter expects a point field or a field on the cell set");
+
+    int th_locator = eavlTimer::Start();
+    eavlCellLocator locator(input, inCells);
+    eavlTimer::Stop(th_locator, "build cell locator");
+
+    int dim = locator.GetSpatialDimension();
+    if (inField->GetArray()->GetNumberOfComponents() < dim)
+        THROW(eavlException,"eavlStreamlineFilter expects a vector field with a component for each spatial dimension");
+    eavlStreamlineField field(locator, inField->GetArray(), pointField);
+
+    eavlStreamlineParameters params;
+    params.maxsteps = maxsteps;
+    params.maxtime = maxtime;
+    params.steplength = steplength;
+    if (params.steplength <= 0)
+    {
+        double lo[3], hi[3];
+        locator.GetBounds(lo, hi);
+        double diag = 0;
+        for (int d=0; d<dim; d++)
+            diag += (hi[d]-lo[d]) * (hi[d]-lo[d]);
+        params.steplength = sqrt(diag) / 100.;
+    }
+    params.minsteplength = params.steplength / 1000.;
+    params.tolerance = (tolerance > 0) ? tolerance : params.steplength / 1000.;
+
+    //
+    // trace the particles.  they take very different numbers of steps,
+    // so they are handed out dynamically; each one keeps its own points
+    // until we know where they go in the output.
+    //
+    int th_trace = eavlTimer::Start();
+    vector<vector<double> > linePoints(nseeds);
+    vector<vector<double> > lineTimes(nseeds);
+    vector<vector<double> > lineSpeeds(nseeds);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int s = 0; s < nseeds; s++)
+    {
+        const double *seed = &(seeds[3*s]);
+        double v[3];
+        int hint = -1;
+        if (!field.Evaluate(seed, hint, v))
+            continue;
+
+        vector<double> &pts = linePoints[s];
+        vector<double> &times = lineTimes[s];
+        vector<double> &speeds = lineSpeeds[s];
+        if (direction != Forward)
+        {
+            // trace backward, then reverse so the line runs forward
+            TraceParticle(field, params, seed, -1., pts, times, speeds);
+            int n = times.size();
+            for (int i=0; i<n/2; i++)
+            {
+                for (int d=0; d<3; d++)
+                    std::swap(pts[3*i+d], pts[3*(n-1-i)+d]);
+                std::swap(times[i], times[n-1-i]);
+                std::swap(speeds[i], speeds[n-1-i]);
+            }
+        }
+        for (int d=0; d<3; d++)
+            pts.push_back(seed[d]);
+        times.push_back(0.);
+        speeds.push_back(Magnitude(v));
+        if (direction != Backward)
+            TraceParticle(field, params, seed, +1., pts, times, speeds);
+    }
+    eavlTimer::Stop(th_trace, "trace streamlines");
+
+    //
+    // set up the output mesh
+    //
+    vector<int> lineStart(nseeds+1, 0);
+    for (int s=0; s<nseeds; s++)
+        lineStart[s+1] = lineStart[s] + lineTimes[s].size();
+    int npts = lineStart[nseeds];
+    output->SetNumPoints(npts);
+
+    eavlFloatArray *coords = new eavlFloatArray("coords", 3, npts);
+    eavlFloatArray *time = new eavlFloatArray("time", 1, npts);
+    eavlFloatArray *speed = new eavlFloatArray("speed", 1, npts);
+    eavlIntArray *seedid = new eavlIntArray("seed_id", 1, npts);
+    float *coordsp = (float*)coords->GetHostArray();
+    float *timep = (float*)time->GetHostArray();
+    float *speedp = (float*)speed->GetHostArray();
+    int *seedidp = (int*)seedid->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int s = 0; s < nseeds; s++)
+    {
+        int n = lineTimes[s].size();
+        for (int i=0; i<n; i++)
+        {
+            int index = lineStart[s] + i;
+            for (int d=0; d<3; d++)
+                coordsp[3*index+d] = linePoints[s][3*i+d];
+            timep[index] = lineTimes[s][i];
+            speedp[index] = lineSpeeds[s][i];
+            seedidp[index] = s;
+        }
+    }
+
+    eavlExplicitConnectivity conn;
+    for (int s=0; s<nseeds; s++)
+    {
+        for (int i=lineStart[s]; i+1<lineStart[s+1]; i++)
+        {
+            int segment[2] = {i, i+1};
+            conn.AddElement(EAVL_BEAM, 2, segment);
+        }
+    }
+    eavlCellSetExplicit *outCellSet = new eavlCellSetExplicit("streamlines",1);
+    outCellSet->SetCellNodeConnectivity(conn);
+    output->AddCellSet(outCellSet);
+
+    output->AddField(new eavlField(1, coords, eavlField::ASSOC_POINTS));
+    output->AddField(new eavlField(1, time, eavlField::ASSOC_POINTS));
+    output->AddField(new eavlField(1, speed, eavlField::ASSOC_POINTS));
+    output->AddField(new eavlField(0, seedid, eavlField::ASSOC_POINTS));
+
+    eavlCoordinatesCartesian *coordsys =
+        new eavlCoordinatesCartesian(NULL,
+                                     eavlCoordinatesCartesian::X,
+                                     eavlCoordinatesCartesian::Y,
+                                     eavlCoordinatesCartesian::Z);
+    coordsys->SetAxis(0, new eavlCoordinateAxisField("coords", 0));
+    coordsys->SetAxis(1, new eavlCoordinateAxisField("coords", 1));
+    coordsys->SetAxis(2, new eavlCoordinateAxisField("coords", 2));
+    output->AddCoordinateSystem(coordsys);
+}
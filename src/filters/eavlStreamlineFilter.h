@@ -0,0 +1,110 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_STREAMLINE_FILTER_H
+#define EAVL_STREAMLINE_FILTER_H
+
+#include "STL.h"
+#include "eavlDataSet.h"
+#include "eavlCellSet.h"
+#include "eavlFilter.h"
+
+// ****************************************************************************
+// Class:  eavlStreamlineFilter
+//
+// Purpose:
+///   Trace streamlines through a vector field from a set of seed points,
+///   which may be added one at a time or as evenly spaced rakes along a
+///   line or across a parallelogram.  The field may be a point field or
+///   a field on the cell set, with at least as many components as the
+///   cell set's spatial dimension.
+///
+///   Particles are advanced with fourth-order Runge-Kutta steps.  The
+///   step size adapts by step doubling: each step is also taken as two
+///   half steps, and the difference between the two results must be
+///   within the tolerance.  A step never moves a particle further than
+///   the step length.  A particle stops when it leaves the cell set,
+///   reaches a point where the field vanishes, or runs out of steps or
+///   time.  Each particle's cell is found with a cell locator, testing
+///   the particle's previous cell first, and particles are traced in
+///   parallel.
+///
+///   The output is an explicit cell set of line segments, with the
+///   streamline points as its coordinates, and point fields holding the
+///   integration time, the field magnitude, and the index of the seed
+///   each point came from.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlStreamlineFilter : public eavlFilter
+{
+  public:
+    enum Direction { Forward, Backward, Both };
+  protected:
+    string         cellsetname;
+    string         fieldname;
+    vector<double> seeds;
+    Direction      direction;
+    int            maxsteps;
+    double         maxtime;
+    double         steplength;
+    double         tolerance;
+  public:
+    eavlStreamlineFilter();
+    void SetCellSet(const string &name)
+    {
+        cellsetname = name;
+    }
+    void SetField(const string &name)
+    {
+        fieldname = name;
+    }
+    void SetDirection(Direction d)
+    {
+        direction = d;
+    }
+    /// The most steps taken in each direction from a seed.
+    void SetMaxSteps(int n)
+    {
+        maxsteps = n;
+    }
+    /// The longest integration time in each direction; 0 means no limit.
+    void SetMaxTime(double t)
+    {
+        maxtime = t;
+    }
+    /// The longest distance covered in one step; defaults to 1/100 of
+    /// the diagonal of the cell set's bounds.
+    void SetStepLength(double l)
+    {
+        steplength = l;
+    }
+    /// The largest position error allowed in one step; defaults to
+    /// 1/1000 of the step length.
+    void SetTolerance(double t)
+    {
+        tolerance = t;
+    }
+
+    void ClearSeeds()
+    {
+        seeds.clear();
+    }
+    void AddSeedPoint(double x, double y, double z)
+    {
+        seeds.push_back(x);
+        seeds.push_back(y);
+        seeds.push_back(z);
+    }
+    /// Add n seeds evenly spaced from p0 to p1, inclusive.
+    void AddSeedLine(const double p0[3], const double p1[3], int n);
+    /// Add nu by nv seeds evenly spaced over the parallelogram spanned
+    /// by u and v from the origin, inclusive of its edges.
+    void AddSeedPlane(const double origin[3],
+                      const double u[3], const double v[3],
+                      int nu, int nv);
+
+    virtual void Execute();
+};
+
+#endif
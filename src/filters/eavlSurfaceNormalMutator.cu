@@ -11,6 +11,7 @@
 #include "eavlVector3.h"
 #include "eavlException.h"
 #include "eavlExecutor.h"
+#include "eavlNodePositions.h"
 
 class FaceNormalFunctor
 {
@@ -34,10 +35,186 @@ class FaceNormalFunctor
     }
 };
 
+// ----------------------------------------------------------------------------
+// The normal of one polygon (given by its points in order) as it is
+// added at each of its points, weighted by its area or by its angle at
+// that point; the weights are zero for a degenerate polygon.
+static void
+PolygonNormalWeights(int n, const int *ids, const eavlNodePositions &positions,
+                     eavlSurfaceNormalMutator::PointWeighting weighting,
+                     int *points, float *weights)
+{
+    eavlPoint3 p[12];
+    for (int i=0; i<n; i++)
+    {
+        positions.Get(ids[i], p[i].x, p[i].y, p[i].z);
+        points[i] = ids[i];
+        weights[3*i+0] = weights[3*i+1] = weights[3*i+2] = 0;
+    }
+
+    // area-weighted normal, as the sum of the fan triangles from p[0]
+    eavlVector3 norm(0,0,0);
+    for (int i=1; i<n-1; i++)
+        norm += (p[i] - p[0]) % (p[i+1] - p[0]);
+    norm *= .5f;
+    float area = norm.norm();
+    if (area == 0)
+        return;
+
+    for (int i=0; i<n; i++)
+    {
+        eavlVector3 w = norm;
+        if (weighting == eavlSurfaceNormalMutator::AngleWeighted)
+        {
+            eavlVector3 a = p[(i+n-1)%n] - p[i];
+            eavlVector3 b = p[(i+1)%n] - p[i];
+            float la = a.norm(), lb = b.norm();
+            if (la == 0 || lb == 0)
+                continue;
+            float c = (a * b) / (la * lb);
+            c = (c < -1) ? -1 : ((c > 1) ? 1 : c);
+            w = norm * (acos(c) / area);
+        }
+        weights[3*i+0] = w.x;
+        weights[3*i+1] = w.y;
+        weights[3*i+2] = w.z;
+    }
+}
+
+// the number of polygon corners a cell adds normals at
+static inline int
+NumNormalCorners(const eavlCell &cell)
+{
+    switch (cell.type)
+    {
+      case EAVL_TRI:
+      case EAVL_QUAD:
+      case EAVL_POLYGON:
+        return cell.numIndices;
+      case EAVL_PIXEL:
+        return 4;
+      case EAVL_TRISTRIP:
+        return (cell.numIndices > 2) ? 3 * (cell.numIndices - 2) : 0;
+      default:
+        // no surface normal for points, lines, or 3D cells
+        return 0;
+    }
+}
+
 eavlSurfaceNormalMutator::eavlSurfaceNormalMutator()
+    : pointnormals(false), weighting(AreaWeighted)
 {
 }
 
+// ****************************************************************************
+// Method:  eavlSurfaceNormalMutator::AddPointNormals
+//
+// Purpose:
+///   Each cell writes the weighted normal it adds at each of its corners
+///   into its own slots; the corners are then bucketed by point in cell
+///   order and each point sums its bucket, so the sums don't depend on
+///   the order the threads run in.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+void
+eavlSurfaceNormalMutator::AddPointNormals(eavlCellSet *inCells)
+{
+    eavlNodePositions positions(dataset);
+
+    int npts = dataset->GetNumPoints();
+    int ncells = inCells->GetNumCells();
+
+    // the corners of each cell
+    vector<int> cornerStart(ncells+1, 0);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int c = 0; c < ncells; c++)
+        cornerStart[c+1] = NumNormalCorners(inCells->GetCellNodes(c));
+    for (int c = 0; c < ncells; c++)
+        cornerStart[c+1] += cornerStart[c];
+    int ncorners = cornerStart[ncells];
+
+    // the weighted normal at each corner
+    vector<int> cornerPoint(ncorners);
+    vector<float> cornerWeight(3*ncorners);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int c = 0; c < ncells; c++)
+    {
+        eavlCell cell = inCells->GetCellNodes(c);
+        int first = cornerStart[c];
+        if (first == cornerStart[c+1])
+            continue;
+        int *points = &(cornerPoint[first]);
+        float *weights = &(cornerWeight[3*first]);
+        switch (cell.type)
+        {
+          case EAVL_PIXEL:
+            {
+                int ids[4] = {cell.indices[0], cell.indices[1],
+                              cell.indices[3], cell.indices[2]};
+                PolygonNormalWeights(4, ids, positions, weighting,
+                                     points, weights);
+            }
+            break;
+          case EAVL_TRISTRIP:
+            for (int t=0; t+2<cell.numIndices; t++)
+            {
+                // every other triangle is flipped
+                int ids[3] = {cell.indices[t + (t%2)],
+                              cell.indices[t + 1 - (t%2)],
+                              cell.indices[t + 2]};
+                PolygonNormalWeights(3, ids, positions, weighting,
+                                     points + 3*t, weights + 9*t);
+            }
+            break;
+          default:
+            PolygonNormalWeights(cell.numIndices, cell.indices, positions,
+                                 weighting, points, weights);
+            break;
+        }
+    }
+
+    // bucket the corners by point, keeping them in cell order
+    vector<int> pointStart(npts+1, 0);
+    for (int i = 0; i < ncorners; i++)
+        pointStart[cornerPoint[i]+1]++;
+    for (int i = 0; i < npts; i++)
+        pointStart[i+1] += pointStart[i];
+    vector<int> pointCorners(ncorners);
+    {
+        vector<int> fill(pointStart.begin(), pointStart.end()-1);
+        for (int i = 0; i < ncorners; i++)
+            pointCorners[fill[cornerPoint[i]]++] = i;
+    }
+
+    eavlFloatArray *out = new eavlFloatArray("nodecentered_surface_normals",
+                                             3, npts);
+    float *normals = (float*)out->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < npts; i++)
+    {
+        eavlVector3 norm(0,0,0);
+        for (int j = pointStart[i]; j < pointStart[i+1]; j++)
+        {
+            const float *w = &(cornerWeight[3*pointCorners[j]]);
+            norm += eavlVector3(w[0], w[1], w[2]);
+        }
+        norm.normalize();
+        normals[3*i+0] = norm.x;
+        normals[3*i+1] = norm.y;
+        normals[3*i+2] = norm.z;
+    }
+
+    dataset->AddField(new eavlField(0, out, eavlField::ASSOC_POINTS));
+}
 
 void
 eavlSurfaceNormalMutator::Execute()
@@ -50,6 +227,12 @@ eavlSurfaceNormalMutator::Execute()
     if (cs->GetDimension() != 3)
         THROW(eavlException,"eavlNodeToCellOp assumes 3D coordinates");
 
+    if (pointnormals)
+    {
+        AddPointNormals(inCells);
+        return;
+    }
+
     eavlCoordinateAxisField *axis0 = dynamic_cast<eavlCoordinateAxisField*>(cs->GetAxis(0));
     eavlCoordinateAxisField *axis1 = dynamic_cast<eavlCoordinateAxisField*>(cs->GetAxis(1));
     eavlCoordinateAxisField *axis2 = dynamic_cast<eavlCoordinateAxisField*>(cs->GetAxis(2));
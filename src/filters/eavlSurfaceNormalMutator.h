@@ -10,23 +10,43 @@
 //
 // Purpose:
 ///   Add new cell field which is the face surface normal of those cells.
+///
+///   Alternatively, add smooth point normals ("nodecentered_surface_normals")
+///   directly: each 2D cell adds its normal to its points, weighted by its
+///   area or by its angle at each point, and the sums are normalized.
+///   This needs neither the cell normals nor the reverse connectivity.
 //
 // Programmer:  Jeremy Meredith, Dave Pugmire, Sean Ahern, Rob Sisneros
 // Creation:    September 2, 2011
 //
+// Modifications:
+//   agent, Sun Oct 18 2026
+//   Added point normals.
+//
 // ****************************************************************************
 class eavlSurfaceNormalMutator : public eavlMutator
 {
+  public:
+    enum PointWeighting { AreaWeighted, AngleWeighted };
   protected:
     string cellsetname;
+    bool   pointnormals;
+    PointWeighting weighting;
   public:
     eavlSurfaceNormalMutator();
     void SetCellSet(const string &name)
     {
         cellsetname = name;
     }
+    void SetPointNormals(bool p, PointWeighting w = AreaWeighted)
+    {
+        pointnormals = p;
+        weighting = w;
+    }
     
     virtual void Execute();
+  protected:
+    void AddPointNormals(eavlCellSet *inCells);
 };
 
 #endif
@@ -3,6 +3,7 @@
 #include "eavlCoordinates.h"
 #include "eavlCellSetExplicit.h"
 #include "eavlException.h"
+#include "eavlNodePositions.h"
 
 static float Legendre(int i, float x)
 {
@@ -16,22 +17,107 @@ static float Legendre(int i, float x)
     return -999999999;
 }
 
-static float EvalLegendre(float scale, float xx, float yy, eavlArray *arr, int index)
+// The (xx,yy) locations, from -1 to +1, where the 3x3 Legendre fields
+// are evaluated in each quadrilateral: the centroid, the midpoints of
+// the four edges, then the four corners.
+///\note: we're assuming a particular edge ordering
+static const float legendreSamples[9][2] =
 {
-    float sum = 0;
-    for (int i=0; i<3; i++)
+    { 0,  0},
+    { 0, -1}, {+1,  0}, { 0, +1}, {-1,  0},
+    {-1, -1}, {+1, -1}, {+1, +1}, {-1, +1}
+};
+
+// ****************************************************************************
+// Class:  Legendre3x3Evaluator
+//
+// Purpose:
+///   Evaluate a 3x3 Legendre expansion at all nine sample locations of a
+///   cell at once.  The basis products at the samples are constant, so
+///   they are tabulated once and each evaluation is a small dense
+///   matrix-vector product.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+struct Legendre3x3Evaluator
+{
+    float basis[9][9];
+
+    Legendre3x3Evaluator()
+    {
+        for (int s=0; s<9; s++)
+            for (int i=0; i<3; i++)
+                for (int j=0; j<3; j++)
+                    basis[s][i*3 + j] = Legendre(i, legendreSamples[s][0]) *
+                                        Legendre(j, legendreSamples[s][1]);
+    }
+
+    void Evaluate(float scale, eavlArray *arr, int index, float out[9]) const
     {
-        for (int j=0; j<3; j++)
+        float coef[9];
+        for (int c=0; c<9; c++)
+            coef[c] = arr->GetComponentAsDouble(index, c);
+        ///\todo: first, scale as calculated has a square root, so squaring it here seems wasteful.
+        ///       furthermore, it's based on the level of the quadtree; that's no good!
+        ///       the right thing is probably to just scale the darn coefficients in the MADNESS reader.
+        float scale2 = scale*scale;
+        for (int s=0; s<9; s++)
         {
-            float v = arr->GetComponentAsDouble(index, i*3 + j) * Legendre(i, xx) * Legendre(j, yy);
-            //cerr << "i="<<i<<" j="<<j<<" val="<<v<<endl;
-            sum += v;
+            float sum = 0;
+            for (int c=0; c<9; c++)
+                sum += coef[c] * basis[s][c];
+            out[s] = sum * scale2;
         }
     }
-    ///\todo: first, scale as calculated has a square root, so squaring it here seems wasteful.
-    ///       furthermore, it's based on the level of the quadtree; that's no good!
-    ///       the right thing is probably to just scale the darn coefficients in the MADNESS reader.
-    return sum * scale*scale;
+};
+
+static int
+GetTesselateEdges(const eavlCell &cell, signed char (*&edges)[2])
+{
+    switch (cell.type)
+    {
+      case EAVL_TRI:
+        edges = eavlTriEdges;
+        return 3;
+      case EAVL_QUAD:
+        edges = eavlQuadEdges;
+        return 4;
+      case EAVL_PIXEL:
+        edges = eavlPixelEdges;
+        return 4;
+      case EAVL_POLYGON:
+        if (cell.numIndices == 3)
+        {
+            edges = eavlTriEdges;
+            return 3;
+        }
+        else if (cell.numIndices == 4)
+        {
+            edges = eavlQuadEdges;
+            return 4;
+        }
+        break;
+      default:
+        break;
+    }
+    edges = NULL;
+    return 0;
+}
+
+///\todo: not a great way to calculate scale; maybe doing it
+///       in the MADNESS reader is a better idea.
+static float
+GetLegendreScale(const eavlNodePositions &positions, const eavlCell &cell)
+{
+    float x0, y0, z0, x1, y1, z1;
+    positions.Get(cell.indices[0], x0, y0, z0);
+    positions.Get(cell.indices[1], x1, y1, z1);
+    float cell_size_a = fabs(x1 - x0);
+    float cell_size_b = fabs(y1 - y0);
+    float cell_size = (cell_size_a > cell_size_b) ? cell_size_a : cell_size_b;
+    return sqrt(1. / cell_size);
 }
 
 
@@ -39,46 +125,74 @@ eavlTesselate2DFilter::eavlTesselate2DFilter()
 {
 }
 
+// ****************************************************************************
+// Method:  eavlTesselate2DFilter::Execute
+//
+// Purpose:
+///   Split each cell into one quad per edge, around a new point at its
+///   centroid and new points at its edge midpoints.  A first parallel
+///   pass counts the edges of every cell and a scan of the counts gives
+///   each cell's new points and new cells, so the output is allocated
+///   once and filled by a second parallel pass.
+//
+// Programmer:  Jeremy Meredith, Dave Pugmire, Sean Ahern
+// Creation:    February 2, 2012
+//
+// Modifications:
+//   agent, Sun Oct 18 2026
+//   Restructured into parallel count, scan and fill passes; evaluate all
+//   samples of the Legendre fields in one pass over each cell.
+//
+// ****************************************************************************
 void
 eavlTesselate2DFilter::Execute()
 {
     eavlCellSet *inCells = input->GetCellSet(cellsetname);
-
-    //
-    // set up output mesh
-    //
-    eavlFloatArray *coords = new eavlFloatArray("coords",3);
-    
-    eavlField *coordField = new eavlField(1, coords, eavlField::ASSOC_POINTS);
-    output->AddField(coordField);
-
-    eavlCellSetExplicit *outCellSet = new eavlCellSetExplicit("tesselated",2);
-    output->AddCellSet(outCellSet);
+    int in_npts = input->GetNumPoints();
+    int in_ncells = inCells->GetNumCells();
 
     //
     // calculate number of edges
     ///\todo: (NOT DOING EDGE MATCHING YET; NEEDS TO SUPPORT QUADTREES WHICH
     ///        THEMSELVES CAN'T DO THAT YET)
     //
-    int total_nedge = 0;
-    int in_ncells = inCells->GetNumCells();
+    vector<int> edgeStart(in_ncells+1);
+    edgeStart[0] = 0;
+    bool badShape = false;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for reduction(||:badShape)
+#endif
     for (int e=0; e<in_ncells; e++)
     {
         eavlCell cell = inCells->GetCellNodes(e);
-        switch (cell.type)
-        {
-          case EAVL_TRI:     total_nedge += 3; break;
-          case EAVL_QUAD:    total_nedge += 4; break;
-          case EAVL_PIXEL:   total_nedge += 4; break;
-          case EAVL_POLYGON: total_nedge += cell.numIndices; break;
-          default: break;
-        }
+        signed char (*edges)[2];
+        int nedges = GetTesselateEdges(cell, edges);
+        if (nedges == 0)
+            badShape = true;
+        edgeStart[e+1] = nedges;
     }
+    if (badShape)
+        THROW(eavlException,"Don't know what to do with this shape\n");
+    for (int e=0; e<in_ncells; e++)
+        edgeStart[e+1] += edgeStart[e];
+    int total_nedge = edgeStart[in_ncells];
+
+    //
+    // calculate total number of points; cell e gets its centroid at
+    // in_npts + e + edgeStart[e], followed by its edge midpoints
+    //
+    int out_npts = in_npts + in_ncells + total_nedge;
+    output->SetNumPoints(out_npts);
 
     //
-    // calculate total number of points
+    // set up output mesh
     //
-    output->SetNumPoints(input->GetNumPoints() + in_ncells + total_nedge);
+    eavlFloatArray *coords = new eavlFloatArray("coords", 3, out_npts);
+    eavlField *coordField = new eavlField(1, coords, eavlField::ASSOC_POINTS);
+    output->AddField(coordField);
+
+    eavlCellSetExplicit *outCellSet = new eavlCellSetExplicit("tesselated",2);
+    output->AddCellSet(outCellSet);
 
     //
     // tesselate high-order cell arrays and fields to single-component nodal scalars
@@ -91,14 +205,16 @@ eavlTesselate2DFilter::Execute()
             input->GetField(i)->GetArray()->GetNumberOfComponents() == 9)
         {
             eavlFloatArray *arr = new eavlFloatArray(input->GetField(i)->GetArray()->GetName(),
-                                                       1); // single-component, now
-            arr->SetNumberOfTuples(output->GetNumPoints());
+                                                     1, out_npts); // single-component, now
             legendre3x3_arrays.push_back(pair<eavlArray*,eavlArray*>(input->GetField(i)->GetArray(), arr));
 
             eavlField *f = new eavlField(1, arr, eavlField::ASSOC_POINTS);
             output->AddField(f);
         }
     }
+    int nlegendre = legendre3x3_arrays.size();
+    if (nlegendre > 0 && total_nedge != 4 * in_ncells)
+        THROW(eavlException,"We've got 3x3 legendre arrays for non-quadrilateral cells?!");
 
     //
     // create nodal arrays and fields
@@ -110,8 +226,8 @@ eavlTesselate2DFilter::Execute()
             input->GetField(i)->GetOrder() == 1)
         {
             eavlFloatArray *arr = new eavlFloatArray(input->GetField(i)->GetArray()->GetName(),
-                                                       input->GetField(i)->GetArray()->GetNumberOfComponents());
-            arr->SetNumberOfTuples(output->GetNumPoints());
+                                                     input->GetField(i)->GetArray()->GetNumberOfComponents(),
+                                                     out_npts);
             nodal_arrays.push_back(pair<eavlArray*,eavlArray*>(input->GetField(i)->GetArray(), arr));
 
             eavlField *f = new eavlField(input->GetField(i)->GetOrder(), arr,
@@ -119,27 +235,38 @@ eavlTesselate2DFilter::Execute()
             output->AddField(f);
         }
     }
+    int nnodal = nodal_arrays.size();
+    vector<float*> nodal_out(nnodal);
+    vector<int> nodal_ncomp(nnodal);
+    for (int k=0; k<nnodal; k++)
+    {
+        nodal_out[k] = (float*)nodal_arrays[k].second->GetHostArray();
+        nodal_ncomp[k] = nodal_arrays[k].first->GetNumberOfComponents();
+    }
+    vector<float*> legendre_out(nlegendre);
+    for (int k=0; k<nlegendre; k++)
+        legendre_out[k] = (float*)legendre3x3_arrays[k].second->GetHostArray();
+
+    eavlNodePositions positions(input);
+    float *xyz = (float*)coords->GetHostArray();
+    Legendre3x3Evaluator legendre;
 
     //
     // copy old points and point values
     //
-    coords->SetNumberOfTuples(output->GetNumPoints());
-    for (int i=0; i<input->GetNumPoints(); i++)
-    {
-        double x = input->GetPoint(i, 0);
-        double y = input->GetPoint(i, 1);
-        double z = input->GetPoint(i, 2);
-        coords->SetComponentFromDouble(i, 0, x);
-        coords->SetComponentFromDouble(i, 1, y);
-        coords->SetComponentFromDouble(i, 2, z);
-    }
-    for (size_t j=0; j<nodal_arrays.size(); j++)
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int p=0; p<in_npts; p++)
     {
-        int nc = nodal_arrays[j].first->GetNumberOfComponents();
-        for (int c=0; c<nc; c++)
-            for (int p=0; p<input->GetNumPoints(); p++)
-                nodal_arrays[j].second->SetComponentFromDouble(p, c,
-                            nodal_arrays[j].first->GetComponentAsDouble(p,c));
+        positions.Get(p, xyz[3*p+0], xyz[3*p+1], xyz[3*p+2]);
+        for (int k=0; k<nnodal; k++)
+        {
+            int nc = nodal_ncomp[k];
+            for (int c=0; c<nc; c++)
+                nodal_out[k][p*nc + c] =
+                    nodal_arrays[k].first->GetComponentAsDouble(p,c);
+        }
     }
 
     //
@@ -147,195 +274,132 @@ eavlTesselate2DFilter::Execute()
     // create new cells and new points
     //
     eavlExplicitConnectivity conn;
-    int new_point_index = input->GetNumPoints();
+    conn.shapetype.resize(total_nedge);
+    conn.connectivity.resize(5 * total_nedge);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
     for (int e=0; e<in_ncells; e++)
     {
         eavlCell cell = inCells->GetCellNodes(e);
-
-        int nedges = 0;
-        signed char (*edges)[2] = NULL;
-        switch (cell.type)
-        {
-          case EAVL_TRI:
-            nedges  = 3;
-            edges   = eavlTriEdges;
-            break;
-          case EAVL_QUAD:
-            nedges  = 4;
-            edges   = eavlQuadEdges;
-            break;
-          case EAVL_PIXEL:
-            nedges  = 4;
-            edges   = eavlPixelEdges;
-            break;
-          case EAVL_POLYGON:
-            if (cell.numIndices == 3)
-            {
-                nedges  = 3;
-                edges   = eavlTriEdges;
-            }
-            else if (cell.numIndices == 4)
-            {
-                nedges  = 4;
-                edges   = eavlQuadEdges;
-            }
-            else
-            {
-                THROW(eavlException,"Don't know what to do with this shape\n");
-            }
-            break;
-          default:
-            THROW(eavlException,"Don't know what to do with this shape\n");
-        }
-
-        ///\todo: not a great way to calculate scale; maybe doing it
-        ///       in the MADNESS reader is a better idea.
-        float cell_size_a = fabs(input->GetPoint(cell.indices[1], 0) -
-                                 input->GetPoint(cell.indices[0], 0));
-        float cell_size_b = fabs(input->GetPoint(cell.indices[1], 1) -
-                                 input->GetPoint(cell.indices[0], 1));
-        float cell_size = (cell_size_a > cell_size_b) ? cell_size_a : cell_size_b;
-        float legendre_scale = sqrt(1. / cell_size);
-        //cerr << "legendre_scale = "<<legendre_scale<<endl;
+        signed char (*edges)[2];
+        int nedges = GetTesselateEdges(cell, edges);
+        int centroid_point_index = in_npts + e + edgeStart[e];
 
         //
-        // create a new point at the centroid of the cell
+        // create a new point at the centroid of the cell,
+        // and new points midway along each edge
         //
-        int centroid_point_index = new_point_index;
-
-        // do the coordinates
-        double x = 0;
-        double y = 0;
-        double z = 0;
+        float pts[4][3];
+        double cx = 0, cy = 0, cz = 0;
         for (int j=0; j<cell.numIndices; j++)
         {
-            x += input->GetPoint(cell.indices[j], 0);
-            y += input->GetPoint(cell.indices[j], 1);
-            z += input->GetPoint(cell.indices[j], 2);
+            positions.Get(cell.indices[j], pts[j][0], pts[j][1], pts[j][2]);
+            cx += pts[j][0];
+            cy += pts[j][1];
+            cz += pts[j][2];
+        }
+        float *c = xyz + 3*centroid_point_index;
+        c[0] = cx / double(cell.numIndices);
+        c[1] = cy / double(cell.numIndices);
+        c[2] = cz / double(cell.numIndices);
+        for (int j=0; j<nedges; j++)
+        {
+            float *m = c + 3*(1 + j);
+            for (int d=0; d<3; d++)
+                m[d] = (double(pts[edges[j][0]][d]) +
+                        double(pts[edges[j][1]][d])) / 2.;
         }
-        x /= double(cell.numIndices);
-        y /= double(cell.numIndices);
-        z /= double(cell.numIndices);
-        coords->SetComponentFromDouble(new_point_index, 0, x);
-        coords->SetComponentFromDouble(new_point_index, 1, y);
-        coords->SetComponentFromDouble(new_point_index, 2, z);
 
         // do the nodal arrays
-        for (size_t k=0; k<nodal_arrays.size(); k++)
+        for (int k=0; k<nnodal; k++)
         {
-            int nc = nodal_arrays[k].first->GetNumberOfComponents();
-            for (int c=0; c<nc; c++)
+            eavlArray *inarr = nodal_arrays[k].first;
+            int nc = nodal_ncomp[k];
+            float *out = nodal_out[k] + centroid_point_index*nc;
+            for (int comp=0; comp<nc; comp++)
             {
+                double vals[4];
                 double value = 0;
                 for (int j=0; j<cell.numIndices; j++)
-                    value += nodal_arrays[k].first->GetComponentAsDouble(cell.indices[j], c);
-                value /= double(cell.numIndices);
-
-                nodal_arrays[k].second->SetComponentFromDouble(new_point_index,
-                                                               c, value);
+                {
+                    vals[j] = inarr->GetComponentAsDouble(cell.indices[j], comp);
+                    value += vals[j];
+                }
+                out[comp] = value / double(cell.numIndices);
+                for (int j=0; j<nedges; j++)
+                    out[(1+j)*nc + comp] = (vals[edges[j][0]] +
+                                            vals[edges[j][1]]) / 2.;
             }
         }
 
-        // tesselate the high-order ones at this centroid
+        // tesselate the high-order ones at this centroid and the edges
         // note: the xx,yy values range from -1 to +1
         //       it must be a quadrilateral cell
         //       and the centroid is at 0,0
-        for (size_t k=0; k<legendre3x3_arrays.size(); k++)
+        if (nlegendre > 0)
         {
-            if (nedges != 4)
-                THROW(eavlException,"We've got 3x3 legendre arrays for non-quadrilateral cells?!");
-            eavlArray *inarr = legendre3x3_arrays[k].first;
-            eavlArray *outarr = legendre3x3_arrays[k].second;
-            float value = EvalLegendre(legendre_scale, 0, 0, inarr, e);
-            outarr->SetComponentFromDouble(new_point_index, 0, value);
-        }
-
-        //
-        // create new points midway along each edge
-        //
-
-        // coordinates
-        new_point_index = centroid_point_index + 1;// note: reset 'new_point_index'
-        for (int j=0; j<nedges; j++)
-        {
-            double x = (input->GetPoint(cell.indices[edges[j][0]], 0) + 
-                        input->GetPoint(cell.indices[edges[j][1]], 0)) / 2.;
-            double y = (input->GetPoint(cell.indices[edges[j][0]], 1) + 
-                        input->GetPoint(cell.indices[edges[j][1]], 1)) / 2.;
-            double z = (input->GetPoint(cell.indices[edges[j][0]], 2) + 
-                        input->GetPoint(cell.indices[edges[j][1]], 2)) / 2.;
-            coords->SetComponentFromDouble(new_point_index, 0, x);
-            coords->SetComponentFromDouble(new_point_index, 1, y);
-            coords->SetComponentFromDouble(new_point_index, 2, z);
-            new_point_index++;
-        }
-
-        // nodal arrays
-        for (size_t k=0; k<nodal_arrays.size(); k++)
-        {
-            new_point_index = centroid_point_index + 1;// note: reset 'new_point_index'
-            int nc = nodal_arrays[k].first->GetNumberOfComponents();
-            for (int j=0; j<nedges; j++)
+            float legendre_scale = GetLegendreScale(positions, cell);
+            for (int k=0; k<nlegendre; k++)
             {
-                for (int c=0; c<nc; c++)
-                {
-                    double value = (nodal_arrays[k].first->GetComponentAsDouble(cell.indices[edges[j][0]], c) +
-                                    nodal_arrays[k].first->GetComponentAsDouble(cell.indices[edges[j][1]], c)) / 2.;
-                                    
-                    nodal_arrays[k].second->SetComponentFromDouble(new_point_index,
-                                                                   c, value);
-                }
-                new_point_index++;
+                float values[9];
+                legendre.Evaluate(legendre_scale,
+                                  legendre3x3_arrays[k].first, e, values);
+                for (int s=0; s<5; s++)
+                    legendre_out[k][centroid_point_index + s] = values[s];
             }
         }
 
-        // tesselate legendre3x3 arrays at the edges
-        for (size_t k=0; k<legendre3x3_arrays.size(); k++)
+        // create the cells for each
+        for (int j=0; j<nedges; j++)
         {
-            new_point_index = centroid_point_index + 1;// note: reset 'new_point_index'
-            eavlArray *inarr = legendre3x3_arrays[k].first;
-            eavlArray *outarr = legendre3x3_arrays[k].second;
-            // note: we're assuming a particular edge ordering
-            float value0 = EvalLegendre(legendre_scale, 0, -1, inarr, e);
-            float value1 = EvalLegendre(legendre_scale, +1, 0, inarr, e);
-            float value2 = EvalLegendre(legendre_scale, 0, +1, inarr, e);
-            float value3 = EvalLegendre(legendre_scale, -1, 0, inarr, e);
-            outarr->SetComponentFromDouble(new_point_index + 0, 0, value0);
-            outarr->SetComponentFromDouble(new_point_index + 1, 0, value1);
-            outarr->SetComponentFromDouble(new_point_index + 2, 0, value2);
-            outarr->SetComponentFromDouble(new_point_index + 3, 0, value3);
-            new_point_index += 4;
+            int newcell = edgeStart[e] + j;
+            int *cc = &conn.connectivity[5 * newcell];
+            conn.shapetype[newcell] = (int)EAVL_QUAD;
+            cc[0] = 4;
+            cc[1] = centroid_point_index;
+            cc[2] = centroid_point_index + 1 + j;
+            cc[3] = cell.indices[edges[j][1]];
+            cc[4] = centroid_point_index + 1 + (j+1)%nedges;
         }
+    }
 
-        // tesselate legendre3x3 arrays at the nodes, too
-        // note: inefficient in the general case since we may have
-        // shared nodes, but it's not too bad
-        for (size_t k=0; k<legendre3x3_arrays.size(); k++)
+    //
+    // tesselate legendre3x3 arrays at the nodes, too; a node shared by
+    // several cells takes its value from the last of them
+    //
+    if (nlegendre > 0)
+    {
+        vector<int> owner(in_npts, -1);
+        for (int e=0; e<in_ncells; e++)
         {
-            eavlArray *inarr = legendre3x3_arrays[k].first;
-            eavlArray *outarr = legendre3x3_arrays[k].second;
-            // note: we're assuming a particular edge ordering again
-            float value0 = EvalLegendre(legendre_scale, -1, -1, inarr, e);
-            float value1 = EvalLegendre(legendre_scale, +1, -1, inarr, e);
-            float value2 = EvalLegendre(legendre_scale, +1, +1, inarr, e);
-            float value3 = EvalLegendre(legendre_scale, -1, +1, inarr, e);
-            outarr->SetComponentFromDouble(cell.indices[edges[0][0]], 0, value0);
-            outarr->SetComponentFromDouble(cell.indices[edges[1][0]], 0, value1);
-            outarr->SetComponentFromDouble(cell.indices[edges[2][0]], 0, value2);
-            outarr->SetComponentFromDouble(cell.indices[edges[3][0]], 0, value3);
+            eavlCell cell = inCells->GetCellNodes(e);
+            signed char (*edges)[2];
+            GetTesselateEdges(cell, edges);
+            for (int j=0; j<4; j++)
+                owner[cell.indices[edges[j][0]]] = 4*e + j;
         }
-
-        // create the cells for each
-        for (int j=0; j<nedges; j++)
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int p=0; p<in_npts; p++)
         {
-            conn.shapetype.push_back((int)EAVL_QUAD);
-            conn.connectivity.push_back(4);
-            conn.connectivity.push_back(centroid_point_index);
-            conn.connectivity.push_back(centroid_point_index + 1 + j);
-            conn.connectivity.push_back(cell.indices[edges[j][1]]);
-            conn.connectivity.push_back(centroid_point_index + 1 + (j+1)%nedges);
+            if (owner[p] < 0)
+                continue;
+            int e = owner[p] / 4;
+            int j = owner[p] % 4;
+            eavlCell cell = inCells->GetCellNodes(e);
+            float legendre_scale = GetLegendreScale(positions, cell);
+            for (int k=0; k<nlegendre; k++)
+            {
+                float values[9];
+                legendre.Evaluate(legendre_scale,
+                                  legendre3x3_arrays[k].first, e, values);
+                legendre_out[k][p] = values[5 + j];
+            }
         }
     }
+
     outCellSet->SetCellNodeConnectivity(conn);
 
     eavlCoordinatesCartesian *coordsys =
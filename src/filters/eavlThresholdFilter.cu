@@ -0,0 +1,250 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlThresholdFilter.h"
+#include "eavlCoordinates.h"
+#include "eavlCellSetExplicit.h"
+#include "eavlException.h"
+#include "eavlExecutor.h"
+#include "eavlGatherOp_1.h"
+#include "eavlPrefixSumOp_1.h"
+#include "eavlReduceOp_1.h"
+#include "eavlSimpleReverseIndexOp.h"
+#include "eavlMemoryTracker.h"
+#include <algorithm>
+
+eavlThresholdFilter::eavlThresholdFilter()
+    : minval(0), maxval(0), component(0),
+      pointRule(eavlThresholdMutator::ALL_POINTS)
+{
+}
+
+// ****************************************************************************
+// Method:  eavlThresholdFilter::Execute
+//
+// Purpose:
+///   Find the kept cells, copy their connectivity in parallel while
+///   flagging the points they use, then scan and reverse the point
+///   flags to renumber the connectivity and gather the point data.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+void
+eavlThresholdFilter::Execute()
+{
+    int inCellSetIndex = input->GetCellSetIndex(cellsetname);
+    eavlCellSet *inCells = input->GetCellSet(cellsetname);
+
+    eavlIntArray *kept = eavlThresholdMutator::FindCellsInRange(input,
+                                                  cellsetname, fieldname,
+                                                  component, minval, maxval,
+                                                  pointRule);
+    int nkept = kept->GetNumberOfTuples();
+    const int *ids = (nkept > 0) ? (const int*)kept->GetHostArray() : NULL;
+    int in_npts = input->GetNumPoints();
+
+    //
+    // size the output connectivity: a count and the nodes for each cell
+    //
+    vector<int> connStart(nkept+1);
+    connStart[0] = 0;
+    for (int i=0; i<nkept; i++)
+        connStart[i+1] = connStart[i] + 1 + inCells->GetCellNodes(ids[i]).numIndices;
+
+    eavlIntArray *pointUsed, *newIndex, *total;
+    {
+        eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+        pointUsed = new eavlIntArray("pointused", 1, in_npts);
+        newIndex = new eavlIntArray("newpointindex", 1, in_npts);
+        total = new eavlIntArray("npointsused", 1, 1);
+    }
+    int *used = (int*)pointUsed->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int p=0; p<in_npts; p++)
+        used[p] = 0;
+
+    //
+    // copy the kept cells, flagging the points they use
+    // (racing writes of the same 1 to a flag are harmless)
+    //
+    eavlExplicitConnectivity conn;
+    conn.shapetype.resize(nkept);
+    conn.connectivity.resize(connStart[nkept]);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i=0; i<nkept; i++)
+    {
+        eavlCell cell = inCells->GetCellNodes(ids[i]);
+        int index = connStart[i];
+        conn.shapetype[i] = int(cell.type);
+        conn.connectivity[index] = cell.numIndices;
+        for (int n=0; n<cell.numIndices; n++)
+        {
+            conn.connectivity[index + 1 + n] = cell.indices[n];
+            used[cell.indices[n]] = 1;
+        }
+    }
+
+    //
+    // number the used points, and find the input point for each one
+    //
+    int noutpts = 0;
+    if (in_npts > 0)
+    {
+        eavlExecutor::AddOperation(
+            new eavlPrefixSumOp_1(pointUsed, newIndex, false),
+            "scan to generate output index of used points");
+        eavlExecutor::AddOperation(
+            new eavlReduceOp_1<eavlAddFunctor<int> >(pointUsed,
+                                                     total,
+                                                     eavlAddFunctor<int>()),
+            "sumreduce to count used points");
+        eavlExecutor::Go();
+        noutpts = total->GetValue(0);
+    }
+
+    eavlIntArray *oldIndex;
+    {
+        eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+        oldIndex = new eavlIntArray("oldpointindex", 1, noutpts);
+    }
+    if (noutpts > 0)
+    {
+        eavlExecutor::AddOperation(
+            new eavlSimpleReverseIndexOp(pointUsed, newIndex, oldIndex),
+            "generate reverse lookup: output point to input point");
+        eavlExecutor::Go();
+    }
+
+    const int *renumber = (const int*)newIndex->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+    for (int i=0; i<nkept; i++)
+    {
+        int index = connStart[i];
+        int npts = conn.connectivity[index];
+        for (int n=0; n<npts; n++)
+            conn.connectivity[index + 1 + n] =
+                renumber[conn.connectivity[index + 1 + n]];
+    }
+
+    //
+    // set up the output mesh
+    //
+    output->SetNumPoints(noutpts);
+
+    eavlCellSetExplicit *outCellSet =
+        new eavlCellSetExplicit("threshold", inCells->GetDimensionality());
+    outCellSet->SetCellNodeConnectivity(conn);
+    output->AddCellSet(outCellSet);
+
+    //
+    // the coordinates are rebuilt below as newx/newy/newz, so skip the
+    // point fields the input's coordinate axes read from
+    //
+    vector<string> coordFields;
+    for (int c=0; c<input->GetNumCoordinateSystems(); c++)
+    {
+        eavlCoordinates *cs = input->GetCoordinateSystem(c);
+        for (int d=0; d<cs->GetDimension(); d++)
+        {
+            eavlCoordinateAxisField *axis =
+                dynamic_cast<eavlCoordinateAxisField*>(cs->GetAxis(d));
+            if (axis)
+                coordFields.push_back(axis->GetFieldName());
+        }
+    }
+
+    //
+    // gather every component of the other point fields and the cell
+    // set's fields
+    //
+    for (int i=0; i<input->GetNumFields(); i++)
+    {
+        eavlField *f = input->GetField(i);
+        eavlIntArray *from = NULL;
+        if (f->GetAssociation() == eavlField::ASSOC_POINTS &&
+            std::find(coordFields.begin(), coordFields.end(),
+                      f->GetArray()->GetName()) != coordFields.end())
+            continue;
+        else if (f->GetAssociation() == eavlField::ASSOC_POINTS)
+            from = oldIndex;
+        else if (f->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+                 f->GetAssocCellSet() == inCellSetIndex)
+            from = kept;
+        else
+            continue;
+
+        eavlArray *a = f->GetArray();
+        int ncomp = a->GetNumberOfComponents();
+        int n = from->GetNumberOfTuples();
+        eavlArray *outArray = a->Create(a->GetName(), ncomp, n);
+        for (int c=0; c<ncomp && n>0; c++)
+        {
+            eavlExecutor::AddOperation(
+                new eavlGatherOp_1(eavlArrayWithLinearIndex(a, c),
+                                   eavlArrayWithLinearIndex(outArray, c),
+                                   from),
+                "gather field to output");
+        }
+
+        eavlField *outField;
+        if (from == oldIndex)
+            outField = new eavlField(f->GetOrder(), outArray,
+                                     eavlField::ASSOC_POINTS);
+        else
+            outField = new eavlField(f->GetOrder(), outArray,
+                                     eavlField::ASSOC_CELL_SET, 0);
+        output->AddField(outField);
+    }
+    eavlExecutor::Go();
+
+    //
+    // the input coordinates may be implicit, so evaluate them for the
+    // used points; warm up the axes' field lookups before going parallel
+    //
+    eavlFloatArray *newx = new eavlFloatArray("newx", 1, noutpts);
+    eavlFloatArray *newy = new eavlFloatArray("newy", 1, noutpts);
+    eavlFloatArray *newz = new eavlFloatArray("newz", 1, noutpts);
+    if (noutpts > 0)
+    {
+        const int *old = (const int*)oldIndex->GetHostArray();
+        float *x = (float*)newx->GetHostArray();
+        float *y = (float*)newy->GetHostArray();
+        float *z = (float*)newz->GetHostArray();
+        for (int c=0; c<3; c++)
+            input->GetPoint(old[0], c);
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int i=0; i<noutpts; i++)
+        {
+            x[i] = input->GetPoint(old[i], 0);
+            y[i] = input->GetPoint(old[i], 1);
+            z[i] = input->GetPoint(old[i], 2);
+        }
+    }
+    output->AddField(new eavlField(1, newx, eavlField::ASSOC_POINTS));
+    output->AddField(new eavlField(1, newy, eavlField::ASSOC_POINTS));
+    output->AddField(new eavlField(1, newz, eavlField::ASSOC_POINTS));
+
+    eavlCoordinatesCartesian *coordsys =
+        new eavlCoordinatesCartesian(NULL,
+                                     eavlCoordinatesCartesian::X,
+                                     eavlCoordinatesCartesian::Y,
+                                     eavlCoordinatesCartesian::Z);
+    coordsys->SetAxis(0, new eavlCoordinateAxisField("newx", 0));
+    coordsys->SetAxis(1, new eavlCoordinateAxisField("newy", 0));
+    coordsys->SetAxis(2, new eavlCoordinateAxisField("newz", 0));
+    output->AddCoordinateSystem(coordsys);
+
+    delete kept;
+    delete pointUsed;
+    delete newIndex;
+    delete total;
+    delete oldIndex;
+}
@@ -0,0 +1,59 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_THRESHOLD_FILTER_H
+#define EAVL_THRESHOLD_FILTER_H
+
+#include "STL.h"
+#include "eavlDataSet.h"
+#include "eavlCellSet.h"
+#include "eavlFilter.h"
+#include "eavlThresholdMutator.h"
+
+// ****************************************************************************
+// Class:  eavlThresholdFilter
+//
+// Purpose:
+///   Threshold a cell set (see eavlThresholdMutator for the rules) into
+///   a new, compacted data set: an explicit cell set of only the kept
+///   cells, referencing only the points those cells use.  All
+///   components of all point fields and of the cell set's cell fields
+///   are gathered to the output under their original names.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlThresholdFilter : public eavlFilter
+{
+  protected:
+    double minval, maxval;
+    int component;
+    eavlThresholdMutator::PointRule pointRule;
+    string fieldname, cellsetname;
+  public:
+    eavlThresholdFilter();
+    void SetRange(double vmin, double vmax)
+    {
+        minval = vmin;
+        maxval = vmax;
+    }
+    void SetField(const string &name)
+    {
+        fieldname = name;
+    }
+    void SetComponent(int c)
+    {
+        component = c;
+    }
+    void SetPointRule(eavlThresholdMutator::PointRule rule)
+    {
+        pointRule = rule;
+    }
+    void SetCellSet(const string &name)
+    {
+        cellsetname = name;
+    }
+
+    virtual void Execute();
+};
+
+#endif
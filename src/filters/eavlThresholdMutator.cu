@@ -0,0 +1,231 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlThresholdMutator.h"
+#include "eavlCellSetSubset.h"
+#include "eavlException.h"
+#include "eavlExecutor.h"
+#include "eavlGatherOp_1.h"
+#include "eavlMapOp_1_1.h"
+#include "eavlPrefixSumOp_1.h"
+#include "eavlReduceOp_1.h"
+#include "eavlSimpleReverseIndexOp.h"
+#include "eavlTopologyMapOp_1_0_1.h"
+#include "eavlMemoryTracker.h"
+
+class ThresholdInRangeFunctor
+{
+    float lo, hi;
+  public:
+    ThresholdInRangeFunctor(float l, float h) : lo(l), hi(h) { }
+    EAVL_FUNCTOR int operator()(float val)
+    {
+        return (val >= lo) && (val <= hi);
+    }
+};
+
+class ThresholdAllPointsFunctor
+{
+    float lo, hi;
+  public:
+    ThresholdAllPointsFunctor(float l, float h) : lo(l), hi(h) { }
+    EAVL_FUNCTOR int operator()(int shapeType, int n, float vals[])
+    {
+        for (int i=0; i<n; i++)
+        {
+            if (vals[i] < lo || vals[i] > hi)
+                return 0;
+        }
+        return 1;
+    }
+};
+
+class ThresholdAnyPointFunctor
+{
+    float lo, hi;
+  public:
+    ThresholdAnyPointFunctor(float l, float h) : lo(l), hi(h) { }
+    EAVL_FUNCTOR int operator()(int shapeType, int n, float vals[])
+    {
+        for (int i=0; i<n; i++)
+        {
+            if (vals[i] >= lo && vals[i] <= hi)
+                return 1;
+        }
+        return 0;
+    }
+};
+
+
+eavlThresholdMutator::eavlThresholdMutator()
+    : minval(0), maxval(0), component(0), pointRule(ALL_POINTS)
+{
+}
+
+// ****************************************************************************
+// Method:  eavlThresholdMutator::FindCellsInRange
+//
+// Purpose:
+///   Flag each cell of the cell set which passes the threshold, scan
+///   the flags to get each kept cell's output index, and reverse that
+///   into the list of kept cells.  Returns a new array (owned by the
+///   caller) of the kept cell indices in increasing order.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+eavlIntArray *
+eavlThresholdMutator::FindCellsInRange(eavlDataSet *ds,
+                                       const string &cellsetname,
+                                       const string &fieldname,
+                                       int component,
+                                       double minval, double maxval,
+                                       PointRule rule)
+{
+    int inCellSetIndex = ds->GetCellSetIndex(cellsetname);
+    eavlCellSet *inCells = ds->GetCellSet(cellsetname);
+    eavlField   *inField = ds->GetField(fieldname);
+    eavlArray   *inArray = inField->GetArray();
+
+    if (component < 0 || component >= inArray->GetNumberOfComponents())
+        THROW(eavlException,"Threshold component out of range for field.");
+
+    int in_ncells = inCells->GetNumCells();
+    eavlIntArray *flags, *outindex, *total;
+    {
+        eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+        flags = new eavlIntArray("threshflag", 1, in_ncells);
+        outindex = new eavlIntArray("threshindex", 1, in_ncells);
+        total = new eavlIntArray("threshtotal", 1, 1);
+    }
+
+    eavlArrayWithLinearIndex values(inArray, component);
+    if (inField->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+        inField->GetAssocCellSet() == inCellSetIndex)
+    {
+        eavlExecutor::AddOperation(
+            new eavlMapOp_1_1<ThresholdInRangeFunctor>(values,
+                                                       flags,
+                         ThresholdInRangeFunctor(minval, maxval)),
+            "flag cells in range");
+    }
+    else if (inField->GetAssociation() == eavlField::ASSOC_POINTS)
+    {
+        if (rule == ALL_POINTS)
+        {
+            eavlExecutor::AddOperation(
+                new eavlTopologyMapOp_1_0_1<ThresholdAllPointsFunctor>
+                    (inCells, EAVL_NODES_OF_CELLS, values, flags,
+                     ThresholdAllPointsFunctor(minval, maxval)),
+                "flag cells with all nodes in range");
+        }
+        else
+        {
+            eavlExecutor::AddOperation(
+                new eavlTopologyMapOp_1_0_1<ThresholdAnyPointFunctor>
+                    (inCells, EAVL_NODES_OF_CELLS, values, flags,
+                     ThresholdAnyPointFunctor(minval, maxval)),
+                "flag cells with any node in range");
+        }
+    }
+    else
+    {
+        delete flags;
+        delete outindex;
+        delete total;
+        THROW(eavlException,"Field for threshold didn't match cell set.");
+    }
+
+    // (a reduction needs at least one value)
+    int nkept = 0;
+    if (in_ncells > 0)
+    {
+        eavlExecutor::AddOperation(
+            new eavlPrefixSumOp_1(flags, outindex, false),
+            "scan to generate output index of kept cells");
+        eavlExecutor::AddOperation(
+            new eavlReduceOp_1<eavlAddFunctor<int> >(flags,
+                                                     total,
+                                                     eavlAddFunctor<int>()),
+            "sumreduce to count kept cells");
+        eavlExecutor::Go();
+        nkept = total->GetValue(0);
+    }
+
+    eavlIntArray *kept;
+    {
+        eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+        kept = new eavlIntArray("keptcells", 1, nkept);
+    }
+    if (nkept > 0)
+    {
+        eavlExecutor::AddOperation(
+            new eavlSimpleReverseIndexOp(flags, outindex, kept),
+            "generate reverse lookup: kept cell to input cell");
+        eavlExecutor::Go();
+    }
+
+    delete flags;
+    delete outindex;
+    delete total;
+    return kept;
+}
+
+void
+eavlThresholdMutator::Execute()
+{
+    int inCellSetIndex = dataset->GetCellSetIndex(cellsetname);
+    eavlCellSet *inCells = dataset->GetCellSet(cellsetname);
+
+    eavlIntArray *kept = FindCellsInRange(dataset, cellsetname, fieldname,
+                                          component, minval, maxval,
+                                          pointRule);
+    int nkept = kept->GetNumberOfTuples();
+
+    // create the subset; the kept cells are in increasing order,
+    // so add them a run at a time
+    eavlCellSetSubset *subset = new eavlCellSetSubset(inCells);
+    const int *ids = (nkept > 0) ? (const int*)kept->GetHostArray() : NULL;
+    for (int i=0; i<nkept; )
+    {
+        int n = 1;
+        while (i+n < nkept && ids[i+n] == ids[i]+n)
+            n++;
+        subset->AddCellRange(ids[i], n);
+        i += n;
+    }
+    subset->Finalize();
+
+    int new_cell_index = dataset->GetNumCellSets();
+    dataset->AddCellSet(subset);
+
+    // gather every component of the cell set's fields
+    int nfields = dataset->GetNumFields();
+    for (int i=0; i<nfields; i++)
+    {
+        eavlField *f = dataset->GetField(i);
+        if (f->GetAssociation() != eavlField::ASSOC_CELL_SET ||
+            f->GetAssocCellSet() != inCellSetIndex)
+            continue;
+
+        eavlArray *a = f->GetArray();
+        int ncomp = a->GetNumberOfComponents();
+        eavlArray *sub = a->Create(string("subset_of_")+a->GetName(),
+                                   ncomp, nkept);
+        for (int c=0; c<ncomp && nkept>0; c++)
+        {
+            eavlExecutor::AddOperation(
+                new eavlGatherOp_1(eavlArrayWithLinearIndex(a, c),
+                                   eavlArrayWithLinearIndex(sub, c),
+                                   kept),
+                "gather cell field to subset");
+        }
+
+        eavlField *newfield = new eavlField(f->GetOrder(), sub,
+                                            eavlField::ASSOC_CELL_SET,
+                                            new_cell_index);
+        dataset->AddField(newfield);
+    }
+    eavlExecutor::Go();
+
+    delete kept;
+}
@@ -13,15 +13,40 @@
 // Purpose:
 ///   Add a thresholded cell set to an existing data set
 ///   as well as stripped copies of the vars.
+///
+///   The field may be a cell field on the cell set, in which case a
+///   cell is kept when its value is in range, or a point field, in
+///   which case a cell is kept when all of its nodes (or, with
+///   SetPointRule(ANY_POINT), any of its nodes) are in range.  For
+///   multi-component fields, SetComponent picks the component tested.
+///
+///   Cells are selected with a parallel predicate, scan, and reverse
+///   index, and every component of every cell field on the cell set is
+///   gathered to the subset, keeping its array type.
+///
+///   See eavlThresholdFilter for a compacted explicit output instead.
 //
 // Programmer:  Jeremy Meredith, Dave Pugmire, Sean Ahern
 // Creation:    April 13, 2012
 //
+// Modifications:
+//   agent, Sun Oct 18 2026
+//   Rebuilt on operations.  Added point field thresholds, component
+//   selection, and full copies of multi-component and non-float fields.
+//
 // ****************************************************************************
 class eavlThresholdMutator : public eavlMutator
 {
+  public:
+    enum PointRule
+    {
+        ALL_POINTS,
+        ANY_POINT
+    };
   protected:
     double minval, maxval;
+    int component;
+    PointRule pointRule;
     string fieldname, cellsetname;
   public:
     eavlThresholdMutator();
@@ -34,13 +59,27 @@ class eavlThresholdMutator : public eavlMutator
     {
         fieldname = name;
     }
+    void SetComponent(int c)
+    {
+        component = c;
+    }
+    void SetPointRule(PointRule rule)
+    {
+        pointRule = rule;
+    }
     void SetCellSet(const string &name)
     {
         cellsetname = name;
     }
-    
+
     virtual void Execute();
+
+    static eavlIntArray *FindCellsInRange(eavlDataSet *ds,
+                                          const string &cellsetname,
+                                          const string &fieldname,
+                                          int component,
+                                          double minval, double maxval,
+                                          PointRule rule);
 };
 
 #endif
-
@@ -74,6 +74,14 @@ eavlUnaryMathMutator::Execute()
 	   "Ln");
         break;
 
+      case SquareRoot:
+        eavlExecutor::AddOperation(
+	   new eavlMapOp_1_1<eavlSqrtFunctor<float> >(field->GetArray(),
+						     result,
+						     eavlSqrtFunctor<float>()),
+	   "SquareRoot");
+        break;
+
 
     }
     eavlExecutor::Go();
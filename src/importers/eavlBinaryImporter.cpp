@@ -0,0 +1,434 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavlBinaryImporter.h"
+#include "eavlBinaryFormat.h"
+#include "eavlCellSetExplicit.h"
+#include "eavlCellSetAllStructured.h"
+#include "eavlCellSetSubset.h"
+#include "eavlLogicalStructureRegular.h"
+#include "eavlCoordinates.h"
+#include "eavlException.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
+
+eavlBinaryImporter::eavlBinaryImporter(const string &filename)
+{
+    buffer = NULL;
+    length = 0;
+    mapped = false;
+    pos = 0;
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        THROW(eavlException,"Couldn't open file!\n");
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        THROW(eavlException,"Couldn't stat file!\n");
+    }
+    length = st.st_size;
+
+#if !defined(_WIN32)
+    void *m = mmap(NULL, length, PROT_READ|PROT_WRITE, MAP_PRIVATE,
+                   fd, 0);
+    if (m != MAP_FAILED)
+    {
+        buffer = (char*)m;
+        mapped = true;
+    }
+#endif
+    if (!mapped)
+    {
+        // fall back to reading the whole file
+        buffer = new char[length];
+        long long nread = 0;
+        while (nread < length)
+        {
+            ssize_t r = read(fd, buffer + nread, length - nread);
+            if (r <= 0)
+            {
+                close(fd);
+                delete[] buffer;
+                buffer = NULL;
+                THROW(eavlException,"Error reading file!\n");
+            }
+            nread += r;
+        }
+    }
+    close(fd);
+
+    Parse();
+}
+
+eavlBinaryImporter::~eavlBinaryImporter()
+{
+#if !defined(_WIN32)
+    if (mapped)
+        munmap(buffer, length);
+#endif
+    if (!mapped && buffer)
+        delete[] buffer;
+}
+
+void
+eavlBinaryImporter::Parse()
+{
+    const char *magic = ReadBytes(8);
+    if (strncmp(magic, EAVL_BINARY_MAGIC, 8) != 0)
+        THROW(eavlException,"Not an EAVL binary file");
+    if (ReadInt() != EAVL_BINARY_VERSION)
+        THROW(eavlException,"Unsupported EAVL binary file version");
+    if (ReadInt() != EAVL_BINARY_ENDIANCHECK)
+        THROW(eavlException,"EAVL binary file was written with a different byte order");
+
+    npoints = ReadInt();
+
+    // logical structure
+    logicalType = ReadInt();
+    logicalDim = 0;
+    logicalRegDim = 0;
+    if (logicalType == EAVL_BINARY_LOGICAL_REGULAR)
+    {
+        logicalDim = ReadInt();
+        logicalRegDim = ReadInt();
+        if (logicalRegDim < 1 || logicalRegDim > 3)
+            THROW(eavlException,"Unexpected logical dimension in EAVL binary file");
+        for (int d=0; d<logicalRegDim; d++)
+            logicalDims[d] = ReadInt();
+    }
+    else if (logicalType != EAVL_BINARY_LOGICAL_NONE)
+        THROW(eavlException,"Unexpected logical structure in EAVL binary file");
+
+    // coordinate systems
+    int ncs = ReadInt();
+    coords.resize(ncs);
+    for (int i=0; i<ncs; i++)
+    {
+        CoordInfo &ci = coords[i];
+        ci.type = ReadInt();
+        if (ci.type == EAVL_BINARY_COORDS_CARTESIAN_WITH_TRANSFORM)
+        {
+            for (int j=0; j<16; j++)
+                ci.transform[j] = ReadDouble();
+        }
+        int ndims = ReadInt();
+        if (ndims < 1 || ndims > 3)
+            THROW(eavlException,"Unexpected coordinate dimension in EAVL binary file");
+        ci.axes.resize(ndims);
+        for (int d=0; d<ndims; d++)
+        {
+            AxisInfo &ai = ci.axes[d];
+            ai.cartesianAxis = ReadInt();
+            ai.type = ReadInt();
+            if (ai.type == EAVL_BINARY_AXIS_FIELD)
+            {
+                ai.fieldname = ReadString();
+                ai.component = ReadInt();
+            }
+            else
+            {
+                ai.logicaldim = ReadInt();
+                ai.origin = ReadDouble();
+                ai.delta = ReadDouble();
+            }
+        }
+    }
+
+    // cell sets
+    int ncellsets = ReadInt();
+    cellsets.resize(ncellsets);
+    for (int i=0; i<ncellsets; i++)
+    {
+        CellSetInfo &ci = cellsets[i];
+        ci.type = ReadInt();
+        ci.name = ReadString();
+        ci.dimensionality = ReadInt();
+        ci.shapetype = ci.connectivity = ci.mapCellToIndex = NULL;
+        ci.parent = -1;
+        if (ci.type == EAVL_BINARY_CELLSET_STRUCTURED)
+        {
+            ci.regdim = ReadInt();
+            if (ci.regdim < 1 || ci.regdim > 3)
+                THROW(eavlException,"Unexpected structured dimension in EAVL binary file");
+            for (int d=0; d<ci.regdim; d++)
+                ci.dims[d] = ReadInt();
+        }
+        else if (ci.type == EAVL_BINARY_CELLSET_EXPLICIT)
+        {
+            ci.ncells = ReadLong();
+            ci.nconn = ReadLong();
+            SkipPadding();
+            ci.shapetype = ReadBytes(ci.ncells * sizeof(int));
+            SkipPadding();
+            ci.connectivity = ReadBytes(ci.nconn * sizeof(int));
+            SkipPadding();
+            ci.mapCellToIndex = ReadBytes(ci.ncells * sizeof(int));
+        }
+        else if (ci.type == EAVL_BINARY_CELLSET_SUBSET)
+        {
+            ci.parent = ReadInt();
+            if (ci.parent < 0 || ci.parent >= i)
+                THROW(eavlException,"Bad subset parent in EAVL binary file");
+            ci.ncells = ReadLong();
+            SkipPadding();
+            ci.connectivity = ReadBytes(ci.ncells * sizeof(int));
+        }
+        else
+            THROW(eavlException,"Unexpected cell set type in EAVL binary file");
+    }
+
+    // fields
+    int nfields = ReadInt();
+    fields.resize(nfields);
+    for (int i=0; i<nfields; i++)
+    {
+        FieldInfo &fi = fields[i];
+        fi.name = ReadString();
+        fi.type = ReadString();
+        fi.order = ReadInt();
+        fi.assoc = ReadInt();
+        fi.assocvalue = ReadInt();
+        fi.ncomp = ReadInt();
+        fi.ntuples = ReadLong();
+        SkipPadding();
+
+        int typesize;
+        if (fi.type == "float")
+            typesize = sizeof(float);
+        else if (fi.type == "int")
+            typesize = sizeof(int);
+        else if (fi.type == "byte")
+            typesize = sizeof(byte);
+        else
+            THROW(eavlException,"Unexpected array type in EAVL binary file");
+        fi.values = ReadBytes(fi.ntuples * fi.ncomp * typesize);
+
+        fi.isCoordinate = false;
+        for (size_t c=0; c<coords.size(); c++)
+            for (size_t d=0; d<coords[c].axes.size(); d++)
+                if (coords[c].axes[d].type == EAVL_BINARY_AXIS_FIELD &&
+                    coords[c].axes[d].fieldname == fi.name)
+                    fi.isCoordinate = true;
+    }
+}
+
+vector<string>
+eavlBinaryImporter::GetFieldList(const std::string &mesh)
+{
+    vector<string> retval;
+    for (size_t i=0; i<fields.size(); i++)
+    {
+        if (!fields[i].isCoordinate)
+            retval.push_back(fields[i].name);
+    }
+    return retval;
+}
+
+vector<string>
+eavlBinaryImporter::GetCellSetList(const std::string &mesh)
+{
+    vector<string> retval;
+    for (size_t i=0; i<cellsets.size(); i++)
+        retval.push_back(cellsets[i].name);
+    return retval;
+}
+
+eavlDataSet *
+eavlBinaryImporter::GetMesh(const string &name, int chunk)
+{
+    eavlDataSet *data = new eavlDataSet;
+    data->SetNumPoints(npoints);
+
+    eavlLogicalStructureRegular *log = NULL;
+    if (logicalType == EAVL_BINARY_LOGICAL_REGULAR)
+    {
+        eavlRegularStructure reg;
+        reg.SetNodeDimension(logicalRegDim, logicalDims);
+        log = new eavlLogicalStructureRegular(logicalDim, reg);
+        data->SetLogicalStructure(log);
+    }
+
+    for (size_t i=0; i<coords.size(); i++)
+    {
+        CoordInfo &ci = coords[i];
+        eavlCoordinatesCartesian::CartesianAxisType at[3];
+        for (size_t d=0; d<ci.axes.size(); d++)
+            at[d] = eavlCoordinatesCartesian::CartesianAxisType(ci.axes[d].cartesianAxis);
+
+        eavlCoordinatesCartesian *cs = NULL;
+        if (ci.type == EAVL_BINARY_COORDS_CARTESIAN_WITH_TRANSFORM)
+        {
+            eavlCoordinatesCartesianWithTransform *csx = NULL;
+            if (ci.axes.size() == 1)
+                csx = new eavlCoordinatesCartesianWithTransform(log, at[0]);
+            else if (ci.axes.size() == 2)
+                csx = new eavlCoordinatesCartesianWithTransform(log, at[0], at[1]);
+            else
+                csx = new eavlCoordinatesCartesianWithTransform(log, at[0], at[1], at[2]);
+            eavlMatrix4x4 m;
+            for (int r=0; r<4; r++)
+                for (int c=0; c<4; c++)
+                    m(r,c) = ci.transform[r*4+c];
+            csx->SetTransform(m);
+            cs = csx;
+        }
+        else
+        {
+            if (ci.axes.size() == 1)
+                cs = new eavlCoordinatesCartesian(log, at[0]);
+            else if (ci.axes.size() == 2)
+                cs = new eavlCoordinatesCartesian(log, at[0], at[1]);
+            else
+                cs = new eavlCoordinatesCartesian(log, at[0], at[1], at[2]);
+        }
+
+        for (size_t d=0; d<ci.axes.size(); d++)
+        {
+            AxisInfo &ai = ci.axes[d];
+            if (ai.type == EAVL_BINARY_AXIS_FIELD)
+                cs->SetAxis(d, new eavlCoordinateAxisField(ai.fieldname,
+                                                           ai.component));
+            else
+                cs->SetAxis(d, new eavlCoordinateAxisRegular(ai.logicaldim,
+                                                             ai.origin,
+                                                             ai.delta));
+        }
+        data->AddCoordinateSystem(cs);
+    }
+
+    for (size_t i=0; i<cellsets.size(); i++)
+    {
+        CellSetInfo &ci = cellsets[i];
+        if (ci.type == EAVL_BINARY_CELLSET_STRUCTURED)
+        {
+            eavlRegularStructure reg;
+            reg.SetNodeDimension(ci.regdim, ci.dims);
+            data->AddCellSet(new eavlCellSetAllStructured(ci.name, reg));
+        }
+        else if (ci.type == EAVL_BINARY_CELLSET_EXPLICIT)
+        {
+            eavlCellSetExplicit *cs = new eavlCellSetExplicit(ci.name,
+                                                              ci.dimensionality);
+            eavlExplicitConnectivity &conn =
+                cs->GetConnectivity(EAVL_NODES_OF_CELLS);
+            conn.shapetype.resize(ci.ncells);
+            conn.connectivity.resize(ci.nconn);
+            conn.mapCellToIndex.resize(ci.ncells);
+            if (ci.ncells > 0)
+            {
+                memcpy(&(conn.shapetype[0]), ci.shapetype,
+                       ci.ncells * sizeof(int));
+                memcpy(&(conn.mapCellToIndex[0]), ci.mapCellToIndex,
+                       ci.ncells * sizeof(int));
+            }
+            if (ci.nconn > 0)
+                memcpy(&(conn.connectivity[0]), ci.connectivity,
+                       ci.nconn * sizeof(int));
+            data->AddCellSet(cs);
+        }
+        else if (ci.type == EAVL_BINARY_CELLSET_SUBSET)
+        {
+            eavlCellSetSubset *cs =
+                new eavlCellSetSubset(ci.name, data->GetCellSet(ci.parent));
+            const int *ids = (const int*)ci.connectivity;
+            for (long long j=0; j<ci.ncells; j++)
+                cs->AddCell(ids[j]);
+            cs->Finalize();
+            data->AddCellSet(cs);
+        }
+    }
+
+    for (size_t i=0; i<fields.size(); i++)
+    {
+        if (fields[i].isCoordinate)
+            data->AddField(CreateField(fields[i]));
+    }
+
+    return data;
+}
+
+eavlField *
+eavlBinaryImporter::GetField(const string &name, const string &mesh, int chunk)
+{
+    for (size_t i=0; i<fields.size(); i++)
+    {
+        if (fields[i].name == name)
+            return CreateField(fields[i]);
+    }
+    THROW(eavlException,"Couldn't find field in EAVL binary file");
+}
+
+eavlField *
+eavlBinaryImporter::CreateField(const FieldInfo &fi)
+{
+    eavlArray *arr = NULL;
+    if (fi.type == "float")
+        arr = new eavlFloatArray((float*)fi.values, fi.name,
+                                 fi.ncomp, fi.ntuples);
+    else if (fi.type == "int")
+        arr = new eavlIntArray((int*)fi.values, fi.name,
+                               fi.ncomp, fi.ntuples);
+    else
+        arr = new eavlByteArray((byte*)fi.values, fi.name,
+                                fi.ncomp, fi.ntuples);
+
+    return new eavlField(fi.order, arr,
+                         eavlField::Association(fi.assoc), fi.assocvalue);
+}
+
+const char *
+eavlBinaryImporter::ReadBytes(long long n)
+{
+    if (n < 0 || pos + n > length)
+        THROW(eavlException,"Unexpected end of EAVL binary file");
+    const char *p = buffer + pos;
+    pos += n;
+    return p;
+}
+
+int
+eavlBinaryImporter::ReadInt()
+{
+    int v;
+    memcpy(&v, ReadBytes(sizeof(int)), sizeof(int));
+    return v;
+}
+
+long long
+eavlBinaryImporter::ReadLong()
+{
+    long long v;
+    memcpy(&v, ReadBytes(sizeof(long long)), sizeof(long long));
+    return v;
+}
+
+double
+eavlBinaryImporter::ReadDouble()
+{
+    double v;
+    memcpy(&v, ReadBytes(sizeof(double)), sizeof(double));
+    return v;
+}
+
+string
+eavlBinaryImporter::ReadString()
+{
+    int n = ReadInt();
+    const char *p = ReadBytes(n);
+    return string(p, n);
+}
+
+void
+eavlBinaryImporter::SkipPadding()
+{
+    int rem = pos % EAVL_BINARY_ALIGNMENT;
+    if (rem != 0)
+        ReadBytes(EAVL_BINARY_ALIGNMENT - rem);
+}
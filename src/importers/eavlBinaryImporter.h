@@ -0,0 +1,108 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_BINARY_IMPORTER_H
+#define EAVL_BINARY_IMPORTER_H
+
+#include "STL.h"
+#include "eavlDataSet.h"
+#include "eavlImporter.h"
+
+// ****************************************************************************
+// Class:  eavlBinaryImporter
+//
+// Purpose:
+///   Import files written by eavlBinaryExporter.  The file is mapped
+///   into memory and only the small metadata records are parsed; the
+///   field arrays returned by GetField wrap the mapped values directly
+///   (as externally-provided eavlConcreteArrays), so the importer must
+///   outlive any fields it returns.  The mapping is private and
+///   copy-on-write, so writes to those arrays never reach the file,
+///   and only the pages written to are copied.  Connectivity is
+///   copied into the cell sets with a single block copy per array.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlBinaryImporter : public eavlImporter
+{
+  protected:
+    struct AxisInfo
+    {
+        int    cartesianAxis;
+        int    type;
+        string fieldname;
+        int    component;
+        int    logicaldim;
+        double origin;
+        double delta;
+    };
+    struct CoordInfo
+    {
+        int              type;
+        double           transform[16];
+        vector<AxisInfo> axes;
+    };
+    struct CellSetInfo
+    {
+        int         type;
+        string      name;
+        int         dimensionality;
+        int         regdim;
+        int         dims[3];
+        long long   ncells;
+        long long   nconn;
+        const char *shapetype;
+        const char *connectivity;
+        const char *mapCellToIndex;
+        int         parent;
+    };
+    struct FieldInfo
+    {
+        string      name;
+        string      type;
+        int         order;
+        int         assoc;
+        int         assocvalue;
+        int         ncomp;
+        long long   ntuples;
+        const char *values;
+        bool        isCoordinate;
+    };
+
+    char               *buffer;
+    long long           length;
+    bool                mapped;
+    long long           pos;
+
+    int                 npoints;
+    int                 logicalType;
+    int                 logicalDim;
+    int                 logicalRegDim;
+    int                 logicalDims[3];
+    vector<CoordInfo>   coords;
+    vector<CellSetInfo> cellsets;
+    vector<FieldInfo>   fields;
+
+  public:
+    eavlBinaryImporter(const string &filename);
+    ~eavlBinaryImporter();
+
+    int                 GetNumChunks(const std::string &mesh) { return 1; }
+    vector<string>      GetFieldList(const std::string &mesh);
+    vector<string>      GetCellSetList(const std::string &mesh);
+
+    eavlDataSet   *GetMesh(const string &name, int chunk);
+    eavlField     *GetField(const string &name, const string &mesh, int chunk);
+
+  protected:
+    void        Parse();
+    eavlField  *CreateField(const FieldInfo &fi);
+    const char *ReadBytes(long long n);
+    int         ReadInt();
+    long long   ReadLong();
+    double      ReadDouble();
+    string      ReadString();
+    void        SkipPadding();
+};
+
+#endif
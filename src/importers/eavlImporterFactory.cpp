@@ -14,6 +14,7 @@
 #include "eavlPDBImporter.h"
 #include "eavlPNGImporter.h"
 #include "eavlCurveImporter.h"
+#include "eavlBinaryImporter.h"
 
 #include "eavlException.h"
 
@@ -36,6 +37,10 @@ eavlImporterFactory::GetImporterForFile(const std::string &fn_orig)
     {
         importer = new eavlMADNESSImporter(fn_orig);
     }
+    else if (flen>5 && filename.substr(flen-5) == ".eavl")
+    {
+        importer = new eavlBinaryImporter(fn_orig);
+    }
     else if (flen>4 && filename.substr(flen-4) == ".bov")
     {
         importer = new eavlBOVImporter(fn_orig);
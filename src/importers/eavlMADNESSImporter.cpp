@@ -266,14 +266,11 @@ eavlMADNESSImporter::eavlMADNESSImporter(const string &fn)
     in.getline(buff,4096);
 
     bool success = ParseNode(in, log->root);
-    log->BuildLeafCellList();
     if (!success)
         THROW(eavlException,"Error parsing MADNESS file");
 
     //log->root.Print(cout);
-    //cerr << "MADNESS TREE: "
-    //     << log->root.GetNumCells(true)<<" leaf cells, "
-    //     << log->root.GetNumCells(false)<<" total cell count\n";
+    log->BuildFlatTree();
 
     in.close();
 }
@@ -305,7 +302,7 @@ eavlMADNESSImporter::GetMesh(const string &mesh, int)
     eavlCoordinatesQuadTree *coords = new eavlCoordinatesQuadTree();
 
     eavlDataSet *data = new eavlDataSet;
-    data->SetNumPoints(log->root.GetNumCells(true) * 4);
+    data->SetNumPoints(log->GetNumLeaves() * 4);
     data->SetLogicalStructure(log);
     data->AddCoordinateSystem(coords);
 
@@ -318,15 +315,18 @@ eavlMADNESSImporter::GetMesh(const string &mesh, int)
 eavlField *
 eavlMADNESSImporter::GetField(const string &name, const string &mesh, int chunk)
 {
+    int ncells = log->GetNumLeaves();
     if (name == "levels")
     {
-        int ncells = log->root.GetNumCells(true);
         eavlFloatArray *arr = new eavlFloatArray(name,1);
         arr->SetNumberOfTuples(ncells);
+        float *vals = (float*)arr->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
         for (int i=0; i<ncells; i++)
         {
-            eavlLogicalStructureQuadTree::QuadTreeCell *n = log->root.GetNthCell(i);
-            arr->SetComponentFromDouble(i, 0, n->lvl);
+            vals[i] = log->nodeLevel[log->GetLeafNode(i)];
         }
      
         eavlField *field = new eavlField(0, arr, eavlField::ASSOC_CELL_SET, 0);
@@ -335,16 +335,18 @@ eavlMADNESSImporter::GetField(const string &name, const string &mesh, int chunk)
     }
     else if (name == "cell_const")
     {
-        int ncells = log->root.GetNumCells(true);
         eavlFloatArray *arr = new eavlFloatArray(name,1);
         arr->SetNumberOfTuples(ncells);
+        float *vals = (float*)arr->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
         for (int i=0; i<ncells; i++)
         {
-            eavlLogicalStructureQuadTree::QuadTreeCell *n = log->root.GetNthCell(i);
+            int n = log->GetLeafNode(i);
+            const float *b = log->GetBounds(n);
             // evaluate the legendre polynomials at the center of the node
-            float v = n->GetValue((n->xmin + n->xmax)/2.,
-                                  (n->ymin + n->ymax)/2.);
-            arr->SetComponentFromDouble(i, 0, v);
+            vals[i] = log->GetValue(n, (b[0] + b[1])/2., (b[2] + b[3])/2.);
         }
      
         eavlField *field = new eavlField(0, arr, eavlField::ASSOC_CELL_SET, 0);
@@ -352,21 +354,21 @@ eavlMADNESSImporter::GetField(const string &name, const string &mesh, int chunk)
     }
     else if (name == "node_linear")
     {
-        int ncells = log->root.GetNumCells(true);
         int nnodes = ncells*4;
         eavlFloatArray *arr = new eavlFloatArray(name,1);
         arr->SetNumberOfTuples(nnodes);
+        float *vals = (float*)arr->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
         for (int i=0; i<ncells; i++)
         {
-            eavlLogicalStructureQuadTree::QuadTreeCell *n = log->root.GetNthCell(i);
-            arr->SetComponentFromDouble(i*4+0, 0,
-                                        n->GetValue(n->xmin, n->ymin));
-            arr->SetComponentFromDouble(i*4+1, 0,
-                                        n->GetValue(n->xmax, n->ymin));
-            arr->SetComponentFromDouble(i*4+2, 0,
-                                        n->GetValue(n->xmin, n->ymax));
-            arr->SetComponentFromDouble(i*4+3, 0,
-                                        n->GetValue(n->xmax, n->ymax));
+            int n = log->GetLeafNode(i);
+            const float *b = log->GetBounds(n);
+            vals[i*4+0] = log->GetValue(n, b[0], b[2]);
+            vals[i*4+1] = log->GetValue(n, b[1], b[2]);
+            vals[i*4+2] = log->GetValue(n, b[0], b[3]);
+            vals[i*4+3] = log->GetValue(n, b[1], b[3]);
         }
      
         eavlField *field = new eavlField(1, arr, eavlField::ASSOC_POINTS);
@@ -374,14 +376,17 @@ eavlMADNESSImporter::GetField(const string &name, const string &mesh, int chunk)
     }
     else if (name == "cell_biquadratic")
     {
-        int ncells = log->root.GetNumCells(true);
         eavlFloatArray *arr = new eavlFloatArray(name,9);
         arr->SetNumberOfTuples(ncells);
+        float *vals = (float*)arr->GetHostArray();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
         for (int i=0; i<ncells; i++)
         {
-            eavlLogicalStructureQuadTree::QuadTreeCell *n = log->root.GetNthCell(i);
+            const float *cf = &(log->coeffs[log->GetLeafNode(i)*K*K]);
             for (int j=0; j<9; j++)
-                arr->SetComponentFromDouble(i, j, n->coeffs[j/3][j%3]);
+                vals[i*9+j] = cf[j];
         }
      
         eavlField *field = new eavlField(2, arr, eavlField::ASSOC_CELL_SET, 0);
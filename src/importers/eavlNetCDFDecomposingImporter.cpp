@@ -3,6 +3,7 @@
 #include "eavlCoordinates.h"
 #include "eavlCellSetAllStructured.h"
 #include "eavlException.h"
+#include "eavlGhostCells.h"
 
 static const bool debugoutput = false;
 
@@ -43,7 +44,8 @@ static const bool debugoutput = false;
 //   domain in the Y axis would go from 0 to 49 while slot 1 would go from
 //   50 to 99.
 //
-//   These routines could be improved to support simple ghosting.
+//   DoDomainDecomposition puts these together, optionally growing each
+//   domain by some number of layers of ghost zones.
 //
 // ****************************************************************************
 
@@ -296,6 +298,10 @@ ComputeDomainBounds(int globalZoneCount, int domCount, int domLogicalCoord,
 //  Programmer:  Jeremy Meredith
 //  Creation:    July 15, 2008
 //
+//  Modifications:
+//    agent, Sun Oct 18 2026
+//    Take the number of ghost zone layers instead of a flag for one.
+//
 // ****************************************************************************
 void DoDomainDecomposition(int nprocs, int rank,
                            int zx, int zy, int zz,
@@ -303,7 +309,7 @@ void DoDomainDecomposition(int nprocs, int rank,
                            int domainGlobalCount[3],
                            int localRealStart[3],
                            int localRealCount[3],
-                           bool addGhosts)
+                           int ghostWidth)
 {
     int globalZoneCount[3] = {zx, zy, zz};
 
@@ -354,19 +360,17 @@ void DoDomainDecomposition(int nprocs, int rank,
         localRealStart[axis] = 0;
         localRealCount[axis] = domainGlobalCount[axis];
 
-        // now account for ghost cells by expanding the requested cells
-        if (addGhosts)
+        // now account for ghost cells by expanding the requested cells,
+        // as far as the mesh goes on either side
+        if (ghostWidth > 0)
         {
-            if (domainIndex[axis] > 0)
-            {
-                localRealStart[axis]++;
-                domainGlobalStart[axis]--;
-                domainGlobalCount[axis]++;
-            }
-            if (domainIndex[axis] < domainCounts[axis]-1)
-            {
-                domainGlobalCount[axis]++;
-            }
+            int nlo = std::min(ghostWidth, domainGlobalStart[axis]);
+            int nhi = std::min(ghostWidth, globalZoneCount[axis] -
+                               domainGlobalStart[axis] -
+                               domainGlobalCount[axis]);
+            localRealStart[axis] += nlo;
+            domainGlobalStart[axis] -= nlo;
+            domainGlobalCount[axis] += nlo + nhi;
 
             if (debugoutput)
                 cerr << "  with ghosts:    domain local indices: "
@@ -386,9 +390,13 @@ void DoDomainDecomposition(int nprocs, int rank,
 
 
 eavlNetCDFDecomposingImporter::eavlNetCDFDecomposingImporter(int numdomains,
-                                                             const string &filename)
+                                                             const string &filename,
+                                                             int ghostlayers)
 {
     numchunks = numdomains;
+    ghostwidth = ghostlayers;
+    if (ghostwidth < 0)
+        THROW(eavlException,"Ghost width must not be negative");
     file = new NcFile(filename.c_str(), NcFile::ReadOnly);
      
     if (!file->is_valid())
@@ -486,7 +494,7 @@ eavlNetCDFDecomposingImporter::GetMesh(const string &mesh, int chunk)
                           domainGlobalCount,
                           localRealStart,
                           localRealCount,
-                          true); // no ghosts for now
+                          ghostwidth);
     int nlx_nodes = domainGlobalCount[0] + 1;  // zonal -> nodal
     int nly_nodes = domainGlobalCount[1] + 1;  // zonal -> nodal
     int nlz_nodes = domainGlobalCount[2] + 1;  // zonal -> nodal
@@ -539,7 +547,8 @@ vector<string>
 eavlNetCDFDecomposingImporter::GetFieldList(const string &mesh)
 {
     vector<string> retval;
-    retval.push_back(".ghost");
+    if (ghostwidth > 0)
+        retval.push_back(EAVL_GHOST_FIELD_NAME);
     for (unsigned int v=0; v<vars.size(); v++)
     {
         NcVar *var = vars[v];
@@ -567,13 +576,13 @@ eavlNetCDFDecomposingImporter::GetField(const string &name, const string &mesh,
                           domainGlobalCount,
                           localRealStart,
                           localRealCount,
-                          true); // no ghosts for now
+                          ghostwidth);
     int nlx_nodes = domainGlobalCount[0] + 1;  // zonal -> nodal
     int nly_nodes = domainGlobalCount[1] + 1;  // zonal -> nodal
     int nlz_nodes = domainGlobalCount[2] + 1;  // zonal -> nodal
     int n = nlx_nodes*nly_nodes*nlz_nodes;
 
-    if (name == ".ghost")
+    if (name == EAVL_GHOST_FIELD_NAME)
     {
         int nlx_zones = domainGlobalCount[0];  // zonal -> nodal
         int nly_zones = domainGlobalCount[1];  // zonal -> nodal
@@ -581,7 +590,7 @@ eavlNetCDFDecomposingImporter::GetField(const string &name, const string &mesh,
         if (nlz_zones < 1)
             nlz_zones = 1;
         int nzones = nlx_zones * nly_zones * nlz_zones;
-        eavlFloatArray *arr = new eavlFloatArray(name, 1);
+        eavlByteArray *arr = new eavlByteArray(name, 1);
         arr->SetNumberOfTuples(nzones);
 
         for (int k = 0; k < nlz_zones; k++)
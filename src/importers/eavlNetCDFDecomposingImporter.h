@@ -17,16 +17,24 @@
 ///   Import NetCDF files as eavlDataSets.
 ///   This version automatically splits the single mesh into
 ///   a number of smaller chunks (i.e. automatic domain decomposition).
+///   Each chunk is grown by a number of layers of ghost zones (one by
+///   default) where it borders another, and these are marked in the
+///   EAVL_GHOST_FIELD_NAME cell field so filters can leave them out.
 //
 // Programmer:  Jeremy Meredith, Dave Pugmire, Sean Ahern
 // Creation:    May  5, 2011
 //
+// Modifications:
+//   agent, Sun Oct 18 2026
+//   Made the number of ghost zone layers configurable; 0 disables them.
+//
 // ****************************************************************************
 class eavlNetCDFDecomposingImporter : public eavlImporter
 {
   public:
     eavlNetCDFDecomposingImporter(int numdomains,
-                                  const string &filename);
+                                  const string &filename,
+                                  int ghostlayers = 1);
     ~eavlNetCDFDecomposingImporter();
 
     int                 GetNumChunks(const std::string &mesh);
@@ -37,6 +45,7 @@ class eavlNetCDFDecomposingImporter : public eavlImporter
     eavlField     *GetField(const string &name, const string &mesh, int chunk);
   protected:
     int numchunks;
+    int ghostwidth;
     NcFile *file;
     vector<NcVar*> vars;
     vector<NcDim*> dims;
@@ -50,7 +59,8 @@ class eavlNetCDFDecomposingImporter : public eavlMissingImporter
 {
   public:
     eavlNetCDFDecomposingImporter(int numdomains,
-                             const string &) : eavlMissingImporter() { throw; }
+                             const string &,
+                             int = 1) : eavlMissingImporter() { throw; }
 };
 
 #endif
@@ -2,6 +2,7 @@
 #ifndef EAVL_CELL_SPARSE_MAP_OP_2_3_H
 #define EAVL_CELL_SPARSE_MAP_OP_2_3_H
 
+#include "eavlCellSetSubset.h"
 #include "eavlOperation.h"
 #include "eavlArray.h"
 #include "eavlOpDispatch_2_3_int.h"
@@ -342,6 +343,10 @@ class eavlCellSparseMapOp_2_3 : public eavlOperation
                  indicesArray.array, indicesArray.mul, indicesArray.add,
                  functor);
         }
+        else if (dynamic_cast<eavlCellSetSubset*>(cells))
+        {
+            THROW(eavlException,"eavlCellSparseMapOp_2_3 doesn't support cell set subsets.");
+        }
         else
         {
             THROW(eavlException,"eavlCellMapOp didn't understand the mesh type.");
@@ -382,6 +387,10 @@ class eavlCellSparseMapOp_2_3 : public eavlOperation
                  indicesArray.array, indicesArray.mul, indicesArray.add,
                  functor);
         }
+        else if (dynamic_cast<eavlCellSetSubset*>(cells))
+        {
+            THROW(eavlException,"eavlCellSparseMapOp_2_3 doesn't support cell set subsets.");
+        }
         else
         {
             THROW(eavlException,"eavlCellMapOp didn't understand the mesh type.");
@@ -0,0 +1,336 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_EXPRESSION_MAP_OP_H
+#define EAVL_EXPRESSION_MAP_OP_H
+
+#include "eavlOperation.h"
+#include "eavlArray.h"
+#include "eavlException.h"
+
+#define EAVL_EXPRESSION_MAX_INPUTS        8
+#define EAVL_EXPRESSION_MAX_INSTRUCTIONS 64
+#define EAVL_EXPRESSION_MAX_STACK        16
+#define EAVL_EXPRESSION_LANES            64
+
+// ****************************************************************************
+// Class:  eavlExpressionProgram
+//
+// Purpose:
+///   A compiled arithmetic expression: a fixed-size postfix program for a
+///   small stack machine, whose instructions push a constant or the value
+///   of an input array, or replace the top one or two stack entries with
+///   the result of an operator.  It is plain data so that it can be
+///   passed by value to a kernel.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+struct eavlExpressionProgram
+{
+    enum OpCode
+    {
+        // push a value
+        PushConstant, PushInput,
+        // unary operators
+        Negate, Sqrt, Abs, Exp, Ln, Log10, Log2,
+        Sin, Cos, Tan, Asin, Acos, Atan,
+        // binary operators
+        Add, Subtract, Multiply, Divide, Power, Min, Max, Atan2
+    };
+
+    int   ninstructions;
+    int   opcode[EAVL_EXPRESSION_MAX_INSTRUCTIONS];
+    int   input[EAVL_EXPRESSION_MAX_INSTRUCTIONS];
+    float constant[EAVL_EXPRESSION_MAX_INSTRUCTIONS];
+    int   ninputs;
+
+    eavlExpressionProgram() : ninstructions(0), ninputs(0)
+    {
+    }
+    static bool IsUnary(int op)
+    {
+        return op >= Negate && op < Add;
+    }
+};
+
+#ifndef DOXYGEN
+
+// One input array, as a typed raw pointer and linear index.
+struct eavlExpressionInput
+{
+    enum Type { FLOAT, INT, BYTE };
+    void *ptr;
+    int   type;
+    int   div, mod, mul, add;
+
+    EAVL_HOSTDEVICE float Get(int i) const
+    {
+        int index = ((i / div) % mod) * mul + add;
+        switch (type)
+        {
+          case FLOAT: return ((const float*)ptr)[index];
+          case INT:   return ((const int*)ptr)[index];
+          default:    return ((const byte*)ptr)[index];
+        }
+    }
+};
+
+struct eavlExpressionInputs
+{
+    eavlExpressionInput in[EAVL_EXPRESSION_MAX_INPUTS];
+};
+
+template <class F>
+EAVL_HOSTDEVICE void eavlExpressionUnaryApply(float &a, F f)
+{
+    a = f(a);
+}
+
+template <class F>
+EAVL_HOSTDEVICE void eavlExpressionBinaryApply(float &a, float b, F f)
+{
+    a = f(a, b);
+}
+
+// Apply an operator to the top of the stack, for "n" lanes at once.
+// With the operator known outside the loop over lanes, each of those
+// loops is a simple one the compiler can vectorize.
+template <class F>
+inline void eavlExpressionUnaryLanes(int n, float *a, F f)
+{
+    for (int l=0; l<n; l++)
+        a[l] = f(a[l]);
+}
+
+template <class F>
+inline void eavlExpressionBinaryLanes(int n, float *a, const float *b, F f)
+{
+    for (int l=0; l<n; l++)
+        a[l] = f(a[l], b[l]);
+}
+
+// Call UNARY or BINARY with the functor for an operator; they apply it
+// to the top of the stack, either for single values or for lanes.
+#define EAVL_EXPRESSION_DISPATCH(op, UNARY, BINARY)                          \
+    switch (op)                                                              \
+    {                                                                        \
+      case eavlExpressionProgram::Negate:   UNARY(eavlNegateFunctor<float>()); break; \
+      case eavlExpressionProgram::Sqrt:     UNARY(eavlSqrtFunctor<float>());   break; \
+      case eavlExpressionProgram::Abs:      UNARY(eavlAbsFunctor<float>());    break; \
+      case eavlExpressionProgram::Exp:      UNARY(eavlExpFunctor<float>());    break; \
+      case eavlExpressionProgram::Ln:       UNARY(eavlLnFunctor<float>());     break; \
+      case eavlExpressionProgram::Log10:    UNARY(eavlLog10Functor<float>());  break; \
+      case eavlExpressionProgram::Log2:     UNARY(eavlLog2Functor<float>());   break; \
+      case eavlExpressionProgram::Sin:      UNARY(eavlSinFunctor<float>());    break; \
+      case eavlExpressionProgram::Cos:      UNARY(eavlCosFunctor<float>());    break; \
+      case eavlExpressionProgram::Tan:      UNARY(eavlTanFunctor<float>());    break; \
+      case eavlExpressionProgram::Asin:     UNARY(eavlAsinFunctor<float>());   break; \
+      case eavlExpressionProgram::Acos:     UNARY(eavlAcosFunctor<float>());   break; \
+      case eavlExpressionProgram::Atan:     UNARY(eavlAtanFunctor<float>());   break; \
+      case eavlExpressionProgram::Add:      BINARY(eavlAddFunctor<float>());   break; \
+      case eavlExpressionProgram::Subtract: BINARY(eavlSubFunctor<float>());   break; \
+      case eavlExpressionProgram::Multiply: BINARY(eavlMulFunctor<float>());   break; \
+      case eavlExpressionProgram::Divide:   BINARY(eavlDivFunctor<float>());   break; \
+      case eavlExpressionProgram::Power:    BINARY(eavlPowFunctor<float>());   break; \
+      case eavlExpressionProgram::Min:      BINARY(eavlMinFunctor<float>());   break; \
+      case eavlExpressionProgram::Max:      BINARY(eavlMaxFunctor<float>());   break; \
+      case eavlExpressionProgram::Atan2:    BINARY(eavlAtan2Functor<float>()); break; \
+    }
+
+// Evaluate the program for one value.
+EAVL_HOSTDEVICE float
+eavlExpressionEvaluate(const eavlExpressionProgram &prog,
+                       const eavlExpressionInputs &inputs, int i)
+{
+    float stack[EAVL_EXPRESSION_MAX_STACK];
+    int top = -1;
+    for (int k=0; k<prog.ninstructions; k++)
+    {
+        int op = prog.opcode[k];
+        if (op == eavlExpressionProgram::PushConstant)
+            stack[++top] = prog.constant[k];
+        else if (op == eavlExpressionProgram::PushInput)
+            stack[++top] = inputs.in[prog.input[k]].Get(i);
+        else
+        {
+#define EAVL_EXPRESSION_UNARY(f)  eavlExpressionUnaryApply(stack[top], f)
+#define EAVL_EXPRESSION_BINARY(f) eavlExpressionBinaryApply(stack[top-1], stack[top], f); --top
+            EAVL_EXPRESSION_DISPATCH(op, EAVL_EXPRESSION_UNARY, EAVL_EXPRESSION_BINARY)
+#undef EAVL_EXPRESSION_UNARY
+#undef EAVL_EXPRESSION_BINARY
+        }
+    }
+    return stack[0];
+}
+
+// Evaluate the program for values [start,start+n), n <= the number of
+// lanes, one instruction at a time across all of them.
+inline void
+eavlExpressionEvaluateLanes(const eavlExpressionProgram &prog,
+                            const eavlExpressionInputs &inputs,
+                            int start, int n,
+                            float *o0, int o0mul, int o0add)
+{
+    float stack[EAVL_EXPRESSION_MAX_STACK][EAVL_EXPRESSION_LANES];
+    int top = -1;
+    for (int k=0; k<prog.ninstructions; k++)
+    {
+        int op = prog.opcode[k];
+        if (op == eavlExpressionProgram::PushConstant)
+        {
+            float *a = stack[++top];
+            float c = prog.constant[k];
+            for (int l=0; l<n; l++)
+                a[l] = c;
+        }
+        else if (op == eavlExpressionProgram::PushInput)
+        {
+            float *a = stack[++top];
+            const eavlExpressionInput &in = inputs.in[prog.input[k]];
+            if (in.type == eavlExpressionInput::FLOAT &&
+                in.div == 1 && in.mod == INT_MAX && in.mul == 1)
+            {
+                const float *p = (const float*)in.ptr + start + in.add;
+                for (int l=0; l<n; l++)
+                    a[l] = p[l];
+            }
+            else
+            {
+                for (int l=0; l<n; l++)
+                    a[l] = in.Get(start + l);
+            }
+        }
+        else
+        {
+#define EAVL_EXPRESSION_UNARY(f)  eavlExpressionUnaryLanes(n, stack[top], f)
+#define EAVL_EXPRESSION_BINARY(f) eavlExpressionBinaryLanes(n, stack[top-1], stack[top], f); --top
+            EAVL_EXPRESSION_DISPATCH(op, EAVL_EXPRESSION_UNARY, EAVL_EXPRESSION_BINARY)
+#undef EAVL_EXPRESSION_UNARY
+#undef EAVL_EXPRESSION_BINARY
+        }
+    }
+    for (int l=0; l<n; l++)
+        o0[(start + l) * o0mul + o0add] = stack[0][l];
+}
+
+#if defined __CUDACC__
+
+__global__ void
+expressionMapKernel(int n, eavlExpressionProgram prog,
+                    eavlExpressionInputs inputs,
+                    float *o0, int o0mul, int o0add)
+{
+    const int numThreads = blockDim.x * gridDim.x;
+    const int threadID   = blockIdx.x * blockDim.x + threadIdx.x;
+    for (int index = threadID; index < n; index += numThreads)
+        o0[index * o0mul + o0add] = eavlExpressionEvaluate(prog, inputs, index);
+}
+
+#endif
+
+#endif // DOXYGEN
+
+// ****************************************************************************
+// Class:  eavlExpressionMapOp
+//
+// Purpose:
+///   Evaluate a compiled expression of any number (up to a limit) of
+///   input arrays, placing the result in a matching location in a float
+///   output array.  Like eavlMapOp_1_1, but with the functor replaced by
+///   a small stack-machine program, so an expression with many operators
+///   is still a single pass with no intermediate arrays.  On the CPU the
+///   values are evaluated in blocks of lanes, one instruction at a time
+///   across a block, with the blocks spread across threads.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlExpressionMapOp : public eavlOperation
+{
+  protected:
+    eavlExpressionProgram            program;
+    vector<eavlArrayWithLinearIndex> inArrays;
+    eavlArrayWithLinearIndex         outArray0;
+  public:
+    eavlExpressionMapOp(const eavlExpressionProgram &prog,
+                        const vector<eavlArrayWithLinearIndex> &ins,
+                        eavlArrayWithLinearIndex out0)
+        : program(prog), inArrays(ins), outArray0(out0)
+    {
+        if ((int)inArrays.size() != program.ninputs)
+            THROW(eavlException,"Wrong number of inputs for expression");
+    }
+    virtual void GoCPU()
+    {
+        int n = outArray0.array->GetNumberOfTuples();
+        eavlExpressionInputs inputs;
+        float *o0 = GetArrays(eavlArray::HOST, n, inputs);
+
+        int nblocks = (n + EAVL_EXPRESSION_LANES - 1) / EAVL_EXPRESSION_LANES;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int b=0; b<nblocks; b++)
+        {
+            int start = b * EAVL_EXPRESSION_LANES;
+            int count = n - start;
+            if (count > EAVL_EXPRESSION_LANES)
+                count = EAVL_EXPRESSION_LANES;
+            eavlExpressionEvaluateLanes(program, inputs, start, count,
+                                        o0, outArray0.mul, outArray0.add);
+        }
+    }
+    virtual void GoGPU()
+    {
+#if defined __CUDACC__
+        int n = outArray0.array->GetNumberOfTuples();
+        eavlExpressionInputs inputs;
+        float *o0 = GetArrays(eavlArray::DEVICE, n, inputs);
+
+        int numThreads = 256;
+        dim3 threads(numThreads,   1, 1);
+        dim3 blocks (32,           1, 1);
+        expressionMapKernel<<< blocks, threads >>>(n, program, inputs,
+                                                   o0, outArray0.mul,
+                                                   outArray0.add);
+        CUDA_CHECK_ERROR();
+#else
+        THROW(eavlException,"Executing GPU code without compiling under CUDA compiler.");
+#endif
+    }
+
+  protected:
+    float *GetArrays(eavlArray::Location loc, int n,
+                     eavlExpressionInputs &inputs)
+    {
+        for (int k=0; k<program.ninputs; k++)
+        {
+            eavlArrayWithLinearIndex &a = inArrays[k];
+            if (a.mod == INT_MAX && a.array->GetNumberOfTuples() != n)
+                THROW(eavlException,"Expecting same-length arrays in eavlExpressionMapOp");
+
+            eavlExpressionInput &in = inputs.in[k];
+            in.ptr = a.array->GetRawPointer(loc);
+            in.div = a.div;
+            in.mod = a.mod;
+            in.mul = a.mul;
+            in.add = a.add;
+            if (dynamic_cast<eavlFloatArray*>(a.array))
+                in.type = eavlExpressionInput::FLOAT;
+            else if (dynamic_cast<eavlIntArray*>(a.array))
+                in.type = eavlExpressionInput::INT;
+            else if (dynamic_cast<eavlByteArray*>(a.array))
+                in.type = eavlExpressionInput::BYTE;
+            else
+                THROW(eavlException,"Unknown array type");
+        }
+
+        eavlFloatArray *out = dynamic_cast<eavlFloatArray*>(outArray0.array);
+        if (!out)
+            THROW(eavlException,"eavlExpressionMapOp expects a float output array");
+        return (float*)out->GetRawPointer(loc);
+    }
+};
+
+#endif
@@ -0,0 +1,222 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_NODE_STENCIL_OP_H
+#define EAVL_NODE_STENCIL_OP_H
+
+#include "eavlArray.h"
+#include "eavlOperation.h"
+#include "eavlRegularStructure.h"
+#include "eavlException.h"
+
+#ifndef DOXYGEN
+// o[i] += w * s[i+dx] over a row of n values, with the source index
+// clamped to the row (i.e. the edge values are repeated past the ends)
+inline void eavlStencilAddShiftedRow(float * __restrict__ o,
+                                     const float * __restrict__ s,
+                                     int n, int dx, float w)
+{
+    int lo = (dx < 0) ? -dx : 0;
+    int hi = (dx > 0) ? n - dx : n;
+    if (lo > n)
+        lo = n;
+    if (hi < lo)
+        hi = lo;
+    for (int i = 0; i < lo; i++)
+        o[i] += w * s[0];
+    for (int i = lo; i < hi; i++)
+        o[i] += w * s[i + dx];
+    for (int i = hi; i < n; i++)
+        o[i] += w * s[n-1];
+}
+#endif
+
+// ****************************************************************************
+// Class:  eavlNodeStencilOp<D,R>
+//
+// Purpose:
+///   Apply a (2*R+1)^D weighted stencil around every node of a
+///   D-dimensional structured grid, to every component of an array.
+///   Values past the edges of the grid repeat the nearest edge value.
+///
+///   A separable stencil is given as one set of 2*R+1 weights which
+///   is applied along each axis in turn, so a 5x5x5 smoothing costs 15
+///   loads per node rather than 125.  A full stencil is given as all
+///   (2*R+1)^D weights, with x varying fastest; zero weights are
+///   skipped.  Either way the work is done a row of nodes at a time, in
+///   parallel over rows, with the innermost loop running along the
+///   contiguous x axis so that neighboring rows stay in cache.  It only
+///   runs on the host.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+template <int D, int R>
+class eavlNodeStencilOp : public eavlOperation
+{
+  public:
+    enum { WIDTH = 2*R + 1,
+           NWEIGHTS = (D == 1) ? WIDTH :
+                      (D == 2) ? WIDTH*WIDTH : WIDTH*WIDTH*WIDTH };
+  protected:
+    eavlRegularStructure  reg;
+    eavlArray            *inArray;
+    eavlFloatArray       *outArray;
+    bool                  separable;
+    float                 weights[NWEIGHTS];
+    int                   dims[3];
+  public:
+    eavlNodeStencilOp(eavlRegularStructure regStructure,
+                      eavlArray *in,
+                      eavlFloatArray *out,
+                      const float *w,
+                      bool sep)
+        : reg(regStructure),
+          inArray(in),
+          outArray(out),
+          separable(sep)
+    {
+        if (reg.dimension != D)
+            THROW(eavlException,"eavlNodeStencilOp dimension doesn't match the grid.");
+        if (inArray->GetNumberOfComponents() != outArray->GetNumberOfComponents())
+            THROW(eavlException,"eavlNodeStencilOp expects input and output with the same number of components.");
+        int nw = separable ? int(WIDTH) : int(NWEIGHTS);
+        for (int i=0; i<nw; i++)
+            weights[i] = w[i];
+        for (int d=0; d<3; d++)
+            dims[d] = (d < D) ? reg.nodeDims[d] : 1;
+        if (inArray->GetNumberOfTuples() != dims[0]*dims[1]*dims[2])
+            THROW(eavlException,"eavlNodeStencilOp expects one input value per grid node.");
+    }
+    virtual void GoCPU()
+    {
+        int nx = dims[0];
+        int nrows = dims[1] * dims[2];
+        int n = nx * nrows;
+        int ncomp = inArray->GetNumberOfComponents();
+
+        vector<float> a(n), b(n);
+        eavlFloatArray *fin = dynamic_cast<eavlFloatArray*>(inArray);
+        const float *in = fin ? (const float*)fin->GetHostArray() : NULL;
+        float *out = (float*)outArray->GetHostArray();
+
+        for (int c = 0; c < ncomp; c++)
+        {
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+            for (int i = 0; i < n; i++)
+                a[i] = in ? in[i*ncomp + c] : inArray->GetComponentAsDouble(i, c);
+
+            const float *result;
+            if (separable)
+            {
+                Pass(&a[0], &b[0], 0);
+                result = &b[0];
+                if (D > 1)
+                {
+                    Pass(&b[0], &a[0], 1);
+                    result = &a[0];
+                }
+                if (D > 2)
+                {
+                    Pass(&a[0], &b[0], 2);
+                    result = &b[0];
+                }
+            }
+            else
+            {
+                Full(&a[0], &b[0]);
+                result = &b[0];
+            }
+
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+            for (int i = 0; i < n; i++)
+                out[i*ncomp + c] = result[i];
+        }
+    }
+    virtual void GoGPU()
+    {
+        // host only; when preferring the GPU, the executor falls back
+        // to GoCPU when this throws
+        THROW(eavlException,"eavlNodeStencilOp has no GPU implementation.");
+    }
+
+  protected:
+    // one separable pass along an axis
+    void Pass(const float *in, float *out, int axis)
+    {
+        int nx = dims[0];
+        int nrows = dims[1] * dims[2];
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int row = 0; row < nrows; row++)
+        {
+            float *orow = out + row*nx;
+            const float *irow = in + row*nx;
+            for (int i = 0; i < nx; i++)
+                orow[i] = 0;
+
+            if (axis == 0)
+            {
+                for (int d = 0; d < WIDTH; d++)
+                {
+                    if (weights[d] != 0)
+                        eavlStencilAddShiftedRow(orow, irow, nx, d - R,
+                                                 weights[d]);
+                }
+                continue;
+            }
+
+            int ijk[2] = {row % dims[1], row / dims[1]};
+            int pos = ijk[axis-1];
+            int len = dims[axis];
+            int stride = (axis == 1) ? 1 : dims[1]; // in rows
+            for (int d = 0; d < WIDTH; d++)
+            {
+                if (weights[d] == 0)
+                    continue;
+                int p = pos + d - R;
+                p = (p < 0) ? 0 : ((p >= len) ? len-1 : p);
+                eavlStencilAddShiftedRow(orow, irow + (p - pos)*stride*nx,
+                                         nx, 0, weights[d]);
+            }
+        }
+    }
+
+    // the whole stencil at once
+    void Full(const float *in, float *out)
+    {
+        int nx = dims[0];
+        int nrows = dims[1] * dims[2];
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int row = 0; row < nrows; row++)
+        {
+            float *orow = out + row*nx;
+            for (int i = 0; i < nx; i++)
+                orow[i] = 0;
+
+            int j = row % dims[1];
+            int k = row / dims[1];
+            for (int w = 0; w < NWEIGHTS; w++)
+            {
+                if (weights[w] == 0)
+                    continue;
+                int dx = w % WIDTH - R;
+                int dy = (D > 1) ? (w / WIDTH) % WIDTH - R : 0;
+                int dz = (D > 2) ? w / (WIDTH*WIDTH) - R : 0;
+                int sj = j + dy, sk = k + dz;
+                sj = (sj < 0) ? 0 : ((sj >= dims[1]) ? dims[1]-1 : sj);
+                sk = (sk < 0) ? 0 : ((sk >= dims[2]) ? dims[2]-1 : sk);
+                eavlStencilAddShiftedRow(orow, in + (sk*dims[1] + sj)*nx,
+                                         nx, dx, weights[w]);
+            }
+        }
+    }
+};
+
+#endif
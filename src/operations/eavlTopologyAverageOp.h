@@ -0,0 +1,259 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EAVL_TOPOLOGY_AVERAGE_OP_H
+#define EAVL_TOPOLOGY_AVERAGE_OP_H
+
+#include "eavlCellSet.h"
+#include "eavlCellSetExplicit.h"
+#include "eavlCellSetAllStructured.h"
+#include "eavlCellSetSubset.h"
+#include "eavlArray.h"
+#include "eavlOperation.h"
+#include "eavlOpDispatch_1_1.h"
+#include "eavlTopology.h"
+#include "eavlException.h"
+
+#ifndef DOXYGEN
+struct eavlTopologyAverageFunctor
+{
+    int          ncomp;
+    const float *weights;
+
+    /// Average (or weighted average) all components of the "n" source
+    /// elements listed in "ids".  If the weights sum to zero, fall back
+    /// to a plain average so the result is still well defined.
+    template <class I0, class O0>
+    EAVL_HOSTDEVICE void operator()(int n, const int *ids,
+                                    const I0 *in, O0 *out)
+    {
+        float wsum = 0.f;
+        if (weights)
+        {
+            for (int i=0; i<n; i++)
+                wsum += weights[ids[i]];
+        }
+
+        if (wsum > 0.f)
+        {
+            for (int c=0; c<ncomp; c++)
+            {
+                float sum = 0.f;
+                for (int i=0; i<n; i++)
+                    sum += weights[ids[i]] * float(in[ids[i]*ncomp + c]);
+                out[c] = O0(sum / wsum);
+            }
+        }
+        else
+        {
+            for (int c=0; c<ncomp; c++)
+            {
+                float sum = 0.f;
+                for (int i=0; i<n; i++)
+                    sum += float(in[ids[i]*ncomp + c]);
+                out[c] = O0((n > 0) ? sum / float(n) : 0.f);
+            }
+        }
+    }
+};
+
+template <class F, class I0, class O0>
+struct cpu_topologyAverageExplicit
+{
+    static void call(int nitems,
+                     const eavlExplicitConnectivity &conn,
+                     const I0 * __restrict__ i0, int, int, int, int,
+                     O0 * __restrict__ o0, int o0mul, int o0add,
+                     F &functor)
+    {
+        // read the lists straight out of the connectivity, since the
+        // cells around a node can outnumber the nodes of any cell;
+        // trailing nodes no cell uses have no list at all
+        int nelements = conn.GetNumElements();
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int index = 0; index < nitems; index++)
+        {
+            if (index >= nelements)
+            {
+                functor(0, (const int*)NULL, i0, o0 + index * o0mul + o0add);
+                continue;
+            }
+            int ci = conn.mapCellToIndex[index];
+            functor(conn.connectivity[ci], &conn.connectivity[ci+1],
+                    i0, o0 + index * o0mul + o0add);
+        }
+    }
+};
+
+template <class F, class I0, class O0>
+struct cpu_topologyAverageRegular
+{
+    static void call(int nitems,
+                     eavlRegularConnectivity &reg,
+                     const I0 * __restrict__ i0, int, int, int, int,
+                     O0 * __restrict__ o0, int o0mul, int o0add,
+                     F &functor)
+    {
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int index = 0; index < nitems; index++)
+        {
+            int ids[12];
+            int npts;
+            reg.GetElementComponents(index, npts, ids);
+            functor(npts, ids, i0, o0 + index * o0mul + o0add);
+        }
+    }
+};
+
+template <class F, class I0, class O0>
+struct cpu_topologyAverageSubset
+{
+    template <class C>
+    static void call(int nitems,
+                     eavlSubsetConnectivity<C> &sub,
+                     const I0 * __restrict__ i0, int, int, int, int,
+                     O0 * __restrict__ o0, int o0mul, int o0add,
+                     F &functor)
+    {
+        // each block of the subset gets its own iterator
+        int nblocks = (nitems + EAVL_SUBSET_ITERATOR_BLOCK - 1) /
+                      EAVL_SUBSET_ITERATOR_BLOCK;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int b = 0; b < nblocks; b++)
+        {
+            int ids[12];
+            int npts, index, cell;
+            eavlCellSetSubset::Iterator it(sub.subset,
+                                   b * EAVL_SUBSET_ITERATOR_BLOCK,
+                                   (b+1) * EAVL_SUBSET_ITERATOR_BLOCK);
+            while (it.Next(index, cell))
+            {
+                sub.conn.GetElementComponents(cell, npts, ids);
+                functor(npts, ids, i0, o0 + index * o0mul + o0add);
+            }
+        }
+    }
+};
+#endif // DOXYGEN
+
+// ****************************************************************************
+// Class:  eavlTopologyAverageOp
+//
+// Purpose:
+///   Map all components of an array from one topological element in a
+///   mesh to another in a single pass: each destination element gets the
+///   average of the source elements connected to it, optionally weighted
+///   by a per-source-element float array.  The input and output arrays
+///   must have the same number of components.
+///
+///   Unlike the eavlTopologyMapOp family this is not limited to a fixed
+///   number of components, nor to 12 source elements per destination
+///   (e.g. for the cells around a node of an unstructured mesh).
+///   It only runs on the host.
+//
+// Programmer:  agent
+// Creation:    October 18, 2026
+//
+// ****************************************************************************
+class eavlTopologyAverageOp : public eavlOperation
+{
+  protected:
+    eavlCellSet     *cells;
+    eavlTopology     topology;
+    eavlArray       *inArray;
+    eavlArray       *outArray;
+    eavlFloatArray  *weights;
+  public:
+    eavlTopologyAverageOp(eavlCellSet *inCells,
+                          eavlTopology topo,
+                          eavlArray *in,
+                          eavlArray *out,
+                          eavlFloatArray *w = NULL)
+        : cells(inCells),
+          topology(topo),
+          inArray(in),
+          outArray(out),
+          weights(w)
+    {
+        if (inArray->GetNumberOfComponents() !=
+            outArray->GetNumberOfComponents())
+            THROW(eavlException,"eavlTopologyAverageOp expects input and output with the same number of components.");
+    }
+    virtual void GoCPU()
+    {
+        eavlTopologyAverageFunctor functor;
+        functor.ncomp = inArray->GetNumberOfComponents();
+        functor.weights = weights ? (const float*)weights->GetHostArray() : NULL;
+
+        int n = outArray->GetNumberOfTuples();
+        int ncomp = functor.ncomp;
+
+        eavlCellSetExplicit *elExp = dynamic_cast<eavlCellSetExplicit*>(cells);
+        eavlCellSetAllStructured *elStr = dynamic_cast<eavlCellSetAllStructured*>(cells);
+        eavlCellSetSubset *elSub = dynamic_cast<eavlCellSetSubset*>(cells);
+        if (elExp)
+        {
+            eavlDispatch_1_1<cpu_topologyAverageExplicit>(n, eavlArray::HOST,
+                                                         elExp->GetConnectivity(topology),
+                                                         inArray, 1, INT_MAX, ncomp, 0,
+                                                         outArray, ncomp, 0,
+                                                         functor);
+        }
+        else if (elStr)
+        {
+            eavlRegularConnectivity conn(elStr->GetRegularStructure(),topology);
+            eavlDispatch_1_1<cpu_topologyAverageRegular>(n, eavlArray::HOST,
+                                                        conn,
+                                                        inArray, 1, INT_MAX, ncomp, 0,
+                                                        outArray, ncomp, 0,
+                                                        functor);
+        }
+        else if (elSub)
+        {
+            // the subset's own cells are only known going from cells
+            if (topology != EAVL_NODES_OF_CELLS)
+                THROW(eavlException,"eavlTopologyAverageOp on a subset must map from nodes to cells.");
+            eavlCellSetExplicit *parExp = dynamic_cast<eavlCellSetExplicit*>(elSub->GetParent());
+            eavlCellSetAllStructured *parStr = dynamic_cast<eavlCellSetAllStructured*>(elSub->GetParent());
+            if (parExp)
+            {
+                eavlSubsetConnectivity<eavlExplicitConnectivity> conn(elSub, parExp->GetConnectivity(topology));
+                eavlDispatch_1_1<cpu_topologyAverageSubset>(n, eavlArray::HOST,
+                                                           conn,
+                                                           inArray, 1, INT_MAX, ncomp, 0,
+                                                           outArray, ncomp, 0,
+                                                           functor);
+            }
+            else if (parStr)
+            {
+                eavlRegularConnectivity reg(parStr->GetRegularStructure(),topology);
+                eavlSubsetConnectivity<eavlRegularConnectivity> conn(elSub, reg);
+                eavlDispatch_1_1<cpu_topologyAverageSubset>(n, eavlArray::HOST,
+                                                           conn,
+                                                           inArray, 1, INT_MAX, ncomp, 0,
+                                                           outArray, ncomp, 0,
+                                                           functor);
+            }
+            else
+            {
+                THROW(eavlException,"eavlTopologyAverageOp didn't understand the subset's parent mesh type.");
+            }
+        }
+        else
+        {
+            THROW(eavlException,"eavlTopologyAverageOp didn't understand the mesh type.");
+        }
+    }
+    virtual void GoGPU()
+    {
+        // host only; when preferring the GPU, the executor falls back
+        // to GoCPU when this throws
+        THROW(eavlException,"eavlTopologyAverageOp has no GPU implementation.");
+    }
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include "eavlCellSet.h"
 #include "eavlCellSetExplicit.h"
 #include "eavlCellSetAllStructured.h"
+#include "eavlCellSetSubset.h"
 #include "eavlDataSet.h"
 #include "eavlArray.h"
 #include "eavlOperation.h"
@@ -369,6 +370,10 @@ class eavlTopologyGatherMapOp_1_1_1 : public eavlOperation
                                  indicesArray.array, indicesArray.mul, indicesArray.add,
                                  functor);
         }
+        else if (dynamic_cast<eavlCellSetSubset*>(cells))
+        {
+            THROW(eavlException,"eavlTopologyGatherMapOp_1_1_1 doesn't support cell set subsets.");
+        }
         else
         {
             THROW(eavlException,"eavlTopologyGatherMapOp didn't understand the mesh type.");
@@ -400,6 +405,10 @@ class eavlTopologyGatherMapOp_1_1_1 : public eavlOperation
                                  indicesArray.array, indicesArray.mul, indicesArray.add,
                                  functor);
         }
+        else if (dynamic_cast<eavlCellSetSubset*>(cells))
+        {
+            THROW(eavlException,"eavlTopologyGatherMapOp_1_1_1 doesn't support cell set subsets.");
+        }
         else
         {
             THROW(eavlException,"eavlTopologyGatherMapOp didn't understand the mesh type.");
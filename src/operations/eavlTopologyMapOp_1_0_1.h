@@ -5,6 +5,7 @@
 #include "eavlCellSet.h"
 #include "eavlCellSetExplicit.h"
 #include "eavlCellSetAllStructured.h"
+#include "eavlCellSetSubset.h"
 #include "eavlDataSet.h"
 #include "eavlArray.h"
 #include "eavlOperation.h"
@@ -73,6 +74,48 @@ struct cpu_topologyMapExplicit_1_0_1
     }
 };
 
+template <class F, class I0, class O0>
+struct cpu_topologyMapSubset_1_0_1
+{
+    template <class C>
+    static void call(int nitems,
+                     eavlSubsetConnectivity<C> &sub,
+                     const I0 * __restrict__ i0, int i0div, int i0mod, int i0mul, int i0add,
+                     O0 * __restrict__ o0, int o0mul, int o0add,
+                     F &functor)
+    {
+        // each block of the subset gets its own iterator
+        int nblocks = (nitems + EAVL_SUBSET_ITERATOR_BLOCK - 1) /
+                      EAVL_SUBSET_ITERATOR_BLOCK;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int b = 0; b < nblocks; b++)
+        {
+            int nodeIds[12];
+            int npts;
+            int index, cell;
+            eavlCellSetSubset::Iterator it(sub.subset,
+                                           b * EAVL_SUBSET_ITERATOR_BLOCK,
+                                           (b+1) * EAVL_SUBSET_ITERATOR_BLOCK);
+            while (it.Next(index, cell))
+            {
+                int shapeType = sub.conn.GetElementComponents(cell, npts, nodeIds);
+
+                float in0[12];
+                for (int n=0; n<npts; n++)
+                {
+                    int node = nodeIds[n];
+                    in0[n] = i0[((node / i0div) % i0mod) * i0mul + i0add];
+                }
+
+                o0[index * o0mul + o0add] = functor(shapeType, npts,
+                                                    in0);
+            }
+        }
+    }
+};
+
 #if defined __CUDACC__
 
 ///\todo: can we specialize for the eavlTopologyMapOp_0_p_q versions?
@@ -243,6 +286,82 @@ void callTopologyMapKernelExplicit_1_0_1(int nitems,
     conn.mapCellToIndex.NeedOnHost();
 }
 
+template <class F, class I0, class O0, class C>
+__global__ void
+topologyMapKernelSubset_1_0_1(int nitems,
+                           eavlIndexedConnectivity<C> conn,
+                           const I0 * __restrict__ i0, int i0div, int i0mod, int i0mul, int i0add,
+                           O0 * __restrict__ o0, int o0mul, int o0add,
+                           F functor)
+{
+    const int numThreads = blockDim.x * gridDim.x;
+    const int threadID   = blockIdx.x * blockDim.x + threadIdx.x;
+    int nodeIds[12];
+    int npts;
+    for (int index = threadID; index < nitems; index += numThreads)
+    {
+        int shapeType = conn.GetElementComponents(index, npts, nodeIds);
+
+        float in0[12];
+        for (int n=0; n<npts; n++)
+        {
+            int node = nodeIds[n];
+            in0[n] = i0[((node / i0div) % i0mod) * i0mul + i0add];
+        }
+
+        o0[index * o0mul + o0add] = functor(shapeType, npts,
+                                            in0);
+    }
+}
+
+template <class F, class I0, class O0>
+struct gpuTopologyMapOp_1_0_1_subset
+{
+    template <class C>
+    static void call(int nitems,
+                     eavlIndexedConnectivity<C> &conn,
+                     I0 *d_i0, int i0div, int i0mod, int i0mul, int i0add,
+                     O0 *d_o0, int o0mul, int o0add,
+                     F &functor)
+    {
+        int numThreads = 256;
+        dim3 threads(numThreads,   1, 1);
+        dim3 blocks (32,           1, 1);
+        topologyMapKernelSubset_1_0_1<<< blocks, threads >>>(nitems,
+                                                          conn,
+                                                          d_i0, i0div, i0mod, i0mul, i0add,
+                                                          d_o0, o0mul, o0add,
+                                                          functor);
+        CUDA_CHECK_ERROR();
+    }
+};
+
+template <class F, class C>
+void callTopologyMapKernelSubset_1_0_1(int nitems,
+                          eavlCellSetSubset *subset,
+                          C &parentConn,
+                          eavlArray *i0, int i0div, int i0mod, int i0mul, int i0add,
+                          eavlArray *o0, int o0mul, int o0add,
+                          F &functor)
+{
+    // the iterator only runs on the host, so flatten the kept parent
+    // cells into an array the kernel can index
+    eavlIntArray cellIds("subset_cells", 1, subset->GetNumCells());
+    subset->GetParentIndices((int*)cellIds.GetHostArray());
+    eavlIndexedConnectivity<C> conn(parentConn, (int*)cellIds.GetCUDAArray());
+
+    i0->GetCUDAArray();
+    o0->GetCUDAArray();
+
+    // run the kernel
+    eavlDispatch_1_1<gpuTopologyMapOp_1_0_1_subset>(nitems,
+                                                 eavlArray::DEVICE,
+                                                 conn,
+                                                 i0, i0div, i0mod, i0mul, i0add,
+                                                 o0, o0mul, o0add,
+                                                 functor);
+}
+
 #endif
 #endif // DOXYGEN
 
@@ -285,6 +404,7 @@ class eavlTopologyMapOp_1_0_1 : public eavlOperation
     {
         eavlCellSetExplicit *elExp = dynamic_cast<eavlCellSetExplicit*>(cells);
         eavlCellSetAllStructured *elStr = dynamic_cast<eavlCellSetAllStructured*>(cells);
+        eavlCellSetSubset *elSub = dynamic_cast<eavlCellSetSubset*>(cells);
         if (elExp)
         {
             eavlDispatch_1_1<cpu_topologyMapExplicit_1_0_1>(outArray0.array->GetNumberOfTuples(),
@@ -305,6 +425,42 @@ class eavlTopologyMapOp_1_0_1 : public eavlOperation
                                                            outArray0.array, outArray0.mul, outArray0.add,
                                                            functor);
         }
+        else if (elSub)
+        {
+            // iterate the kept cells directly, using the parent's own
+            // connectivity so structured parents stay structured
+            if (topology != EAVL_NODES_OF_CELLS &&
+                topology != EAVL_EDGES_OF_CELLS &&
+                topology != EAVL_FACES_OF_CELLS)
+                THROW(eavlException,"eavlTopologyMapOp on a subset must map from cells.");
+            eavlCellSetExplicit *parExp = dynamic_cast<eavlCellSetExplicit*>(elSub->GetParent());
+            eavlCellSetAllStructured *parStr = dynamic_cast<eavlCellSetAllStructured*>(elSub->GetParent());
+            if (parExp)
+            {
+                eavlSubsetConnectivity<eavlExplicitConnectivity> conn(elSub, parExp->GetConnectivity(topology));
+                eavlDispatch_1_1<cpu_topologyMapSubset_1_0_1>(outArray0.array->GetNumberOfTuples(),
+                                                              eavlArray::HOST,
+                                                              conn,
+                                                              inArray0.array, inArray0.div, inArray0.mod, inArray0.mul, inArray0.add,
+                                                              outArray0.array, outArray0.mul, outArray0.add,
+                                                              functor);
+            }
+            else if (parStr)
+            {
+                eavlRegularConnectivity reg(parStr->GetRegularStructure(),topology);
+                eavlSubsetConnectivity<eavlRegularConnectivity> conn(elSub, reg);
+                eavlDispatch_1_1<cpu_topologyMapSubset_1_0_1>(outArray0.array->GetNumberOfTuples(),
+                                                              eavlArray::HOST,
+                                                              conn,
+                                                              inArray0.array, inArray0.div, inArray0.mod, inArray0.mul, inArray0.add,
+                                                              outArray0.array, outArray0.mul, outArray0.add,
+                                                              functor);
+            }
+            else
+            {
+                THROW(eavlException,"eavlTopologyMapOp didn't understand the subset's parent mesh type.");
+            }
+        }
         else
         {
             THROW(eavlException,"eavlTopologyMapOp didn't understand the mesh type.");
@@ -315,7 +471,45 @@ class eavlTopologyMapOp_1_0_1 : public eavlOperation
 #if defined __CUDACC__
         eavlCellSetExplicit *elExp = dynamic_cast<eavlCellSetExplicit*>(cells);
         eavlCellSetAllStructured *elStr = dynamic_cast<eavlCellSetAllStructured*>(cells);
-        if (elExp)
+        eavlCellSetSubset *elSub = dynamic_cast<eavlCellSetSubset*>(cells);
+        if (elSub)
+        {
+            if (topology != EAVL_NODES_OF_CELLS &&
+                topology != EAVL_EDGES_OF_CELLS &&
+                topology != EAVL_FACES_OF_CELLS)
+                THROW(eavlException,"eavlTopologyMapOp on a subset must map from cells.");
+            eavlCellSetExplicit *parExp = dynamic_cast<eavlCellSetExplicit*>(elSub->GetParent());
+            eavlCellSetAllStructured *parStr = dynamic_cast<eavlCellSetAllStructured*>(elSub->GetParent());
+            if (parExp)
+            {
+                eavlExplicitConnectivity &conn = parExp->GetConnectivity(topology);
+                conn.shapetype.NeedOnDevice();
+                conn.connectivity.NeedOnDevice();
+                conn.mapCellToIndex.NeedOnDevice();
+                callTopologyMapKernelSubset_1_0_1(outArray0.array->GetNumberOfTuples(),
+                                   elSub, conn,
+                                   inArray0.array, inArray0.div, inArray0.mod, inArray0.mul, inArray0.add,
+                                   outArray0.array, outArray0.mul, outArray0.add,
+                                   functor);
+                conn.shapetype.NeedOnHost();
+                conn.connectivity.NeedOnHost();
+                conn.mapCellToIndex.NeedOnHost();
+            }
+            else if (parStr)
+            {
+                eavlRegularConnectivity conn(parStr->GetRegularStructure(),topology);
+                callTopologyMapKernelSubset_1_0_1(outArray0.array->GetNumberOfTuples(),
+                                   elSub, conn,
+                                   inArray0.array, inArray0.div, inArray0.mod, inArray0.mul, inArray0.add,
+                                   outArray0.array, outArray0.mul, outArray0.add,
+                                   functor);
+            }
+            else
+            {
+                THROW(eavlException,"eavlTopologyMapOp didn't understand the subset's parent mesh type.");
+            }
+        }
+        else if (elExp)
         {
             ///\todo: assert that div,mod are always 1,INT_MAX?
             callTopologyMapKernelExplicit_1_0_1(outArray0.array->GetNumberOfTuples(),
@@ -5,6 +5,7 @@
 #include "eavlCellSet.h"
 #include "eavlCellSetExplicit.h"
 #include "eavlCellSetAllStructured.h"
+#include "eavlCellSetSubset.h"
 #include "eavlDataSet.h"
 #include "eavlArray.h"
 #include "eavlOperation.h"
@@ -99,6 +100,61 @@ struct cpu_topologyMapExplicit_3_0_3
     }
 };
 
+template <class F, class I01, class I2, class O01, class O2>
+struct cpu_topologyMapSubset_3_0_3
+{
+    template <class C>
+    static void call(int nitems,
+                     eavlSubsetConnectivity<C> &sub,
+                     I01 *i0, int i0div, int i0mod, int i0mul, int i0add,
+                     I01 *i1, int i1div, int i1mod, int i1mul, int i1add,
+                     I2  *i2, int i2div, int i2mod, int i2mul, int i2add,
+                     O01 *o0, int o0mul, int o0add,
+                     O01 *o1, int o1mul, int o1add,
+                     O2  *o2, int o2mul, int o2add,
+                     F &functor)
+    {
+        // each block of the subset gets its own iterator
+        int nblocks = (nitems + EAVL_SUBSET_ITERATOR_BLOCK - 1) /
+                      EAVL_SUBSET_ITERATOR_BLOCK;
+#ifdef HAVE_OPENMP
+#pragma omp parallel for
+#endif
+        for (int b = 0; b < nblocks; b++)
+        {
+            int nodeIds[12];
+            int npts;
+            int index, cell;
+            eavlCellSetSubset::Iterator it(sub.subset,
+                                           b * EAVL_SUBSET_ITERATOR_BLOCK,
+                                           (b+1) * EAVL_SUBSET_ITERATOR_BLOCK);
+            while (it.Next(index, cell))
+            {
+                int shapeType = sub.conn.GetElementComponents(cell, npts, nodeIds);
+
+                float x[12], y[12], z[12];
+                for (int n=0; n<npts; n++)
+                {
+                    int node = nodeIds[n];
+                    x[n] = i0[((node / i0div) % i0mod) * i0mul + i0add];
+                    y[n] = i1[((node / i1div) % i1mod) * i1mul + i1add];
+                    z[n] = i2[((node / i2div) % i2mod) * i2mul + i2add];
+                }
+
+                float out0, out1, out2;
+
+                functor(shapeType, npts,
+                        x, y, z,
+                        out0, out1, out2);
+
+                o0[index * o0mul + o0add] = out0;
+                o1[index * o1mul + o1add] = out1;
+                o2[index * o2mul + o2add] = out2;
+            }
+        }
+    }
+};
+
 #if defined __CUDACC__
 
 template <class F, class I01, class I2, class O01, class O2>
@@ -329,6 +385,116 @@ void callTopologyMapKernelExplicit_3_0_3(int nitems,
     conn.mapCellToIndex.NeedOnHost();
 }
 
+template <class F, class I01, class I2, class O01, class O2, class C>
+__global__ void
+topologyMapKernelSubset_3_0_3(int nitems,
+                           eavlIndexedConnectivity<C> conn,
+                           I01 *i0, int i0div, int i0mod, int i0mul, int i0add,
+                           I01 *i1, int i1div, int i1mod, int i1mul, int i1add,
+                           I2  *i2, int i2div, int i2mod, int i2mul, int i2add,
+                           O01 *o0, int o0mul, int o0add,
+                           O01 *o1, int o1mul, int o1add,
+                           O2  *o2, int o2mul, int o2add,
+                           F functor)
+{
+    const int numThreads = blockDim.x * gridDim.x;
+    const int threadID   = blockIdx.x * blockDim.x + threadIdx.x;
+    int nodeIds[12];
+    for (int index = threadID; index < nitems; index += numThreads)
+    {
+        int npts;
+        int shapeType = conn.GetElementComponents(index, npts, nodeIds);
+
+        float x[12], y[12], z[12];
+        for (int n=0; n<npts; n++)
+        {
+            int node = nodeIds[n];
+            x[n] = i0[((node / i0div) % i0mod) * i0mul + i0add];
+            y[n] = i1[((node / i1div) % i1mod) * i1mul + i1add];
+            z[n] = i2[((node / i2div) % i2mod) * i2mul + i2add];
+        }
+
+        float out0, out1, out2;
+
+        functor(shapeType, npts,
+                x, y, z,
+                out0, out1, out2);
+
+        o0[index * o0mul + o0add] = out0;
+        o1[index * o1mul + o1add] = out1;
+        o2[index * o2mul + o2add] = out2;
+    }
+}
+
+template <class F, class I01, class I2, class O01, class O2>
+struct gpuTopologyMapOp_3_0_3_subset
+{
+    template <class C>
+    static void call(int nitems,
+                     eavlIndexedConnectivity<C> &conn,
+                     I01 *i0, int i0div, int i0mod, int i0mul, int i0add,
+                     I01 *i1, int i1div, int i1mod, int i1mul, int i1add,
+                     I2  *i2, int i2div, int i2mod, int i2mul, int i2add,
+                     O01 *o0, int o0mul, int o0add,
+                     O01 *o1, int o1mul, int o1add,
+                     O2  *o2, int o2mul, int o2add,
+                     F &functor)
+    {
+        int numThreads = 256;
+        dim3 threads(numThreads,   1, 1);
+        dim3 blocks (32,           1, 1);
+
+        topologyMapKernelSubset_3_0_3<<< blocks, threads >>>(nitems,
+                                                          conn,
+                                                          i0, i0div, i0mod, i0mul, i0add,
+                                                          i1, i1div, i1mod, i1mul, i1add,
+                                                          i2, i2div, i2mod, i2mul, i2add,
+                                                          o0, o0mul, o0add,
+                                                          o1, o1mul, o1add,
+                                                          o2, o2mul, o2add,
+                                                          functor);
+        CUDA_CHECK_ERROR();
+    }
+};
+
+template <class F, class C>
+void callTopologyMapKernelSubset_3_0_3(int nitems,
+                          eavlCellSetSubset *subset,
+                          C &parentConn,
+                          eavlArray *i0, int i0div, int i0mod, int i0mul, int i0add,
+                          eavlArray *i1, int i1div, int i1mod, int i1mul, int i1add,
+                          eavlArray *i2, int i2div, int i2mod, int i2mul, int i2add,
+                          eavlArray *o0, int o0mul, int o0add,
+                          eavlArray *o1, int o1mul, int o1add,
+                          eavlArray *o2, int o2mul, int o2add,
+                          F &functor)
+{
+    // the iterator only runs on the host, so flatten the kept parent
+    // cells into an array the kernel can index
+    eavlIntArray cellIds("subset_cells", 1, subset->GetNumCells());
+    subset->GetParentIndices((int*)cellIds.GetHostArray());
+    eavlIndexedConnectivity<C> conn(parentConn, (int*)cellIds.GetCUDAArray());
+
+    i0->GetCUDAArray();
+    i1->GetCUDAArray();
+    i2->GetCUDAArray();
+    o0->GetCUDAArray();
+    o1->GetCUDAArray();
+    o2->GetCUDAArray();
+
+    // run the kernel
+    eavlDispatch_3_3<gpuTopologyMapOp_3_0_3_subset>(nitems,
+                                                 eavlArray::DEVICE,
+                                                 conn,
+                                                 i0, i0div, i0mod, i0mul, i0add,
+                                                 i1, i1div, i1mod, i1mul, i1add,
+                                                 i2, i2div, i2mod, i2mul, i2add,
+                                                 o0, o0mul, o0add,
+                                                 o1, o1mul, o1add,
+                                                 o2, o2mul, o2add,
+                                                 functor);
+}
+
 #endif
 #endif // DOXYGEN
 
@@ -379,6 +545,7 @@ class eavlTopologyMapOp_3_0_3 : public eavlOperation
     {
         eavlCellSetExplicit *elExp = dynamic_cast<eavlCellSetExplicit*>(cells);
         eavlCellSetAllStructured *elStr = dynamic_cast<eavlCellSetAllStructured*>(cells);
+        eavlCellSetSubset *elSub = dynamic_cast<eavlCellSetSubset*>(cells);
         if (elExp)
         {
             eavlDispatch_3_3<cpu_topologyMapExplicit_3_0_3>(outArray0.array->GetNumberOfTuples(),
@@ -406,6 +573,50 @@ class eavlTopologyMapOp_3_0_3 : public eavlOperation
                                                            outArray2.array, outArray2.mul, outArray2.add,
                                                            functor);
         }
+        else if (elSub)
+        {
+            // iterate the kept cells directly, using the parent's own
+            // connectivity so structured parents stay structured
+            if (topology != EAVL_NODES_OF_CELLS &&
+                topology != EAVL_EDGES_OF_CELLS &&
+                topology != EAVL_FACES_OF_CELLS)
+                THROW(eavlException,"eavlTopologyMapOp on a subset must map from cells.");
+            eavlCellSetExplicit *parExp = dynamic_cast<eavlCellSetExplicit*>(elSub->GetParent());
+            eavlCellSetAllStructured *parStr = dynamic_cast<eavlCellSetAllStructured*>(elSub->GetParent());
+            if (parExp)
+            {
+                eavlSubsetConnectivity<eavlExplicitConnectivity> conn(elSub, parExp->GetConnectivity(topology));
+                eavlDispatch_3_3<cpu_topologyMapSubset_3_0_3>(outArray0.array->GetNumberOfTuples(),
+                                                              eavlArray::HOST,
+                                                              conn,
+                                                              inArray0.array, inArray0.div, inArray0.mod, inArray0.mul, inArray0.add,
+                                                              inArray1.array, inArray1.div, inArray1.mod, inArray1.mul, inArray1.add,
+                                                              inArray2.array, inArray2.div, inArray2.mod, inArray2.mul, inArray2.add,
+                                                              outArray0.array, outArray0.mul, outArray0.add,
+                                                              outArray1.array, outArray1.mul, outArray1.add,
+                                                              outArray2.array, outArray2.mul, outArray2.add,
+                                                              functor);
+            }
+            else if (parStr)
+            {
+                eavlRegularConnectivity reg(parStr->GetRegularStructure(),topology);
+                eavlSubsetConnectivity<eavlRegularConnectivity> conn(elSub, reg);
+                eavlDispatch_3_3<cpu_topologyMapSubset_3_0_3>(outArray0.array->GetNumberOfTuples(),
+                                                              eavlArray::HOST,
+                                                              conn,
+                                                              inArray0.array, inArray0.div, inArray0.mod, inArray0.mul, inArray0.add,
+                                                              inArray1.array, inArray1.div, inArray1.mod, inArray1.mul, inArray1.add,
+                                                              inArray2.array, inArray2.div, inArray2.mod, inArray2.mul, inArray2.add,
+                                                              outArray0.array, outArray0.mul, outArray0.add,
+                                                              outArray1.array, outArray1.mul, outArray1.add,
+                                                              outArray2.array, outArray2.mul, outArray2.add,
+                                                              functor);
+            }
+            else
+            {
+                THROW(eavlException,"eavlTopologyMapOp didn't understand the subset's parent mesh type.");
+            }
+        }
         else
         {
             THROW(eavlException,"eavlTopologyMapOp didn't understand the mesh type.");
@@ -416,7 +627,53 @@ class eavlTopologyMapOp_3_0_3 : public eavlOperation
 #if defined __CUDACC__
         eavlCellSetExplicit *elExp = dynamic_cast<eavlCellSetExplicit*>(cells);
         eavlCellSetAllStructured *elStr = dynamic_cast<eavlCellSetAllStructured*>(cells);
-        if (elExp)
+        eavlCellSetSubset *elSub = dynamic_cast<eavlCellSetSubset*>(cells);
+        if (elSub)
+        {
+            if (topology != EAVL_NODES_OF_CELLS &&
+                topology != EAVL_EDGES_OF_CELLS &&
+                topology != EAVL_FACES_OF_CELLS)
+                THROW(eavlException,"eavlTopologyMapOp on a subset must map from cells.");
+            eavlCellSetExplicit *parExp = dynamic_cast<eavlCellSetExplicit*>(elSub->GetParent());
+            eavlCellSetAllStructured *parStr = dynamic_cast<eavlCellSetAllStructured*>(elSub->GetParent());
+            if (parExp)
+            {
+                eavlExplicitConnectivity &conn = parExp->GetConnectivity(topology);
+                conn.shapetype.NeedOnDevice();
+                conn.connectivity.NeedOnDevice();
+                conn.mapCellToIndex.NeedOnDevice();
+                callTopologyMapKernelSubset_3_0_3(outArray0.array->GetNumberOfTuples(),
+                                   elSub, conn,
+                                   inArray0.array, inArray0.div, inArray0.mod, inArray0.mul, inArray0.add,
+                                   inArray1.array, inArray1.div, inArray1.mod, inArray1.mul, inArray1.add,
+                                   inArray2.array, inArray2.div, inArray2.mod, inArray2.mul, inArray2.add,
+                                   outArray0.array, outArray0.mul, outArray0.add,
+                                   outArray1.array, outArray1.mul, outArray1.add,
+                                   outArray2.array, outArray2.mul, outArray2.add,
+                                   functor);
+                conn.shapetype.NeedOnHost();
+                conn.connectivity.NeedOnHost();
+                conn.mapCellToIndex.NeedOnHost();
+            }
+            else if (parStr)
+            {
+                eavlRegularConnectivity conn(parStr->GetRegularStructure(),topology);
+                callTopologyMapKernelSubset_3_0_3(outArray0.array->GetNumberOfTuples(),
+                                   elSub, conn,
+                                   inArray0.array, inArray0.div, inArray0.mod, inArray0.mul, inArray0.add,
+                                   inArray1.array, inArray1.div, inArray1.mod, inArray1.mul, inArray1.add,
+                                   inArray2.array, inArray2.div, inArray2.mod, inArray2.mul, inArray2.add,
+                                   outArray0.array, outArray0.mul, outArray0.add,
+                                   outArray1.array, outArray1.mul, outArray1.add,
+                                   outArray2.array, outArray2.mul, outArray2.add,
+                                   functor);
+            }
+            else
+            {
+                THROW(eavlException,"eavlTopologyMapOp didn't understand the subset's parent mesh type.");
+            }
+        }
+        else if (elExp)
         {
             ///\todo: assert that div,mod are always 1,INT_MAX?
             callTopologyMapKernelExplicit_3_0_3(outArray0.array->GetNumberOfTuples(),
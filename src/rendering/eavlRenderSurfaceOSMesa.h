@@ -3,6 +3,7 @@
 
 #include "eavlRenderSurface.h"
 #include "eavlException.h"
+#include "eavlMemoryTracker.h"
 
 #include "GL/gl_mangle.h"
 #include "GL/osmesa.h"
@@ -24,6 +25,8 @@ class eavlRenderSurfaceOSMesa : public eavlRenderSurface
     {
         if (ctx)
             OSMesaDestroyContext(ctx);
+        eavlMemoryTracker::Free(eavlMemoryTracker::RENDER,
+                                rgba.capacity() + zbuff.capacity()*sizeof(float));
     }
     virtual void Initialize()
     {
@@ -36,7 +39,19 @@ class eavlRenderSurfaceOSMesa : public eavlRenderSurface
     {
         width = w;
         height = h;
+        // check the budget before growing so an exhausted budget
+        // throws before allocating, then record the actual capacity
+        long long oldbytes = rgba.capacity();
+        long long bytes = (long long)w*h*4;
+        if (bytes > oldbytes)
+        {
+            eavlMemoryTracker::Change(eavlMemoryTracker::RENDER,
+                                      oldbytes, bytes);
+            oldbytes = bytes;
+        }
         rgba.resize(w*h*4);
+        eavlMemoryTracker::Change(eavlMemoryTracker::RENDER,
+                                  oldbytes, rgba.capacity());
     }
     virtual void Activate()
     {
@@ -69,7 +84,17 @@ class eavlRenderSurfaceOSMesa : public eavlRenderSurface
         OSMesaGetDepthBuffer(ctx, &w, &h, &zbytes, (void**)&raw_zbuff);
         // but caller wants a float....
         int npixels = w*h;
+        long long oldbytes = zbuff.capacity()*sizeof(float);
+        long long bytes = (long long)npixels*sizeof(float);
+        if (bytes > oldbytes)
+        {
+            eavlMemoryTracker::Change(eavlMemoryTracker::RENDER,
+                                      oldbytes, bytes);
+            oldbytes = bytes;
+        }
         zbuff.resize(npixels);
+        eavlMemoryTracker::Change(eavlMemoryTracker::RENDER,
+                                  oldbytes, zbuff.capacity()*sizeof(float));
         for (int i=0; i<npixels; ++i)
             zbuff[i] = raw_zbuff[i] / float(UINT_MAX);
         return &zbuff[0];
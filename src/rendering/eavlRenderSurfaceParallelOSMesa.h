@@ -18,13 +18,37 @@ class eavlRenderSurfaceParallelOSMesa : public eavlRenderSurfaceOSMesa
         : eavlRenderSurfaceOSMesa(), comm(mpicomm), bg(bgcolor)
     {
     }
+    virtual ~eavlRenderSurfaceParallelOSMesa()
+    {
+        eavlMemoryTracker::Free(eavlMemoryTracker::RENDER,
+                                composited_rgba.capacity() +
+                                composited_zbuff.capacity()*sizeof(float));
+    }
     virtual void Finish()
     {
         eavlRenderSurfaceOSMesa::Finish();
 
         int npixels = width * height;
+        long long oldbytes = composited_rgba.capacity() +
+                             composited_zbuff.capacity()*sizeof(float);
+        long long rgbacap = composited_rgba.capacity();
+        long long zbuffcap = composited_zbuff.capacity();
+        if (4LL*npixels > rgbacap)
+            rgbacap = 4LL*npixels;
+        if (npixels > zbuffcap)
+            zbuffcap = npixels;
+        long long bytes = rgbacap + zbuffcap*sizeof(float);
+        if (bytes > oldbytes)
+        {
+            eavlMemoryTracker::Change(eavlMemoryTracker::RENDER,
+                                      oldbytes, bytes);
+            oldbytes = bytes;
+        }
         composited_rgba.resize(4*npixels);
         composited_zbuff.resize(npixels);
+        eavlMemoryTracker::Change(eavlMemoryTracker::RENDER, oldbytes,
+                                  composited_rgba.capacity() +
+                                  composited_zbuff.capacity()*sizeof(float));
 
         const unsigned char *rgba = GetRGBABuffer();
         const float *zbuff = GetZBuffer();
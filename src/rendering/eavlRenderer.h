@@ -4,6 +4,7 @@
 
 #include "eavlDataSet.h"
 #include "eavlCellSet.h"
+#include "eavlGhostCells.h"
 #include "eavlColor.h"
 #include "eavlColorTable.h"
 
@@ -66,7 +67,8 @@ template <bool PointColors, bool CellColors>
 void eavlRenderCells1D(eavlCellSet *cs,
                   int , double *pts,
                   eavlField *f, double vmin, double vmax,
-                  eavlColorTable *)
+                  eavlColorTable *,
+                  const byte *ghost)
 {
     glDisable(GL_LIGHTING);
     if (PointColors || CellColors)
@@ -83,6 +85,8 @@ void eavlRenderCells1D(eavlCellSet *cs,
     glBegin(GL_LINES);
     for (int j=0; j<ncells; j++)
     {
+        if (ghost && ghost[j])
+            continue;
         eavlCell cell = cs->GetCellNodes(j);
         if (cell.type != EAVL_BEAM)
             continue;
@@ -122,7 +126,8 @@ void eavlRenderCells2D(eavlCellSet *cs,
                        int , double *pts,
                        eavlField *f, double vmin, double vmax,
                        eavlColorTable *,
-                       eavlField *normals)
+                       eavlField *normals,
+                       const byte *ghost)
 {
     if (PointColors || CellColors)
     {
@@ -148,6 +153,8 @@ void eavlRenderCells2D(eavlCellSet *cs,
     glBegin(GL_TRIANGLES);
     for (int j=0; j<ncells; j++)
     {
+        if (ghost && ghost[j])
+            continue;
         eavlCell cell = cs->GetCellNodes(j);
         if (cell.numIndices == 3)
         {
@@ -225,6 +232,8 @@ void eavlRenderCells2D(eavlCellSet *cs,
     glBegin(GL_QUADS);
     for (int j=0; j<ncells; j++)
     {
+        if (ghost && ghost[j])
+            continue;
         eavlCell cell = cs->GetCellNodes(j);
         if (cell.numIndices == 4)
         {
@@ -327,7 +336,8 @@ void eavlRenderCellsWireframe2D(eavlCellSet *cs,
                                 int , double *pts,
                                 eavlField *f, double vmin, double vmax,
                                 eavlColorTable *,
-                                eavlField *normals)
+                                eavlField *normals,
+                                const byte *ghost)
 {
     if (PointColors || CellColors)
     {
@@ -353,6 +363,8 @@ void eavlRenderCellsWireframe2D(eavlCellSet *cs,
     glBegin(GL_LINES);
     for (int j=0; j<ncells; j++)
     {
+        if (ghost && ghost[j])
+            continue;
         eavlCell cell = cs->GetCellNodes(j);
         if (cell.numIndices == 3)
         {
@@ -448,6 +460,8 @@ void eavlRenderCellsWireframe2D(eavlCellSet *cs,
     glBegin(GL_LINES);
     for (int j=0; j<ncells; j++)
     {
+        if (ghost && ghost[j])
+            continue;
         eavlCell cell = cs->GetCellNodes(j);
         if (cell.numIndices == 4)
         {
@@ -579,6 +593,9 @@ void eavlRenderCellsWireframe2D(eavlCellSet *cs,
 //   Big refactoring; more consistent internal code with less
 //   duplication and cleaner external API.
 //
+//   agent, Sun Oct 18 2026
+//   Don't draw ghost cells.
+//
 // ****************************************************************************
 class eavlRenderer
 {
@@ -590,6 +607,7 @@ class eavlRenderer
     eavlField   *field;
     bool         field_nodal;
     eavlField   *normals;
+    eavlGhostCells *ghosts;
 
     double min_coord_extents[3];
     double max_coord_extents[3];
@@ -602,7 +620,8 @@ class eavlRenderer
                                  double &x, double &y, double &z),
                  const string &csname = "",
                  const string &fieldname = "")
-        : dataset(ds), cellset(NULL), field(NULL), normals(NULL)
+        : dataset(ds), cellset(NULL), field(NULL), normals(NULL),
+          ghosts(NULL)
     {
         //
         // extract the points and find coordinate extents
@@ -664,6 +683,7 @@ class eavlRenderer
         if (csname != "")
         {
             cellset = ds->GetCellSet(csname);
+            ghosts = new eavlGhostCells(ds, ds->GetCellSetIndex(csname));
 
             for (int i=0; i<dataset->GetNumFields(); i++)
             {
@@ -739,6 +759,7 @@ class eavlRenderer
     ~eavlRenderer()
     {
         delete[] pts;
+        delete ghosts;
     }
     eavlDataSet *GetDataSet() { return dataset; }
     double GetMinCoordExtent(int axis) { return min_coord_extents[axis]; }
@@ -855,7 +876,8 @@ class eavlPseudocolorRenderer : public eavlRenderer
             eavlRenderCells1D<true, false>(cellset, npts, pts,
                                            field,
                                            min_data_extents, max_data_extents,
-                                           &colortable);
+                                           &colortable,
+                                           ghosts->GetFlags());
             return;
         }
         else if (dataset->GetCellSet(field->GetAssocCellSet()) == cellset)
@@ -863,7 +885,8 @@ class eavlPseudocolorRenderer : public eavlRenderer
             eavlRenderCells1D<false, true>(cellset, npts, pts,
                                            field,
                                            min_data_extents, max_data_extents,
-                                           &colortable);
+                                           &colortable,
+                                           ghosts->GetFlags());
             return;
         }
 
@@ -884,14 +907,16 @@ class eavlPseudocolorRenderer : public eavlRenderer
                                                                 field,
                                                                 min_data_extents,
                                                                 max_data_extents,
-                                                                &colortable, normals);
+                                                                &colortable, normals,
+                                                                ghosts->GetFlags());
                 else if (normals)
                     eavlRenderCellsWireframe2D<true, false, false, true>(cellset,
                                                                 npts, pts,
                                                                 field,
                                                                 min_data_extents,
                                                                 max_data_extents,
-                                                                &colortable, normals);
+                                                                &colortable, normals,
+                                                                ghosts->GetFlags());
                 else
                     eavlRenderCellsWireframe2D<true, false, false, false>(cellset,
                                                                  npts, pts,
@@ -899,7 +924,8 @@ class eavlPseudocolorRenderer : public eavlRenderer
                                                                  min_data_extents,
                                                                  max_data_extents,
                                                                  &colortable,
-                                                                 NULL);
+                                                                 NULL,
+                                                                 ghosts->GetFlags());
             }
             else
             {
@@ -909,14 +935,16 @@ class eavlPseudocolorRenderer : public eavlRenderer
                                                                 field,
                                                                 min_data_extents,
                                                                 max_data_extents,
-                                                                &colortable, normals);
+                                                                &colortable, normals,
+                                                                ghosts->GetFlags());
                 else if (normals)
                     eavlRenderCells2D<true, false, false, true>(cellset,
                                                                 npts, pts,
                                                                 field,
                                                                 min_data_extents,
                                                                 max_data_extents,
-                                                                &colortable, normals);
+                                                                &colortable, normals,
+                                                                ghosts->GetFlags());
                 else
                     eavlRenderCells2D<true, false, false, false>(cellset,
                                                                  npts, pts,
@@ -924,7 +952,8 @@ class eavlPseudocolorRenderer : public eavlRenderer
                                                                  min_data_extents,
                                                                  max_data_extents,
                                                                  &colortable,
-                                                                 NULL);
+                                                                 NULL,
+                                                                 ghosts->GetFlags());
             }
             return;
         }
@@ -938,14 +967,16 @@ class eavlPseudocolorRenderer : public eavlRenderer
                                                                 field,
                                                                 min_data_extents,
                                                                 max_data_extents,
-                                                                &colortable, normals);
+                                                                &colortable, normals,
+                                                                ghosts->GetFlags());
                 else if (normals)
                     eavlRenderCellsWireframe2D<false, true, false, true>(cellset,
                                                                 npts, pts,
                                                                 field,
                                                                 min_data_extents,
                                                                 max_data_extents,
-                                                                &colortable, normals);
+                                                                &colortable, normals,
+                                                                ghosts->GetFlags());
                 else
                     eavlRenderCellsWireframe2D<false, true, false, false>(cellset,
                                                                  npts, pts,
@@ -953,7 +984,8 @@ class eavlPseudocolorRenderer : public eavlRenderer
                                                                  min_data_extents,
                                                                  max_data_extents,
                                                                  &colortable,
-                                                                 NULL);
+                                                                 NULL,
+                                                                 ghosts->GetFlags());
             }
             else
             {
@@ -963,14 +995,16 @@ class eavlPseudocolorRenderer : public eavlRenderer
                                                                 field,
                                                                 min_data_extents,
                                                                 max_data_extents,
-                                                                &colortable, normals);
+                                                                &colortable, normals,
+                                                                ghosts->GetFlags());
                 else if (normals)
                     eavlRenderCells2D<false, true, false, true>(cellset,
                                                                 npts, pts,
                                                                 field,
                                                                 min_data_extents,
                                                                 max_data_extents,
-                                                                &colortable, normals);
+                                                                &colortable, normals,
+                                                                ghosts->GetFlags());
                 else
                     eavlRenderCells2D<false, true, false, false>(cellset,
                                                                  npts, pts,
@@ -978,7 +1012,8 @@ class eavlPseudocolorRenderer : public eavlRenderer
                                                                  min_data_extents,
                                                                  max_data_extents,
                                                                  &colortable,
-                                                                 NULL);
+                                                                 NULL,
+                                                                 ghosts->GetFlags());
             }
             return;
         }
@@ -1026,7 +1061,7 @@ class eavlSingleColorRenderer : public eavlRenderer
         glDisable(GL_LIGHTING);
         glLineWidth(2);
         glColor3fv(color.c);
-        eavlRenderCells1D<false, false>(cellset, npts, pts, NULL,0,0,NULL);
+        eavlRenderCells1D<false, false>(cellset, npts, pts, NULL,0,0,NULL, ghosts->GetFlags());
     }
     virtual void RenderCells2D()
     {
@@ -1035,20 +1070,20 @@ class eavlSingleColorRenderer : public eavlRenderer
         if (wireframe)
         {
             if (normals && normals->GetAssociation()==eavlField::ASSOC_POINTS)
-                eavlRenderCellsWireframe2D<false, false, true, false>(cellset, npts, pts, NULL,0,0,NULL, normals);
+                eavlRenderCellsWireframe2D<false, false, true, false>(cellset, npts, pts, NULL,0,0,NULL, normals, ghosts->GetFlags());
             else if (normals)
-                eavlRenderCellsWireframe2D<false, false, false, true>(cellset, npts, pts, NULL,0,0,NULL, normals);
+                eavlRenderCellsWireframe2D<false, false, false, true>(cellset, npts, pts, NULL,0,0,NULL, normals, ghosts->GetFlags());
             else
-                eavlRenderCellsWireframe2D<false, false, false, false>(cellset, npts, pts, NULL,0,0,NULL, NULL);
+                eavlRenderCellsWireframe2D<false, false, false, false>(cellset, npts, pts, NULL,0,0,NULL, NULL, ghosts->GetFlags());
         }
         else
         {
             if (normals && normals->GetAssociation()==eavlField::ASSOC_POINTS)
-                eavlRenderCells2D<false, false, true, false>(cellset, npts, pts, NULL,0,0,NULL, normals);
+                eavlRenderCells2D<false, false, true, false>(cellset, npts, pts, NULL,0,0,NULL, normals, ghosts->GetFlags());
             else if (normals)
-                eavlRenderCells2D<false, false, false, true>(cellset, npts, pts, NULL,0,0,NULL, normals);
+                eavlRenderCells2D<false, false, false, true>(cellset, npts, pts, NULL,0,0,NULL, normals, ghosts->GetFlags());
             else
-                eavlRenderCells2D<false, false, false, false>(cellset, npts, pts, NULL,0,0,NULL, NULL);
+                eavlRenderCells2D<false, false, false, false>(cellset, npts, pts, NULL,0,0,NULL, NULL, ghosts->GetFlags());
         }
     }
 };
@@ -1120,6 +1155,8 @@ class eavlCurveRenderer : public eavlRenderer
             int ncells = cellset->GetNumCells();
             for (int j=0; j<ncells; j++)
             {
+                if (ghosts->IsGhost(j))
+                    continue;
                 eavlCell cell = cellset->GetCellNodes(j);
                 if (cell.type != EAVL_BEAM)
                     continue;
@@ -1196,6 +1233,8 @@ class eavlBarRenderer : public eavlRenderer
             int ncells = cellset->GetNumCells();
             for (int j=0; j<ncells; j++)
             {
+                if (ghosts->IsGhost(j))
+                    continue;
                 eavlCell cell = cellset->GetCellNodes(j);
                 if (cell.type != EAVL_BEAM)
                     continue;
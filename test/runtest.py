@@ -59,6 +59,8 @@ def RunTest(category, fn, args):
     bn = os.path.basename(fn)
     coutfn = "%s/%s.out" % (category,bn)
     cerrfn = "%s/%s.err" % (category,bn)
+    if not os.path.isdir("current/" + category):
+        os.makedirs("current/" + category)
     cout = open("current/" + coutfn, "w")
     cerr = open("current/" + cerrfn, "w")
 
@@ -130,6 +132,163 @@ def TestTransform(fn):
     # an optional final argument specifies an output file for hand-verification
     #["./testxform", fn, fn+"-xform.vtk"])
 
+#
+# Resample tests
+#
+def TestResample(fn, nsamples):
+    RunTest("testresample", fn,
+            ["./testresample", "%d"%nsamples, fn])
+    # an optional final argument specifies an output file for hand-verification
+    #["./testresample", "%d"%nsamples, fn, fn+"-resample.vtk"])
+
+#
+# Native binary format round trip tests
+#
+def TestBinary(fn):
+    bn = os.path.basename(fn)
+    RunTest("testbinary", fn,
+            ["./testbinary", fn, "current/testbinary/"+bn+".eavl"])
+
+#
+# Cell set subset tests
+#
+def TestSubset(fn, varname):
+    RunTest("testsubset", fn,
+            ["./testsubset", varname, fn])
+
+#
+# Memory accounting tests
+#
+def TestMemory(fn):
+    RunTest("testmemory", fn,
+            ["./testmemory", fn])
+
+#
+# Multiple isovalue tests
+#
+def TestIsoMulti(fn, values, varname):
+    RunTest("testisomulti", fn,
+            ["./testiso", ",".join(["%f"%v for v in values]), varname, fn])
+
+#
+# Metacell isosurface tests
+#
+def TestIsoMetaCells(fn, value, varname):
+    RunTest("testisometacells", fn,
+            ["./testiso", "--metacells", "%f"%value, varname, fn])
+
+#
+# Edge key isosurface tests
+#
+def TestIsoEdgeKeys(fn, value, varname):
+    RunTest("testisoedgekeys", fn,
+            ["./testiso", "--edgekeys", "%f"%value, varname, fn])
+
+#
+# General path isosurface tests on structured inputs
+#
+def TestIsoGeneral(fn, value, varname):
+    RunTest("testisogeneral", fn,
+            ["./testiso", "--general", "%f"%value, varname, fn])
+
+#
+# Threshold tests
+#
+def TestThreshold(fn, minval, maxval, varname):
+    RunTest("testthreshold", fn,
+            ["./testthreshold", "%f"%minval, "%f"%maxval, varname, fn])
+
+#
+# External face tests
+#
+def TestExtFace(fn):
+    RunTest("testextface", fn, ["./testextface", fn])
+
+#
+# Clip and slice tests
+#
+def TestClip(fn):
+    RunTest("testclip", fn, ["./testclip", fn])
+
+#
+# Graph layout tests
+#
+def TestGraphLayout(fn):
+    RunTest("testgraphlayout", fn, ["./testgraphlayout", fn])
+
+#
+# 2D tesselation tests
+#
+def TestTesselate(fn):
+    RunTest("testtesselate", fn, ["./testtesselate", fn])
+
+#
+# Expression tests
+#
+def TestExpression(fn):
+    RunTest("testexpression", fn, ["./testexpression", fn])
+
+#
+# Recentering tests
+#
+def TestRecenter(fn):
+    RunTest("testrecenter", fn, ["./testrecenter", fn])
+
+#
+# Gradient tests
+#
+def TestGradient(fn):
+    RunTest("testgradient", fn, ["./testgradient", fn])
+
+#
+# Point normal tests
+#
+def TestPointNormal(fn, weighting):
+    RunTest("testnormal"+weighting, fn,
+            ["./testnormal", "--"+weighting, fn])
+
+#
+# Node stencil tests
+#
+def TestStencil(fn):
+    RunTest("teststencil", fn, ["./teststencil", fn])
+
+#
+# Streamline tests
+#
+def TestStreamline(fn):
+    RunTest("teststreamline", fn, ["./teststreamline", fn])
+
+#
+# Connected component tests
+#
+def TestComponents(fn, percent):
+    RunTest("testcomponents", fn, ["./testcomponents", "%d"%percent, fn])
+
+#
+# Decimation tests
+#
+def TestDecimate(fn, target):
+    RunTest("testdecimate", fn, ["./testdecimate", "%d"%target, fn])
+
+#
+# Append tests
+#
+def TestAppend(fn, chunks):
+    RunTest("testappend", fn, ["./testappend", "%d"%chunks, fn])
+
+#
+# Ghost cell tests
+#
+def TestGhost(fn, percent, value, varname):
+    RunTest("testghost", fn, ["./testghost", "%d"%percent, "%f"%value, varname, fn])
+
+#
+# Statistics tests
+#
+def TestStatistics(fn, varname):
+    RunTest("teststatistics", fn, ["./teststatistics", varname, fn])
+
 
 # -----------------------------------------------------------------------------
 #                               Run Tests
@@ -168,6 +327,7 @@ if __name__ == "__main__":
     TestImport("../data/ucd_cube.vtk")
     TestImport("../data/ucd_sphere.vtk")
     TestImport("../data/ucd_tets.vtk")
+    TestImport("../data/quadtree.madness")
 
     logfile.write("\n===== %s =====\n" % "testiso")
     print "Running isosurface tests"
@@ -221,6 +381,215 @@ if __name__ == "__main__":
     TestTransform("../data/ucd_sphere.vtk")
     TestTransform("../data/ucd_tets.vtk")
 
+    logfile.write("\n===== %s =====\n" % "testresample")
+    print "Running resample tests"
+    TestResample("../data/rect_cube.vtk", 7)
+    TestResample("../data/curv_cube.vtk", 7)
+    TestResample("../data/ucd_cube.vtk", 7)
+    TestResample("../data/ucd_sphere.vtk", 7)
+    TestResample("../data/ucd_tets.vtk", 7)
+    TestResample("../data/ucd_2d_xy.vtk", 7)
+
+    logfile.write("\n===== %s =====\n" % "testbinary")
+    print "Running binary format tests"
+    TestBinary("../data/curv_cube.vtk")
+    TestBinary("../data/curv_xy.vtk")
+    TestBinary("../data/poly_1d_in_3d.vtk")
+    TestBinary("../data/poly_sphere.vtk")
+    TestBinary("../data/poly_verts_and_lines.vtk")
+    TestBinary("../data/rect_cube.vtk")
+    TestBinary("../data/rect_x.vtk")
+    TestBinary("../data/rect_xz.vtk")
+    TestBinary("../data/ucd_1d_in_3d.vtk")
+    TestBinary("../data/ucd_2d_xy.vtk")
+    TestBinary("../data/ucd_cube.vtk")
+    TestBinary("../data/ucd_sphere.vtk")
+    TestBinary("../data/ucd_tets.vtk")
+
+    logfile.write("\n===== %s =====\n" % "testsubset")
+    print "Running cell set subset tests"
+    TestSubset("../data/rect_cube.vtk", "nodal")
+    TestSubset("../data/curv_cube.vtk", "nodal")
+    TestSubset("../data/ucd_cube.vtk", "nodal")
+    TestSubset("../data/ucd_sphere.vtk", "nodal")
+    TestSubset("../data/ucd_tets.vtk", "nodal")
+    TestSubset("../data/ucd_2d_xy.vtk", "nodal")
+
+    logfile.write("\n===== %s =====\n" % "testmemory")
+    print "Running memory accounting tests"
+    TestMemory("../data/rect_cube.vtk")
+    TestMemory("../data/curv_cube.vtk")
+    TestMemory("../data/ucd_cube.vtk")
+    TestMemory("../data/poly_sphere.vtk")
+
+    logfile.write("\n===== %s =====\n" % "testisomulti")
+    print "Running multiple isovalue tests"
+    TestIsoMulti("../data/rect_cube.vtk", [2.5, 3.5, 4.5], "nodal")
+    TestIsoMulti("../data/curv_cube.vtk", [2.5, 3.5, 4.5], "nodal")
+    TestIsoMulti("../data/ucd_cube.vtk",  [2.5, 3.5, 4.5], "nodal")
+    TestIsoMulti("../data/ucd_sphere.vtk",[2.5, 3.5, 4.5], "nodal")
+    TestIsoMulti("../data/ucd_tets.vtk",  [2.5, 3.5, 4.5], "nodal")
+
+    logfile.write("\n===== %s =====\n" % "testisometacells")
+    print "Running metacell isosurface tests"
+    TestIsoMetaCells("../data/ucd_cube.vtk",   3.5, "nodal")
+    TestIsoMetaCells("../data/ucd_sphere.vtk", 3.5, "nodal")
+    TestIsoMetaCells("../data/ucd_tets.vtk",   3.5, "nodal")
+
+    logfile.write("\n===== %s =====\n" % "testisoedgekeys")
+    print "Running edge key isosurface tests"
+    TestIsoEdgeKeys("../data/ucd_cube.vtk",   3.5, "nodal")
+    TestIsoEdgeKeys("../data/ucd_sphere.vtk", 3.5, "nodal")
+    TestIsoEdgeKeys("../data/ucd_tets.vtk",   3.5, "nodal")
+
+    logfile.write("\n===== %s =====\n" % "testisogeneral")
+    print "Running general path isosurface tests"
+    TestIsoGeneral("../data/rect_cube.vtk", 3.5, "nodal")
+    TestIsoGeneral("../data/curv_cube.vtk", 3.5, "nodal")
+
+    logfile.write("\n===== %s =====\n" % "testthreshold")
+    print "Running threshold tests"
+    TestThreshold("../data/rect_cube.vtk",   2.5, 4.5, "nodal")
+    TestThreshold("../data/curv_cube.vtk",   2.5, 4.5, "nodal")
+    TestThreshold("../data/ucd_cube.vtk",    2.5, 4.5, "zonal")
+    TestThreshold("../data/ucd_sphere.vtk",  2.5, 4.5, "nodal")
+    TestThreshold("../data/ucd_tets.vtk",    2.5, 4.5, "nodal")
+    TestThreshold("../data/ucd_2d_xy.vtk",   2.5, 4.5, "nodal")
+
+    logfile.write("\n===== %s =====\n" % "testextface")
+    print "Running external face tests"
+    TestExtFace("../data/rect_cube.vtk")
+    TestExtFace("../data/curv_cube.vtk")
+    TestExtFace("../data/ucd_cube.vtk")
+    TestExtFace("../data/ucd_sphere.vtk")
+    TestExtFace("../data/ucd_tets.vtk")
+
+    logfile.write("\n===== %s =====\n" % "testclip")
+    print "Running clip and slice tests"
+    TestClip("../data/rect_cube.vtk")
+    TestClip("../data/curv_cube.vtk")
+    TestClip("../data/ucd_cube.vtk")
+    TestClip("../data/ucd_sphere.vtk")
+    TestClip("../data/ucd_tets.vtk")
+    TestClip("../data/ucd_2d_xy.vtk")
+
+    logfile.write("\n===== %s =====\n" % "testgraphlayout")
+    print "Running graph layout tests"
+    TestGraphLayout("../data/poly_1d_in_3d.vtk")
+    TestGraphLayout("../data/poly_verts_and_lines.vtk")
+    TestGraphLayout("../data/ucd_1d_in_3d.vtk")
+
+    logfile.write("\n===== %s =====\n" % "testtesselate")
+    print "Running 2D tesselation tests"
+    TestTesselate("../data/rect_xy.vtk")
+    TestTesselate("../data/curv_xy.vtk")
+    TestTesselate("../data/ucd_2d_xy.vtk")
+    TestTesselate("../data/poly_2d_in_3d.vtk")
+    TestTesselate("../data/quadtree.madness")
+
+    logfile.write("\n===== %s =====\n" % "testexpression")
+    print "Running expression tests"
+    TestExpression("../data/rect_cube.vtk")
+    TestExpression("../data/curv_cube.vtk")
+    TestExpression("../data/ucd_cube.vtk")
+    TestExpression("../data/ucd_2d_xy.vtk")
+
+    logfile.write("\n===== %s =====\n" % "testrecenter")
+    print "Running recentering tests"
+    TestRecenter("../data/rect_cube.vtk")
+    TestRecenter("../data/curv_cube.vtk")
+    TestRecenter("../data/ucd_cube.vtk")
+    TestRecenter("../data/ucd_sphere.vtk")
+    TestRecenter("../data/ucd_tets.vtk")
+    TestRecenter("../data/ucd_2d_xy.vtk")
+    TestRecenter("../data/poly_sphere.vtk")
+
+    logfile.write("\n===== %s =====\n" % "testgradient")
+    print "Running gradient tests"
+    TestGradient("../data/rect_cube.vtk")
+    TestGradient("../data/curv_cube.vtk")
+    TestGradient("../data/ucd_cube.vtk")
+    TestGradient("../data/ucd_sphere.vtk")
+    TestGradient("../data/ucd_tets.vtk")
+    TestGradient("../data/rect_xy.vtk")
+    TestGradient("../data/ucd_2d_xy.vtk")
+
+    for weighting in ["area", "angle"]:
+        logfile.write("\n===== %s =====\n" % ("testnormal"+weighting))
+        print "Running %s weighted point normal tests" % weighting
+        TestPointNormal("../data/curv_cube.vtk", weighting)
+        TestPointNormal("../data/poly_2d_in_3d.vtk", weighting)
+        TestPointNormal("../data/poly_sphere.vtk", weighting)
+        TestPointNormal("../data/rect_xy.vtk", weighting)
+        TestPointNormal("../data/ucd_2d_xy.vtk", weighting)
+        TestPointNormal("../data/ucd_sphere.vtk", weighting)
+        TestPointNormal("../data/ucd_tets.vtk", weighting)
+
+    logfile.write("\n===== %s =====\n" % "teststencil")
+    print "Running node stencil tests"
+    TestStencil("../data/rect_x.vtk")
+    TestStencil("../data/rect_xy.vtk")
+    TestStencil("../data/curv_xy.vtk")
+    TestStencil("../data/rect_cube.vtk")
+    TestStencil("../data/curv_cube.vtk")
+
+    logfile.write("\n===== %s =====\n" % "teststreamline")
+    print "Running streamline tests"
+    TestStreamline("../data/rect_cube.vtk")
+    TestStreamline("../data/curv_cube.vtk")
+    TestStreamline("../data/ucd_cube.vtk")
+    TestStreamline("../data/ucd_sphere.vtk")
+    TestStreamline("../data/ucd_tets.vtk")
+    TestStreamline("../data/rect_xy.vtk")
+    TestStreamline("../data/ucd_2d_xy.vtk")
+
+    logfile.write("\n===== %s =====\n" % "testcomponents")
+    print "Running connected component tests"
+    TestComponents("../data/rect_cube.vtk", 40)
+    TestComponents("../data/curv_cube.vtk", 40)
+    TestComponents("../data/ucd_cube.vtk", 40)
+    TestComponents("../data/ucd_sphere.vtk", 40)
+    TestComponents("../data/ucd_tets.vtk", 40)
+    TestComponents("../data/rect_xy.vtk", 40)
+    TestComponents("../data/ucd_2d_xy.vtk", 40)
+    TestComponents("../data/poly_sphere.vtk", 40)
+
+    logfile.write("\n===== %s =====\n" % "testdecimate")
+    print "Running decimation tests"
+    TestDecimate("../data/poly_sphere.vtk", 60)
+    TestDecimate("../data/poly_2d_in_3d.vtk", 60)
+    TestDecimate("../data/curv_xy.vtk", 60)
+    TestDecimate("../data/rect_cube.vtk", 60)
+    TestDecimate("../data/ucd_sphere.vtk", 60)
+    TestDecimate("../data/ucd_tets.vtk", 60)
+
+    logfile.write("\n===== %s =====\n" % "testappend")
+    print "Running append tests"
+    TestAppend("../data/rect_cube.vtk", 4)
+    TestAppend("../data/curv_cube.vtk", 4)
+    TestAppend("../data/ucd_cube.vtk", 4)
+    TestAppend("../data/ucd_sphere.vtk", 4)
+    TestAppend("../data/ucd_tets.vtk", 4)
+    TestAppend("../data/ucd_2d_xy.vtk", 4)
+    TestAppend("../data/poly_sphere.vtk", 4)
+
+    logfile.write("\n===== %s =====\n" % "testghost")
+    print "Running ghost cell tests"
+    TestGhost("../data/rect_cube.vtk", 30, 3.5, "nodal")
+    TestGhost("../data/curv_cube.vtk", 30, 3.5, "nodal")
+    TestGhost("../data/ucd_cube.vtk", 30, 3.5, "nodal")
+    TestGhost("../data/ucd_sphere.vtk", 30, 3.5, "nodal")
+    TestGhost("../data/ucd_tets.vtk", 30, 3.5, "nodal")
+
+    logfile.write("\n===== %s =====\n" % "teststatistics")
+    print "Running statistics tests"
+    TestStatistics("../data/rect_cube.vtk", "nodal")
+    TestStatistics("../data/curv_cube.vtk", "zonal")
+    TestStatistics("../data/ucd_cube.vtk", "zonal")
+    TestStatistics("../data/ucd_sphere.vtk", "nodal")
+    TestStatistics("../data/ucd_tets.vtk", "nodal")
+    TestStatistics("../data/curv_xy.vtk", "nodal")
+
     errors = PrintResults()
 
     logfile.close()
@@ -0,0 +1,236 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlCellSetExplicit.h"
+#include "eavlAppendFilter.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+// ----------------------------------------------------------------------------
+// A chunk holding cells [c0,c1) of a cell set and only the points they
+// use, moved by up to the jitter, with the original point and cell ids.
+static eavlDataSet *
+MakeChunk(eavlDataSet *data, eavlCellSet *cells, int c0, int c1, double jitter)
+{
+    map<int,int> local;
+    vector<int> ids;
+    eavlExplicitConnectivity conn;
+    for (int c=c0; c<c1; c++)
+    {
+        eavlCell cell = cells->GetCellNodes(c);
+        int pts[12];
+        for (int k=0; k<cell.numIndices; k++)
+        {
+            int p = cell.indices[k];
+            if (!local.count(p))
+            {
+                local[p] = ids.size();
+                ids.push_back(p);
+            }
+            pts[k] = local[p];
+        }
+        conn.AddElement(cell.type, cell.numIndices, pts);
+    }
+
+    eavlDataSet *chunk = new eavlDataSet;
+    int npts = ids.size();
+    chunk->SetNumPoints(npts);
+    eavlFloatArray *coords = new eavlFloatArray("coords", 3, npts);
+    eavlIntArray *pointid = new eavlIntArray("pointid", 1, npts);
+    for (int i=0; i<npts; i++)
+    {
+        for (int d=0; d<3; d++)
+        {
+            int offset = ((ids[i] + c0) * 7 + d * 3) % 3 - 1;
+            coords->SetComponentFromDouble(i, d, data->GetPoint(ids[i], d) +
+                                                 jitter * offset);
+        }
+        pointid->SetValue(i, ids[i]);
+    }
+    chunk->AddField(new eavlField(1, coords, eavlField::ASSOC_POINTS));
+    chunk->AddField(new eavlField(1, pointid, eavlField::ASSOC_POINTS));
+
+    eavlCellSetExplicit *chunkcells =
+        new eavlCellSetExplicit("cells", cells->GetDimensionality());
+    chunkcells->SetCellNodeConnectivity(conn);
+    chunk->AddCellSet(chunkcells);
+    eavlIntArray *cellid = new eavlIntArray("cellid", 1, c1 - c0);
+    for (int c=c0; c<c1; c++)
+        cellid->SetValue(c - c0, c);
+    chunk->AddField(new eavlField(0, cellid, eavlField::ASSOC_CELL_SET, 0));
+
+    eavlCoordinatesCartesian *coordsys =
+        new eavlCoordinatesCartesian(NULL,
+                                     eavlCoordinatesCartesian::X,
+                                     eavlCoordinatesCartesian::Y,
+                                     eavlCoordinatesCartesian::Z);
+    for (int d=0; d<3; d++)
+        coordsys->SetAxis(d, new eavlCoordinateAxisField("coords", d));
+    chunk->AddCoordinateSystem(coordsys);
+    return chunk;
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 3 && argc != 4)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        int nchunks = atoi(argv[1]);
+        if (nchunks < 1)
+            THROW(eavlException,"Expected at least one chunk");
+
+        // Read the input
+        eavlDataSet *data = ReadWholeFile(argv[2]);
+
+        // use the first 3D cell set, or else the first 2D one
+        int cellsetindex = -1;
+        for (int dim = 3; dim >= 2 && cellsetindex < 0; dim--)
+        {
+            for (int i=0; i<data->GetNumCellSets(); i++)
+            {
+                if (data->GetCellSet(i)->GetDimensionality() == dim)
+                {
+                    cellsetindex = i;
+                    cerr << "Found " << dim << "D topo dim cell set name '"
+                         << data->GetCellSet(i)->GetName()
+                         << "' index " << cellsetindex << endl;
+                    break;
+                }
+            }
+        }
+        if (cellsetindex < 0)
+            THROW(eavlException,"Couldn't find a 2D or 3D cell set.  Aborting.");
+        eavlCellSet *cells = data->GetCellSet(cellsetindex);
+        int ncells = cells->GetNumCells();
+        set<int> used;
+        for (int c=0; c<ncells; c++)
+        {
+            eavlCell cell = cells->GetCellNodes(c);
+            for (int k=0; k<cell.numIndices; k++)
+                used.insert(cell.indices[k]);
+        }
+        double extent = 0;
+        for (int i=1; i<data->GetNumPoints(); i++)
+        {
+            for (int d=0; d<3; d++)
+            {
+                double e = fabs(data->GetPoint(i,d) - data->GetPoint(0,d));
+                if (e > extent)
+                    extent = e;
+            }
+        }
+
+        // appending exact chunks, chunks moved by less than the tolerance,
+        // and chunks without merging
+        eavlDataSet *result = NULL;
+        for (int pass=0; pass<3; pass++)
+        {
+            double jitter = (pass == 1) ? 1.e-5 * extent : 0.;
+            eavlAppendFilter *append = new eavlAppendFilter;
+            int nchunkpts = 0;
+            for (int j=0; j<nchunks; j++)
+            {
+                eavlDataSet *chunk = MakeChunk(data, cells,
+                                               ncells * j / nchunks,
+                                               ncells * (j+1) / nchunks,
+                                               jitter);
+                nchunkpts += chunk->GetNumPoints();
+                append->AddInput(chunk);
+            }
+            append->SetCellSet("cells");
+            append->SetMergePoints(pass < 2);
+            append->SetTolerance(pass == 1 ? 1.e-4 * extent : 0.);
+            append->Execute();
+            eavlDataSet *out = append->GetOutput();
+
+            // every cell must have its original points, and merging must
+            // leave exactly the points the cells use
+            int expected = (pass < 2) ? used.size() : nchunkpts;
+            if (out->GetNumPoints() != expected)
+                THROW(eavlException,"Wrong number of appended points.");
+            eavlCellSet *outcells = out->GetCellSet("cells");
+            if (outcells->GetNumCells() != ncells)
+                THROW(eavlException,"Wrong number of appended cells.");
+            eavlArray *pointid = out->GetField("pointid")->GetArray();
+            eavlArray *cellid = out->GetField("cellid")->GetArray();
+            for (int c=0; c<ncells; c++)
+            {
+                eavlCell a = outcells->GetCellNodes(c);
+                eavlCell b = cells->GetCellNodes(int(cellid->GetComponentAsDouble(c,0)));
+                if (a.numIndices != b.numIndices)
+                    THROW(eavlException,"Appended cell changed shape.");
+                for (int k=0; k<a.numIndices; k++)
+                    if (int(pointid->GetComponentAsDouble(a.indices[k],0)) != b.indices[k])
+                        THROW(eavlException,"Appended cell has the wrong points.");
+            }
+            cout << (pass == 0 ? "exact" : (pass == 1 ? "jittered" : "unmerged"))
+                 << ": " << nchunks << " chunks with " << nchunkpts
+                 << " points appended to " << out->GetNumPoints() << endl;
+            if (pass == 0)
+                result = out;
+        }
+
+        if (argc == 4)
+        {
+            cerr << "\n\n-- done with append, writing to file --\n";	
+            WriteToVTKFile(result, argv[3], 0);
+        }
+        else
+        {
+            cerr << "No output filename given; not writing result\n";
+        }
+
+
+        cout << "\n\n-- summary of data set result --\n";	
+        result->PrintSummary(cout);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <chunks> <infile.vtk> [<outfile.vtk>]\n";
+        return 1;
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlBinaryExporter.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 3)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        string binfile(argv[2]);
+        if (binfile.length() < 5 ||
+            binfile.substr(binfile.length()-5) != ".eavl")
+            THROW(eavlException,"Expected a .eavl file name for the second argument");
+
+        // Read the input and write it in the native binary format
+        eavlDataSet *data = ReadWholeFile(argv[1]);
+        ofstream out(binfile.c_str(), ios::out | ios::binary);
+        eavlBinaryExporter exporter(data);
+        exporter.Export(out);
+        out.close();
+
+        // read it back and make sure nothing changed along the way
+        eavlDataSet *result = ReadWholeFile(binfile);
+
+        ostringstream before, after;
+        data->PrintSummary(before);
+        result->PrintSummary(after);
+        if (before.str() != after.str())
+        {
+            cerr << "-- summary before round trip --\n" << before.str();
+            cerr << "-- summary after round trip --\n" << after.str();
+            THROW(eavlException,"Data set changed in the round trip.");
+        }
+
+        // the summaries only show a few values, so check them all
+        for (int i=0; i<data->GetNumPoints(); i++)
+            for (int d=0; d<3; d++)
+                if (data->GetPoint(i,d) != result->GetPoint(i,d))
+                    THROW(eavlException,"Point coordinates changed in the round trip.");
+        for (int f=0; f<data->GetNumFields(); f++)
+        {
+            eavlArray *a = data->GetField(f)->GetArray();
+            eavlArray *b = result->GetField(f)->GetArray();
+            for (int i=0; i<a->GetNumberOfTuples(); i++)
+                for (int c=0; c<a->GetNumberOfComponents(); c++)
+                    if (a->GetComponentAsDouble(i,c) != b->GetComponentAsDouble(i,c))
+                        THROW(eavlException,"Field values changed in the round trip.");
+        }
+        for (int s=0; s<data->GetNumCellSets(); s++)
+        {
+            eavlCellSet *a = data->GetCellSet(s);
+            eavlCellSet *b = result->GetCellSet(s);
+            for (int i=0; i<a->GetNumCells(); i++)
+            {
+                eavlCell ca = a->GetCellNodes(i);
+                eavlCell cb = b->GetCellNodes(i);
+                bool same = (ca.type == cb.type &&
+                             ca.numIndices == cb.numIndices);
+                for (int n=0; same && n<ca.numIndices; n++)
+                    same = (ca.indices[n] == cb.indices[n]);
+                if (!same)
+                    THROW(eavlException,"Cells changed in the round trip.");
+            }
+        }
+        cerr << "Round trip through " << binfile << " matched\n";
+
+        cout << "\n\n-- summary of data set result --\n";	
+        result->PrintSummary(cout);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <infile.vtk> <scratchfile.eavl>\n";
+        return 1;
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,282 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlCellComponents.h"
+#include "eavlSliceFilter.h"
+#include "eavlClipFilter.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+// ----------------------------------------------------------------------------
+// signed volume of the tetrahedron (a,b,c,o)
+static double
+TetVolume(const double *a, const double *b, const double *c, const double *o)
+{
+    double u[3], v[3], w[3];
+    for (int d=0; d<3; d++)
+    {
+        u[d] = a[d] - o[d];
+        v[d] = b[d] - o[d];
+        w[d] = c[d] - o[d];
+    }
+    return (u[0]*(v[1]*w[2]-v[2]*w[1]) -
+            u[1]*(v[0]*w[2]-v[2]*w[0]) +
+            u[2]*(v[0]*w[1]-v[1]*w[0])) / 6.;
+}
+
+// ----------------------------------------------------------------------------
+// total volume (or XY area for 2D cells) of a cell set, as the sum over
+// each cell's faces of the tetrahedra they make with its center
+static double
+Measure(eavlDataSet *data, eavlCellSet *cells)
+{
+    double total = 0;
+    for (int c=0; c<cells->GetNumCells(); c++)
+    {
+        eavlCell cell = cells->GetCellNodes(c);
+        double pts[12][3], center[3] = {0,0,0};
+        for (int i=0; i<cell.numIndices; i++)
+        {
+            for (int d=0; d<3; d++)
+            {
+                pts[i][d] = data->GetPoint(cell.indices[i], d);
+                center[d] += pts[i][d] / cell.numIndices;
+            }
+        }
+
+        int ntris = 0, nquads = 0;
+        signed char (*tris)[3] = NULL;
+        signed char (*quads)[4] = NULL;
+        switch (cell.type)
+        {
+          case EAVL_TET:
+            ntris = 4; tris = eavlTetTriangleFaces;
+            break;
+          case EAVL_PYRAMID:
+            ntris = 4; tris = eavlPyramidTriangleFaces;
+            nquads = 1; quads = eavlPyramidQuadFaces;
+            break;
+          case EAVL_WEDGE:
+            ntris = 2; tris = eavlWedgeTriangleFaces;
+            nquads = 3; quads = eavlWedgeQuadFaces;
+            break;
+          case EAVL_HEX:
+            nquads = 6; quads = eavlHexQuadFaces;
+            break;
+          case EAVL_VOXEL:
+            nquads = 6; quads = eavlVoxQuadFaces;
+            break;
+          case EAVL_TRI:
+          case EAVL_QUAD:
+          case EAVL_PIXEL:
+            {
+                int ring[4] = {0, 1, 2, 3};
+                if (cell.type == EAVL_PIXEL)
+                {
+                    ring[2] = 3;
+                    ring[3] = 2;
+                }
+                for (int i=0; i<cell.numIndices; i++)
+                {
+                    const double *a = pts[ring[i]];
+                    const double *b = pts[ring[(i+1) % cell.numIndices]];
+                    total += 0.5 * (a[0]*b[1] - b[0]*a[1]);
+                }
+            }
+            break;
+          default:
+            THROW(eavlException,"Unexpected cell shape.");
+        }
+        for (int f=0; f<ntris; f++)
+            total += TetVolume(pts[tris[f][0]], pts[tris[f][1]],
+                               pts[tris[f][2]], center);
+        for (int f=0; f<nquads; f++)
+            total += TetVolume(pts[quads[f][0]], pts[quads[f][1]],
+                               pts[quads[f][2]], center) +
+                     TetVolume(pts[quads[f][0]], pts[quads[f][2]],
+                               pts[quads[f][3]], center);
+    }
+    return total;
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 2 && argc != 3)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        // Read the input
+        eavlDataSet *data = ReadWholeFile(argv[1]);
+
+        // use the first 3D cell set, or else the first 2D one
+        int cellsetindex = -1;
+        for (int dim = 3; dim >= 2 && cellsetindex < 0; dim--)
+        {
+            for (int i=0; i<data->GetNumCellSets(); i++)
+            {
+                if (data->GetCellSet(i)->GetDimensionality() == dim)
+                {
+                    cellsetindex = i;
+                    cerr << "Found " << dim << "D topo dim cell set name '"
+                         << data->GetCellSet(i)->GetName()
+                         << "' index " << cellsetindex << endl;
+                    break;
+                }
+            }
+        }
+        if (cellsetindex < 0)
+            THROW(eavlException,"Couldn't find a 2D or 3D cell set.  Aborting.");
+        eavlCellSet *cells = data->GetCellSet(cellsetindex);
+
+        // cut with a tilted plane and a sphere placed off center in the
+        // bounding box of the points
+        double lo[3], hi[3];
+        for (int d=0; d<3; d++)
+            lo[d] = hi[d] = data->GetPoint(0, d);
+        for (int i=1; i<data->GetNumPoints(); i++)
+        {
+            for (int d=0; d<3; d++)
+            {
+                double v = data->GetPoint(i, d);
+                lo[d] = (v < lo[d]) ? v : lo[d];
+                hi[d] = (v > hi[d]) ? v : hi[d];
+            }
+        }
+        double mid[3];
+        for (int d=0; d<3; d++)
+            mid[d] = lo[d] + 0.37 * (hi[d] - lo[d]);
+        double size = hi[0] - lo[0];
+        eavlImplicitFunction funcs[2] = {
+            eavlImplicitFunction::Plane(mid[0],mid[1],mid[2], 1,0.3,0.2),
+            eavlImplicitFunction::Sphere(mid[0],mid[1],mid[2], 0.4*size)
+        };
+        const char *funcnames[2] = {"plane", "sphere"};
+        double tol = 1.e-4 * size;
+
+        double full = Measure(data, cells);
+        cout << "input measure: " << full << endl;
+
+        eavlDataSet *result = NULL;
+        for (int f=0; f<2; f++)
+        {
+            // edge crossings are interpolated linearly, so only the plane
+            // puts new points exactly on its surface
+            bool linear = (funcs[f].GetType() == eavlImplicitFunction::PLANE);
+
+            // slice points must lie on the surface
+            if (cells->GetDimensionality() == 3)
+            {
+                eavlSliceFilter slice;
+                slice.SetInput(data);
+                slice.SetCellSet(cells->GetName());
+                slice.SetFunction(funcs[f]);
+                slice.Execute();
+                eavlDataSet *out = slice.GetOutput();
+                for (int i=0; linear && i<out->GetNumPoints(); i++)
+                {
+                    if (fabs(funcs[f].Eval(out->GetPoint(i,0),
+                                           out->GetPoint(i,1),
+                                           out->GetPoint(i,2))) > tol)
+                        THROW(eavlException,"Slice point is off the surface.");
+                }
+                cout << funcnames[f] << " slice: "
+                     << out->GetCellSet(0)->GetNumCells() << " triangles, "
+                     << out->GetNumPoints() << " points" << endl;
+            }
+
+            // the two sides of a clip must stay on their side and
+            // together cover the input
+            double sum = 0;
+            for (int inv=0; inv<2; inv++)
+            {
+                eavlClipFilter clip;
+                clip.SetInput(data);
+                clip.SetCellSet(cells->GetName());
+                clip.SetFunction(funcs[f]);
+                clip.SetInvert(inv);
+                clip.Execute();
+                eavlDataSet *out = clip.GetOutput();
+                for (int i=0; linear && i<out->GetNumPoints(); i++)
+                {
+                    double v = funcs[f].Eval(out->GetPoint(i,0),
+                                             out->GetPoint(i,1),
+                                             out->GetPoint(i,2));
+                    if ((inv ? -v : v) > tol)
+                        THROW(eavlException,"Clipped point is on the wrong side.");
+                }
+                double measure = Measure(out, out->GetCellSet(0));
+                sum += measure;
+                cout << funcnames[f] << " clip" << (inv ? " (inverted)" : "")
+                     << ": " << out->GetCellSet(0)->GetNumCells() << " cells, "
+                     << out->GetNumPoints() << " points, measure "
+                     << measure << endl;
+                if (f == 0 && inv == 0)
+                    result = out;
+            }
+            if (fabs(sum - full) > 1.e-4 * fabs(full))
+                THROW(eavlException,"Clip sides don't add up to the input.");
+        }
+
+        if (argc == 3)
+        {
+            cerr << "\n\n-- done with clip, writing to file --\n";	
+            WriteToVTKFile(result, argv[2], 0);
+        }
+        else
+        {
+            cerr << "No output filename given; not writing result\n";
+        }
+
+
+        cout << "\n\n-- summary of data set result --\n";	
+        result->PrintSummary(cout);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <infile.vtk> [<outfile.vtk>]\n";
+        return 1;
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlCellSetSubset.h"
+#include "eavlConnectedComponentsMutator.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+// ----------------------------------------------------------------------------
+static int
+FindRoot(vector<int> &parent, int i)
+{
+    while (parent[i] != i)
+        i = parent[i] = parent[parent[i]];
+    return i;
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 3)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        int percent = atoi(argv[1]);
+
+        // Read the input
+        eavlDataSet *data = ReadWholeFile(argv[2]);
+
+        // use the first 3D cell set, or else the first 2D one
+        int cellsetindex = -1;
+        for (int dim = 3; dim >= 2 && cellsetindex < 0; dim--)
+        {
+            for (int i=0; i<data->GetNumCellSets(); i++)
+            {
+                if (data->GetCellSet(i)->GetDimensionality() == dim)
+                {
+                    cellsetindex = i;
+                    cerr << "Found " << dim << "D topo dim cell set name '"
+                         << data->GetCellSet(i)->GetName()
+                         << "' index " << cellsetindex << endl;
+                    break;
+                }
+            }
+        }
+        if (cellsetindex < 0)
+            THROW(eavlException,"Couldn't find a 2D or 3D cell set.  Aborting.");
+        eavlCellSet *parent = data->GetCellSet(cellsetindex);
+
+        // a scattered selection of the cells breaks the mesh into pieces
+        eavlCellSetSubset *cells = new eavlCellSetSubset("selected", parent);
+        for (int i=0; i<parent->GetNumCells(); i++)
+        {
+            if ((i * 7919) % 100 < percent)
+                cells->AddCell(i);
+        }
+        cells->Finalize();
+        data->AddCellSet(cells);
+        int ncells = cells->GetNumCells();
+        int dim = cells->GetDimensionality();
+
+        cout << "\n\n-- summary of component results --\n";	
+        cout << ncells << " of " << parent->GetNumCells() << " cells selected\n";
+        for (int adj=0; adj<2; adj++)
+        {
+            string prefix = adj ? "face" : "node";
+            eavlConnectedComponentsMutator comp;
+            comp.SetDataSet(data);
+            comp.SetCellSet("selected");
+            comp.SetAdjacency(adj ? eavlConnectedComponentsMutator::FaceAdjacency
+                                  : eavlConnectedComponentsMutator::NodeAdjacency);
+            comp.SetResultPrefix(prefix);
+            comp.Execute();
+
+            // join every pair of cells sharing enough nodes, and number
+            // the components in order of their lowest cell
+            int need = adj ? dim : 1;
+            vector<int> root(ncells);
+            for (int i=0; i<ncells; i++)
+                root[i] = i;
+            for (int a=0; a<ncells; a++)
+            {
+                eavlCell ca = cells->GetCellNodes(a);
+                for (int b=a+1; b<ncells; b++)
+                {
+                    eavlCell cb = cells->GetCellNodes(b);
+                    int shared = 0;
+                    for (int i=0; i<ca.numIndices; i++)
+                        for (int j=0; j<cb.numIndices; j++)
+                            shared += (ca.indices[i] == cb.indices[j]);
+                    if (shared < need)
+                        continue;
+                    int ra = FindRoot(root, a), rb = FindRoot(root, b);
+                    if (ra < rb)
+                        root[rb] = ra;
+                    else if (rb < ra)
+                        root[ra] = rb;
+                }
+            }
+            vector<int> label(ncells, -1), count;
+            for (int i=0; i<ncells; i++)
+            {
+                if (FindRoot(root, i) == i)
+                {
+                    label[i] = count.size();
+                    count.push_back(0);
+                }
+                count[label[FindRoot(root, i)]]++;
+            }
+
+            eavlArray *ids = data->GetField(prefix + "_id")->GetArray();
+            eavlArray *counts = data->GetField(prefix + "_cell_count")->GetArray();
+            if (counts->GetNumberOfTuples() != (int)count.size())
+                THROW(eavlException,"Wrong number of components.");
+            for (int i=0; i<ncells; i++)
+                if (ids->GetComponentAsDouble(i,0) != label[FindRoot(root, i)])
+                    THROW(eavlException,"Wrong component id.");
+            for (size_t c=0; c<count.size(); c++)
+                if (counts->GetComponentAsDouble(c,0) != count[c])
+                    THROW(eavlException,"Wrong component cell count.");
+
+            cout << prefix << " adjacency: " << count.size() << " components:";
+            for (size_t c=0; c<count.size(); c++)
+                cout << " " << count[c];
+            cout << endl;
+        }
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <percent of cells> <infile.vtk>\n";
+        return 1;
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,184 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlExternalFaceMutator.h"
+#include "eavlDecimateFilter.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 3 && argc != 4)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        int target = atoi(argv[1]);
+        if (target < 1)
+            THROW(eavlException,"Expected a positive triangle budget");
+
+        // Read the input
+        eavlDataSet *data = ReadWholeFile(argv[2]);
+
+        // decimate the first 2D cell set, or the faces of a 3D one
+        int cellsetindex = -1;
+        for (int i=0; i<data->GetNumCellSets(); i++)
+        {
+            if (data->GetCellSet(i)->GetDimensionality() == 2)
+            {
+                cellsetindex = i;
+                cerr << "Found 2D topo dim cell set name '"
+                     << data->GetCellSet(i)->GetName()
+                     << "' index " << cellsetindex << endl;
+                break;
+            }
+        }
+        if (cellsetindex < 0)
+        {
+            for (int i=0; i<data->GetNumCellSets() && cellsetindex < 0; i++)
+            {
+                if (data->GetCellSet(i)->GetDimensionality() != 3)
+                    continue;
+                eavlExternalFaceMutator extface;
+                extface.SetDataSet(data);
+                extface.SetCellSet(data->GetCellSet(i)->GetName());
+                extface.Execute();
+                cellsetindex = data->GetNumCellSets() - 1;
+            }
+        }
+        if (cellsetindex < 0)
+            THROW(eavlException,"Couldn't find a 2D or 3D cell set.  Aborting.");
+        eavlCellSet *cells = data->GetCellSet(cellsetindex);
+
+        // a constant field must come through unchanged
+        int npts = data->GetNumPoints();
+        eavlFloatArray *constant = new eavlFloatArray("constant", 1, npts);
+        for (int i=0; i<npts; i++)
+            constant->SetValue(i, 7.5);
+        data->AddField(new eavlField(1, constant, eavlField::ASSOC_POINTS));
+
+        double lo[3], hi[3];
+        for (int d=0; d<3; d++)
+            lo[d] = hi[d] = data->GetPoint(0, d);
+        for (int i=1; i<npts; i++)
+        {
+            for (int d=0; d<3; d++)
+            {
+                double v = data->GetPoint(i, d);
+                lo[d] = (v < lo[d]) ? v : lo[d];
+                hi[d] = (v > hi[d]) ? v : hi[d];
+            }
+        }
+        // a merged point fitting the planes of a curved surface may lie
+        // a little outside it, but never far
+        double margin = 0;
+        for (int d=0; d<3; d++)
+            margin = (0.1 * (hi[d]-lo[d]) > margin) ? 0.1 * (hi[d]-lo[d]) : margin;
+
+        eavlDecimateFilter *decimate = new eavlDecimateFilter;
+        decimate->SetInput(data);
+        decimate->SetCellSet(cells->GetName());
+        decimate->SetTargetTriangles(target);
+        decimate->Execute();
+        eavlDataSet *result = decimate->GetOutput();
+        eavlCellSet *tris = result->GetCellSet(0);
+
+        // the budget is met with distinct, non-degenerate triangles
+        // whose points stay near the input bounds
+        if (tris->GetNumCells() > target)
+            THROW(eavlException,"Decimation went over the triangle budget.");
+        if (result->GetNumPoints() > npts)
+            THROW(eavlException,"Decimation added points.");
+        set<vector<int> > unique;
+        for (int i=0; i<tris->GetNumCells(); i++)
+        {
+            eavlCell cell = tris->GetCellNodes(i);
+            if (cell.type != EAVL_TRI)
+                THROW(eavlException,"Decimation gave a cell that isn't a triangle.");
+            // triangles facing opposite ways are different, so only
+            // rotate the lowest index to the front
+            vector<int> key(cell.indices, cell.indices + 3);
+            std::rotate(key.begin(), std::min_element(key.begin(), key.end()),
+                        key.end());
+            if (key[0] == key[1] || key[1] == key[2] || key[0] == key[2])
+                THROW(eavlException,"Decimation gave a degenerate triangle.");
+            if (!unique.insert(key).second)
+                THROW(eavlException,"Decimation gave a duplicate triangle.");
+        }
+        eavlArray *c = result->GetField("constant")->GetArray();
+        for (int i=0; i<result->GetNumPoints(); i++)
+        {
+            for (int d=0; d<3; d++)
+            {
+                double v = result->GetPoint(i, d);
+                if (v < lo[d] - margin || v > hi[d] + margin)
+                    THROW(eavlException,"Decimated point is far outside the input bounds.");
+            }
+            if (c->GetComponentAsDouble(i,0) != 7.5)
+                THROW(eavlException,"Decimation changed a constant field.");
+        }
+        cout << "decimated " << cells->GetNumCells() << " cells to "
+             << tris->GetNumCells() << " triangles" << endl;
+
+        if (argc == 4)
+        {
+            cerr << "\n\n-- done with decimation, writing to file --\n";	
+            WriteToVTKFile(result, argv[3], 0);
+        }
+        else
+        {
+            cerr << "No output filename given; not writing result\n";
+        }
+
+
+        cout << "\n\n-- summary of data set result --\n";	
+        result->PrintSummary(cout);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <max triangles> <infile.vtk> [<outfile.vtk>]\n";
+        return 1;
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlExpressionMutator.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 2 && argc != 3)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        // Read the input
+        eavlDataSet *data = ReadWholeFile(argv[1]);
+
+        // add the point positions as a vector field
+        int npts = data->GetNumPoints();
+        eavlFloatArray *pos = new eavlFloatArray("pos", 3, npts);
+        for (int i=0; i<npts; i++)
+            for (int d=0; d<3; d++)
+                pos->SetComponentFromDouble(i, d, data->GetPoint(i, d));
+        data->AddField(new eavlField(1, pos, eavlField::ASSOC_POINTS));
+
+        // each expression, checked against the same computed here
+        const char *exprs[] = {
+            "sqrt(pos[0]*pos[0] + pos[1]*pos[1] + pos[2]*pos[2]) * nodal"
+                " - 2^3^2 / (1 + abs(nodal))",
+            "-2^2 + nodal",
+            "atan2(pos[0], pos[2]) + max(nodal, pos[1]) - min(nodal, -pos[1])"
+                " + exp(-abs(nodal))",
+            "\"zonal\" * 3 - log10(1 + abs(zonal)) + sin(zonal)*cos(zonal)"
+        };
+        const int nexprs = sizeof(exprs) / sizeof(exprs[0]);
+        for (int e=0; e<nexprs; e++)
+        {
+            char name[20];
+            sprintf(name, "expr%d", e);
+            eavlExpressionMutator expr;
+            expr.SetDataSet(data);
+            expr.SetExpression(exprs[e]);
+            expr.SetResultName(name);
+            expr.Execute();
+
+            eavlArray *result = data->GetField(name)->GetArray();
+            eavlArray *nodal = data->GetField("nodal")->GetArray();
+            eavlArray *zonal = data->GetField("zonal")->GetArray();
+            for (int i=0; i<result->GetNumberOfTuples(); i++)
+            {
+                double ref;
+                if (e == 3)
+                {
+                    double z = zonal->GetComponentAsDouble(i,0);
+                    ref = z*3 - log10(1 + fabs(z)) + sin(z)*cos(z);
+                }
+                else
+                {
+                    double n = nodal->GetComponentAsDouble(i,0);
+                    double x = pos->GetComponentAsDouble(i,0);
+                    double y = pos->GetComponentAsDouble(i,1);
+                    double z = pos->GetComponentAsDouble(i,2);
+                    if (e == 0)
+                        ref = sqrt(x*x + y*y + z*z) * n - 512 / (1 + fabs(n));
+                    else if (e == 1)
+                        ref = -4 + n;
+                    else
+                        ref = atan2(x, z) + (n > y ? n : y) -
+                              (n < -y ? n : -y) + exp(-fabs(n));
+                }
+                double v = result->GetComponentAsDouble(i,0);
+                if (fabs(v - ref) > 1.e-4 * (1 + fabs(ref)))
+                    THROW(eavlException,string("Wrong value from ") + exprs[e]);
+            }
+            cout << name << " = " << exprs[e] << endl;
+        }
+
+        // and these must be rejected
+        const char *bad[] = {
+            "nodal +", "pos", "pos[3]", "nosuchfield * 2", "sqrt(nodal",
+            "nodal * zonal", "nosuchfunction(nodal)", "nodal $ 2", ""
+        };
+        const int nbad = sizeof(bad) / sizeof(bad[0]);
+        for (int e=0; e<nbad; e++)
+        {
+            bool rejected = false;
+            try
+            {
+                eavlExpressionMutator expr;
+                expr.SetDataSet(data);
+                expr.SetExpression(bad[e]);
+                expr.SetResultName("bad");
+                expr.Execute();
+            }
+            catch (const eavlException &)
+            {
+                rejected = true;
+            }
+            if (!rejected)
+                THROW(eavlException,string("Accepted bad expression ") + bad[e]);
+            cout << "rejected \"" << bad[e] << "\"" << endl;
+        }
+
+        if (argc == 3)
+        {
+            cerr << "\n\n-- done with expressions, writing to file --\n";	
+            WriteToVTKFile(data, argv[2], 0);
+        }
+        else
+        {
+            cerr << "No output filename given; not writing result\n";
+        }
+
+
+        cout << "\n\n-- summary of data set result --\n";	
+        data->PrintSummary(cout);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <infile.vtk> [<outfile.vtk>]\n";
+        return 1;
+    }
+
+
+    return 0;
+}
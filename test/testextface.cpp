@@ -0,0 +1,125 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlExternalFaceMutator.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 2 && argc != 3)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        // Read the input
+        eavlDataSet *data = ReadWholeFile(argv[1]);
+
+        int cellsetindex = -1;
+        for (int i=0; i<data->GetNumCellSets(); i++)
+        {
+            if (data->GetCellSet(i)->GetDimensionality() == 3)
+            {
+                cellsetindex = i;
+                cerr << "Found 3D topo dim cell set name '"
+                     << data->GetCellSet(i)->GetName()
+                     << "' index " << cellsetindex << endl;
+                break;
+            }
+        }
+        if (cellsetindex < 0)
+            THROW(eavlException,"Couldn't find a 3D cell set.  Aborting.");
+
+        eavlExternalFaceMutator *extface = new eavlExternalFaceMutator;
+        extface->SetDataSet(data);
+        extface->SetCellSet(data->GetCellSet(cellsetindex)->GetName());
+        extface->Execute();
+
+        // the faces enclose the mesh, so every face edge must be shared
+        // by exactly two faces; pixels don't list their nodes in loop order
+        static const int pixelorder[4] = {0, 1, 3, 2};
+        eavlCellSet *faces = data->GetCellSet(data->GetNumCellSets() - 1);
+        map<pair<int,int>, int> edgecount;
+        for (int i=0; i<faces->GetNumCells(); i++)
+        {
+            eavlCell cell = faces->GetCellNodes(i);
+            bool pixel = (cell.type == EAVL_PIXEL);
+            for (int j=0; j<cell.numIndices; j++)
+            {
+                int k = (j+1) % cell.numIndices;
+                int a = cell.indices[pixel ? pixelorder[j] : j];
+                int b = cell.indices[pixel ? pixelorder[k] : k];
+                edgecount[pair<int,int>(a<b ? a : b, a<b ? b : a)]++;
+            }
+        }
+        for (map<pair<int,int>, int>::iterator it = edgecount.begin();
+             it != edgecount.end(); ++it)
+        {
+            if (it->second != 2)
+                THROW(eavlException,"External faces don't form a closed surface.");
+        }
+        cout << "external faces: " << faces->GetNumCells()
+             << " with " << edgecount.size() << " edges" << endl;
+
+        if (argc == 3)
+        {
+            cerr << "\n\n-- done with external faces, writing to file --\n";	
+            WriteToVTKFile(data, argv[2], data->GetNumCellSets() - 1);
+        }
+        else
+        {
+            cerr << "No output filename given; not writing result\n";
+        }
+
+
+        cout << "\n\n-- summary of data set result --\n";	
+        data->PrintSummary(cout);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <infile.vtk> [<outfile.vtk>]\n";
+        return 1;
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,221 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlCellSetExplicit.h"
+#include "eavlGhostCells.h"
+#include "eavlExternalFaceMutator.h"
+#include "eavlIsosurfaceFilter.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+// ----------------------------------------------------------------------------
+// The sorted node lists of the faces of a 2D cell set, optionally only
+// those whose source cell (through the cellid field) is no ghost.
+static vector<vector<int> >
+FaceKeys(eavlDataSet *data, int cellsetindex, const vector<int> &ghost,
+         bool skipghosts)
+{
+    eavlCellSet *faces = data->GetCellSet(cellsetindex);
+    eavlArray *cellid = NULL;
+    for (int i=0; i<data->GetNumFields(); i++)
+    {
+        eavlField *f = data->GetField(i);
+        if (f->GetArray()->GetName() == "cellid" &&
+            f->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+            f->GetAssocCellSet() == cellsetindex)
+            cellid = f->GetArray();
+    }
+    if (!cellid)
+        THROW(eavlException,"Cell ids were not carried to the faces.");
+
+    vector<vector<int> > keys;
+    for (int i=0; i<faces->GetNumCells(); i++)
+    {
+        int c = int(cellid->GetComponentAsDouble(i,0));
+        if (ghost[c] && skipghosts)
+            continue;
+        if (ghost[c])
+            THROW(eavlException,"External face of a ghost cell.");
+        eavlCell face = faces->GetCellNodes(i);
+        vector<int> key(face.indices, face.indices + face.numIndices);
+        std::sort(key.begin(), key.end());
+        keys.push_back(key);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+static int
+NumIsosurfaceCells(eavlDataSet *data, const string &cellsetname,
+                   const string &fieldname, double value, int mode)
+{
+    eavlIsosurfaceFilter iso;
+    iso.SetInput(data);
+    iso.SetCellSet(cellsetname);
+    iso.SetField(fieldname);
+    iso.SetIsoValue(value);
+    iso.SetUseStructuredPath(mode == 0);
+    iso.SetUseMetaCells(mode == 2);
+    iso.SetUseEdgeKeys(mode == 3);
+    iso.Execute();
+    int n = iso.GetOutput()->GetCellSet(0)->GetNumCells();
+    return n;
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 5 && argc != 6)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        int percent = atoi(argv[1]);
+        double value = atof(argv[2]);
+        string fieldname = argv[3];
+
+        // Read the input twice: one copy gets ghost cells
+        eavlDataSet *data = ReadWholeFile(argv[4]);
+        eavlDataSet *plain = ReadWholeFile(argv[4]);
+
+        int cellsetindex = -1;
+        for (int i=0; i<data->GetNumCellSets(); i++)
+        {
+            if (data->GetCellSet(i)->GetDimensionality() == 3)
+            {
+                cellsetindex = i;
+                cerr << "Found 3D topo dim cell set name '"
+                     << data->GetCellSet(i)->GetName()
+                     << "' index " << cellsetindex << endl;
+                break;
+            }
+        }
+        if (cellsetindex < 0)
+            THROW(eavlException,"Couldn't find a 3D cell set.  Aborting.");
+        eavlCellSet *cells = data->GetCellSet(cellsetindex);
+        string cellsetname = cells->GetName();
+        int ncells = cells->GetNumCells();
+
+        // mark a scattered percentage of the cells as ghosts
+        vector<int> ghost(ncells);
+        eavlByteArray *ghostarray = new eavlByteArray(EAVL_GHOST_FIELD_NAME, 1, ncells);
+        eavlIntArray *cellid = new eavlIntArray("cellid", 1, ncells);
+        eavlIntArray *plaincellid = new eavlIntArray("cellid", 1, ncells);
+        int nghosts = 0;
+        for (int i=0; i<ncells; i++)
+        {
+            ghost[i] = ((i * 7919) % 100 < percent);
+            nghosts += ghost[i];
+            ghostarray->SetValue(i, ghost[i]);
+            cellid->SetValue(i, i);
+            plaincellid->SetValue(i, i);
+        }
+        data->AddField(new eavlField(0, ghostarray, eavlField::ASSOC_CELL_SET, cellsetindex));
+        data->AddField(new eavlField(0, cellid, eavlField::ASSOC_CELL_SET, cellsetindex));
+        plain->AddField(new eavlField(0, plaincellid, eavlField::ASSOC_CELL_SET, cellsetindex));
+        cout << nghosts << " of " << ncells << " cells are ghosts" << endl;
+
+        // external faces must be those of the whole mesh, less the ones
+        // belonging to ghost cells
+        eavlExternalFaceMutator extface;
+        extface.SetDataSet(data);
+        extface.SetCellSet(cellsetname);
+        extface.Execute();
+        eavlExternalFaceMutator plainextface;
+        plainextface.SetDataSet(plain);
+        plainextface.SetCellSet(cellsetname);
+        plainextface.Execute();
+        vector<vector<int> > faces =
+            FaceKeys(data, data->GetNumCellSets()-1, ghost, false);
+        vector<vector<int> > expected =
+            FaceKeys(plain, plain->GetNumCellSets()-1, ghost, true);
+        if (faces != expected)
+            THROW(eavlException,"External faces differ from those of the non-ghost cells.");
+        cout << "external faces: " << faces.size() << endl;
+
+        // every isosurface path must match the isosurface of an explicit
+        // cell set holding only the non-ghost cells
+        eavlExplicitConnectivity conn;
+        for (int i=0; i<ncells; i++)
+        {
+            if (ghost[i])
+                continue;
+            eavlCell cell = cells->GetCellNodes(i);
+            conn.AddElement(cell.type, cell.numIndices, cell.indices);
+        }
+        eavlCellSetExplicit *owned = new eavlCellSetExplicit("owned", 3);
+        owned->SetCellNodeConnectivity(conn);
+        plain->AddCellSet(owned);
+        int reference = NumIsosurfaceCells(plain, "owned", fieldname, value, 1);
+        cout << "isosurface of non-ghost cells: " << reference << endl;
+        const char *modes[] = {"structured", "general", "metacells", "edgekeys"};
+        for (int mode=0; mode<4; mode++)
+        {
+            int n = NumIsosurfaceCells(data, cellsetname, fieldname, value, mode);
+            if (n != reference)
+                THROW(eavlException,string("Isosurface with ghosts differs on the ") +
+                      modes[mode] + " path.");
+            cout << "isosurface with ghosts, " << modes[mode] << ": " << n << endl;
+        }
+
+        if (argc == 6)
+        {
+            cerr << "\n\n-- done with ghosts, writing to file --\n";	
+            WriteToVTKFile(data, argv[5], 0);
+        }
+        else
+        {
+            cerr << "No output filename given; not writing result\n";
+        }
+
+
+        cout << "\n\n-- summary of data set result --\n";	
+        data->PrintSummary(cout);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <percent> <value> <fieldname> <infile.vtk> [<outfile.vtk>]\n";
+        return 1;
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,199 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlGradientMutator.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 2 && argc != 3)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        // Read the input
+        eavlDataSet *data = ReadWholeFile(argv[1]);
+
+        // use the first 3D cell set, or else the first 2D one
+        int cellsetindex = -1;
+        for (int dim = 3; dim >= 2 && cellsetindex < 0; dim--)
+        {
+            for (int i=0; i<data->GetNumCellSets(); i++)
+            {
+                if (data->GetCellSet(i)->GetDimensionality() == dim)
+                {
+                    cellsetindex = i;
+                    cerr << "Found " << dim << "D topo dim cell set name '"
+                         << data->GetCellSet(i)->GetName()
+                         << "' index " << cellsetindex << endl;
+                    break;
+                }
+            }
+        }
+        if (cellsetindex < 0)
+            THROW(eavlException,"Couldn't find a 2D or 3D cell set.  Aborting.");
+        eavlCellSet *cells = data->GetCellSet(cellsetindex);
+        bool is3d = (cells->GetDimensionality() == 3);
+
+        // linear fields have exact gradients; on a surface in the XY
+        // plane only the tangent parts are seen, so leave out Z there
+        double g[3] = {2., -3., is3d ? 0.5 : 0.};
+        int npts = data->GetNumPoints();
+        eavlFloatArray *f = new eavlFloatArray("f", 1, npts);
+        eavlFloatArray *u = new eavlFloatArray("u", 3, npts);
+        for (int i=0; i<npts; i++)
+        {
+            double x = data->GetPoint(i,0);
+            double y = data->GetPoint(i,1);
+            double z = data->GetPoint(i,2);
+            f->SetComponentFromDouble(i, 0, g[0]*x + g[1]*y + g[2]*z);
+            u->SetComponentFromDouble(i, 0, y);
+            u->SetComponentFromDouble(i, 1, -x);
+            u->SetComponentFromDouble(i, 2, is3d ? z : 0.);
+        }
+        data->AddField(new eavlField(1, f, eavlField::ASSOC_POINTS));
+        data->AddField(new eavlField(1, u, eavlField::ASSOC_POINTS));
+        double divergence = is3d ? 1. : 0.;
+        double qcriterion = is3d ? 0.5 : 1.;
+
+        for (int cellcentered=0; cellcentered<2; cellcentered++)
+        {
+            string fname = cellcentered ? "gradient_f_cells" : "gradient_f";
+            string uname = cellcentered ? "gradient_u_cells" : "gradient_u";
+
+            eavlGradientMutator grad;
+            grad.SetDataSet(data);
+            grad.SetField("f");
+            grad.SetCellSet(cells->GetName());
+            grad.SetCellCentered(cellcentered);
+            grad.SetResultName(fname);
+            grad.Execute();
+
+            eavlArray *a = data->GetField(fname)->GetArray();
+            for (int i=0; i<a->GetNumberOfTuples(); i++)
+                for (int d=0; d<3; d++)
+                    if (fabs(a->GetComponentAsDouble(i,d) - g[d]) > 1.e-3)
+                        THROW(eavlException,"Wrong gradient of a linear field.");
+
+            // the derived quantities are named after the field, so only
+            // ask for them once
+            eavlGradientMutator vgrad;
+            vgrad.SetDataSet(data);
+            vgrad.SetField("u");
+            vgrad.SetCellSet(cells->GetName());
+            vgrad.SetCellCentered(cellcentered);
+            vgrad.SetResultName(uname);
+            vgrad.SetComputeVorticity(cellcentered);
+            vgrad.SetComputeDivergence(cellcentered);
+            vgrad.SetComputeQCriterion(cellcentered);
+            vgrad.Execute();
+
+            a = data->GetField(uname)->GetArray();
+            if (a->GetNumberOfComponents() != 9)
+                THROW(eavlException,"Expected 9 gradient components.");
+            double ref[9] = {0, 1, 0,  -1, 0, 0,  0, 0, is3d ? 1. : 0.};
+            for (int i=0; i<a->GetNumberOfTuples(); i++)
+                for (int c=0; c<9; c++)
+                    if (fabs(a->GetComponentAsDouble(i,c) - ref[c]) > 1.e-3)
+                        THROW(eavlException,"Wrong gradient of a linear vector field.");
+            if (cellcentered)
+            {
+                eavlArray *vort = data->GetField("vorticity_u")->GetArray();
+                eavlArray *div = data->GetField("divergence_u")->GetArray();
+                eavlArray *q = data->GetField("qcriterion_u")->GetArray();
+                for (int i=0; i<a->GetNumberOfTuples(); i++)
+                {
+                    if (fabs(vort->GetComponentAsDouble(i,0)) > 1.e-3 ||
+                        fabs(vort->GetComponentAsDouble(i,1)) > 1.e-3 ||
+                        fabs(vort->GetComponentAsDouble(i,2) + 2) > 1.e-3 ||
+                        fabs(div->GetComponentAsDouble(i,0) - divergence) > 1.e-3 ||
+                        fabs(q->GetComponentAsDouble(i,0) - qcriterion) > 1.e-3)
+                        THROW(eavlException,"Wrong derived quantities.");
+                }
+            }
+            cout << (cellcentered ? "cell" : "point")
+                 << " gradients match" << endl;
+        }
+
+        // derived quantities need a 3-component field
+        bool rejected = false;
+        try
+        {
+            eavlGradientMutator bad;
+            bad.SetDataSet(data);
+            bad.SetField("f");
+            bad.SetCellSet(cells->GetName());
+            bad.SetResultName("bad");
+            bad.SetComputeVorticity(true);
+            bad.Execute();
+        }
+        catch (const eavlException &)
+        {
+            rejected = true;
+        }
+        if (!rejected)
+            THROW(eavlException,"Computed the vorticity of a scalar.");
+
+        if (argc == 3)
+        {
+            cerr << "\n\n-- done with gradients, writing to file --\n";	
+            WriteToVTKFile(data, argv[2], cellsetindex);
+        }
+        else
+        {
+            cerr << "No output filename given; not writing result\n";
+        }
+
+
+        cout << "\n\n-- summary of data set result --\n";	
+        data->PrintSummary(cout);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <infile.vtk> [<outfile.vtk>]\n";
+        return 1;
+    }
+
+
+    return 0;
+}
@@ -9,7 +9,7 @@
 #include "eavlImporterFactory.h"
 #include "eavlVTKExporter.h"
 
-#include "eavl2DGraphLayoutMutator.h"
+#include "eavl2DGraphLayoutForceMutator.h"
 #include "eavlExecutor.h"
 
 
@@ -54,9 +54,20 @@ int main(int argc, char *argv[])
         eavlDataSet *data = ReadWholeFile(argv[1]);
         data->PrintSummary(cout);
 
-        int cellsetindex = 0;
+        // use the first cell set of edges
+        int cellsetindex = -1;
+        for (int i=0; i<data->GetNumCellSets(); i++)
+        {
+            if (data->GetCellSet(i)->GetDimensionality() == 1)
+            {
+                cellsetindex = i;
+                break;
+            }
+        }
+        if (cellsetindex < 0)
+            THROW(eavlException,"Couldn't find a 1D cell set.  Aborting.");
 
-        eavl2DGraphLayoutMutator *layout = new eavl2DGraphLayoutMutator;
+        eavl2DGraphLayoutForceMutator *layout = new eavl2DGraphLayoutForceMutator;
         layout->SetDataSet(data);
         layout->SetCellSet(data->GetCellSet(cellsetindex)->GetName());
 
@@ -74,12 +85,48 @@ int main(int argc, char *argv[])
             WriteToVTKFile(data, fn, cellsetindex);
         }
 #else
+        // the starting positions are random; fix them so results compare
+        srandom(1);
         layout->SetNumIterations(300);
         layout->SetStartDist(1.0);
         layout->SetFinalDist(0.01);
         layout->Execute();
 #endif
 
+        // every point must have been placed, with edges of a sane length
+        eavlArray *x = data->GetField("newx")->GetArray();
+        eavlArray *y = data->GetField("newy")->GetArray();
+        for (int i=0; i<data->GetNumPoints(); i++)
+        {
+            double xx = x->GetComponentAsDouble(i,0);
+            double yy = y->GetComponentAsDouble(i,0);
+            if (xx != xx || yy != yy || fabs(xx) > 1.e6 || fabs(yy) > 1.e6)
+                THROW(eavlException,"Graph layout gave a bad position.");
+        }
+        eavlCellSet *edges = data->GetCellSet(cellsetindex);
+        double minlen = 0, maxlen = 0, sumlen = 0;
+        int nedges = 0;
+        for (int c=0; c<edges->GetNumCells(); c++)
+        {
+            eavlCell cell = edges->GetCellNodes(c);
+            if (cell.numIndices != 2)
+                continue;
+            double dx = x->GetComponentAsDouble(cell.indices[1],0) -
+                        x->GetComponentAsDouble(cell.indices[0],0);
+            double dy = y->GetComponentAsDouble(cell.indices[1],0) -
+                        y->GetComponentAsDouble(cell.indices[0],0);
+            double len = sqrt(dx*dx + dy*dy);
+            minlen = (nedges == 0 || len < minlen) ? len : minlen;
+            maxlen = (nedges == 0 || len > maxlen) ? len : maxlen;
+            sumlen += len;
+            nedges++;
+        }
+        if (nedges > 0 && minlen <= 0)
+            THROW(eavlException,"Graph layout collapsed an edge.");
+        cout << "edges: " << nedges << ", length min " << minlen
+             << " mean " << (nedges ? sumlen / nedges : 0)
+             << " max " << maxlen << endl;
+
         if (argc == 3)
         {
             cerr << "\n\n-- done with 2D graph layout, writing to file --\n";	
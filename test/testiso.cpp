@@ -4,6 +4,7 @@
 #include "eavlFilter.h"
 #include "eavlDataSet.h"
 #include "eavlTimer.h"
+#include "eavlMemoryTracker.h"
 #include "eavlException.h"
 
 #include "eavlImporterFactory.h"
@@ -12,6 +13,8 @@
 #include "eavlIsosurfaceFilter.h"
 #include "eavlExecutor.h"
 
+#include <cstring>
+
 
 eavlDataSet *ReadWholeFile(const string &filename)
 {
@@ -46,18 +49,45 @@ int main(int argc, char *argv[])
     {   
         eavlInitializeGPU();
 
-        if (argc != 4 && argc != 5)
+        // leading options select the isosurface algorithm variants
+        bool metacells = false;
+        bool edgekeys = false;
+        bool general = false;
+        int arg = 1;
+        while (arg < argc && strncmp(argv[arg], "--", 2) == 0)
+        {
+            if (strcmp(argv[arg], "--metacells") == 0)
+                metacells = true;
+            else if (strcmp(argv[arg], "--edgekeys") == 0)
+                edgekeys = true;
+            else if (strcmp(argv[arg], "--general") == 0)
+                general = true;
+            else
+                THROW(eavlException,string("Unknown option ") + argv[arg]);
+            ++arg;
+        }
+
+        if (argc - arg != 3 && argc - arg != 4)
             THROW(eavlException,"Incorrect number of arguments");
 
-        char *tmp;
-        double value = strtod(argv[1], &tmp);
-        if (tmp == argv[1])
-            THROW(eavlException,"Expected a value for first argument");
+        // accept a comma-separated list of isovalues
+        vector<double> values;
+        char *tmp = argv[arg];
+        while (true)
+        {
+            char *start = tmp;
+            values.push_back(strtod(start, &tmp));
+            if (tmp == start)
+                THROW(eavlException,"Expected a value for first argument");
+            if (*tmp != ',')
+                break;
+            ++tmp;
+        }
 
-        const char *fieldname = argv[2];
+        const char *fieldname = argv[arg+1];
     
         // Read the input
-        eavlDataSet *data = ReadWholeFile(argv[3]);
+        eavlDataSet *data = ReadWholeFile(argv[arg+2]);
         //cout << "\n\n-- summary of data set input --\n";	
         //data->PrintSummary(cout);
 
@@ -84,24 +114,32 @@ int main(int argc, char *argv[])
         iso->SetInput(data);
         iso->SetCellSet(data->GetCellSet(cellsetindex)->GetName());
         iso->SetField(fieldname);
-        iso->SetIsoValue(value);
+        iso->SetIsoValues(values);
+        iso->SetUseMetaCells(metacells);
+        iso->SetUseEdgeKeys(edgekeys);
+        iso->SetUseStructuredPath(!general);
         int th = eavlTimer::Start();
         iso->Execute();
         cerr << "TOTAL RUNTIME: "<<eavlTimer::Stop(th,"whole isosurface")<<endl;
+        int firstcells = iso->GetOutput()->GetCellSet(0)->GetNumCells();
         iso->GetOutput()->Clear();
         int th2 = eavlTimer::Start();
         iso->Execute();
         cerr << "SECOND PASS (AFTER INIT): "<<eavlTimer::Stop(th2,"whole isosurface")<<endl;
+        // the second pass reuses anything cached by the first
+        if (iso->GetOutput()->GetCellSet(0)->GetNumCells() != firstcells)
+            THROW(eavlException,"Second isosurface pass gave a different number of cells.");
 
         eavlTimer::Dump(cerr);
+        eavlMemoryTracker::Dump(cerr);
 
         // For debugging we can add some temp arrays to input data set
         //WriteToVTKFile(data, "input_modified.vtk", 0);
 
-        if (argc == 5)
+        if (argc - arg == 4)
         {
             cerr << "\n\n-- done isosurfacing, writing to file --\n";	
-            WriteToVTKFile(iso->GetOutput(), argv[4], 0);
+            WriteToVTKFile(iso->GetOutput(), argv[arg+3], 0);
         }
         else
         {
@@ -115,7 +153,7 @@ int main(int argc, char *argv[])
     catch (const eavlException &e)
     {
         cerr << e.GetErrorText() << endl;
-        cerr << "\nUsage: "<<argv[0]<<" <value> <fieldname> <infile.vtk> [<outfile.vtk>]\n";
+        cerr << "\nUsage: "<<argv[0]<<" [--metacells] [--edgekeys] [--general] <value>[,<value>...] <fieldname> <infile.vtk> [<outfile.vtk>]\n";
         return 1;
     }
 
@@ -0,0 +1,132 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlMemoryTracker.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+void PrintUsage(const string &when)
+{
+    cout << when << ":\n";
+    long long sum = 0;
+    for (int i=0; i<eavlMemoryTracker::NUM_CATEGORIES; i++)
+    {
+        eavlMemoryTracker::Category c = eavlMemoryTracker::Category(i);
+        cout << "    " << eavlMemoryTracker::GetCategoryName(c)
+             << ": current " << eavlMemoryTracker::GetCurrent(c)
+             << " peak " << eavlMemoryTracker::GetPeak(c) << endl;
+        sum += eavlMemoryTracker::GetCurrent(c);
+    }
+    cout << "    total: current " << eavlMemoryTracker::GetTotalCurrent()
+         << " peak " << eavlMemoryTracker::GetTotalPeak() << endl;
+    if (sum != eavlMemoryTracker::GetTotalCurrent())
+        THROW(eavlException,"Category totals don't add up.");
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 2)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        // don't let an EAVL_MEMORY_BUDGET in the environment interfere
+        eavlMemoryTracker::SetSoftBudget(0);
+
+        // Read the input
+        eavlDataSet *data = ReadWholeFile(argv[1]);
+
+        cout << "\n\n-- memory accounting --\n";	
+        PrintUsage("after reading the file");
+        long long before = eavlMemoryTracker::GetCurrent(eavlMemoryTracker::ARRAY);
+
+        // an array is charged while it exists, to the current category
+        eavlFloatArray *a = new eavlFloatArray("a", 3, 1000);
+        eavlFloatArray *t;
+        {
+            eavlMemoryTracker::ScopedArrayCategory tmpcat(eavlMemoryTracker::TEMPORARY);
+            t = new eavlFloatArray("t", 1, 500);
+        }
+        PrintUsage("with two more arrays");
+        if (eavlMemoryTracker::GetCurrent(eavlMemoryTracker::ARRAY) != before + 12000)
+            THROW(eavlException,"Wrong charge for a 3x1000 float array.");
+        if (eavlMemoryTracker::GetArrayCategory() != eavlMemoryTracker::ARRAY)
+            THROW(eavlException,"ScopedArrayCategory didn't restore the category.");
+        delete a;
+        delete t;
+        PrintUsage("after deleting them");
+        if (eavlMemoryTracker::GetCurrent(eavlMemoryTracker::ARRAY) != before)
+            THROW(eavlException,"Deleting an array didn't release its charge.");
+
+        // an allocation over the soft budget throws before allocating
+        eavlMemoryTracker::ResetPeaks();
+        eavlMemoryTracker::SetSoftBudget(eavlMemoryTracker::GetTotalCurrent() + 4096);
+        bool threw = false;
+        try
+        {
+            eavlFloatArray *big = new eavlFloatArray("big", 1, 1024*1024);
+            delete big;
+        }
+        catch (const eavlException &)
+        {
+            threw = true;
+        }
+        eavlMemoryTracker::SetSoftBudget(0);
+        if (!threw)
+            THROW(eavlException,"Allocation over the soft budget didn't throw.");
+        cout << "allocation over the soft budget threw\n";
+        PrintUsage("after the refused allocation");
+        if (eavlMemoryTracker::GetCurrent(eavlMemoryTracker::ARRAY) != before)
+            THROW(eavlException,"A refused allocation was still charged.");
+
+        cout << "\n\n-- summary of data set result --\n";	
+        data->PrintSummary(cout);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <infile.vtk>\n";
+        return 1;
+    }
+
+
+    return 0;
+}
@@ -11,8 +11,11 @@
 
 #include "eavlExternalFaceMutator.h"
 #include "eavlSurfaceNormalMutator.h"
+#include "eavlRecenterMutator.h"
 #include "eavlExecutor.h"
 
+#include <cstring>
+
 
 eavlDataSet *ReadWholeFile(const string &filename)
 {
@@ -48,14 +51,31 @@ int main(int argc, char *argv[])
         eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
         eavlInitializeGPU();
 
-        if (argc != 2 && argc != 3)
+        // a leading option asks for point normals with the given weighting
+        bool pointnormals = false;
+        eavlSurfaceNormalMutator::PointWeighting weighting =
+            eavlSurfaceNormalMutator::AreaWeighted;
+        int arg = 1;
+        if (argc > 1 && strcmp(argv[1], "--area") == 0)
+        {
+            pointnormals = true;
+            ++arg;
+        }
+        else if (argc > 1 && strcmp(argv[1], "--angle") == 0)
+        {
+            pointnormals = true;
+            weighting = eavlSurfaceNormalMutator::AngleWeighted;
+            ++arg;
+        }
+
+        if (argc - arg != 1 && argc - arg != 2)
             THROW(eavlException,"Incorrect number of arguments");
 
         // Read the input
-        eavlDataSet *data = ReadWholeFile(argv[1]);
+        eavlDataSet *data = ReadWholeFile(argv[arg]);
 
         int cellsetindex = -1;
-        for (size_t i=0; i<data->GetNumCellSets(); i++)
+        for (int i=0; i<data->GetNumCellSets(); i++)
         {
             if (data->GetCellSet(i)->GetDimensionality() == 2)
             {
@@ -70,7 +90,7 @@ int main(int argc, char *argv[])
         {
             cerr << "Couldn't find a 2D cell set.  Trying to add external faces to a 3D set.\n";
             int cellsetindex3d = -1;
-            for (size_t i=0; i<data->GetNumCellSets(); i++)
+            for (int i=0; i<data->GetNumCellSets(); i++)
             {
                 if (data->GetCellSet(i)->GetDimensionality() == 3)
                 {
@@ -82,11 +102,10 @@ int main(int argc, char *argv[])
             if (cellsetindex3d < 0)
                 THROW(eavlException,"Couldn't find a 3D set to add faces, to either.  Aborting.");
 
-            eavlExternalFaceMutator *extface = new eavlExternalFaceMutator;
-            extface->SetDataSet(data);
-            extface->SetCellSet(data->GetCellSet(cellsetindex3d)->GetName());
-            extface->Execute();
-            delete extface;
+            eavlExternalFaceMutator extface;
+            extface.SetDataSet(data);
+            extface.SetCellSet(data->GetCellSet(cellsetindex3d)->GetName());
+            extface.Execute();
             cellsetindex = data->GetNumCellSets() - 1;
         }
 
@@ -96,12 +115,55 @@ int main(int argc, char *argv[])
         eavlSurfaceNormalMutator *surfnorm = new eavlSurfaceNormalMutator;
         surfnorm->SetDataSet(data);
         surfnorm->SetCellSet(data->GetCellSet(cellsetindex)->GetName());
+        surfnorm->SetPointNormals(pointnormals, weighting);
         surfnorm->Execute();
 
-        if (argc == 3)
+        if (pointnormals)
+        {
+            // each point normal must be a unit vector on the same side as
+            // the average of the normals of the cells around it
+            eavlSurfaceNormalMutator cellnorm;
+            cellnorm.SetDataSet(data);
+            cellnorm.SetCellSet(data->GetCellSet(cellsetindex)->GetName());
+            cellnorm.Execute();
+            eavlRecenterMutator recenter;
+            recenter.SetDataSet(data);
+            recenter.SetField("surface_normals");
+            recenter.SetResultName("recentered_surface_normals");
+            recenter.Execute();
+
+            eavlArray *pn = data->GetField("nodecentered_surface_normals")->GetArray();
+            eavlArray *cn = data->GetField("recentered_surface_normals")->GetArray();
+            vector<bool> used(data->GetNumPoints(), false);
+            eavlCellSet *cells = data->GetCellSet(cellsetindex);
+            for (int i=0; i<cells->GetNumCells(); i++)
+            {
+                eavlCell cell = cells->GetCellNodes(i);
+                for (int j=0; j<cell.numIndices; j++)
+                    used[cell.indices[j]] = true;
+            }
+            for (int i=0; i<data->GetNumPoints(); i++)
+            {
+                if (!used[i])
+                    continue;
+                double len = 0, dot = 0;
+                for (int d=0; d<3; d++)
+                {
+                    double n = pn->GetComponentAsDouble(i,d);
+                    len += n * n;
+                    dot += n * cn->GetComponentAsDouble(i,d);
+                }
+                if (fabs(sqrt(len) - 1) > 1.e-3)
+                    THROW(eavlException,"Point normal isn't a unit vector.");
+                if (dot <= 0)
+                    THROW(eavlException,"Point normal points away from its cells.");
+            }
+        }
+
+        if (argc - arg == 2)
         {
             cerr << "\n\n-- done with surface normal, writing to file --\n";	
-            WriteToVTKFile(data, argv[2], cellsetindex);
+            WriteToVTKFile(data, argv[arg+1], cellsetindex);
         }
         else
         {
@@ -115,7 +177,7 @@ int main(int argc, char *argv[])
     catch (const eavlException &e)
     {
         cerr << e.GetErrorText() << endl;
-        cerr << "\nUsage: "<<argv[0]<<" <infile.vtk> [<outfile.vtk>]\n";
+        cerr << "\nUsage: "<<argv[0]<<" [--area|--angle] <infile.vtk> [<outfile.vtk>]\n";
         return 1;
     }
 
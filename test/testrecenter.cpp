@@ -0,0 +1,206 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlShapeFunctions.h"
+#include "eavlRecenterMutator.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 2 && argc != 3)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        // Read the input
+        eavlDataSet *data = ReadWholeFile(argv[1]);
+
+        // use the first 3D cell set, or else the first 2D one
+        int cellsetindex = -1;
+        for (int dim = 3; dim >= 2 && cellsetindex < 0; dim--)
+        {
+            for (int i=0; i<data->GetNumCellSets(); i++)
+            {
+                if (data->GetCellSet(i)->GetDimensionality() == dim)
+                {
+                    cellsetindex = i;
+                    cerr << "Found " << dim << "D topo dim cell set name '"
+                         << data->GetCellSet(i)->GetName()
+                         << "' index " << cellsetindex << endl;
+                    break;
+                }
+            }
+        }
+        if (cellsetindex < 0)
+            THROW(eavlException,"Couldn't find a 2D or 3D cell set.  Aborting.");
+        eavlCellSet *cells = data->GetCellSet(cellsetindex);
+        int ncells = cells->GetNumCells();
+        int npts = data->GetNumPoints();
+
+        // multi-component fields in both directions
+        eavlFloatArray *tensor = new eavlFloatArray("tensor", 9, ncells);
+        for (int i=0; i<ncells; i++)
+            for (int c=0; c<9; c++)
+                tensor->SetComponentFromDouble(i, c, sin(i*0.3 + c) + c);
+        data->AddField(new eavlField(0, tensor, eavlField::ASSOC_CELL_SET,
+                                     cellsetindex));
+        eavlFloatArray *ptensor = new eavlFloatArray("ptensor", 6, npts);
+        for (int i=0; i<npts; i++)
+            for (int c=0; c<6; c++)
+                ptensor->SetComponentFromDouble(i, c, cos(i*0.7 + c) * c);
+        data->AddField(new eavlField(1, ptensor, eavlField::ASSOC_POINTS));
+
+        // cell measures, and each point's share of them, for the weights
+        vector<double> measure(ncells);
+        vector<double> share(npts, 0.);
+        for (int i=0; i<ncells; i++)
+        {
+            eavlCell cell = cells->GetCellNodes(i);
+            double pts[3*12];
+            for (int n=0; n<cell.numIndices; n++)
+                for (int d=0; d<3; d++)
+                    pts[3*n+d] = data->GetPoint(cell.indices[n], d);
+            measure[i] = eavlCellMeasure(cell.type, cell.numIndices, pts);
+            for (int n=0; n<cell.numIndices; n++)
+                share[cell.indices[n]] += measure[i] / cell.numIndices;
+        }
+
+        for (int weighted=0; weighted<2; weighted++)
+        {
+            string tname = weighted ? "tensor_weighted" : "tensor_nodal";
+            string pname = weighted ? "ptensor_weighted" : "ptensor_zonal";
+
+            eavlRecenterMutator tocells;
+            tocells.SetDataSet(data);
+            tocells.SetField("ptensor");
+            tocells.SetCellSet(cells->GetName());
+            tocells.SetVolumeWeighted(weighted);
+            tocells.SetResultName(pname);
+            tocells.Execute();
+
+            eavlRecenterMutator topoints;
+            topoints.SetDataSet(data);
+            topoints.SetField("tensor");
+            topoints.SetVolumeWeighted(weighted);
+            topoints.SetResultName(tname);
+            topoints.Execute();
+
+            // cell to point: the (weighted) mean over the cells at a point
+            vector<double> sum(npts*9, 0.), wsum(npts, 0.);
+            for (int i=0; i<ncells; i++)
+            {
+                eavlCell cell = cells->GetCellNodes(i);
+                double w = weighted ? measure[i] : 1.;
+                for (int n=0; n<cell.numIndices; n++)
+                {
+                    wsum[cell.indices[n]] += w;
+                    for (int c=0; c<9; c++)
+                        sum[cell.indices[n]*9 + c] +=
+                            w * tensor->GetComponentAsDouble(i, c);
+                }
+            }
+            eavlArray *result = data->GetField(tname)->GetArray();
+            if (result->GetNumberOfComponents() != 9)
+                THROW(eavlException,"Recentered field lost its components.");
+            for (int i=0; i<npts; i++)
+            {
+                if (wsum[i] == 0)
+                    continue;
+                for (int c=0; c<9; c++)
+                {
+                    double ref = sum[i*9 + c] / wsum[i];
+                    double v = result->GetComponentAsDouble(i, c);
+                    if (fabs(v - ref) > 1.e-4 * (1 + fabs(ref)))
+                        THROW(eavlException,"Wrong value recentering to points.");
+                }
+            }
+
+            // point to cell: the (weighted) mean over the cell's points
+            result = data->GetField(pname)->GetArray();
+            if (result->GetNumberOfComponents() != 6)
+                THROW(eavlException,"Recentered field lost its components.");
+            for (int i=0; i<ncells; i++)
+            {
+                eavlCell cell = cells->GetCellNodes(i);
+                for (int c=0; c<6; c++)
+                {
+                    double s = 0, sw = 0;
+                    for (int n=0; n<cell.numIndices; n++)
+                    {
+                        double w = weighted ? share[cell.indices[n]] : 1.;
+                        s += w * ptensor->GetComponentAsDouble(cell.indices[n], c);
+                        sw += w;
+                    }
+                    double ref = s / sw;
+                    double v = result->GetComponentAsDouble(i, c);
+                    if (fabs(v - ref) > 1.e-4 * (1 + fabs(ref)))
+                        THROW(eavlException,"Wrong value recentering to cells.");
+                }
+            }
+            cout << (weighted ? "volume weighted" : "unweighted")
+                 << " recentering matches" << endl;
+        }
+
+        if (argc == 3)
+        {
+            cerr << "\n\n-- done with recentering, writing to file --\n";	
+            WriteToVTKFile(data, argv[2], cellsetindex);
+        }
+        else
+        {
+            cerr << "No output filename given; not writing result\n";
+        }
+
+
+        cout << "\n\n-- summary of data set result --\n";	
+        data->PrintSummary(cout);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <infile.vtk> [<outfile.vtk>]\n";
+        return 1;
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlResampleFilter.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 3 && argc != 4)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        int nsamples = atoi(argv[1]);
+        if (nsamples < 2)
+            THROW(eavlException,"Expected at least 2 samples per axis");
+
+        // Read the input
+        eavlDataSet *data = ReadWholeFile(argv[2]);
+
+        // use the first 3D cell set, or else the first 2D one
+        int cellsetindex = -1;
+        for (int dim = 3; dim >= 2 && cellsetindex < 0; dim--)
+        {
+            for (int i=0; i<data->GetNumCellSets(); i++)
+            {
+                if (data->GetCellSet(i)->GetDimensionality() == dim)
+                {
+                    cellsetindex = i;
+                    cerr << "Found " << dim << "D topo dim cell set name '"
+                         << data->GetCellSet(i)->GetName()
+                         << "' index " << cellsetindex << endl;
+                    break;
+                }
+            }
+        }
+        if (cellsetindex < 0)
+            THROW(eavlException,"Couldn't find a 2D or 3D cell set.  Aborting.");
+
+        // sample the bounding box of the points, with a single sample
+        // along any flat axis
+        if (data->GetNumPoints() == 0)
+            THROW(eavlException,"No points to resample.");
+        double lo[3], hi[3];
+        for (int d=0; d<3; d++)
+            lo[d] = hi[d] = data->GetPoint(0, d);
+        for (int i=1; i<data->GetNumPoints(); i++)
+        {
+            for (int d=0; d<3; d++)
+            {
+                double v = data->GetPoint(i, d);
+                lo[d] = (v < lo[d]) ? v : lo[d];
+                hi[d] = (v > hi[d]) ? v : hi[d];
+            }
+        }
+        int dims[3];
+        double origin[3], spacing[3];
+        for (int d=0; d<3; d++)
+        {
+            dims[d] = (hi[d] > lo[d]) ? nsamples : 1;
+            origin[d] = lo[d];
+            spacing[d] = (dims[d] > 1) ? (hi[d] - lo[d]) / (dims[d] - 1) : 1;
+        }
+        eavlRegularStructure reg;
+        if (dims[2] == 1)
+            reg.SetNodeDimension2D(dims[0], dims[1]);
+        else
+            reg.SetNodeDimension3D(dims[0], dims[1], dims[2]);
+
+        eavlResampleFilter *resample = new eavlResampleFilter;
+        resample->SetInput(data);
+        resample->SetCellSet(data->GetCellSet(cellsetindex)->GetName());
+        resample->SetSampleGrid(reg, origin, spacing);
+        resample->Execute();
+
+        if (argc == 4)
+        {
+            cerr << "\n\n-- done with resample, writing to file --\n";	
+            WriteToVTKFile(resample->GetOutput(), argv[3], 0);
+        }
+        else
+        {
+            cerr << "No output filename given; not writing result\n";
+        }
+
+
+        // the summary only shows the corners, which are often outside,
+        // so also give the range of each field over the valid samples
+        eavlDataSet *result = resample->GetOutput();
+        eavlArray *mask = result->GetField("valid_point_mask")->GetArray();
+        int nvalid = 0;
+        for (int i=0; i<result->GetNumPoints(); i++)
+            nvalid += mask->GetComponentAsDouble(i,0) ? 1 : 0;
+        cout << "valid samples: " << nvalid << " of "
+             << result->GetNumPoints() << endl;
+        for (int f=0; f<result->GetNumFields(); f++)
+        {
+            eavlArray *a = result->GetField(f)->GetArray();
+            if (a == mask)
+                continue;
+            for (int c=0; c<a->GetNumberOfComponents(); c++)
+            {
+                double vmin = 0, vmax = 0;
+                bool first = true;
+                for (int i=0; i<result->GetNumPoints(); i++)
+                {
+                    if (!mask->GetComponentAsDouble(i,0))
+                        continue;
+                    double v = a->GetComponentAsDouble(i,c);
+                    vmin = (first || v < vmin) ? v : vmin;
+                    vmax = (first || v > vmax) ? v : vmax;
+                    first = false;
+                }
+                cout << a->GetName() << " component " << c
+                     << " range over valid samples: "
+                     << vmin << " to " << vmax << endl;
+            }
+        }
+
+        cout << "\n\n-- summary of data set result --\n";	
+        result->PrintSummary(cout);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <samples per axis> <infile.vtk> [<outfile.vtk>]\n";
+        return 1;
+    }
+
+
+    return 0;
+}
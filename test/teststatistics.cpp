@@ -0,0 +1,251 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlStatistics.h"
+#include "eavlStatisticsMutator.h"
+#include "eavlGhostCells.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+// ----------------------------------------------------------------------------
+static void
+Check(const string &what, double value, double expected, double tolerance)
+{
+    if (fabs(value - expected) > tolerance * (1 + fabs(expected)))
+        THROW(eavlException,what + " differs from the direct computation.");
+}
+
+// Moments computed directly, in two passes.
+static void
+CheckMoments(const string &label, const eavlStatistics &s,
+             const vector<double> &v)
+{
+    double n = v.size();
+    double mean = 0;
+    for (size_t i=0; i<v.size(); i++)
+        mean += v[i];
+    mean /= n;
+    double s2 = 0, s3 = 0, s4 = 0;
+    for (size_t i=0; i<v.size(); i++)
+    {
+        double d = v[i] - mean;
+        s2 += d*d;
+        s3 += d*d*d;
+        s4 += d*d*d*d;
+    }
+    if (s.GetCount() != n)
+        THROW(eavlException,label + ": wrong count.");
+    Check(label + ": mean", s.GetMean(), mean, 1.e-9);
+    Check(label + ": variance", s.GetVariance(), s2 / (n-1), 1.e-9);
+    if (s2 > 0)
+    {
+        Check(label + ": skewness", s.GetSkewness(), sqrt(n) * s3 / pow(s2, 1.5), 1.e-6);
+        Check(label + ": kurtosis", s.GetKurtosis(), n * s4 / (s2*s2) - 3, 1.e-6);
+    }
+}
+
+// An estimated quantile must have about the requested fraction of the
+// values below it.
+static void
+CheckQuantiles(const string &label, const eavlStatistics &s,
+               const vector<double> &v, double tolerance)
+{
+    vector<double> sorted(v);
+    std::sort(sorted.begin(), sorted.end());
+    if (s.GetMin() != sorted.front() || s.GetMax() != sorted.back())
+        THROW(eavlException,label + ": wrong min or max.");
+    double n = sorted.size();
+    for (int i=1; i<20; i++)
+    {
+        double q = i / 20.;
+        double e = s.GetQuantile(q);
+        double below = (std::lower_bound(sorted.begin(), sorted.end(), e) -
+                        sorted.begin()) / n;
+        double atorbelow = (std::upper_bound(sorted.begin(), sorted.end(), e) -
+                            sorted.begin()) / n;
+        if (below > q + tolerance || atorbelow < q - tolerance)
+            THROW(eavlException,label + ": quantile out of tolerance.");
+    }
+}
+
+static void
+PrintStatistics(const string &label, const eavlStatistics &s)
+{
+    cout << label << ": count " << s.GetCount()
+         << " min " << s.GetMin() << " max " << s.GetMax()
+         << " mean " << s.GetMean() << " variance " << s.GetVariance()
+         << " skewness " << s.GetSkewness() << " kurtosis " << s.GetKurtosis()
+         << endl;
+    cout << "   quartiles " << s.GetQuantile(0.25) << " "
+         << s.GetQuantile(0.5) << " " << s.GetQuantile(0.75) << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 3)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        string fieldname = argv[1];
+        eavlDataSet *data = ReadWholeFile(argv[2]);
+        eavlArray *array = data->GetField(fieldname)->GetArray();
+        vector<double> values;
+        for (int i=0; i<array->GetNumberOfTuples(); i++)
+            values.push_back(array->GetComponentAsDouble(i,0));
+        if (values.size() < 3)
+            THROW(eavlException,"Expected at least three values.");
+        cout.precision(6);
+
+        // the mutator's summary of the field
+        eavlStatisticsMutator *statsmutator = new eavlStatisticsMutator;
+        statsmutator->SetDataSet(data);
+        statsmutator->SetField(fieldname);
+        statsmutator->Execute();
+        const eavlStatistics &stats = statsmutator->GetStatistics();
+        CheckMoments(fieldname, stats, values);
+        CheckQuantiles(fieldname, stats, values, 0.02);
+        eavlArray *moments = data->GetField(fieldname + "_statistics")->GetArray();
+        double expected[] = {stats.GetCount(), stats.GetMin(), stats.GetMax(),
+                             stats.GetMean(), stats.GetVariance(),
+                             stats.GetSkewness(), stats.GetKurtosis()};
+        for (int c=0; c<7; c++)
+            Check(fieldname + "_statistics", moments->GetComponentAsDouble(0,c),
+                  expected[c], 1.e-6);
+        eavlArray *quantiles = data->GetField(fieldname + "_quantiles")->GetArray();
+        if (quantiles->GetNumberOfTuples() != 5)
+            THROW(eavlException,"Wrong number of quantiles.");
+        PrintStatistics(fieldname, stats);
+
+        // summaries of three uneven pieces, one sent through its state,
+        // must merge into the summary of the whole
+        int n = values.size();
+        eavlStatistics pieces[3];
+        for (int i=0; i<n; i++)
+            pieces[i == 0 ? 0 : (i < n*2/3 ? 1 : 2)].Add(values[i]);
+        vector<double> state;
+        pieces[1].GetState(state);
+        eavlStatistics sent, merged;
+        sent.SetState(state);
+        merged.Merge(pieces[0]);
+        merged.Merge(sent);
+        merged.Merge(pieces[2]);
+        merged.Merge(eavlStatistics());
+        CheckMoments("merged", merged, values);
+        CheckQuantiles("merged", merged, values, 0.02);
+
+        bool rejected = false;
+        try
+        {
+            state.pop_back();
+            sent.SetState(state);
+        }
+        catch (const eavlException &)
+        {
+            rejected = true;
+        }
+        if (!rejected)
+            THROW(eavlException,"Truncated state was accepted.");
+
+        // ghost cells are left out of statistics of cell fields
+        eavlField *field = data->GetField(fieldname);
+        if (field->GetAssociation() == eavlField::ASSOC_CELL_SET)
+        {
+            eavlByteArray *ghost = new eavlByteArray(EAVL_GHOST_FIELD_NAME, 1, n);
+            vector<double> owned;
+            for (int i=0; i<n; i++)
+            {
+                ghost->SetValue(i, i % 3 == 0);
+                if (i % 3 != 0)
+                    owned.push_back(values[i]);
+            }
+            data->AddField(new eavlField(0, ghost, eavlField::ASSOC_CELL_SET,
+                                         field->GetAssocCellSet()));
+            eavlStatisticsMutator *ownedmutator = new eavlStatisticsMutator;
+            ownedmutator->SetDataSet(data);
+            ownedmutator->SetField(fieldname);
+            ownedmutator->SetResultPrefix("owned");
+            ownedmutator->Execute();
+            CheckMoments("owned", ownedmutator->GetStatistics(), owned);
+            PrintStatistics("owned", ownedmutator->GetStatistics());
+        }
+
+        // a long skewed stream spanning several blocks of the mutator
+        int nstream = 200000;
+        eavlDataSet *streamdata = new eavlDataSet;
+        streamdata->SetNumPoints(nstream);
+        eavlFloatArray *streamarray = new eavlFloatArray("stream", 1, nstream);
+        vector<double> stream;
+        unsigned int seed = 12345;
+        for (int i=0; i<nstream; i++)
+        {
+            double normal = -6;
+            for (int k=0; k<12; k++)
+            {
+                seed = seed * 1103515245 + 12345;
+                normal += ((seed >> 8) & 0xffff) / 65536.;
+            }
+            float x = 100 + exp(normal);
+            streamarray->SetValue(i, x);
+            stream.push_back(x);
+        }
+        streamdata->AddField(new eavlField(1, streamarray, eavlField::ASSOC_POINTS));
+        eavlStatisticsMutator *streammutator = new eavlStatisticsMutator;
+        streammutator->SetDataSet(streamdata);
+        streammutator->SetField("stream");
+        streammutator->Execute();
+        CheckMoments("stream", streammutator->GetStatistics(), stream);
+        CheckQuantiles("stream", streammutator->GetStatistics(), stream, 0.005);
+        PrintStatistics("stream", streammutator->GetStatistics());
+
+        cout << "\n\n-- summary of data set result --\n";	
+        data->PrintSummary(cout);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <fieldname> <infile.vtk>\n";
+        return 1;
+    }
+
+
+    return 0;
+}
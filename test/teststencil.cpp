@@ -0,0 +1,194 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlLogicalStructureRegular.h"
+#include "eavlNodeStencilMutator.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+static inline int
+Clamp(int i, int hi)
+{
+    return (i < 0) ? 0 : ((i > hi) ? hi : i);
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 2 && argc != 3)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        // Read the input
+        eavlDataSet *data = ReadWholeFile(argv[1]);
+
+        eavlLogicalStructureRegular *log =
+            dynamic_cast<eavlLogicalStructureRegular*>(data->GetLogicalStructure());
+        if (!log)
+            THROW(eavlException,"Expected a structured grid.");
+        eavlRegularStructure &reg = log->GetRegularStructure();
+        int ndims = reg.dimension;
+        int dims[3] = {1, 1, 1};
+        for (int d=0; d<ndims; d++)
+            dims[d] = reg.nodeDims[d];
+
+        // a rough two-component field
+        int npts = data->GetNumPoints();
+        eavlFloatArray *f = new eavlFloatArray("f", 2, npts);
+        for (int i=0; i<npts; i++)
+        {
+            f->SetComponentFromDouble(i, 0, (i * 37) % 101);
+            f->SetComponentFromDouble(i, 1, (i % 7) * 0.5);
+        }
+        data->AddField(new eavlField(1, f, eavlField::ASSOC_POINTS));
+
+        const char *typenames[3] = {"box", "smooth", "laplacian"};
+        for (int t=0; t<3; t++)
+        {
+            for (int radius=1; radius<=3; radius++)
+            {
+                if (t == eavlNodeStencilMutator::Laplacian && radius > 1)
+                    continue;
+                char name[64];
+                sprintf(name, "%s%d", typenames[t], radius);
+                eavlNodeStencilMutator stencil;
+                stencil.SetDataSet(data);
+                stencil.SetField("f");
+                stencil.SetType(eavlNodeStencilMutator::StencilType(t));
+                stencil.SetRadius(radius);
+                stencil.SetResultName(name);
+                stencil.Execute();
+                eavlArray *result = data->GetField(name)->GetArray();
+
+                // the 1D weights of the separable stencils
+                int width = 2*radius + 1;
+                double w1[7];
+                double sum = 0, binom = 1;
+                for (int i=0; i<width; i++)
+                {
+                    w1[i] = (t == eavlNodeStencilMutator::Box) ? 1. : binom;
+                    binom = binom * (width-1-i) / (i+1);
+                    sum += w1[i];
+                }
+                for (int i=0; i<width; i++)
+                    w1[i] /= sum;
+
+                // apply the full stencil directly, clamping at the edges
+                for (int k=0; k<dims[2]; k++)
+                for (int j=0; j<dims[1]; j++)
+                for (int i=0; i<dims[0]; i++)
+                for (int c=0; c<2; c++)
+                {
+                    double ref = 0;
+                    for (int dk=-radius; dk<=radius; dk++)
+                    for (int dj=-radius; dj<=radius; dj++)
+                    for (int di=-radius; di<=radius; di++)
+                    {
+                        if ((ndims < 3 && dk) || (ndims < 2 && dj))
+                            continue;
+                        double w;
+                        if (t == eavlNodeStencilMutator::Laplacian)
+                        {
+                            int off = (di!=0) + (dj!=0) + (dk!=0);
+                            w = (off == 0) ? -2.*ndims : (off == 1 ? 1. : 0.);
+                        }
+                        else
+                        {
+                            w = w1[di+radius] *
+                                (ndims > 1 ? w1[dj+radius] : 1.) *
+                                (ndims > 2 ? w1[dk+radius] : 1.);
+                        }
+                        int si = Clamp(i+di, dims[0]-1);
+                        int sj = Clamp(j+dj, dims[1]-1);
+                        int sk = Clamp(k+dk, dims[2]-1);
+                        ref += w * f->GetComponentAsDouble(
+                                        (sk*dims[1] + sj)*dims[0] + si, c);
+                    }
+                    double v = result->GetComponentAsDouble(
+                                        (k*dims[1] + j)*dims[0] + i, c);
+                    if (fabs(v - ref) > 1.e-3 * (1 + fabs(ref)))
+                        THROW(eavlException,string("Wrong value from ") + name);
+                }
+                cout << name << " matches" << endl;
+            }
+        }
+
+        // only radii up to 3 are supported
+        bool rejected = false;
+        try
+        {
+            eavlNodeStencilMutator bad;
+            bad.SetDataSet(data);
+            bad.SetField("f");
+            bad.SetRadius(4);
+            bad.Execute();
+        }
+        catch (const eavlException &)
+        {
+            rejected = true;
+        }
+        if (!rejected)
+            THROW(eavlException,"Accepted a stencil radius of 4.");
+
+        if (argc == 3)
+        {
+            cerr << "\n\n-- done with stencils, writing to file --\n";	
+            WriteToVTKFile(data, argv[2], 0);
+        }
+        else
+        {
+            cerr << "No output filename given; not writing result\n";
+        }
+
+
+        cout << "\n\n-- summary of data set result --\n";	
+        data->PrintSummary(cout);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <infile.vtk> [<outfile.vtk>]\n";
+        return 1;
+    }
+
+
+    return 0;
+}
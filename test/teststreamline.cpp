@@ -0,0 +1,209 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlStreamlineFilter.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 2 && argc != 3)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        // Read the input
+        eavlDataSet *data = ReadWholeFile(argv[1]);
+
+        // use the first 3D cell set, or else the first 2D one
+        int cellsetindex = -1;
+        for (int dim = 3; dim >= 2 && cellsetindex < 0; dim--)
+        {
+            for (int i=0; i<data->GetNumCellSets(); i++)
+            {
+                if (data->GetCellSet(i)->GetDimensionality() == dim)
+                {
+                    cellsetindex = i;
+                    cerr << "Found " << dim << "D topo dim cell set name '"
+                         << data->GetCellSet(i)->GetName()
+                         << "' index " << cellsetindex << endl;
+                    break;
+                }
+            }
+        }
+        if (cellsetindex < 0)
+            THROW(eavlException,"Couldn't find a 2D or 3D cell set.  Aborting.");
+        string cellsetname = data->GetCellSet(cellsetindex)->GetName();
+
+        double lo[3], hi[3];
+        for (int d=0; d<3; d++)
+            lo[d] = hi[d] = data->GetPoint(0, d);
+        for (int i=1; i<data->GetNumPoints(); i++)
+        {
+            for (int d=0; d<3; d++)
+            {
+                double v = data->GetPoint(i, d);
+                lo[d] = (v < lo[d]) ? v : lo[d];
+                hi[d] = (v > hi[d]) ? v : hi[d];
+            }
+        }
+        double center[3];
+        for (int d=0; d<3; d++)
+            center[d] = (lo[d] + hi[d]) / 2;
+
+        // a rigid rotation about the center, and a constant flow along X
+        int npts = data->GetNumPoints();
+        eavlFloatArray *rotation = new eavlFloatArray("rotation", 3, npts);
+        eavlFloatArray *constant = new eavlFloatArray("constant", 3, npts);
+        for (int i=0; i<npts; i++)
+        {
+            rotation->SetComponentFromDouble(i, 0, -(data->GetPoint(i,1) - center[1]));
+            rotation->SetComponentFromDouble(i, 1, data->GetPoint(i,0) - center[0]);
+            rotation->SetComponentFromDouble(i, 2, 0.);
+            constant->SetComponentFromDouble(i, 0, 1.);
+            constant->SetComponentFromDouble(i, 1, 0.5);
+            constant->SetComponentFromDouble(i, 2, 0.);
+        }
+        data->AddField(new eavlField(1, rotation, eavlField::ASSOC_POINTS));
+        data->AddField(new eavlField(1, constant, eavlField::ASSOC_POINTS));
+
+        // seeds on the +X axis go around circles once, with the angle
+        // matching the time, in a full turn forward and backward
+        int nseeds = 5;
+        double radius = 0.3 * (hi[0] - lo[0]);
+        double p0[3] = {center[0] + 0.1*radius, center[1], center[2]};
+        double p1[3] = {center[0] + radius, center[1], center[2]};
+        eavlStreamlineFilter *stream = new eavlStreamlineFilter;
+        stream->SetInput(data);
+        stream->SetCellSet(cellsetname);
+        stream->SetField("rotation");
+        stream->AddSeedLine(p0, p1, nseeds);
+        stream->SetMaxTime(M_PI);
+        stream->SetMaxSteps(100000);
+        stream->SetDirection(eavlStreamlineFilter::Both);
+        stream->Execute();
+
+        eavlDataSet *result = stream->GetOutput();
+        eavlArray *time = result->GetField("time")->GetArray();
+        eavlArray *speed = result->GetField("speed")->GetArray();
+        eavlArray *seed = result->GetField("seed_id")->GetArray();
+        double tmin = 0, tmax = 0;
+        for (int i=0; i<result->GetNumPoints(); i++)
+        {
+            double x = result->GetPoint(i,0) - center[0];
+            double y = result->GetPoint(i,1) - center[1];
+            double r = sqrt(x*x + y*y);
+            int s = int(seed->GetComponentAsDouble(i,0));
+            double r0 = p0[0] - center[0] + (p1[0] - p0[0]) * s / (nseeds-1.);
+            double t = time->GetComponentAsDouble(i,0);
+            tmin = (t < tmin) ? t : tmin;
+            tmax = (t > tmax) ? t : tmax;
+            if (fabs(r - r0) > 1.e-3 * r0)
+                THROW(eavlException,"Streamline left its circle.");
+            if (fabs(remainder(atan2(y, x) - t, 2*M_PI)) > 1.e-3)
+                THROW(eavlException,"Streamline angle doesn't match its time.");
+            if (fabs(speed->GetComponentAsDouble(i,0) - r) > 1.e-3 * r0)
+                THROW(eavlException,"Wrong streamline speed.");
+        }
+        if (fabs(tmin + M_PI) > 1.e-6 || fabs(tmax - M_PI) > 1.e-6)
+            THROW(eavlException,"Streamlines didn't run for their full time.");
+        cout << "rotation: " << result->GetNumPoints() << " points on "
+             << nseeds << " circles" << endl;
+
+        // a constant flow from the center leaves the cell set
+        eavlStreamlineFilter exit;
+        exit.SetInput(data);
+        exit.SetCellSet(cellsetname);
+        exit.SetField("constant");
+        exit.AddSeedPoint(center[0], center[1], center[2]);
+        exit.Execute();
+        eavlDataSet *exitresult = exit.GetOutput();
+        int nexit = exitresult->GetNumPoints();
+        if (nexit < 2)
+            THROW(eavlException,"Constant flow streamline didn't move.");
+        double lastx = exitresult->GetPoint(nexit-1, 0);
+        double lasty = exitresult->GetPoint(nexit-1, 1);
+        if (lastx < center[0] + 0.25*(hi[0]-lo[0]) ||
+            lasty < center[1] + 0.125*(hi[0]-lo[0]))
+            THROW(eavlException,"Constant flow streamline stopped early.");
+        cout << "constant flow: " << nexit << " points" << endl;
+
+        // there must be seeds
+        bool rejected = false;
+        try
+        {
+            eavlStreamlineFilter bad;
+            bad.SetInput(data);
+            bad.SetCellSet(cellsetname);
+            bad.SetField("rotation");
+            bad.Execute();
+        }
+        catch (const eavlException &)
+        {
+            rejected = true;
+        }
+        if (!rejected)
+            THROW(eavlException,"Traced streamlines without seeds.");
+
+        if (argc == 3)
+        {
+            cerr << "\n\n-- done with streamlines, writing to file --\n";	
+            WriteToVTKFile(result, argv[2], 0);
+        }
+        else
+        {
+            cerr << "No output filename given; not writing result\n";
+        }
+
+
+        cout << "\n\n-- summary of data set result --\n";	
+        result->PrintSummary(cout);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <infile.vtk> [<outfile.vtk>]\n";
+        return 1;
+    }
+
+
+    return 0;
+}
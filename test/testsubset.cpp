@@ -0,0 +1,201 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlCellSetSubset.h"
+#include "eavlTopologyMapOp_1_0_1.h"
+#include "eavlTopologyMapOp_3_0_3.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+struct SubsetAverageFunctor
+{
+    EAVL_FUNCTOR float operator()(int shapeType, int n, float vals[])
+    {
+        float sum = 0;
+        for (int i=0; i<n; i++)
+            sum += vals[i];
+        return (n > 0) ? sum / float(n) : 0;
+    }
+};
+
+struct SubsetCenterFunctor
+{
+    EAVL_FUNCTOR void operator()(int shapeType, int n,
+                                 float x[], float y[], float z[],
+                                 float &cx, float &cy, float &cz)
+    {
+        cx = cy = cz = 0;
+        for (int i=0; i<n; i++)
+        {
+            cx += x[i];
+            cy += y[i];
+            cz += z[i];
+        }
+        if (n > 0)
+        {
+            cx /= float(n);
+            cy /= float(n);
+            cz /= float(n);
+        }
+    }
+};
+
+// average the point field over, and find the center of, every cell
+void MapToCells(eavlCellSet *cells, eavlArray *values, eavlArray *xyz,
+                eavlFloatArray *avg, eavlFloatArray *center)
+{
+    eavlExecutor::AddOperation(new eavlTopologyMapOp_1_0_1<SubsetAverageFunctor>(
+                                   cells, EAVL_NODES_OF_CELLS,
+                                   eavlArrayWithLinearIndex(values, 0),
+                                   eavlArrayWithLinearIndex(avg, 0),
+                                   SubsetAverageFunctor()),
+                               "average over cells");
+    eavlExecutor::AddOperation(new eavlTopologyMapOp_3_0_3<SubsetCenterFunctor>(
+                                   cells, EAVL_NODES_OF_CELLS,
+                                   eavlArrayWithLinearIndex(xyz, 0),
+                                   eavlArrayWithLinearIndex(xyz, 1),
+                                   eavlArrayWithLinearIndex(xyz, 2),
+                                   eavlArrayWithLinearIndex(center, 0),
+                                   eavlArrayWithLinearIndex(center, 1),
+                                   eavlArrayWithLinearIndex(center, 2),
+                                   SubsetCenterFunctor()),
+                               "cell centers");
+    eavlExecutor::Go();
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 3)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        const char *fieldname = argv[1];
+
+        // Read the input
+        eavlDataSet *data = ReadWholeFile(argv[2]);
+        eavlCellSet *cells = data->GetCellSet(0);
+        int ncells = cells->GetNumCells();
+        int npts = data->GetNumPoints();
+
+        eavlField *field = data->GetField(fieldname);
+        if (field->GetAssociation() != eavlField::ASSOC_POINTS)
+            THROW(eavlException,"Expected a point field.");
+
+        eavlFloatArray *xyz = new eavlFloatArray("xyz", 3, npts);
+        for (int i=0; i<npts; i++)
+            for (int d=0; d<3; d++)
+                xyz->SetComponentFromDouble(i, d, data->GetPoint(i, d));
+
+        // the results on the whole cell set, to compare against
+        eavlFloatArray *fullavg = new eavlFloatArray("average", 1, ncells);
+        eavlFloatArray *fullcenter = new eavlFloatArray("center", 3, ncells);
+        MapToCells(cells, field->GetArray(), xyz, fullavg, fullcenter);
+
+        cout << "\n\n-- summary of subset results --\n";	
+        const char *selections[3] = {"middle half", "every third cell",
+                                     "every fifth cell, reversed"};
+        const char *storage[3] = {"RANGES", "BITMAP", "LIST"};
+        for (int sel=0; sel<3; sel++)
+        {
+            vector<int> ids;
+            if (sel == 0)
+            {
+                for (int i=ncells/4; i<ncells/4+ncells/2; i++)
+                    ids.push_back(i);
+            }
+            else if (sel == 1)
+            {
+                for (int i=0; i<ncells; i+=3)
+                    ids.push_back(i);
+            }
+            else
+            {
+                for (int i=((ncells-1)/5)*5; i>=0; i-=5)
+                    ids.push_back(i);
+            }
+
+            eavlCellSetSubset subset(cells);
+            subset.SetCells(ids);
+            int n = subset.GetNumCells();
+            if (n != (int)ids.size())
+                THROW(eavlException,"Subset has the wrong number of cells.");
+            for (int i=0; i<n; i++)
+            {
+                if (subset.GetParentIndex(i) != ids[i])
+                    THROW(eavlException,"Subset returned the wrong parent cell.");
+            }
+
+            eavlFloatArray *avg = new eavlFloatArray("average", 1, n);
+            eavlFloatArray *center = new eavlFloatArray("center", 3, n);
+            MapToCells(&subset, field->GetArray(), xyz, avg, center);
+            for (int i=0; i<n; i++)
+            {
+                bool same = (avg->GetValue(i) == fullavg->GetValue(ids[i]));
+                for (int d=0; d<3; d++)
+                    same = same && (center->GetComponentAsDouble(i,d) ==
+                                    fullcenter->GetComponentAsDouble(ids[i],d));
+                if (!same)
+                    THROW(eavlException,"Subset result differs from the whole cell set.");
+            }
+
+            cout << selections[sel] << ": "
+                 << n << " of " << ncells << " cells, stored as "
+                 << storage[subset.GetStorageType()] << endl;
+            cout << "    ";
+            avg->PrintSummary(cout);
+            cout << "    ";
+            center->PrintSummary(cout);
+
+            delete avg;
+            delete center;
+        }
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <fieldname> <infile.vtk>\n";
+        return 1;
+    }
+
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlTesselate2DFilter.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+// ----------------------------------------------------------------------------
+// total signed area of the 2D cells of a cell set projected onto the YZ,
+// ZX and XY planes; unlike the true area, this is exactly additive when
+// a cell that isn't planar is split up
+static void
+ProjectedArea(eavlDataSet *data, eavlCellSet *cells, double area[3])
+{
+    area[0] = area[1] = area[2] = 0;
+    for (int c=0; c<cells->GetNumCells(); c++)
+    {
+        eavlCell cell = cells->GetCellNodes(c);
+        int ring[4] = {0, 1, 2, 3};
+        if (cell.type == EAVL_PIXEL)
+        {
+            ring[2] = 3;
+            ring[3] = 2;
+        }
+        for (int i=0; i<cell.numIndices; i++)
+        {
+            int a = cell.indices[ring[i]];
+            int b = cell.indices[ring[(i+1) % cell.numIndices]];
+            for (int d=0; d<3; d++)
+            {
+                int d1 = (d+1) % 3, d2 = (d+2) % 3;
+                area[d] += 0.5 * (data->GetPoint(a,d1) * data->GetPoint(b,d2) -
+                                  data->GetPoint(b,d1) * data->GetPoint(a,d2));
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 2 && argc != 3)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        // Read the input
+        eavlDataSet *data = ReadWholeFile(argv[1]);
+
+        int cellsetindex = -1;
+        for (int i=0; i<data->GetNumCellSets(); i++)
+        {
+            if (data->GetCellSet(i)->GetDimensionality() == 2)
+            {
+                cellsetindex = i;
+                cerr << "Found 2D topo dim cell set name '"
+                     << data->GetCellSet(i)->GetName()
+                     << "' index " << cellsetindex << endl;
+                break;
+            }
+        }
+        if (cellsetindex < 0)
+            THROW(eavlException,"Couldn't find a 2D cell set.  Aborting.");
+        eavlCellSet *cells = data->GetCellSet(cellsetindex);
+
+        eavlTesselate2DFilter *tess = new eavlTesselate2DFilter;
+        tess->SetInput(data);
+        tess->SetCellSet(cells->GetName());
+        tess->Execute();
+        eavlDataSet *result = tess->GetOutput();
+
+        // each cell becomes one quad per edge, with a new point at its
+        // center and one at each edge midpoint, covering the same area
+        int nedges = 0;
+        for (int c=0; c<cells->GetNumCells(); c++)
+            nedges += cells->GetCellNodes(c).numIndices;
+        if (result->GetCellSet(0)->GetNumCells() != nedges)
+            THROW(eavlException,"Wrong number of tesselated cells.");
+        if (result->GetNumPoints() !=
+            data->GetNumPoints() + cells->GetNumCells() + nedges)
+            THROW(eavlException,"Wrong number of tesselated points.");
+        double inarea[3], outarea[3];
+        ProjectedArea(data, cells, inarea);
+        ProjectedArea(result, result->GetCellSet(0), outarea);
+        double scale = fabs(inarea[0]) + fabs(inarea[1]) + fabs(inarea[2]);
+        for (int d=0; d<3; d++)
+        {
+            if (fabs(outarea[d] - inarea[d]) > 1.e-4 * scale)
+                THROW(eavlException,"Tesselated cells don't cover the input.");
+        }
+        cout << "tesselated " << cells->GetNumCells() << " cells into "
+             << nedges << ", projected area " << outarea[0] << " "
+             << outarea[1] << " " << outarea[2] << endl;
+
+        if (argc == 3)
+        {
+            cerr << "\n\n-- done with tesselate, writing to file --\n";	
+            WriteToVTKFile(result, argv[2], 0);
+        }
+        else
+        {
+            cerr << "No output filename given; not writing result\n";
+        }
+
+
+        cout << "\n\n-- summary of data set result --\n";	
+        result->PrintSummary(cout);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <infile> [<outfile.vtk>]\n";
+        return 1;
+    }
+
+
+    return 0;
+}
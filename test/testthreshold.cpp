@@ -0,0 +1,139 @@
+// Copyright 2010-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "eavl.h"
+#include "eavlCUDA.h"
+#include "eavlFilter.h"
+#include "eavlDataSet.h"
+#include "eavlTimer.h"
+#include "eavlException.h"
+
+#include "eavlImporterFactory.h"
+#include "eavlVTKExporter.h"
+
+#include "eavlThresholdFilter.h"
+#include "eavlExecutor.h"
+
+
+eavlDataSet *ReadWholeFile(const string &filename)
+{
+    eavlImporter *importer = eavlImporterFactory::GetImporterForFile(filename);
+    
+    if (!importer)
+        THROW(eavlException,"Didn't determine proper file reader to use");
+
+    string mesh = importer->GetMeshList()[0];
+    eavlDataSet *out = importer->GetMesh(mesh, 0);
+    vector<string> allvars = importer->GetFieldList(mesh);
+    for (size_t i=0; i<allvars.size(); i++)
+        out->AddField(importer->GetField(allvars[i], mesh, 0));
+
+    return out;
+}
+ 
+void WriteToVTKFile(eavlDataSet *data, const string &filename,
+        int cellSetIndex = 0)
+{
+    ofstream *p = new ofstream(filename.c_str());
+    ostream *s = p;
+    eavlVTKExporter exporter(data, cellSetIndex);
+    exporter.Export(*s);
+    p->close();
+    delete p;
+}
+
+int main(int argc, char *argv[])
+{
+    try
+    {   
+        eavlExecutor::SetExecutionMode(eavlExecutor::PreferGPU);
+        eavlInitializeGPU();
+
+        if (argc != 5 && argc != 6)
+            THROW(eavlException,"Incorrect number of arguments");
+
+        double minval = strtod(argv[1], NULL);
+        double maxval = strtod(argv[2], NULL);
+        const char *fieldname = argv[3];
+
+        // Read the input
+        eavlDataSet *data = ReadWholeFile(argv[4]);
+
+        // use the first 3D cell set, or else the first 2D one
+        int cellsetindex = -1;
+        for (int dim = 3; dim >= 2 && cellsetindex < 0; dim--)
+        {
+            for (int i=0; i<data->GetNumCellSets(); i++)
+            {
+                if (data->GetCellSet(i)->GetDimensionality() == dim)
+                {
+                    cellsetindex = i;
+                    cerr << "Found " << dim << "D topo dim cell set name '"
+                         << data->GetCellSet(i)->GetName()
+                         << "' index " << cellsetindex << endl;
+                    break;
+                }
+            }
+        }
+        if (cellsetindex < 0)
+            THROW(eavlException,"Couldn't find a 2D or 3D cell set.  Aborting.");
+        string cellsetname = data->GetCellSet(cellsetindex)->GetName();
+
+        // keeping cells with any point in range must keep at least as
+        // many cells as keeping those with all points in range
+        eavlThresholdFilter *anythresh = new eavlThresholdFilter;
+        anythresh->SetInput(data);
+        anythresh->SetCellSet(cellsetname);
+        anythresh->SetField(fieldname);
+        anythresh->SetRange(minval, maxval);
+        anythresh->SetPointRule(eavlThresholdMutator::ANY_POINT);
+        anythresh->Execute();
+
+        eavlThresholdFilter *thresh = new eavlThresholdFilter;
+        thresh->SetInput(data);
+        thresh->SetCellSet(cellsetname);
+        thresh->SetField(fieldname);
+        thresh->SetRange(minval, maxval);
+        thresh->SetPointRule(eavlThresholdMutator::ALL_POINTS);
+        thresh->Execute();
+
+        eavlDataSet *result = thresh->GetOutput();
+        int ncells = result->GetCellSet(0)->GetNumCells();
+        int nany = anythresh->GetOutput()->GetCellSet(0)->GetNumCells();
+        cout << "cells kept: " << ncells << " of "
+             << data->GetCellSet(cellsetindex)->GetNumCells()
+             << " (any point rule: " << nany << ")" << endl;
+        if (nany < ncells)
+            THROW(eavlException,"Any point rule kept fewer cells than all points.");
+
+        // every value of the thresholded field in the result must be in range
+        eavlArray *a = result->GetField(fieldname)->GetArray();
+        for (int i=0; i<a->GetNumberOfTuples(); i++)
+        {
+            double v = a->GetComponentAsDouble(i,0);
+            if (v < minval || v > maxval)
+                THROW(eavlException,"Found a value outside the threshold range.");
+        }
+
+        if (argc == 6)
+        {
+            cerr << "\n\n-- done with threshold, writing to file --\n";	
+            WriteToVTKFile(result, argv[5], 0);
+        }
+        else
+        {
+            cerr << "No output filename given; not writing result\n";
+        }
+
+
+        cout << "\n\n-- summary of data set result --\n";	
+        result->PrintSummary(cout);
+    }
+    catch (const eavlException &e)
+    {
+        cerr << e.GetErrorText() << endl;
+        cerr << "\nUsage: "<<argv[0]<<" <min> <max> <fieldname> <infile.vtk> [<outfile.vtk>]\n";
+        return 1;
+    }
+
+
+    return 0;
+}